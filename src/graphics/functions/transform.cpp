@@ -1,5 +1,9 @@
 #include "transform.hpp"
 
+#include <stdexcept>
+
+#include "util_functions.hpp"
+
 namespace gfx {
     // 2D Translation Matrix Factory Function (Float List Argument Overload)
     Matrix3 create2DTranslationMatrix(const double x, const double y)
@@ -220,4 +224,215 @@ namespace gfx {
 
         return orientation * createTranslationMatrix(-input_space);
     }
+
+    // Returns the unit quaternion, as (w, x, y, z), of the rotation held in the upper-left 3x3 block of a matrix
+    static std::array<double, 4> extractRotationQuaternion(const Matrix4& rotation)
+    {
+        // Divide by the largest of the four quaternion components to keep the result numerically stable
+        const double trace{ rotation[0, 0] + rotation[1, 1] + rotation[2, 2] };
+        if (trace > 0) {
+            const double s{ std::sqrt(trace + 1) * 2 };
+            return { s / 4,
+                     (rotation[2, 1] - rotation[1, 2]) / s,
+                     (rotation[0, 2] - rotation[2, 0]) / s,
+                     (rotation[1, 0] - rotation[0, 1]) / s };
+        }
+        if (rotation[0, 0] > rotation[1, 1] && rotation[0, 0] > rotation[2, 2]) {
+            const double s{ std::sqrt(1 + rotation[0, 0] - rotation[1, 1] - rotation[2, 2]) * 2 };
+            return { (rotation[2, 1] - rotation[1, 2]) / s,
+                     s / 4,
+                     (rotation[0, 1] + rotation[1, 0]) / s,
+                     (rotation[0, 2] + rotation[2, 0]) / s };
+        }
+        if (rotation[1, 1] > rotation[2, 2]) {
+            const double s{ std::sqrt(1 + rotation[1, 1] - rotation[0, 0] - rotation[2, 2]) * 2 };
+            return { (rotation[0, 2] - rotation[2, 0]) / s,
+                     (rotation[0, 1] + rotation[1, 0]) / s,
+                     s / 4,
+                     (rotation[1, 2] + rotation[2, 1]) / s };
+        }
+        const double s{ std::sqrt(1 + rotation[2, 2] - rotation[0, 0] - rotation[1, 1]) * 2 };
+        return { (rotation[1, 0] - rotation[0, 1]) / s,
+                 (rotation[0, 2] + rotation[2, 0]) / s,
+                 (rotation[1, 2] + rotation[2, 1]) / s,
+                 s / 4 };
+    }
+
+    // Transform Decomposer
+    TransformDecomposition decomposeTransform(const Matrix4& transform_matrix)
+    {
+        // The columns of the upper-left 3x3 block are the rotated and scaled basis vectors
+        std::array<Vector4, 3> basis_vectors{ };
+        for (size_t col = 0; col < 3; ++col) {
+            basis_vectors[col] = createVector(transform_matrix[0, col],
+                                              transform_matrix[1, col],
+                                              transform_matrix[2, col]);
+        }
+
+        const double determinant{ dotProduct(basis_vectors[0], basis_vectors[1].crossProduct(basis_vectors[2])) };
+        if (utils::areEqual(determinant, 0.0)) {
+            throw std::invalid_argument{ "Cannot decompose a singular transformation matrix" };
+        }
+
+        // A reflection cannot be represented by a rotation, so it is folded into the x-scale
+        TransformDecomposition decomposition{ };
+        const double x_scale{ determinant < 0 ? -basis_vectors[0].magnitude() : basis_vectors[0].magnitude() };
+        decomposition.scale = createVector(x_scale, basis_vectors[1].magnitude(), basis_vectors[2].magnitude());
+        decomposition.translation = createVector(transform_matrix[0, 3],
+                                                 transform_matrix[1, 3],
+                                                 transform_matrix[2, 3]);
+
+        // Shear is discarded by orthonormalizing the basis vectors before extracting the rotation
+        const Vector4 x_axis{ normalize(basis_vectors[0]) * (determinant < 0 ? -1.0 : 1.0) };
+        const Vector4 z_axis{ normalize(x_axis.crossProduct(basis_vectors[1])) };
+        const Vector4 y_axis{ z_axis.crossProduct(x_axis) };
+        const Matrix4 rotation{
+            x_axis.x(), y_axis.x(), z_axis.x(), 0,
+            x_axis.y(), y_axis.y(), z_axis.y(), 0,
+            x_axis.z(), y_axis.z(), z_axis.z(), 0,
+            0, 0, 0, 1
+        };
+        decomposition.rotation = extractRotationQuaternion(rotation);
+
+        return decomposition;
+    }
+
+    // Transform Composer
+    Matrix4 composeTransform(const TransformDecomposition& decomposition)
+    {
+        const auto [ w, x, y, z ] { decomposition.rotation };
+        const Matrix4 rotation{
+            1 - 2 * (y * y + z * z), 2 * (x * y - z * w), 2 * (x * z + y * w), 0,
+            2 * (x * y + z * w), 1 - 2 * (x * x + z * z), 2 * (y * z - x * w), 0,
+            2 * (x * z - y * w), 2 * (y * z + x * w), 1 - 2 * (x * x + y * y), 0,
+            0, 0, 0, 1
+        };
+
+        return createTranslationMatrix(decomposition.translation) * rotation * createScalingMatrix(decomposition.scale);
+    }
+
+    // Transform Interpolator
+    Matrix4 interpolateTransforms(const Matrix4& start_transform, const Matrix4& end_transform, const double t)
+    {
+        const TransformDecomposition start{ decomposeTransform(start_transform) };
+        const TransformDecomposition end{ decomposeTransform(end_transform) };
+
+        TransformDecomposition interpolated{ };
+        interpolated.translation = start.translation + (end.translation - start.translation) * t;
+        interpolated.scale = start.scale + (end.scale - start.scale) * t;
+
+        // A quaternion and its negation describe the same rotation, so flip the end rotation if needed to take the
+        // shorter of the two arcs between them
+        std::array<double, 4> end_rotation{ end.rotation };
+        double cos_angle{ 0 };
+        for (size_t i = 0; i < 4; ++i) {
+            cos_angle += start.rotation[i] * end_rotation[i];
+        }
+        if (cos_angle < 0) {
+            cos_angle = -cos_angle;
+            for (double& component : end_rotation) {
+                component = -component;
+            }
+        }
+
+        // Spherical interpolation is unstable for nearly equal rotations, where a normalized linear interpolation
+        // is indistinguishable from it
+        double start_weight{ 1 - t };
+        double end_weight{ t };
+        if (cos_angle < 1 - utils::EPSILON) {
+            const double angle{ std::acos(cos_angle) };
+            start_weight = std::sin((1 - t) * angle) / std::sin(angle);
+            end_weight = std::sin(t * angle) / std::sin(angle);
+        }
+
+        double rotation_length{ 0 };
+        for (size_t i = 0; i < 4; ++i) {
+            interpolated.rotation[i] = start_weight * start.rotation[i] + end_weight * end_rotation[i];
+            rotation_length += interpolated.rotation[i] * interpolated.rotation[i];
+        }
+        for (double& component : interpolated.rotation) {
+            component /= std::sqrt(rotation_length);
+        }
+
+        return composeTransform(interpolated);
+    }
+
+    // Transform Classifier
+    TransformType classifyTransform(const Matrix4& transform_matrix)
+    {
+        // Exact comparisons are used throughout so that each fast path reproduces the full matrix product exactly
+        if (transform_matrix[3, 0] != 0.0 || transform_matrix[3, 1] != 0.0 ||
+            transform_matrix[3, 2] != 0.0 || transform_matrix[3, 3] != 1.0)
+            return TransformType::GeneralAffine;
+
+        // Any off-diagonal value in the upper-left 3x3 block indicates a rotation or skew
+        for (int row = 0; row < 3; ++row)
+            for (int col = 0; col < 3; ++col) {
+                if (row != col && transform_matrix[row, col] != 0.0)
+                    return TransformType::GeneralAffine;
+            }
+
+        // Non-uniform scaling (or a degenerate zero scaling) cannot be handled by a single scalar
+        const double scale{ transform_matrix[0, 0] };
+        if (scale == 0.0 || transform_matrix[1, 1] != scale || transform_matrix[2, 2] != scale)
+            return TransformType::GeneralAffine;
+
+        if (scale != 1.0)
+            return TransformType::UniformScale;
+
+        if (transform_matrix[0, 3] != 0.0 || transform_matrix[1, 3] != 0.0 || transform_matrix[2, 3] != 0.0)
+            return TransformType::Translation;
+
+        return TransformType::Identity;
+    }
+
+    // Classified Transform Standard Constructor
+    ClassifiedTransform::ClassifiedTransform(const Matrix4& transform_matrix)
+            : m_matrix{ transform_matrix },
+              m_inverse{ transform_matrix.inverse() },
+              m_normal_matrix{ m_inverse.transpose() },
+              m_type{ classifyTransform(transform_matrix) },
+              m_translation{ transform_matrix[0, 3], transform_matrix[1, 3], transform_matrix[2, 3], 0 },
+              m_scale{ transform_matrix[0, 0] }
+    {}
+
+    // Inverse Transform Application
+    Vector4 ClassifiedTransform::applyInverse(const Vector4& tuple) const
+    {
+        // The translation only applies to points, so it is weighted by the w-value of the tuple
+        switch (m_type) {
+            case TransformType::Identity:
+                return tuple;
+            case TransformType::Translation:
+                return Vector4{ tuple.x() - m_translation.x() * tuple.w(),
+                                tuple.y() - m_translation.y() * tuple.w(),
+                                tuple.z() - m_translation.z() * tuple.w(),
+                                tuple.w() };
+            case TransformType::UniformScale:
+                return Vector4{ (tuple.x() - m_translation.x() * tuple.w()) / m_scale,
+                                (tuple.y() - m_translation.y() * tuple.w()) / m_scale,
+                                (tuple.z() - m_translation.z() * tuple.w()) / m_scale,
+                                tuple.w() };
+            case TransformType::GeneralAffine:
+                break;
+        }
+        return m_inverse * tuple;
+    }
+
+    // Normal Transform Application
+    Vector4 ClassifiedTransform::applyToNormal(const Vector4& normal) const
+    {
+        // The inverse transpose of a translation leaves a normal's direction untouched, and a uniform scaling
+        // only affects its length (and its sign, for a negative scale factor), so only general transforms
+        // require the full matrix product
+        Vector4 transformed_normal{ normal };
+        if (m_type == TransformType::GeneralAffine)
+            transformed_normal = m_normal_matrix * normal;
+        else if (m_type == TransformType::UniformScale && m_scale < 0.0)
+            transformed_normal = -transformed_normal;
+
+        // Reset the w-value in case the transformation matrix included a translation
+        transformed_normal.resetW();
+        return transformed_normal;
+    }
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <cmath>
 
 #include "matrix3.hpp"
@@ -8,6 +9,81 @@
 #include "vector4.hpp"
 
 namespace gfx {
+    // Categories of affine transform, ordered from cheapest to most expensive to apply
+    enum class TransformType {
+        Identity,               // No transformation
+        Translation,            // Pure translation
+        UniformScale,           // Uniform scaling followed by a (possibly zero) translation
+        GeneralAffine           // Any other affine transformation
+    };
+
+    // A transformation matrix stored alongside its inverse and classification, so that points, vectors, and normals
+    // can be moved between spaces using the cheapest exact method available for that transform
+    class ClassifiedTransform
+    {
+    public:
+        /* Constructors */
+
+        // Default Constructor (Identity Transform)
+        ClassifiedTransform() = default;
+
+        // Standard Constructor
+        explicit ClassifiedTransform(const Matrix4& transform_matrix);
+
+        // Copy Constructor
+        ClassifiedTransform(const ClassifiedTransform&) = default;
+
+        /* Destructor */
+
+        ~ClassifiedTransform() = default;
+
+        /* Assignment Operators */
+
+        ClassifiedTransform& operator=(const ClassifiedTransform&) = default;
+
+        /* Accessors */
+
+        [[nodiscard]] const Matrix4& getMatrix() const
+        { return m_matrix; }
+
+        [[nodiscard]] const Matrix4& getInverse() const
+        { return m_inverse; }
+
+        [[nodiscard]] TransformType getType() const
+        { return m_type; }
+
+        /* Transformation Operations */
+
+        // Returns a point or vector transformed by the inverse of this transform
+        [[nodiscard]] Vector4 applyInverse(const Vector4& tuple) const;
+
+        // Returns a normal vector transformed by the inverse transpose of this transform, with the w-value reset.
+        // The result is not normalized.
+        [[nodiscard]] Vector4 applyToNormal(const Vector4& normal) const;
+
+    private:
+        /* Data Members */
+
+        Matrix4 m_matrix{ };
+        Matrix4 m_inverse{ };
+        Matrix4 m_normal_matrix{ };     // Transpose of the inverse transform
+
+        /* Cached State */
+        // Values extracted from the matrix for the non-general transform types
+
+        TransformType m_type{ TransformType::Identity };
+        Vector4 m_translation{ 0, 0, 0, 0 };
+        double m_scale{ 1.0 };
+    };
+
+    // The translation, rotation and per-axis scale which compose an affine transform as translation * rotation * scale
+    struct TransformDecomposition
+    {
+        Vector4 translation{ 0, 0, 0, 0 };
+        std::array<double, 4> rotation{ 1, 0, 0, 0 };   // A unit quaternion, stored as (w, x, y, z)
+        Vector4 scale{ 1, 1, 1, 0 };
+    };
+
     /* 2D Transformation Matrix Factory Functions */
 
     // Returns a matrix representing a 2D translation along the vector formed by passed-in coordinates
@@ -77,4 +153,24 @@ namespace gfx {
             const Vector4& input_space,
             const Vector4& output_space,
             const Vector4& up_vector);
+
+    /* Transform Decomposition Functions */
+
+    // Returns the translation, rotation and scale of an affine transformation matrix. A reflection is represented by
+    // negating the x-scale, and any shear is discarded. Throws if the matrix is singular.
+    [[nodiscard]] TransformDecomposition decomposeTransform(const Matrix4& transform_matrix);
+
+    // Returns the transformation matrix formed by translation * rotation * scale
+    [[nodiscard]] Matrix4 composeTransform(const TransformDecomposition& decomposition);
+
+    // Returns the transform a fraction t of the way between two transforms, interpolating their translations and
+    // scales linearly and their rotations along the shortest arc
+    [[nodiscard]] Matrix4 interpolateTransforms(const Matrix4& start_transform,
+                                                const Matrix4& end_transform,
+                                                double t);
+
+    /* Transform Classification Functions */
+
+    // Returns the cheapest transform category which exactly represents the passed-in transformation matrix
+    [[nodiscard]] TransformType classifyTransform(const Matrix4& transform_matrix);
 }
\ No newline at end of file
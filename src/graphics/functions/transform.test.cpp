@@ -2,6 +2,7 @@
 #include "transform.hpp"
 
 #include <cmath>
+#include <stdexcept>
 
 #include "matrix4.hpp"
 #include "vector4.hpp"
@@ -379,4 +380,66 @@ TEST(GraphicsMatrixTransformations, CreateViewTransformMatrix)
                     up_vector_d) };
 
     EXPECT_EQ(view_transform_actual_d, view_transform_expected_d);
+}
+
+// Tests classifying transformation matrices by the cheapest equivalent transform
+TEST(GraphicsMatrixTransformations, ClassifyTransform)
+{
+    EXPECT_EQ(gfx::classifyTransform(gfx::createIdentityMatrix()), gfx::TransformType::Identity);
+    EXPECT_EQ(gfx::classifyTransform(gfx::createTranslationMatrix(1, -2, 3)), gfx::TransformType::Translation);
+    EXPECT_EQ(gfx::classifyTransform(gfx::createScalingMatrix(2)), gfx::TransformType::UniformScale);
+    EXPECT_EQ(gfx::classifyTransform(gfx::createTranslationMatrix(1, -2, 3) * gfx::createScalingMatrix(-0.5)),
+              gfx::TransformType::UniformScale);
+    EXPECT_EQ(gfx::classifyTransform(gfx::createScalingMatrix(1, 2, 1)), gfx::TransformType::GeneralAffine);
+    EXPECT_EQ(gfx::classifyTransform(gfx::createYRotationMatrix(M_PI / 3)), gfx::TransformType::GeneralAffine);
+    EXPECT_EQ(gfx::classifyTransform(gfx::createSkewMatrix(1, 0, 0, 0, 0, 0)), gfx::TransformType::GeneralAffine);
+}
+
+// Tests decomposing transformation matrices into their translation, rotation and scale
+TEST(GraphicsMatrixTransformations, DecomposeTransform)
+{
+    const gfx::Matrix4 transform{ gfx::createTranslationMatrix(1, -2, 3) *
+                                  gfx::createYRotationMatrix(M_PI / 3) *
+                                  gfx::createXRotationMatrix(M_PI / 5) *
+                                  gfx::createScalingMatrix(2, 0.5, 3) };
+
+    const gfx::TransformDecomposition decomposition{ gfx::decomposeTransform(transform) };
+
+    EXPECT_EQ(decomposition.translation, gfx::createVector(1, -2, 3));
+    EXPECT_EQ(decomposition.scale, gfx::createVector(2, 0.5, 3));
+    EXPECT_EQ(gfx::composeTransform(decomposition), transform);
+
+    // A rotation of pi/2 around the y-axis is the quaternion (cos(pi/4), 0, sin(pi/4), 0)
+    const gfx::TransformDecomposition rotation{ gfx::decomposeTransform(gfx::createYRotationMatrix(M_PI / 2)) };
+    EXPECT_FLOAT_EQ(rotation.rotation[0], std::sqrt(2) / 2);
+    EXPECT_FLOAT_EQ(rotation.rotation[2], std::sqrt(2) / 2);
+
+    // Reflections are folded into the x-scale
+    const gfx::Matrix4 reflection{ gfx::createZRotationMatrix(M_PI / 4) * gfx::createScalingMatrix(1, -1, 1) };
+    const gfx::TransformDecomposition reflection_decomposition{ gfx::decomposeTransform(reflection) };
+    EXPECT_LT(reflection_decomposition.scale.x(), 0);
+    EXPECT_EQ(gfx::composeTransform(reflection_decomposition), reflection);
+
+    EXPECT_THROW(static_cast<void>(gfx::decomposeTransform(gfx::createScalingMatrix(1, 0, 1))), std::invalid_argument);
+}
+
+// Tests interpolating between transformation matrices
+TEST(GraphicsMatrixTransformations, InterpolateTransforms)
+{
+    const gfx::Matrix4 start{ gfx::createTranslationMatrix(0, 0, 0) };
+    const gfx::Matrix4 end{ gfx::createTranslationMatrix(4, 2, 0) *
+                            gfx::createZRotationMatrix(M_PI / 2) *
+                            gfx::createScalingMatrix(3) };
+
+    EXPECT_EQ(gfx::interpolateTransforms(start, end, 0), start);
+    EXPECT_EQ(gfx::interpolateTransforms(start, end, 1), end);
+    EXPECT_EQ(gfx::interpolateTransforms(start, end, 0.5),
+              gfx::createTranslationMatrix(2, 1, 0) *
+              gfx::createZRotationMatrix(M_PI / 4) *
+              gfx::createScalingMatrix(2));
+
+    // Rotations are interpolated along the shorter arc, even when it crosses a half turn
+    const gfx::Matrix4 rotation_start{ gfx::createYRotationMatrix(M_PI * 0.9) };
+    const gfx::Matrix4 rotation_end{ gfx::createYRotationMatrix(-M_PI * 0.9) };
+    EXPECT_EQ(gfx::interpolateTransforms(rotation_start, rotation_end, 0.5), gfx::createYRotationMatrix(M_PI));
 }
\ No newline at end of file
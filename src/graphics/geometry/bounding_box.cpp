@@ -47,6 +47,18 @@ namespace gfx {
         return this->containsPoint(box.getMinExtentPoint()) && this->containsPoint(box.getMaxExtentPoint());
     }
 
+    bool BoundingBox::overlapsBox(const BoundingBox& box) const
+    {
+        for (size_t axis = 0; axis < 3; ++axis) {
+            if (!utils::isLessOrEqual(m_min_extents[axis], box.m_max_extents[axis]) ||
+                !utils::isLessOrEqual(box.m_min_extents[axis], m_max_extents[axis])) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
 
     bool BoundingBox::isIntersectedBy(const Ray& ray) const
     {
@@ -130,6 +130,9 @@ namespace gfx {
         // by the extents of this bounding box
         [[nodiscard]] bool containsBox(const BoundingBox& box) const;
 
+        // Returns true if the extents of the passed-in bounding box overlap or touch the extents of this bounding box
+        [[nodiscard]] bool overlapsBox(const BoundingBox& box) const;
+
         // Returns true if a ray intersects with this bounding box
         [[nodiscard]] bool isIntersectedBy(const Ray& ray) const;
 
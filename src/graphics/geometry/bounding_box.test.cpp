@@ -230,6 +230,32 @@ TEST(GraphicsBoundingBox, ContainsBox)
     }
 }
 
+// Tests checking if a bounding box overlaps the extents of another bounding box
+TEST(GraphicsBoundingBox, OverlapsBox)
+{
+    const gfx::BoundingBox bounding_box{ 5, -2, 0,
+                                         11, 4, 7 };
+    constexpr double INF{ std::numeric_limits<double>::infinity() };
+
+    std::vector<std::pair<gfx::BoundingBox, bool>> test_cases_input_expected{
+            { gfx::BoundingBox{ 6, -1, 1, 10, 3, 6 }, true },
+            { gfx::BoundingBox{ 0, 0, 0, 6, 1, 1 }, true },
+            { gfx::BoundingBox{ 11, 4, 7, 12, 5, 8 }, true },
+            { gfx::BoundingBox{ 0, 0, 0, 4, 1, 1 }, false },
+            { gfx::BoundingBox{ 6, 5, 1, 10, 6, 6 }, false },
+            { gfx::BoundingBox{ 6, -1, -INF, 10, 3, -1 }, false },
+            { gfx::BoundingBox{ 6, -1, -INF, 10, 3, INF }, true },
+            { gfx::BoundingBox{ }, false }
+    };
+
+    for (const auto test_case : test_cases_input_expected) {
+        auto [input_box, result_expected] { test_case };
+
+        const bool result_actual{ bounding_box.overlapsBox(input_box) };
+        EXPECT_EQ(result_actual, result_expected);
+    }
+}
+
 // Tests transforming a bounding box and getting a new enclosing volume
 TEST(GraphicsBoundingBox, Transform)
 {
@@ -0,0 +1,204 @@
+#include "bounding_volume_hierarchy.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+namespace gfx {
+    // Maximum number of primitives stored in a single leaf node
+    static constexpr size_t MAX_LEAF_PRIMITIVES{ 4 };
+
+    // The relative costs of testing a ray against the bounds of a node and against a single primitive, used to
+    // estimate the quality of a hierarchy
+    static constexpr double SAH_TRAVERSAL_COST{ 1.0 };
+    static constexpr double SAH_INTERSECTION_COST{ 1.0 };
+
+    // Standard Constructor
+    BoundingVolumeHierarchy::BoundingVolumeHierarchy(const std::vector<BoundingBox>& primitive_bounds)
+            : m_nodes{ }, m_primitive_indices(primitive_bounds.size())
+    {
+        if (primitive_bounds.empty()) {
+            return;
+        }
+
+        // Primitives are partitioned around the centers of their bounds
+        std::vector<std::array<double, 3>> primitive_centroids{ };
+        primitive_centroids.reserve(primitive_bounds.size());
+        for (const BoundingBox& bounds : primitive_bounds) {
+            primitive_centroids.push_back({ (bounds.getMinX() + bounds.getMaxX()) / 2,
+                                            (bounds.getMinY() + bounds.getMaxY()) / 2,
+                                            (bounds.getMinZ() + bounds.getMaxZ()) / 2 });
+        }
+
+        for (size_t i = 0; i < m_primitive_indices.size(); ++i) {
+            m_primitive_indices[i] = static_cast<uint32_t>(i);
+        }
+
+        m_nodes.reserve(2 * primitive_bounds.size());
+        this->buildNode(primitive_bounds, primitive_centroids, 0, primitive_bounds.size());
+        m_nodes.shrink_to_fit();
+
+        // Link each node and primitive to the node above it, so that partial refits can walk up the hierarchy
+        m_parent_indices.resize(m_nodes.size(), 0);
+        m_primitive_leaves.resize(primitive_bounds.size(), 0);
+        m_dirty_nodes.resize(m_nodes.size(), 0);
+        for (uint32_t node_index = 0; node_index < m_nodes.size(); ++node_index) {
+            const Node& node{ m_nodes[node_index] };
+            m_sah_cost_sum += calculateWeightedArea(node);
+            if (node.isLeaf()) {
+                for (uint32_t i = node.offset; i < node.offset + node.primitive_count; ++i) {
+                    m_primitive_leaves[m_primitive_indices[i]] = node_index;
+                }
+            } else {
+                m_parent_indices[node_index + 1] = node_index;
+                m_parent_indices[node.offset] = node_index;
+            }
+        }
+        m_build_sah_cost = m_sah_cost_sum;
+    }
+
+    // Recursive Node Builder
+    uint32_t BoundingVolumeHierarchy::buildNode(const std::vector<BoundingBox>& primitive_bounds,
+                                                const std::vector<std::array<double, 3>>& primitive_centroids,
+                                                const size_t begin,
+                                                const size_t end)
+    {
+        const auto node_index{ static_cast<uint32_t>(m_nodes.size()) };
+        m_nodes.emplace_back();
+
+        // Enclose the bounds of every primitive in this node, tracking the spread of their centroids
+        BoundingBox node_bounds{ };
+        BoundingBox centroid_bounds{ };
+        for (size_t i = begin; i < end; ++i) {
+            node_bounds.mergeWithBox(primitive_bounds[m_primitive_indices[i]]);
+            const auto& [ x, y, z ] { primitive_centroids[m_primitive_indices[i]] };
+            centroid_bounds.addPoint(createPoint(x, y, z));
+        }
+        m_nodes[node_index].bounds = node_bounds;
+
+        // Small primitive lists are stored directly in a leaf
+        const size_t primitive_count{ end - begin };
+        if (primitive_count <= MAX_LEAF_PRIMITIVES) {
+            m_nodes[node_index].offset = static_cast<uint32_t>(begin);
+            m_nodes[node_index].primitive_count = static_cast<uint32_t>(primitive_count);
+            return node_index;
+        }
+
+        // Split at the median centroid along the axis where the centroids are most spread out
+        const std::array<double, 3> centroid_spread{ centroid_bounds.getMaxX() - centroid_bounds.getMinX(),
+                                                     centroid_bounds.getMaxY() - centroid_bounds.getMinY(),
+                                                     centroid_bounds.getMaxZ() - centroid_bounds.getMinZ() };
+        const auto split_axis{ std::distance(centroid_spread.begin(),
+                                             std::max_element(centroid_spread.begin(), centroid_spread.end())) };
+
+        const size_t middle{ begin + primitive_count / 2 };
+        std::nth_element(m_primitive_indices.begin() + static_cast<std::ptrdiff_t>(begin),
+                         m_primitive_indices.begin() + static_cast<std::ptrdiff_t>(middle),
+                         m_primitive_indices.begin() + static_cast<std::ptrdiff_t>(end),
+                         [&](const uint32_t lhs, const uint32_t rhs) {
+                             return primitive_centroids[lhs][split_axis] < primitive_centroids[rhs][split_axis];
+                         });
+
+        // The left child is built first so that it is stored directly after this node
+        this->buildNode(primitive_bounds, primitive_centroids, begin, middle);
+        const uint32_t right_child_index{ this->buildNode(primitive_bounds, primitive_centroids, middle, end) };
+        m_nodes[node_index].offset = right_child_index;
+
+        return node_index;
+    }
+
+    // Hierarchy Refitter
+    void BoundingVolumeHierarchy::refit(const std::vector<BoundingBox>& primitive_bounds)
+    {
+        if (primitive_bounds.size() != m_primitive_indices.size()) {
+            throw std::invalid_argument("Cannot refit a hierarchy to a different number of primitives");
+        }
+
+        // Children are always stored after their parent, so visiting the nodes in reverse refits every child before
+        // the parent which encloses it
+        for (size_t node_index = m_nodes.size(); node_index-- > 0;) {
+            this->refitNode(static_cast<uint32_t>(node_index), primitive_bounds);
+        }
+
+        // Recalculate the cost from scratch, discarding any rounding errors accumulated by partial refits
+        m_sah_cost_sum = 0;
+        for (const Node& node : m_nodes) {
+            m_sah_cost_sum += calculateWeightedArea(node);
+        }
+    }
+
+    // Partial Hierarchy Refitter
+    void BoundingVolumeHierarchy::refit(const std::vector<BoundingBox>& primitive_bounds,
+                                        const std::span<const size_t> changed_primitives)
+    {
+        if (primitive_bounds.size() != m_primitive_indices.size()) {
+            throw std::invalid_argument("Cannot refit a hierarchy to a different number of primitives");
+        }
+
+        // Flag the path from each changed primitive up to the root, ending at the root or at the first node which is
+        // already flagged, since every node above it is flagged too
+        std::vector<uint32_t> dirty_nodes{ };
+        for (const size_t primitive_index : changed_primitives) {
+            uint32_t node_index{ m_primitive_leaves.at(primitive_index) };
+            while (!m_dirty_nodes[node_index]) {
+                m_dirty_nodes[node_index] = 1;
+                dirty_nodes.push_back(node_index);
+                node_index = m_parent_indices[node_index];
+            }
+        }
+
+        // Refit the flagged nodes from the bottom of the hierarchy up, clearing their flags
+        std::ranges::sort(dirty_nodes, std::greater{ });
+        for (const uint32_t node_index : dirty_nodes) {
+            this->refitNode(node_index, primitive_bounds);
+            m_dirty_nodes[node_index] = 0;
+        }
+    }
+
+    // Single Node Refitter
+    void BoundingVolumeHierarchy::refitNode(const uint32_t node_index, const std::vector<BoundingBox>& primitive_bounds)
+    {
+        Node& node{ m_nodes[node_index] };
+        m_sah_cost_sum -= calculateWeightedArea(node);
+
+        BoundingBox node_bounds{ };
+        if (node.isLeaf()) {
+            for (uint32_t i = node.offset; i < node.offset + node.primitive_count; ++i) {
+                node_bounds.mergeWithBox(primitive_bounds[m_primitive_indices[i]]);
+            }
+        } else {
+            node_bounds.mergeWithBox(m_nodes[node_index + 1].bounds);
+            node_bounds.mergeWithBox(m_nodes[node.offset].bounds);
+        }
+        node.bounds = node_bounds;
+
+        m_sah_cost_sum += calculateWeightedArea(node);
+    }
+
+    // Weighted Node Area Calculator
+    double BoundingVolumeHierarchy::calculateWeightedArea(const Node& node)
+    {
+        const double x_extent{ node.bounds.getMaxX() - node.bounds.getMinX() };
+        const double y_extent{ node.bounds.getMaxY() - node.bounds.getMinY() };
+        const double z_extent{ node.bounds.getMaxZ() - node.bounds.getMinZ() };
+        const double surface_area{ 2 * (x_extent * y_extent + y_extent * z_extent + z_extent * x_extent) };
+
+        return surface_area * (node.isLeaf() ? node.primitive_count * SAH_INTERSECTION_COST : SAH_TRAVERSAL_COST);
+    }
+
+    // Node Bounds Check
+    bool BoundingVolumeHierarchy::isNodeIntersected(const BoundingBox& bounds,
+                                                    const Ray& ray,
+                                                    const double t_min,
+                                                    const double t_max)
+    {
+        const auto [ t_enter, t_exit ] { calculateBoxIntersectionTs(ray,
+                                                                    bounds.getMinExtentPoint(),
+                                                                    bounds.getMaxExtentPoint()) };
+
+        return
+                utils::isLessOrEqual(t_enter, t_exit) &&
+                utils::isLessOrEqual(t_enter, t_max) &&
+                utils::isGreaterOrEqual(t_exit, t_min);
+    }
+}
\ No newline at end of file
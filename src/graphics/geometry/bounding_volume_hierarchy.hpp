@@ -0,0 +1,231 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "bounding_box.hpp"
+#include "ray.hpp"
+#include "ray_packet.hpp"
+#include "intersection.hpp"
+#include "util_functions.hpp"
+
+namespace gfx {
+    class BoundingVolumeHierarchy
+    {
+    public:
+        /* BVH Node */
+        // Nodes are stored depth-first in a single array, so the left child of an interior node always immediately
+        // follows its parent and only the index of the right child needs to be stored
+
+        struct Node
+        {
+            BoundingBox bounds{ };
+            uint32_t offset{ 0 };           // Index of the right child (interior nodes) or first primitive (leaves)
+            uint32_t primitive_count{ 0 };  // Zero for interior nodes
+
+            [[nodiscard]] bool isLeaf() const
+            { return primitive_count > 0; }
+        };
+
+        /* Constructors */
+
+        // Default Constructor
+        BoundingVolumeHierarchy() = default;
+
+        // Builds a hierarchy over a list of primitive bounds, which must all be finite
+        explicit BoundingVolumeHierarchy(const std::vector<BoundingBox>& primitive_bounds);
+
+        // Copy Constructor
+        BoundingVolumeHierarchy(const BoundingVolumeHierarchy&) = default;
+
+        // Move Constructor
+        BoundingVolumeHierarchy(BoundingVolumeHierarchy&&) = default;
+
+        /* Destructor */
+
+        ~BoundingVolumeHierarchy() = default;
+
+        /* Assignment Operators */
+
+        BoundingVolumeHierarchy& operator=(const BoundingVolumeHierarchy&) = default;
+        BoundingVolumeHierarchy& operator=(BoundingVolumeHierarchy&&) = default;
+
+        /* Accessors */
+
+        [[nodiscard]] bool isEmpty() const
+        { return m_nodes.empty(); }
+
+        [[nodiscard]] size_t getNodeCount() const
+        { return m_nodes.size(); }
+
+        [[nodiscard]] const Node& getNodeAt(const size_t index) const
+        { return m_nodes.at(index); }
+
+        [[nodiscard]] size_t getPrimitiveCount() const
+        { return m_primitive_indices.size(); }
+
+        // Returns the number of bytes used by the node, primitive and refitting arrays
+        [[nodiscard]] size_t getMemoryUsage() const
+        {
+            return
+                    m_nodes.capacity() * sizeof(Node) +
+                    m_primitive_indices.capacity() * sizeof(uint32_t) +
+                    m_parent_indices.capacity() * sizeof(uint32_t) +
+                    m_primitive_leaves.capacity() * sizeof(uint32_t) +
+                    m_dirty_nodes.capacity() * sizeof(uint8_t);
+        }
+
+        // Returns the surface area heuristic cost of the hierarchy: the surface area of each node, weighted by the
+        // cost of visiting it. The sum is left unnormalized by the area of the root, so that nodes which grow to
+        // follow primitives moving apart raise the cost even as the root grows with them.
+        [[nodiscard]] double getSAHCost() const
+        { return m_sah_cost_sum; }
+
+        // Returns the surface area heuristic cost of the hierarchy when it was built
+        [[nodiscard]] double getBuildSAHCost() const
+        { return m_build_sah_cost; }
+
+        /* Mutators */
+
+        // Recomputes the bounds of every node from updated primitive bounds, listed in the same order as those the
+        // hierarchy was built from, while keeping its structure. Refitting is much cheaper than rebuilding, but the
+        // hierarchy becomes less efficient to traverse the further the primitives move from where it was built.
+        void refit(const std::vector<BoundingBox>& primitive_bounds);
+
+        // Refits only the nodes enclosing the passed-in changed primitives. Each changed primitive flags its leaf and
+        // ancestors as dirty, stopping at the first ancestor which is already flagged, so that every dirty node is
+        // refitted exactly once, in O(depth) nodes per changed primitive.
+        void refit(const std::vector<BoundingBox>& primitive_bounds, std::span<const size_t> changed_primitives);
+
+        /* Traversal Operations */
+
+        // Visits the index of each primitive whose leaf bounds are intersected by the ray within the range
+        // [t_min, t_max]. The visitor returns true to end the traversal early, in which case traverse returns true.
+        template<typename PrimitiveVisitor>
+        bool traverse(const Ray& ray, double t_min, double t_max, PrimitiveVisitor&& visit_primitive) const;
+
+        // Visits every primitive whose leaf bounds lie anywhere along the line of the ray
+        template<typename PrimitiveVisitor>
+        void traverse(const Ray& ray, PrimitiveVisitor&& visit_primitive) const
+        {
+            this->traverse(ray,
+                           -std::numeric_limits<double>::infinity(),
+                           std::numeric_limits<double>::infinity(),
+                           [&](const size_t primitive_index) { visit_primitive(primitive_index); return false; });
+        }
+
+        // Visits each primitive whose leaf bounds are intersected by any active lane of the packet, along with the
+        // mask of lanes which reached it. Subtrees are skipped as soon as every lane of the packet misses them.
+        template<typename PacketPrimitiveVisitor>
+        void traverse(const RayPacket& packet, PacketPrimitiveVisitor&& visit_primitive) const;
+
+    private:
+        /* Data Members */
+
+        std::vector<Node> m_nodes{ };
+        std::vector<uint32_t> m_primitive_indices{ };
+        std::vector<uint32_t> m_parent_indices{ };      // The parent of each node, with the root as its own parent
+        std::vector<uint32_t> m_primitive_leaves{ };    // The leaf containing each primitive
+        std::vector<uint8_t> m_dirty_nodes{ };          // Flags the nodes awaiting a partial refit
+        double m_sah_cost_sum{ 0 };                     // The surface area of each node weighted by its cost
+        double m_build_sah_cost{ 0 };
+
+        /* Helper Methods */
+
+        // Recursively builds the subtree for the primitives in the index range [begin, end), returning its index
+        uint32_t buildNode(const std::vector<BoundingBox>& primitive_bounds,
+                           const std::vector<std::array<double, 3>>& primitive_centroids,
+                           size_t begin,
+                           size_t end);
+
+        // Recomputes the bounds of a single node from its primitives or children, updating the cost sum to match
+        void refitNode(uint32_t node_index, const std::vector<BoundingBox>& primitive_bounds);
+
+        // Returns the surface area of a node weighted by the cost of visiting it
+        [[nodiscard]] static double calculateWeightedArea(const Node& node);
+
+        // Returns true if the ray intersects the bounds anywhere within the range [t_min, t_max]
+        [[nodiscard]] static bool isNodeIntersected(const BoundingBox& bounds,
+                                                    const Ray& ray,
+                                                    double t_min,
+                                                    double t_max);
+    };
+
+    // BVH Traversal
+    template<typename PrimitiveVisitor>
+    bool BoundingVolumeHierarchy::traverse(const Ray& ray,
+                                           const double t_min,
+                                           const double t_max,
+                                           PrimitiveVisitor&& visit_primitive) const
+    {
+        if (m_nodes.empty()) {
+            return false;
+        }
+
+        // Depth-first traversal using a fixed-size stack, deep enough for any hierarchy built from 32-bit indices
+        std::array<uint32_t, 64> node_stack{ };
+        size_t stack_size{ 0 };
+        node_stack[stack_size++] = 0;
+
+        while (stack_size > 0) {
+            const Node& node{ m_nodes[node_stack[--stack_size]] };
+            if (!isNodeIntersected(node.bounds, ray, t_min, t_max)) {
+                continue;
+            }
+
+            if (node.isLeaf()) {
+                for (uint32_t i = node.offset; i < node.offset + node.primitive_count; ++i) {
+                    if (visit_primitive(static_cast<size_t>(m_primitive_indices[i]))) {
+                        return true;
+                    }
+                }
+            } else {
+                const auto node_index{ static_cast<uint32_t>(&node - m_nodes.data()) };
+                node_stack[stack_size++] = node.offset;
+                node_stack[stack_size++] = node_index + 1;
+            }
+        }
+
+        return false;
+    }
+
+    // BVH Packet Traversal
+    template<typename PacketPrimitiveVisitor>
+    void BoundingVolumeHierarchy::traverse(const RayPacket& packet, PacketPrimitiveVisitor&& visit_primitive) const
+    {
+        if (m_nodes.empty() || packet.active_lanes == 0) {
+            return;
+        }
+
+        // Each stack entry carries the lanes which reached the parent node, so lanes that have already missed are
+        // not retested further down the tree
+        std::array<std::pair<uint32_t, uint32_t>, 64> node_stack{ };
+        size_t stack_size{ 0 };
+        node_stack[stack_size++] = { 0, packet.active_lanes };
+
+        while (stack_size > 0) {
+            const auto [ node_index, parent_lanes ] { node_stack[--stack_size] };
+            const Node& node{ m_nodes[node_index] };
+
+            const uint32_t node_lanes{ calculateBoxHitLanes(packet,
+                                                            parent_lanes,
+                                                            node.bounds.getMinExtentPoint(),
+                                                            node.bounds.getMaxExtentPoint()) };
+            if (node_lanes == 0) {
+                continue;
+            }
+
+            if (node.isLeaf()) {
+                for (uint32_t i = node.offset; i < node.offset + node.primitive_count; ++i) {
+                    visit_primitive(static_cast<size_t>(m_primitive_indices[i]), node_lanes);
+                }
+            } else {
+                node_stack[stack_size++] = { node.offset, node_lanes };
+                node_stack[stack_size++] = { node_index + 1, node_lanes };
+            }
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,182 @@
+#include "gtest/gtest.h"
+#include "bounding_volume_hierarchy.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include "bounding_box.hpp"
+#include "ray.hpp"
+
+// Tests the default constructor
+TEST(GraphicsBoundingVolumeHierarchy, DefaultConstructor)
+{
+    const gfx::BoundingVolumeHierarchy bvh{ };
+
+    EXPECT_TRUE(bvh.isEmpty());
+    EXPECT_EQ(bvh.getNodeCount(), 0);
+    EXPECT_EQ(bvh.getPrimitiveCount(), 0);
+}
+
+// Tests building a hierarchy small enough to fit in a single leaf
+TEST(GraphicsBoundingVolumeHierarchy, BuildSingleLeaf)
+{
+    const std::vector<gfx::BoundingBox> primitive_bounds{
+        gfx::BoundingBox{ -1, -1, -1, 1, 1, 1 },
+        gfx::BoundingBox{ 2, -1, -1, 4, 1, 1 }
+    };
+
+    const gfx::BoundingVolumeHierarchy bvh{ primitive_bounds };
+
+    ASSERT_EQ(bvh.getNodeCount(), 1);
+    EXPECT_TRUE(bvh.getNodeAt(0).isLeaf());
+    EXPECT_EQ(bvh.getNodeAt(0).primitive_count, 2);
+    EXPECT_EQ(bvh.getNodeAt(0).bounds, (gfx::BoundingBox{ -1, -1, -1, 4, 1, 1 }));
+}
+
+// Tests that interior nodes enclose their children and every primitive ends up in exactly one leaf
+TEST(GraphicsBoundingVolumeHierarchy, BuildNestedNodes)
+{
+    std::vector<gfx::BoundingBox> primitive_bounds{ };
+    for (int i = 0; i < 20; ++i) {
+        primitive_bounds.emplace_back(i * 3 - 1, -1, -1, i * 3 + 1, 1, 1);
+    }
+
+    const gfx::BoundingVolumeHierarchy bvh{ primitive_bounds };
+
+    ASSERT_GT(bvh.getNodeCount(), 1);
+    EXPECT_EQ(bvh.getNodeAt(0).bounds, (gfx::BoundingBox{ -1, -1, -1, 58, 1, 1 }));
+
+    size_t leaf_primitive_count{ 0 };
+    for (size_t i = 0; i < bvh.getNodeCount(); ++i) {
+        const gfx::BoundingVolumeHierarchy::Node& node{ bvh.getNodeAt(i) };
+        if (node.isLeaf()) {
+            leaf_primitive_count += node.primitive_count;
+        } else {
+            EXPECT_TRUE(node.bounds.containsBox(bvh.getNodeAt(i + 1).bounds));
+            EXPECT_TRUE(node.bounds.containsBox(bvh.getNodeAt(node.offset).bounds));
+        }
+    }
+    EXPECT_EQ(leaf_primitive_count, primitive_bounds.size());
+}
+
+// Tests that traversal only visits primitives whose leaf bounds are intersected by the ray
+TEST(GraphicsBoundingVolumeHierarchy, Traverse)
+{
+    std::vector<gfx::BoundingBox> primitive_bounds{ };
+    for (int i = 0; i < 20; ++i) {
+        primitive_bounds.emplace_back(i * 3 - 1, -1, -1, i * 3 + 1, 1, 1);
+    }
+    const gfx::BoundingVolumeHierarchy bvh{ primitive_bounds };
+
+    // A ray passing through the box around x = 30 along the z-axis
+    const gfx::Ray ray{ 30, 0, -5,
+                        0, 0, 1 };
+    std::vector<size_t> visited_primitives{ };
+    bvh.traverse(ray, [&](const size_t primitive_index) { visited_primitives.push_back(primitive_index); });
+
+    EXPECT_NE(std::ranges::find(visited_primitives, 10), visited_primitives.end());
+    EXPECT_LE(visited_primitives.size(), 4);
+
+    // A ray which misses every box visits nothing
+    const gfx::Ray ray_miss{ 30, 5, -5,
+                             0, 0, 1 };
+    visited_primitives.clear();
+    bvh.traverse(ray_miss, [&](const size_t primitive_index) { visited_primitives.push_back(primitive_index); });
+
+    EXPECT_TRUE(visited_primitives.empty());
+}
+
+// Tests limiting a traversal to a range along the ray and ending it early
+TEST(GraphicsBoundingVolumeHierarchy, TraverseRange)
+{
+    std::vector<gfx::BoundingBox> primitive_bounds{ };
+    for (int i = 0; i < 20; ++i) {
+        primitive_bounds.emplace_back(i * 3 - 1, -1, -1, i * 3 + 1, 1, 1);
+    }
+    const gfx::BoundingVolumeHierarchy bvh{ primitive_bounds };
+    const gfx::Ray ray{ -5, 0, 0,
+                        1, 0, 0 };
+
+    // The boxes beyond the range are never visited
+    size_t visit_count{ 0 };
+    const bool was_stopped{ bvh.traverse(ray, 0, 10, [&](const size_t) { ++visit_count; return false; }) };
+    EXPECT_FALSE(was_stopped);
+    EXPECT_LE(visit_count, 8);
+
+    // The traversal ends as soon as the visitor asks it to
+    visit_count = 0;
+    EXPECT_TRUE(bvh.traverse(ray, 0, 100, [&](const size_t) { ++visit_count; return true; }));
+    EXPECT_EQ(visit_count, 1);
+}
+
+// Tests that refitting a hierarchy encloses the moved primitives while keeping its structure
+TEST(GraphicsBoundingVolumeHierarchy, Refit)
+{
+    std::vector<gfx::BoundingBox> primitive_bounds{ };
+    for (int i = 0; i < 20; ++i) {
+        primitive_bounds.emplace_back(i * 3 - 1, -1, -1, i * 3 + 1, 1, 1);
+    }
+    gfx::BoundingVolumeHierarchy bvh{ primitive_bounds };
+    const size_t node_count{ bvh.getNodeCount() };
+
+    // Lift the box around x = 30 above the others
+    primitive_bounds[10] = gfx::BoundingBox{ 29, 9, -1, 31, 11, 1 };
+    bvh.refit(primitive_bounds);
+
+    ASSERT_EQ(bvh.getNodeCount(), node_count);
+    EXPECT_EQ(bvh.getNodeAt(0).bounds, (gfx::BoundingBox{ -1, -1, -1, 58, 11, 1 }));
+    for (size_t i = 0; i < bvh.getNodeCount(); ++i) {
+        const gfx::BoundingVolumeHierarchy::Node& node{ bvh.getNodeAt(i) };
+        if (!node.isLeaf()) {
+            EXPECT_TRUE(node.bounds.containsBox(bvh.getNodeAt(i + 1).bounds));
+            EXPECT_TRUE(node.bounds.containsBox(bvh.getNodeAt(node.offset).bounds));
+        }
+    }
+
+    // Rays now reach the box at its new position
+    const gfx::Ray ray{ 30, 10, -5,
+                        0, 0, 1 };
+    std::vector<size_t> visited_primitives{ };
+    bvh.traverse(ray, [&](const size_t primitive_index) { visited_primitives.push_back(primitive_index); });
+    EXPECT_NE(std::ranges::find(visited_primitives, 10), visited_primitives.end());
+
+    EXPECT_THROW(bvh.refit(std::vector<gfx::BoundingBox>(3)), std::invalid_argument);
+}
+
+// Tests that refitting only the changed primitives matches refitting the whole hierarchy, and tracks its cost
+TEST(GraphicsBoundingVolumeHierarchy, RefitChangedPrimitives)
+{
+    std::vector<gfx::BoundingBox> primitive_bounds{ };
+    for (int i = 0; i < 20; ++i) {
+        primitive_bounds.emplace_back(i * 3 - 1, -1, -1, i * 3 + 1, 1, 1);
+    }
+    gfx::BoundingVolumeHierarchy bvh{ primitive_bounds };
+    gfx::BoundingVolumeHierarchy bvh_expected{ bvh };
+    EXPECT_GT(bvh.getBuildSAHCost(), 0);
+    EXPECT_DOUBLE_EQ(bvh.getSAHCost(), bvh.getBuildSAHCost());
+
+    // Lift two boxes above the others, listing one of them twice
+    primitive_bounds[3] = gfx::BoundingBox{ 8, 19, -1, 10, 21, 1 };
+    primitive_bounds[10] = gfx::BoundingBox{ 29, 9, -1, 31, 11, 1 };
+    const std::vector<size_t> changed_primitives{ 10, 3, 10 };
+    bvh.refit(primitive_bounds, changed_primitives);
+    bvh_expected.refit(primitive_bounds);
+
+    ASSERT_EQ(bvh.getNodeCount(), bvh_expected.getNodeCount());
+    for (size_t i = 0; i < bvh.getNodeCount(); ++i) {
+        EXPECT_EQ(bvh.getNodeAt(i).bounds, bvh_expected.getNodeAt(i).bounds);
+    }
+    EXPECT_NEAR(bvh.getSAHCost(), bvh_expected.getSAHCost(), 1e-9);
+    EXPECT_GT(bvh.getSAHCost(), bvh.getBuildSAHCost());
+
+    // Moving the boxes back restores the original cost
+    primitive_bounds[3] = gfx::BoundingBox{ 8, -1, -1, 10, 1, 1 };
+    primitive_bounds[10] = gfx::BoundingBox{ 29, -1, -1, 31, 1, 1 };
+    bvh.refit(primitive_bounds, changed_primitives);
+    EXPECT_NEAR(bvh.getSAHCost(), bvh.getBuildSAHCost(), 1e-9);
+
+    const std::vector<size_t> invalid_primitives{ 20 };
+    EXPECT_THROW(bvh.refit(primitive_bounds, invalid_primitives), std::out_of_range);
+    EXPECT_THROW(bvh.refit(std::vector<gfx::BoundingBox>(3), changed_primitives), std::invalid_argument);
+}
\ No newline at end of file
@@ -0,0 +1,408 @@
+#include "compiled_scene.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <variant>
+
+#include "surface.hpp"
+#include "composite_surface.hpp"
+#include "util_functions.hpp"
+
+namespace gfx {
+    // Returns true if every extent of a bounding box is finite
+    static bool isFiniteBox(const BoundingBox& bounds)
+    {
+        return
+                std::isfinite(bounds.getMinX()) && std::isfinite(bounds.getMaxX()) &&
+                std::isfinite(bounds.getMinY()) && std::isfinite(bounds.getMaxY()) &&
+                std::isfinite(bounds.getMinZ()) && std::isfinite(bounds.getMaxZ());
+    }
+
+    // World Compiling Constructor
+    CompiledScene::CompiledScene(const World& world)
+            : m_light_sources{ world.getLightSources().begin(), world.getLightSources().end() },
+              m_area_lights{ world.getAreaLights().begin(), world.getAreaLights().end() },
+              m_light_sampling_settings{ world.getLightSamplingSettings() }
+    {
+        std::vector<const Object*> objects{ };
+        for (size_t i = 0; i < world.getObjectCount(); ++i) {
+            objects.push_back(&world.getObjectAt(i));
+        }
+        this->compileObjects(objects, true);
+        this->buildShadowMaps(world.getShadowMapSettings());
+    }
+
+    // Object Compiling Constructor
+    CompiledScene::CompiledScene(const Object& object)
+            : m_light_sources{ PointLight{ } }
+    {
+        const std::array<const Object*, 1> objects{ &object };
+        this->compileObjects(objects, false);
+    }
+
+    // Top-Level Object Compiler
+    void CompiledScene::compileObjects(const std::span<const Object* const> objects,
+                                       const bool are_objects_transformed)
+    {
+        const auto build_start{ std::chrono::steady_clock::now() };
+
+        // Flatten the object hierarchy, collecting the world-space bounds of each primitive and recording which
+        // top-level object each one belongs to
+        std::vector<BoundingBox> primitive_bounds{ };
+        std::vector<size_t> primitive_objects{ };
+        for (size_t i = 0; i < objects.size(); ++i) {
+            const Object& object{ *objects[i] };
+            const Matrix4 world_transform{ are_objects_transformed ? object.getTransform() : createIdentityMatrix() };
+            this->flattenObject(object, world_transform, createIdentityMatrix(), primitive_bounds);
+            primitive_objects.resize(m_primitives.size(), i);
+        }
+
+        // Primitives with infinite extents (e.g. planes) are tested against every ray, all others go in the BVH
+        std::vector<BoundingBox> bounded_primitive_bounds{ };
+        std::vector<size_t> bounded_primitives{ };
+        for (size_t i = 0; i < m_primitives.size(); ++i) {
+            if (isFiniteBox(primitive_bounds[i])) {
+                bounded_primitive_bounds.push_back(primitive_bounds[i]);
+                bounded_primitives.push_back(i);
+            } else {
+                m_unbounded_primitives.push_back(i);
+            }
+        }
+
+        // Store the bounded primitives first, in the order the BVH refers to them
+        std::vector<size_t> primitive_order{ bounded_primitives };
+        primitive_order.insert(primitive_order.end(), m_unbounded_primitives.begin(), m_unbounded_primitives.end());
+
+        std::vector<Primitive> ordered_primitives{ };
+        std::vector<std::shared_ptr<const Surface>> ordered_surfaces{ };
+        std::vector<Matrix4> ordered_local_transforms{ };
+        ordered_primitives.reserve(m_primitives.size());
+        ordered_surfaces.reserve(m_primitives.size());
+        ordered_local_transforms.reserve(m_primitives.size());
+        m_object_primitives.resize(objects.size());
+        for (const size_t primitive_index : primitive_order) {
+            m_object_primitives[primitive_objects[primitive_index]].push_back(ordered_primitives.size());
+            ordered_primitives.push_back(m_primitives[primitive_index]);
+            ordered_surfaces.push_back(m_surfaces[primitive_index]);
+            ordered_local_transforms.push_back(m_local_transforms[primitive_index]);
+        }
+        for (size_t i = 0; i < m_unbounded_primitives.size(); ++i) {
+            m_unbounded_primitives[i] = bounded_primitives.size() + i;
+        }
+        m_primitives = std::move(ordered_primitives);
+        m_surfaces = std::move(ordered_surfaces);
+        m_local_transforms = std::move(ordered_local_transforms);
+        m_primitive_bounds = std::move(bounded_primitive_bounds);
+        m_bvh = BoundingVolumeHierarchy{ m_primitive_bounds };
+
+        // Record the build statistics
+        m_statistics.build_time = std::chrono::steady_clock::now() - build_start;
+        m_statistics.primitive_count = m_primitives.size();
+        m_statistics.unbounded_primitive_count = m_unbounded_primitives.size();
+        m_statistics.material_count = m_materials.size();
+        m_statistics.bvh_node_count = m_bvh.getNodeCount();
+        m_statistics.memory_usage = this->calculateMemoryUsage();
+    }
+
+    // Object Transform Mutator
+    void CompiledScene::setObjectTransform(const size_t object_index, const Matrix4& transform_matrix)
+    {
+        for (const size_t primitive_index : m_object_primitives.at(object_index)) {
+            const Matrix4 world_transform{ transform_matrix * m_local_transforms[primitive_index] };
+
+            // Other copies of the scene may still be rendering with the current surface, so freeze a new copy of it
+            const auto moved_surface{ std::dynamic_pointer_cast<Surface>(m_surfaces[primitive_index]->clone()) };
+            moved_surface->setTransform(world_transform);
+
+            Primitive& primitive{ m_primitives[primitive_index] };
+            primitive.world_transform = ClassifiedTransform{ world_transform };
+            primitive.surface = moved_surface.get();
+            m_surfaces[primitive_index] = moved_surface;
+
+            // The bounded primitives are stored first, in the order the BVH refers to them
+            if (primitive_index < m_primitive_bounds.size()) {
+                m_dirty_primitives.push_back(primitive_index);
+            }
+        }
+    }
+
+    // BVH Updater
+    BVHUpdate CompiledScene::updateBVH(const BVHUpdatePolicy policy)
+    {
+        if (m_dirty_primitives.empty() && policy != BVHUpdatePolicy::Rebuild) {
+            return BVHUpdate::None;
+        }
+
+        // An object may have been moved more than once since the last update
+        std::ranges::sort(m_dirty_primitives);
+        const auto duplicates{ std::ranges::unique(m_dirty_primitives) };
+        m_dirty_primitives.erase(duplicates.begin(), duplicates.end());
+        for (const size_t primitive_index : m_dirty_primitives) {
+            m_primitive_bounds[primitive_index] = calculatePrimitiveBounds(m_primitives[primitive_index]);
+        }
+
+        BVHUpdate update{ BVHUpdate::Rebuild };
+        if (policy != BVHUpdatePolicy::Rebuild) {
+            m_bvh.refit(m_primitive_bounds, m_dirty_primitives);
+            if (policy == BVHUpdatePolicy::Refit ||
+                    m_bvh.getSAHCost() <= m_bvh.getBuildSAHCost() * BVH_REBUILD_COST_RATIO) {
+                update = BVHUpdate::Refit;
+            }
+        }
+        m_dirty_primitives.clear();
+
+        if (update == BVHUpdate::Refit) {
+            ++m_statistics.bvh_refit_count;
+        } else {
+            m_bvh = BoundingVolumeHierarchy{ m_primitive_bounds };
+            ++m_statistics.bvh_rebuild_count;
+            m_statistics.bvh_node_count = m_bvh.getNodeCount();
+        }
+
+        // The moved objects may cast different shadows
+        if (!m_shadow_maps.empty()) {
+            this->buildShadowMaps(m_shadow_map_settings);
+        }
+        m_statistics.memory_usage = this->calculateMemoryUsage();
+        return update;
+    }
+
+    // Shadow Map Builder
+    void CompiledScene::buildShadowMaps(const ShadowMapSettings& settings)
+    {
+        const auto build_start{ std::chrono::steady_clock::now() };
+
+        m_shadow_map_settings = settings;
+        m_shadow_maps.clear();
+        if (settings.resolution > 0) {
+            m_shadow_maps.reserve(m_light_sources.size());
+            for (const PointLight& light : m_light_sources) {
+                m_shadow_maps.emplace_back(*this, light.position, settings);
+            }
+        }
+        m_shadow_maps.shrink_to_fit();
+
+        m_statistics.shadow_map_count = m_shadow_maps.size();
+        m_statistics.shadow_map_build_time = std::chrono::steady_clock::now() - build_start;
+        m_statistics.memory_usage = this->calculateMemoryUsage();
+    }
+
+    // Compiled Scene Intersection Calculator
+    std::vector<Intersection> CompiledScene::getAllIntersections(const Ray& ray) const
+    {
+        std::vector<Intersection> scene_intersections{ };
+
+        // Every intersection along the line of the ray is needed (including those behind its origin) to determine
+        // which objects contain the ray when calculating refraction, so the BVH is traversed without t-limits
+        m_bvh.traverse(ray, [&](const size_t primitive_index) {
+            this->intersectPrimitive(m_primitives[primitive_index], ray, scene_intersections);
+        });
+        for (const size_t primitive_index : m_unbounded_primitives) {
+            this->intersectPrimitive(m_primitives[primitive_index], ray, scene_intersections);
+        }
+
+        // Sort list and return
+        std::sort(scene_intersections.begin(), scene_intersections.end());
+        return scene_intersections;
+    }
+
+    // Compiled Scene Packet Intersection Calculator
+    PacketIntersections CompiledScene::getAllPacketIntersections(const RayPacket& packet) const
+    {
+        PacketIntersections packet_intersections{ };
+
+        // Primitives are visited in the same order as for single rays, so each lane gathers the same list
+        m_bvh.traverse(packet, [&](const size_t primitive_index, const uint32_t lanes) {
+            this->intersectPrimitive(m_primitives[primitive_index], packet, lanes, packet_intersections);
+        });
+        for (const size_t primitive_index : m_unbounded_primitives) {
+            this->intersectPrimitive(m_primitives[primitive_index], packet, packet.active_lanes, packet_intersections);
+        }
+
+        // Sort each list and return
+        for (std::vector<Intersection>& lane_intersections : packet_intersections) {
+            std::sort(lane_intersections.begin(), lane_intersections.end());
+        }
+        return packet_intersections;
+    }
+
+    // Compiled Scene Occlusion Check
+    bool CompiledScene::isOccluded(const Ray& ray, const double distance) const
+    {
+        return this->findOccluder(ray, distance).has_value();
+    }
+
+    // Compiled Scene Occluder Finder
+    std::optional<size_t> CompiledScene::findOccluder(const Ray& ray, const double distance) const
+    {
+        std::optional<size_t> occluder{ };
+        const auto is_primitive_occluding{ [&](const size_t primitive_index) {
+            if (this->isOccludedBy(ray, distance, primitive_index)) {
+                occluder = primitive_index;
+            }
+            return occluder.has_value();
+        } };
+
+        if (!std::ranges::any_of(m_unbounded_primitives, is_primitive_occluding)) {
+            m_bvh.traverse(ray, 0, distance, is_primitive_occluding);
+        }
+        return occluder;
+    }
+
+    // Compiled Scene Occluder Check
+    bool CompiledScene::isOccludedBy(const Ray& ray, const double distance, const size_t occluder) const
+    {
+        if (occluder >= m_primitives.size()) {
+            return false;
+        }
+
+        const Primitive& primitive{ m_primitives[occluder] };
+        const Ray object_ray{ primitive.world_transform.getType() == TransformType::Identity ?
+                              ray : ray.inverseTransform(primitive.world_transform) };
+        return isGeometryHitWithin(primitive.geometry, primitive.surface, object_ray, distance);
+    }
+
+    // Object Hierarchy Flattener
+    void CompiledScene::flattenObject(const Object& object,
+                                      const Matrix4& world_transform,
+                                      const Matrix4& local_transform,
+                                      std::vector<BoundingBox>& bounds)
+    {
+        // Composite surfaces contribute their children, with the group transform composed into each child
+        if (const auto composite{ dynamic_cast<const CompositeSurface*>(&object) }) {
+            for (size_t i = 0; i < composite->getChildCount(); ++i) {
+                const Object& child{ composite->getChildAt(i) };
+                this->flattenObject(child,
+                                    world_transform * child.getTransform(),
+                                    local_transform * child.getTransform(),
+                                    bounds);
+            }
+            return;
+        }
+
+        // Freeze a copy of the surface with its world transform and inherited material resolved, so that shading
+        // no longer depends on the parent pointers of the authored hierarchy
+        const auto& authored_surface{ dynamic_cast<const Surface&>(object) };
+        const auto frozen_surface{ std::dynamic_pointer_cast<Surface>(authored_surface.clone()) };
+        const size_t material_index{ this->internMaterial(authored_surface.getMaterial()) };
+
+        Material shared_material{ m_materials[material_index].getProperties() };
+        shared_material.setTexture(std::shared_ptr<Texture>{ m_materials[material_index].getTexturePtr() });
+        frozen_surface->setParent(nullptr);
+        frozen_surface->setTransform(world_transform);
+        frozen_surface->setMaterial(std::move(shared_material));
+
+        m_primitives.emplace_back(frozen_surface->getPrimitiveGeometry(),
+                                  ClassifiedTransform{ world_transform },
+                                  frozen_surface.get(),
+                                  material_index);
+        m_surfaces.push_back(frozen_surface);
+        m_local_transforms.push_back(local_transform);
+        bounds.push_back(calculatePrimitiveBounds(m_primitives.back()));
+    }
+
+    // Primitive Bounds Calculator
+    BoundingBox CompiledScene::calculatePrimitiveBounds(const Primitive& primitive)
+    {
+        // Unbounded extents are kept as-is, since transforming them would produce undefined values
+        const BoundingBox object_bounds{ primitive.surface->getBounds() };
+        if (!isFiniteBox(object_bounds)) {
+            return object_bounds;
+        }
+
+        return object_bounds.transform(primitive.world_transform.getMatrix());
+    }
+
+    // Object Bounds Calculator
+    BoundingBox CompiledScene::calculateObjectBounds(const size_t object_index) const
+    {
+        BoundingBox object_bounds{ };
+        for (const size_t primitive_index : m_object_primitives.at(object_index)) {
+            const BoundingBox primitive_bounds{ calculatePrimitiveBounds(m_primitives[primitive_index]) };
+            if (!isFiniteBox(primitive_bounds)) {
+                return BoundingBox{ -std::numeric_limits<double>::infinity(),
+                                    -std::numeric_limits<double>::infinity(),
+                                    -std::numeric_limits<double>::infinity(),
+                                    std::numeric_limits<double>::infinity(),
+                                    std::numeric_limits<double>::infinity(),
+                                    std::numeric_limits<double>::infinity() };
+            }
+            object_bounds.mergeWithBox(primitive_bounds);
+        }
+
+        return object_bounds;
+    }
+
+    // Memory Usage Calculator
+    size_t CompiledScene::calculateMemoryUsage() const
+    {
+        size_t shadow_map_memory_usage{ 0 };
+        for (const ShadowMap& shadow_map : m_shadow_maps) {
+            shadow_map_memory_usage += shadow_map.getMemoryUsage();
+        }
+
+        return
+                m_primitives.capacity() * sizeof(Primitive) +
+                m_unbounded_primitives.capacity() * sizeof(size_t) +
+                m_materials.capacity() * sizeof(Material) +
+                m_surfaces.capacity() * sizeof(std::shared_ptr<const Surface>) +
+                m_local_transforms.capacity() * sizeof(Matrix4) +
+                m_primitive_bounds.capacity() * sizeof(BoundingBox) +
+                m_bvh.getMemoryUsage() +
+                shadow_map_memory_usage;
+    }
+
+    // Material Interner
+    size_t CompiledScene::internMaterial(const Material& material)
+    {
+        const auto material_iter{ std::ranges::find(m_materials, material) };
+        if (material_iter != m_materials.end()) {
+            return static_cast<size_t>(std::distance(m_materials.begin(), material_iter));
+        }
+
+        m_materials.push_back(material);
+        return m_materials.size() - 1;
+    }
+
+    // Single Primitive Intersection Calculator
+    void CompiledScene::intersectPrimitive(const Primitive& primitive,
+                                           const Ray& ray,
+                                           std::vector<Intersection>& intersections) const
+    {
+        // Transform the ray into the object space of the primitive and dispatch to its geometry kernel
+        const Ray object_ray{ primitive.world_transform.getType() == TransformType::Identity ?
+                              ray : ray.inverseTransform(primitive.world_transform) };
+        std::visit([&](const auto& geometry) {
+            geometry.intersect(object_ray, primitive.surface, intersections);
+        }, primitive.geometry);
+    }
+
+    // Single Primitive Packet Intersection Calculator
+    void CompiledScene::intersectPrimitive(const Primitive& primitive,
+                                           const RayPacket& packet,
+                                           const uint32_t lanes,
+                                           PacketIntersections& intersections) const
+    {
+        const RayPacket object_packet{ packet.inverseTransform(primitive.world_transform) };
+        std::visit([&](const auto& geometry) {
+            if constexpr (requires { geometry.intersect(object_packet, lanes, primitive.surface, intersections); }) {
+                geometry.intersect(object_packet, lanes, primitive.surface, intersections);
+            } else {
+                // Geometry without a packet kernel intersects each lane as a single ray
+                for (size_t lane = 0; lane < RAY_PACKET_SIZE; ++lane) {
+                    if ((lanes >> lane) & 1u) {
+                        geometry.intersect(object_packet.getRayAt(lane), primitive.surface, intersections[lane]);
+                    }
+                }
+            }
+        }, primitive.geometry);
+    }
+
+    // Compiled Scene Factory Function
+    CompiledScene compileScene(const World& world)
+    {
+        return CompiledScene{ world };
+    }
+}
\ No newline at end of file
@@ -0,0 +1,239 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <span>
+#include <optional>
+#include <vector>
+
+#include "world.hpp"
+#include "traceable_scene.hpp"
+#include "bounding_volume_hierarchy.hpp"
+#include "material.hpp"
+#include "transform.hpp"
+#include "primitive_geometry.hpp"
+
+namespace gfx {
+    class Object;
+    class Surface;
+
+    // A single leaf surface of a scene, flattened out of the object hierarchy and stored by value
+    struct Primitive
+    {
+        PrimitiveGeometry geometry{ CustomGeometry{ } };
+        ClassifiedTransform world_transform{ };     // The composed object-to-world transform of the surface
+        const Surface* surface{ nullptr };          // The frozen surface, used for shading and custom geometry
+        size_t material_index{ 0 };                 // Index of the surface material in the interned material list
+    };
+
+    // A refitted BVH is rebuilt once its estimated traversal cost grows past this multiple of its cost when built
+    inline constexpr double BVH_REBUILD_COST_RATIO{ 1.5 };
+
+    // Selects how the BVH of a compiled scene is updated after its objects move
+    enum class BVHUpdatePolicy
+    {
+        Automatic,      // Refit, then rebuild if the refitted hierarchy has degraded past BVH_REBUILD_COST_RATIO
+        Refit,
+        Rebuild
+    };
+
+    // Describes how the BVH of a compiled scene was updated
+    enum class BVHUpdate
+    {
+        None,
+        Refit,
+        Rebuild
+    };
+
+    // Statistics recorded while compiling a scene
+    struct SceneBuildStatistics
+    {
+        std::chrono::duration<double, std::milli> build_time{ 0 };
+        size_t primitive_count{ 0 };
+        size_t unbounded_primitive_count{ 0 };      // Primitives with infinite bounds, kept outside of the BVH
+        size_t material_count{ 0 };                 // Number of distinct materials after interning
+        size_t bvh_node_count{ 0 };
+        size_t bvh_refit_count{ 0 };                // Updates which refitted the BVH after objects moved
+        size_t bvh_rebuild_count{ 0 };              // Updates which rebuilt the BVH after objects moved
+        size_t shadow_map_count{ 0 };
+        std::chrono::duration<double, std::milli> shadow_map_build_time{ 0 };
+        size_t memory_usage{ 0 };                   // Bytes used by the flattened primitive, BVH, material and
+                                                    // shadow map arrays
+    };
+
+    // A flattened snapshot of a world which is safe to share between threads while rendering. The top-level objects
+    // of the snapshot can be moved between renders, e.g. to animate the scene without compiling it again.
+    class CompiledScene : public TraceableScene
+    {
+    public:
+        /* Constructors */
+
+        CompiledScene() = delete;
+
+        // Flattens the object hierarchy of a world into a contiguous list of primitives, each with its own frozen
+        // copy of the authored surface, and builds an acceleration structure over them. Shadow maps are rendered
+        // for the point lights if the world enables them.
+        explicit CompiledScene(const World& world);
+
+        // Flattens a single object in its own space, without its own transform applied, such as an asset shared by
+        // the instances of a two-level scene. The scene is lit by a default light source.
+        explicit CompiledScene(const Object& object);
+
+        // Copy Constructor
+        CompiledScene(const CompiledScene&) = default;
+
+        // Move Constructor
+        CompiledScene(CompiledScene&&) = default;
+
+        /* Destructor */
+
+        ~CompiledScene() override = default;
+
+        /* Assignment Operators */
+
+        CompiledScene& operator=(const CompiledScene&) = default;
+        CompiledScene& operator=(CompiledScene&&) = default;
+
+        /* Accessors */
+
+        [[nodiscard]] std::span<const PointLight> getLightSources() const override
+        { return m_light_sources; }
+
+        [[nodiscard]] std::span<const AreaLight> getAreaLights() const override
+        { return m_area_lights; }
+
+        [[nodiscard]] const LightSamplingSettings& getLightSamplingSettings() const override
+        { return m_light_sampling_settings; }
+
+        [[nodiscard]] const LightBVH& getLightBVH() const override
+        { return m_light_bvh; }
+
+        [[nodiscard]] std::span<const ShadowMap> getShadowMaps() const override
+        { return m_shadow_maps; }
+
+        [[nodiscard]] size_t getPrimitiveCount() const
+        { return m_primitives.size(); }
+
+        [[nodiscard]] const Primitive& getPrimitiveAt(const size_t index) const
+        { return m_primitives.at(index); }
+
+        [[nodiscard]] size_t getMaterialCount() const
+        { return m_materials.size(); }
+
+        [[nodiscard]] const Material& getMaterialAt(const size_t index) const
+        { return m_materials.at(index); }
+
+        [[nodiscard]] const BoundingVolumeHierarchy& getBVH() const
+        { return m_bvh; }
+
+        [[nodiscard]] const SceneBuildStatistics& getBuildStatistics() const
+        { return m_statistics; }
+
+        // Returns the number of top-level objects in the world the scene was compiled from
+        [[nodiscard]] size_t getObjectCount() const
+        { return m_object_primitives.size(); }
+
+        // Returns the indices of the primitives flattened out of a top-level object
+        [[nodiscard]] std::span<const size_t> getObjectPrimitiveIndices(const size_t object_index) const
+        { return m_object_primitives.at(object_index); }
+
+        // Returns the world-space bounds of the primitives of a top-level object, which are infinite if any of them
+        // is unbounded
+        [[nodiscard]] BoundingBox calculateObjectBounds(size_t object_index) const;
+
+        /* Mutators */
+
+        // Moves a top-level object of the world the scene was compiled from, composing the new transform into the
+        // world transform of each of its primitives. Moved primitives are given new frozen surfaces, so copies of the
+        // scene are unaffected. The BVH must be updated before the scene is rendered again.
+        void setObjectTransform(size_t object_index, const Matrix4& transform_matrix);
+
+        // Brings the BVH up to date with the primitives moved since the last update. Refitting only visits the nodes
+        // above the moved primitives, but the hierarchy degrades as they drift apart, so by default it is rebuilt
+        // once its estimated cost has grown too far past that of a fresh build. Any shadow maps are rendered again
+        // once the BVH is up to date. Returns the update performed.
+        BVHUpdate updateBVH(BVHUpdatePolicy policy = BVHUpdatePolicy::Automatic);
+
+        // Renders a shadow map for each point light of the scene, replacing any built before. A resolution of zero
+        // removes the shadow maps, so every shadow query casts a ray.
+        void buildShadowMaps(const ShadowMapSettings& settings);
+
+        /* Ray-Tracing Operations */
+
+        // Returns a sorted list of all intersections with primitives in this scene with a passed-in Ray
+        [[nodiscard]] std::vector<Intersection> getAllIntersections(const Ray& ray) const override;
+
+        // Returns the sorted list of intersections for each active lane of a ray packet, tracing the packet through
+        // the BVH and the primitive kernels together
+        [[nodiscard]] PacketIntersections getAllPacketIntersections(const RayPacket& packet) const override;
+
+        // Returns true if any primitive intersects the ray in the range [0, distance), stopping at the first one
+        [[nodiscard]] bool isOccluded(const Ray& ray, double distance) const override;
+
+        // Returns the index of the first primitive found intersecting the ray in the range [0, distance)
+        [[nodiscard]] std::optional<size_t> findOccluder(const Ray& ray, double distance) const override;
+
+        // Returns true if the primitive at the passed-in index intersects the ray in the range [0, distance)
+        [[nodiscard]] bool isOccludedBy(const Ray& ray, double distance, size_t occluder) const override;
+
+    private:
+        /* Data Members */
+
+        std::vector<PointLight> m_light_sources{ };
+        LightBVH m_light_bvh{ m_light_sources };
+        std::vector<AreaLight> m_area_lights{ };
+        LightSamplingSettings m_light_sampling_settings{ };
+        ShadowMapSettings m_shadow_map_settings{ };
+        std::vector<ShadowMap> m_shadow_maps{ };
+        std::vector<Primitive> m_primitives{ };
+        std::vector<size_t> m_unbounded_primitives{ };      // Indices of primitives which cannot be placed in the BVH
+        std::vector<Material> m_materials{ };
+        std::vector<std::shared_ptr<const Surface>> m_surfaces{ };  // The frozen surface of each primitive
+        std::vector<Matrix4> m_local_transforms{ };                 // The transform of each primitive relative to
+                                                                    // its top-level object
+        std::vector<std::vector<size_t>> m_object_primitives{ };    // The primitives of each top-level object
+        std::vector<BoundingBox> m_primitive_bounds{ };             // The world-space bounds of each BVH primitive
+        std::vector<size_t> m_dirty_primitives{ };                  // BVH primitives moved since the last update
+        BoundingVolumeHierarchy m_bvh{ };
+        SceneBuildStatistics m_statistics{ };
+
+        /* Helper Methods */
+
+        // Flattens each top-level object into the primitive list and builds the BVH over them. Objects are placed by
+        // their own transforms, unless they are to be compiled in their own space.
+        void compileObjects(std::span<const Object* const> objects, bool are_objects_transformed);
+
+        // Appends the leaf surfaces of an object (and any of its children) to the primitive list, along with the
+        // world-space bounds of each. Both transforms include that of the object itself, and the local transform is
+        // relative to the top-level object it belongs to.
+        void flattenObject(const Object& object,
+                           const Matrix4& world_transform,
+                           const Matrix4& local_transform,
+                           std::vector<BoundingBox>& bounds);
+
+        // Returns the world-space bounds of a primitive, or its object-space bounds if they are unbounded
+        [[nodiscard]] static BoundingBox calculatePrimitiveBounds(const Primitive& primitive);
+
+        // Returns the number of bytes used by the flattened primitive, BVH, material and shadow map arrays
+        [[nodiscard]] size_t calculateMemoryUsage() const;
+
+        // Returns the index of a material in the interned material list, adding it if no equal material is present
+        [[nodiscard]] size_t internMaterial(const Material& material);
+
+        // Appends the intersections of a ray with a single primitive
+        void intersectPrimitive(const Primitive& primitive,
+                                const Ray& ray,
+                                std::vector<Intersection>& intersections) const;
+
+        // Appends the intersections of the passed-in lanes of a ray packet with a single primitive
+        void intersectPrimitive(const Primitive& primitive,
+                                const RayPacket& packet,
+                                uint32_t lanes,
+                                PacketIntersections& intersections) const;
+    };
+
+    /* Compiled Scene Factory Functions */
+
+    // Returns a compiled snapshot of the passed-in world, ready for rendering
+    [[nodiscard]] CompiledScene compileScene(const World& world);
+}
\ No newline at end of file
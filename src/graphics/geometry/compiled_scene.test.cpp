@@ -0,0 +1,434 @@
+#include "gtest/gtest.h"
+#include "compiled_scene.hpp"
+
+#include <vector>
+#include <variant>
+#include <span>
+#include <algorithm>
+#include <numbers>
+#include <stdexcept>
+#include <optional>
+#include <tuple>
+
+#include "light.hpp"
+#include "sphere.hpp"
+#include "plane.hpp"
+#include "cube.hpp"
+#include "cylinder.hpp"
+#include "cone.hpp"
+#include "triangle.hpp"
+#include "composite_surface.hpp"
+#include "ray.hpp"
+#include "transform.hpp"
+#include "intersection.hpp"
+
+// Tests flattening a world with nested composite surfaces into a list of primitives
+TEST(GraphicsCompiledScene, FlattenObjectHierarchy)
+{
+    const gfx::Sphere sphere{ gfx::createTranslationMatrix(5, 0, 0) };
+    const gfx::CompositeSurface inner_group{ gfx::createScalingMatrix(2), sphere };
+    const gfx::CompositeSurface outer_group{ gfx::createYRotationMatrix(std::numbers::pi / 2),
+                                             inner_group,
+                                             gfx::Cylinder{ -1, 1, true } };
+    const gfx::World world{ outer_group, gfx::Plane{ } };
+
+    const gfx::CompiledScene scene{ world };
+
+    ASSERT_EQ(scene.getPrimitiveCount(), 3);
+    ASSERT_TRUE(std::holds_alternative<gfx::SphereGeometry>(scene.getPrimitiveAt(0).geometry));
+    ASSERT_TRUE(std::holds_alternative<gfx::CylinderGeometry>(scene.getPrimitiveAt(1).geometry));
+    ASSERT_TRUE(std::holds_alternative<gfx::PlaneGeometry>(scene.getPrimitiveAt(2).geometry));
+
+    // The composed transform of a primitive maps it to the same place as its authored surface
+    const gfx::Matrix4 sphere_transform_expected{ gfx::createYRotationMatrix(std::numbers::pi / 2) *
+                                                  gfx::createScalingMatrix(2) *
+                                                  gfx::createTranslationMatrix(5, 0, 0) };
+    EXPECT_EQ(scene.getPrimitiveAt(0).world_transform.getMatrix(), sphere_transform_expected);
+    EXPECT_EQ(scene.getPrimitiveAt(2).world_transform.getType(), gfx::TransformType::Identity);
+
+    // Cylinder parameters are carried over into the geometry description
+    const auto& cylinder_geometry{ std::get<gfx::CylinderGeometry>(scene.getPrimitiveAt(1).geometry) };
+    EXPECT_FLOAT_EQ(cylinder_geometry.y_min, -1);
+    EXPECT_FLOAT_EQ(cylinder_geometry.y_max, 1);
+    EXPECT_TRUE(cylinder_geometry.is_closed);
+}
+
+// Tests that compiled surfaces are frozen copies with their inherited materials resolved and parents detached
+TEST(GraphicsCompiledScene, FreezeSurfaces)
+{
+    const gfx::Material group_material{ gfx::Color{ 1, 0, 0 } };
+    gfx::CompositeSurface group{ gfx::createTranslationMatrix(0, 2, 0),
+                                 gfx::Sphere{ },
+                                 gfx::Sphere{ gfx::createTranslationMatrix(3, 0, 0) } };
+    group.addMaterial(group_material);
+    const gfx::World world{ group, gfx::Sphere{ gfx::Material{ gfx::Color{ 0, 0, 1 } } } };
+
+    const gfx::CompiledScene scene{ world };
+
+    ASSERT_EQ(scene.getPrimitiveCount(), 3);
+    ASSERT_EQ(scene.getMaterialCount(), 2);
+    for (size_t i = 0; i < scene.getPrimitiveCount(); ++i) {
+        const gfx::Primitive& primitive{ scene.getPrimitiveAt(i) };
+        EXPECT_FALSE(primitive.surface->hasParent());
+        EXPECT_EQ(primitive.surface->getTransform(), primitive.world_transform.getMatrix());
+        EXPECT_EQ(primitive.surface->getMaterial(), scene.getMaterialAt(primitive.material_index));
+    }
+
+    // Surfaces sharing an interned material also share its texture
+    EXPECT_EQ(scene.getPrimitiveAt(0).material_index, scene.getPrimitiveAt(1).material_index);
+    EXPECT_EQ(scene.getPrimitiveAt(0).surface->getMaterial(), group_material);
+    EXPECT_EQ(&scene.getPrimitiveAt(0).surface->getMaterial().getTexture(),
+              &scene.getPrimitiveAt(1).surface->getMaterial().getTexture());
+}
+
+// Tests the statistics recorded while compiling a scene
+TEST(GraphicsCompiledScene, BuildStatistics)
+{
+    const gfx::World world{ gfx::Sphere{ },
+                            gfx::Sphere{ gfx::createTranslationMatrix(3, 0, 0) },
+                            gfx::Cube{ gfx::createTranslationMatrix(-3, 0, 0) },
+                            gfx::Plane{ } };
+
+    const gfx::CompiledScene scene{ gfx::compileScene(world) };
+    const gfx::SceneBuildStatistics& build_stats{ scene.getBuildStatistics() };
+
+    EXPECT_EQ(build_stats.primitive_count, 4);
+    EXPECT_EQ(build_stats.unbounded_primitive_count, 1);
+    EXPECT_EQ(build_stats.material_count, 1);
+    EXPECT_EQ(build_stats.bvh_node_count, scene.getBVH().getNodeCount());
+    EXPECT_EQ(scene.getBVH().getPrimitiveCount(), 3);
+    EXPECT_GT(build_stats.memory_usage, 0);
+    EXPECT_GE(build_stats.build_time.count(), 0);
+}
+
+// Tests that the occlusion check of a compiled scene agrees with the shadow test of its world
+TEST(GraphicsCompiledScene, PointIsShadowedMatchesWorld)
+{
+    const gfx::World world{
+        gfx::PointLight{ gfx::Color{ 1, 1, 1 }, gfx::createPoint(-10, 10, -10) },
+        gfx::Sphere{ },
+        gfx::Sphere{ gfx::createScalingMatrix(0.5) },
+        gfx::Plane{ gfx::createTranslationMatrix(0, -1, 0) }
+    };
+    const gfx::CompiledScene scene{ world };
+
+    const std::vector<gfx::Vector4> points{
+        gfx::createPoint(0, 10, 0),
+        gfx::createPoint(10, -10, 10),
+        gfx::createPoint(-20, 20, -20),
+        gfx::createPoint(-2, 2, -2),
+        gfx::createPoint(1, -0.99, 1),
+        gfx::createPoint(0, -2, 0)
+    };
+
+    for (const gfx::Vector4& point : points) {
+        EXPECT_EQ(scene.isShadowed(point), world.isShadowed(point));
+    }
+}
+
+// Tests that shadow rays first test the last occluder found for their light before traversing the scene
+TEST(GraphicsCompiledScene, ShadowOccluderCache)
+{
+    const gfx::World world{
+        gfx::PointLight{ gfx::Color{ 1, 1, 1 }, gfx::createPoint(0, 10, 0) },
+        gfx::Plane{ gfx::createTranslationMatrix(0, -1, 0) },
+        gfx::Sphere{ gfx::createTranslationMatrix(5, 0, 0) },
+        gfx::Sphere{ }
+    };
+    const gfx::CompiledScene scene{ world };
+
+    // The occluder of a shadow ray can be tested again on its own
+    const gfx::Ray shadow_ray{ 0, -0.99, 0, 0, 1, 0 };
+    const std::optional<size_t> occluder{ scene.findOccluder(shadow_ray, 11) };
+    ASSERT_TRUE(occluder.has_value());
+    EXPECT_TRUE(scene.isOccludedBy(shadow_ray, 11, occluder.value()));
+    EXPECT_FALSE(scene.isOccludedBy(shadow_ray, 0.005, occluder.value()));
+    EXPECT_FALSE(scene.isOccludedBy(shadow_ray, 11, scene.getPrimitiveCount()));
+    EXPECT_FALSE(scene.findOccluder(gfx::Ray{ 0, 5, 0, 0, 1, 0 }, 5).has_value());
+
+    // Returns the shadow statistics added by shading the floor below a point
+    const auto shade_floor{ [&scene](const double x) {
+        const gfx::Ray ray{ x, 0.5, 0,
+                            0, -1, 0 };
+        const gfx::DetailedIntersection hit{ getHit(scene.getAllIntersections(ray)).value(), ray };
+        const gfx::ShadowRayStatistics statistics_before{ scene.getShadowRayStatistics() };
+        std::ignore = scene.calculateSurfaceColorAt(hit);
+        const gfx::ShadowRayStatistics statistics_after{ scene.getShadowRayStatistics() };
+        return statistics_after.occluder_cache_hit_count - statistics_before.occluder_cache_hit_count;
+    } };
+
+    // Neighboring points shadowed by the same sphere find it in the cache, while lit points leave it in place
+    std::ignore = shade_floor(0);
+    EXPECT_EQ(shade_floor(0.1), 1);
+    EXPECT_EQ(shade_floor(3), 0);
+    EXPECT_EQ(shade_floor(-0.1), 1);
+
+    // Reaching the other sphere replaces the cached occluder
+    EXPECT_EQ(shade_floor(5), 0);
+    EXPECT_EQ(shade_floor(5.1), 1);
+    for (const double x : { -0.5, 0.0, 2.0, 4.5, 5.0, 8.0 }) {
+        EXPECT_EQ(scene.isShadowed(gfx::createPoint(x, -0.99, 0)), world.isShadowed(gfx::createPoint(x, -0.99, 0)));
+    }
+}
+
+// Tests that the any-hit checks of a single object agree with the intersections of every kind of shape
+TEST(GraphicsCompiledScene, IsOccludedByMatchesIntersections)
+{
+    const gfx::CompositeSurface group{ gfx::createTranslationMatrix(0, 1, 3),
+                                       gfx::Sphere{ gfx::createScalingMatrix(0.5) },
+                                       gfx::Cone{ -1, 0, true } };
+    const gfx::World world{
+        gfx::PointLight{ gfx::Color{ 1, 1, 1 }, gfx::createPoint(0, 10, 0) },
+        gfx::Sphere{ gfx::createTranslationMatrix(-2, 0, 0) },
+        gfx::Plane{ gfx::createTranslationMatrix(0, -1, 0) },
+        gfx::Cube{ gfx::createTranslationMatrix(2, 0, 0) * gfx::createYRotationMatrix(0.5) },
+        gfx::Cylinder{ gfx::createTranslationMatrix(0, 0, -3), -1, 1, true },
+        gfx::Triangle{ gfx::createPoint(-1, 2, 0), gfx::createPoint(1, 2, 0), gfx::createPoint(0, 3, 1) },
+        group
+    };
+    const gfx::CompiledScene scene{ world };
+
+    size_t hit_count{ 0 };
+    size_t check_count{ 0 };
+    for (double x = -3; x <= 3; x += 0.5)
+        for (double y = -1.5; y <= 3; y += 0.5) {
+            const gfx::Ray ray{ 0, 0.5, -8, x, y - 0.5, 8 };
+            const std::vector<gfx::Intersection> scene_intersections{ scene.getAllIntersections(ray) };
+            for (const double distance : { 0.5, 1.0, 1.5, 10.0 }) {
+                for (size_t i = 0; i < world.getObjectCount(); ++i) {
+                    const bool is_hit_expected{
+                        std::ranges::any_of(world.getObjectAt(i).getObjectIntersections(ray), [&](const auto& hit) {
+                            return gfx::isInOcclusionRange(hit.getT(), distance);
+                        }) };
+                    EXPECT_EQ(world.isOccludedBy(ray, distance, i), is_hit_expected);
+                }
+                for (size_t i = 0; i < scene.getPrimitiveCount(); ++i) {
+                    const bool is_hit_expected{ std::ranges::any_of(scene_intersections, [&](const auto& hit) {
+                        return &hit.getObject() == scene.getPrimitiveAt(i).surface &&
+                               gfx::isInOcclusionRange(hit.getT(), distance);
+                    }) };
+                    EXPECT_EQ(scene.isOccludedBy(ray, distance, i), is_hit_expected);
+                    hit_count += is_hit_expected;
+                    ++check_count;
+                }
+            }
+        }
+
+    EXPECT_GT(hit_count, 0);
+    EXPECT_LT(hit_count, check_count);
+}
+
+// Tests that a compiled scene produces the same intersections as the world it was compiled from
+TEST(GraphicsCompiledScene, IntersectionsMatchWorld)
+{
+    const gfx::CompositeSurface group{
+        gfx::createTranslationMatrix(0, 1, 0) * gfx::createScalingMatrix(0.5),
+        gfx::Cube{ gfx::createTranslationMatrix(-3, 0, 0) },
+        gfx::Cone{ gfx::createTranslationMatrix(3, 0, 0), -1, 0, true },
+        gfx::Triangle{ gfx::createPoint(0, 1, 0), gfx::createPoint(-1, 0, 0), gfx::createPoint(1, 0, 0) }
+    };
+    const gfx::World world{ gfx::Sphere{ gfx::createScalingMatrix(0.5) },
+                            gfx::Plane{ gfx::createTranslationMatrix(0, -1, 0) },
+                            gfx::Cylinder{ gfx::createTranslationMatrix(0, 0, 4), 0, 2, true },
+                            group };
+    const gfx::CompiledScene scene{ world };
+
+    const std::vector<gfx::Ray> rays{
+        gfx::Ray{ 0, 0, -5, 0, 0, 1 },
+        gfx::Ray{ -1.5, 1, -5, 0, 0, 1 },
+        gfx::Ray{ 1.5, 0.8, -5, 0, 0, 1 },
+        gfx::Ray{ 0, 1.2, -5, 0, 0, 1 },
+        gfx::Ray{ 0, 5, 4, 0, -1, 0 },
+        gfx::Ray{ 0, 5, -5, 0, -0.5, 0.8 }
+    };
+
+    for (const gfx::Ray& ray : rays) {
+        const std::vector<gfx::Intersection> intersections_expected{ world.getAllIntersections(ray) };
+        const std::vector<gfx::Intersection> intersections_actual{ scene.getAllIntersections(ray) };
+
+        ASSERT_EQ(intersections_actual.size(), intersections_expected.size());
+        for (size_t i = 0; i < intersections_expected.size(); ++i) {
+            EXPECT_FLOAT_EQ(intersections_actual.at(i).getT(), intersections_expected.at(i).getT());
+            EXPECT_EQ(intersections_actual.at(i).getObject().getMaterial(),
+                      intersections_expected.at(i).getObject().getMaterial());
+        }
+    }
+}
+
+// Tests that shading a compiled scene produces the same color as shading the world it was compiled from
+TEST(GraphicsCompiledScene, CalculatePixelColorMatchesWorld)
+{
+    const gfx::Material glass{ gfx::Color{ 0.1, 0.1, 0.1 },
+                               gfx::MaterialProperties{ .reflectivity = 0.9, .transparency = 0.9, .refractive_index = 1.5 } };
+    const gfx::World world{
+        gfx::PointLight{ gfx::Color{ 1, 1, 1 }, gfx::createPoint(-10, 10, -10) },
+        gfx::Sphere{ glass },
+        gfx::Sphere{ gfx::createScalingMatrix(0.5),
+                     gfx::Material{ gfx::Color{ 0.8, 1.0, 0.6 } } },
+        gfx::Plane{ gfx::createTranslationMatrix(0, -1, 0) }
+    };
+    const gfx::CompiledScene scene{ world };
+    const gfx::Ray ray{ 0.2, 0.3, -5,
+                        0, 0, 1 };
+
+    EXPECT_EQ(scene.calculatePixelColor(ray), world.calculatePixelColor(ray));
+}
+
+// Tests that tracing packets through a compiled scene produces the same intersections as tracing single rays
+TEST(GraphicsCompiledScene, PacketIntersectionsMatchSingleRays)
+{
+    const gfx::CompositeSurface group{
+        gfx::createTranslationMatrix(0, 1, 0) * gfx::createScalingMatrix(0.5),
+        gfx::Cube{ gfx::createTranslationMatrix(-3, 0, 0) },
+        gfx::Cone{ gfx::createTranslationMatrix(3, 0, 0), -1, 0, true },
+        gfx::Triangle{ gfx::createPoint(0, 1, 0), gfx::createPoint(-1, 0, 0), gfx::createPoint(1, 0, 0) }
+    };
+    const gfx::World world{ gfx::Sphere{ gfx::createScalingMatrix(0.5) },
+                            gfx::Sphere{ gfx::createTranslationMatrix(0, 0, 2) },
+                            gfx::Plane{ gfx::createTranslationMatrix(0, -1, 0) },
+                            gfx::Cylinder{ gfx::createTranslationMatrix(0, 0, 4), 0, 2, true },
+                            group };
+    const gfx::CompiledScene scene{ world };
+
+    const std::vector<gfx::Ray> rays{
+        gfx::Ray{ 0, 0, -5, 0, 0, 1 },
+        gfx::Ray{ -1.5, 1, -5, 0, 0, 1 },
+        gfx::Ray{ 1.5, 0.8, -5, 0, 0, 1 },
+        gfx::Ray{ 0, 1.2, -5, 0, 0, 1 },
+        gfx::Ray{ 0, 5, 4, 0, -1, 0 },
+        gfx::Ray{ 0, 5, -5, 0, -0.6, 0.8 },
+        gfx::Ray{ 10, 10, 10, 1, 0, 0 }
+    };
+
+    for (size_t first_ray = 0; first_ray < rays.size(); first_ray += gfx::RAY_PACKET_SIZE) {
+        const size_t ray_count{ std::min(gfx::RAY_PACKET_SIZE, rays.size() - first_ray) };
+        const gfx::RayPacket packet{ std::span{ rays }.subspan(first_ray, ray_count) };
+        const gfx::PacketIntersections packet_intersections{ scene.getAllPacketIntersections(packet) };
+
+        for (size_t lane = 0; lane < ray_count; ++lane) {
+            const std::vector<gfx::Intersection> intersections_expected{
+                scene.getAllIntersections(rays[first_ray + lane]) };
+
+            ASSERT_EQ(packet_intersections[lane].size(), intersections_expected.size());
+            for (size_t i = 0; i < intersections_expected.size(); ++i) {
+                EXPECT_EQ(packet_intersections[lane].at(i), intersections_expected.at(i));
+            }
+        }
+        for (size_t lane = ray_count; lane < gfx::RAY_PACKET_SIZE; ++lane) {
+            EXPECT_TRUE(packet_intersections[lane].empty());
+        }
+    }
+}
+
+// Tests that moving the top-level objects of a compiled scene matches compiling the world with them moved
+TEST(GraphicsCompiledScene, SetObjectTransform)
+{
+    const gfx::Matrix4 group_transform{ gfx::createTranslationMatrix(0, 1, 0) };
+    const gfx::Matrix4 group_transform_moved{ gfx::createTranslationMatrix(1, 2, 3) *
+                                              gfx::createYRotationMatrix(std::numbers::pi / 4) };
+    const gfx::Matrix4 sphere_transform_moved{ gfx::createTranslationMatrix(-2, 0, 1) * gfx::createScalingMatrix(0.5) };
+    const auto create_world{ [](const gfx::Matrix4& group_transform, const gfx::Matrix4& sphere_transform) {
+        return gfx::World{ gfx::Plane{ gfx::createTranslationMatrix(0, -1, 0) },
+                           gfx::CompositeSurface{ group_transform,
+                                                  gfx::Cube{ gfx::createTranslationMatrix(-3, 0, 0) },
+                                                  gfx::Sphere{ gfx::createScalingMatrix(2, 1, 1) } },
+                           gfx::Sphere{ sphere_transform } };
+    } };
+
+    gfx::CompiledScene scene{ create_world(group_transform, gfx::createIdentityMatrix()) };
+    const gfx::CompiledScene original_scene{ scene };
+    const gfx::CompiledScene scene_expected{ create_world(group_transform_moved, sphere_transform_moved) };
+    ASSERT_EQ(scene.getObjectCount(), 3);
+
+    scene.setObjectTransform(1, group_transform_moved);
+    scene.setObjectTransform(2, sphere_transform_moved);
+    EXPECT_EQ(scene.updateBVH(gfx::BVHUpdatePolicy::Refit), gfx::BVHUpdate::Refit);
+
+    ASSERT_EQ(scene.getPrimitiveCount(), scene_expected.getPrimitiveCount());
+    for (size_t i = 0; i < scene.getPrimitiveCount(); ++i) {
+        const gfx::Primitive& primitive{ scene.getPrimitiveAt(i) };
+        EXPECT_EQ(primitive.world_transform.getMatrix(), scene_expected.getPrimitiveAt(i).world_transform.getMatrix());
+        EXPECT_EQ(primitive.surface->getTransform(), primitive.world_transform.getMatrix());
+    }
+    EXPECT_EQ(scene.getBVH().getNodeAt(0).bounds, scene_expected.getBVH().getNodeAt(0).bounds);
+
+    const std::vector<gfx::Ray> rays{
+        gfx::Ray{ 0, 0, -5, 0, 0, 1 },
+        gfx::Ray{ -2, 0, -5, 0, 0, 1 },
+        gfx::Ray{ 1, 2, -5, 0, 0, 1 },
+        gfx::Ray{ -1, 2.5, -5, 0.2, 0, 1 },
+        gfx::Ray{ 1, 5, 3, 0, -1, 0 }
+    };
+    for (const gfx::Ray& ray : rays) {
+        const std::vector<gfx::Intersection> intersections_expected{ scene_expected.getAllIntersections(ray) };
+        const std::vector<gfx::Intersection> intersections_actual{ scene.getAllIntersections(ray) };
+
+        ASSERT_EQ(intersections_actual.size(), intersections_expected.size());
+        for (size_t i = 0; i < intersections_expected.size(); ++i) {
+            EXPECT_FLOAT_EQ(intersections_actual.at(i).getT(), intersections_expected.at(i).getT());
+        }
+    }
+
+    // Copies of the scene keep their own surfaces and transforms
+    EXPECT_EQ(original_scene.getPrimitiveAt(2).world_transform.getMatrix(), gfx::createIdentityMatrix());
+    EXPECT_EQ(original_scene.getPrimitiveAt(2).surface->getTransform(), gfx::createIdentityMatrix());
+    EXPECT_THROW(scene.setObjectTransform(3, gfx::createIdentityMatrix()), std::out_of_range);
+}
+
+// Tests that updating the BVH refits it after small moves, and rebuilds it once the moves have degraded it
+TEST(GraphicsCompiledScene, UpdateBVH)
+{
+    gfx::World world{ };
+    for (int i = 0; i < 16; ++i) {
+        world.addObject(gfx::Sphere{ gfx::createTranslationMatrix(i * 3, 0, 0) });
+    }
+    world.addObject(gfx::Plane{ gfx::createTranslationMatrix(0, -1, 0) });
+
+    gfx::CompiledScene scene{ world };
+    const size_t node_count{ scene.getBVH().getNodeCount() };
+    EXPECT_EQ(scene.updateBVH(), gfx::BVHUpdate::None);
+
+    // Nudging a sphere, or moving the unbounded plane, keeps the hierarchy close to its original cost
+    scene.setObjectTransform(5, gfx::createTranslationMatrix(15, 0.5, 0));
+    scene.setObjectTransform(16, gfx::createTranslationMatrix(0, -2, 0));
+    EXPECT_EQ(scene.updateBVH(), gfx::BVHUpdate::Refit);
+    EXPECT_EQ(scene.getBVH().getNodeCount(), node_count);
+    EXPECT_EQ(scene.getBVH().getNodeAt(0).bounds, (gfx::BoundingBox{ -1, -1, -1, 46, 1.5, 1 }));
+
+    // Lifting every other sphere far above the rest leaves each node spanning both rows
+    for (int i = 0; i < 16; i += 2) {
+        scene.setObjectTransform(i, gfx::createTranslationMatrix(i * 3, 100, 0));
+    }
+    EXPECT_EQ(scene.updateBVH(), gfx::BVHUpdate::Rebuild);
+    EXPECT_DOUBLE_EQ(scene.getBVH().getSAHCost(), scene.getBVH().getBuildSAHCost());
+
+    const gfx::CompiledScene scene_expected{ [&] {
+        gfx::World moved_world{ };
+        for (int i = 0; i < 16; ++i) {
+            const double y{ i % 2 == 0 ? 100.0 : (i == 5 ? 0.5 : 0.0) };
+            moved_world.addObject(gfx::Sphere{ gfx::createTranslationMatrix(i * 3, y, 0) });
+        }
+        moved_world.addObject(gfx::Plane{ gfx::createTranslationMatrix(0, -2, 0) });
+        return moved_world;
+    }() };
+    for (const gfx::Ray& ray : { gfx::Ray{ 0, 100, -5, 0, 0, 1 }, gfx::Ray{ 15, 0.5, -5, 0, 0, 1 },
+                                 gfx::Ray{ 9, 0, -5, 0, 0, 1 }, gfx::Ray{ 6, 5, 0, 0, -1, 0 } }) {
+        const std::vector<gfx::Intersection> intersections_expected{ scene_expected.getAllIntersections(ray) };
+        const std::vector<gfx::Intersection> intersections_actual{ scene.getAllIntersections(ray) };
+
+        ASSERT_EQ(intersections_actual.size(), intersections_expected.size());
+        for (size_t i = 0; i < intersections_expected.size(); ++i) {
+            EXPECT_FLOAT_EQ(intersections_actual.at(i).getT(), intersections_expected.at(i).getT());
+        }
+    }
+
+    // The policy can force either update
+    scene.setObjectTransform(0, gfx::createTranslationMatrix(0, -100, 0));
+    EXPECT_EQ(scene.updateBVH(gfx::BVHUpdatePolicy::Refit), gfx::BVHUpdate::Refit);
+    EXPECT_EQ(scene.updateBVH(gfx::BVHUpdatePolicy::Rebuild), gfx::BVHUpdate::Rebuild);
+
+    const gfx::SceneBuildStatistics& build_stats{ scene.getBuildStatistics() };
+    EXPECT_EQ(build_stats.bvh_refit_count, 2);
+    EXPECT_EQ(build_stats.bvh_rebuild_count, 2);
+    EXPECT_EQ(build_stats.bvh_node_count, scene.getBVH().getNodeCount());
+}
\ No newline at end of file
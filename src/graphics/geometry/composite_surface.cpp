@@ -8,10 +8,12 @@ namespace gfx {
     // Copy Assignment Operator
     CompositeSurface& CompositeSurface::operator=(const CompositeSurface& rhs)
     {
-        this->setTransform(rhs.getTransform());
         m_children = rhs.m_children;
         this->setParentForAllChildren(this);
         m_bounds = rhs.m_bounds;
+
+        // Set the transform once the bounds are in place, so that any enclosing group is refitted around them
+        this->setTransform(rhs.getTransform());
         m_material = rhs.m_material;
 
         return *this;
@@ -20,10 +22,12 @@ namespace gfx {
     // Move Assignment Operator
     CompositeSurface& CompositeSurface::operator=(CompositeSurface&& rhs) noexcept
     {
-        this->setTransform(rhs.getTransform());
         m_children = std::move(rhs.m_children);
         this->setParentForAllChildren(this);
         m_bounds = rhs.m_bounds;
+
+        // Set the transform once the bounds are in place, so that any enclosing group is refitted around them
+        this->setTransform(rhs.getTransform());
         m_material = std::move(rhs.m_material);
 
         return *this;
@@ -46,6 +50,17 @@ namespace gfx {
         m_bounds.mergeWithBox(object_ptr->getLocalSpaceBounds());
     }
 
+    // Bounding Volume Refitter
+    void CompositeSurface::refitBounds()
+    {
+        const BoundingBox refitted_bounds{ this->calculateBounds() };
+        if (refitted_bounds == m_bounds)
+            return;
+
+        m_bounds = refitted_bounds;
+        this->refitParentBounds();
+    }
+
     // Intersections with Child Object(s) in a Composite Surface
     std::vector<Intersection> CompositeSurface::calculateIntersections(const Ray& transformed_ray) const
     {
@@ -63,6 +78,15 @@ namespace gfx {
         return intersections;
     }
 
+    // Composite Surface Any-Hit Check
+    bool CompositeSurface::isObjectSpaceHitWithin(const Ray& transformed_ray, const double distance) const
+    {
+        return m_bounds.isIntersectedBy(transformed_ray) &&
+               std::ranges::any_of(m_children, [&](const auto& object_ptr) {
+                   return object_ptr->isHitWithin(transformed_ray, distance);
+               });
+    }
+
     // Composite Surface Object Equivalency Check
     bool CompositeSurface::areEquivalent(const Object& other_object) const
     {
@@ -93,6 +93,9 @@ namespace gfx {
         [[nodiscard]] bool isEmpty() const
         { return m_children.empty(); }
 
+        [[nodiscard]] size_t getChildCount() const
+        { return m_children.size(); }
+
         // Primarily for testing purposes, will perform object slicing if is not cast to the proper derived class
         [[nodiscard]] const Object& getChildAt(const size_t index) const
         { return *m_children.at(index); }
@@ -120,6 +123,10 @@ namespace gfx {
         void removeMaterial()
         { m_material = std::nullopt; }
 
+        // Recalculates the bounds of the group after a child moves, continuing up through the enclosing groups until
+        // one of them is left unchanged. Each group along the way is refitted once, so a move costs O(depth) refits.
+        void refitBounds();
+
         /* Object Operations */
 
         // Creates a clone of this group to be stored in an object list
@@ -136,6 +143,7 @@ namespace gfx {
         /* Object Helper Method Overrides */
 
         [[nodiscard]] std::vector<Intersection> calculateIntersections(const Ray& transformed_ray) const override;
+        [[nodiscard]] bool isObjectSpaceHitWithin(const Ray& transformed_ray, double distance) const override;
         [[nodiscard]] bool areEquivalent(const Object& other_object) const override;
 
         /* Helper Methods */
@@ -281,6 +281,29 @@ TEST(GraphicsCompositeSurface, GetBounds)
     EXPECT_EQ(composite_surface_d_max_extent_actual, composite_surface_d_max_extent_expected);
 }
 
+// Test that moving a child refits the bounds of each group enclosing it
+TEST(GraphicsCompositeSurface, RefitBounds)
+{
+    const std::shared_ptr<gfx::Sphere> sphere_ptr{ std::make_shared<gfx::Sphere>() };
+    const std::shared_ptr<gfx::CompositeSurface> inner_group_ptr{ std::make_shared<gfx::CompositeSurface>(
+            gfx::createTranslationMatrix(0, 2, 0), sphere_ptr)
+    };
+    const gfx::CompositeSurface outer_group{ gfx::createScalingMatrix(2), inner_group_ptr };
+
+    EXPECT_EQ(inner_group_ptr->getBounds(), (gfx::BoundingBox{ -1, -1, -1, 1, 1, 1 }));
+    EXPECT_EQ(outer_group.getBounds(), (gfx::BoundingBox{ -1, 1, -1, 1, 3, 1 }));
+
+    // Moving the child refits both groups
+    sphere_ptr->setTransform(gfx::createTranslationMatrix(3, 0, 0));
+    EXPECT_EQ(inner_group_ptr->getBounds(), (gfx::BoundingBox{ 2, -1, -1, 4, 1, 1 }));
+    EXPECT_EQ(outer_group.getBounds(), (gfx::BoundingBox{ 2, 1, -1, 4, 3, 1 }));
+
+    // Moving the inner group only refits the outer group
+    inner_group_ptr->setTransform(gfx::createIdentityMatrix());
+    EXPECT_EQ(inner_group_ptr->getBounds(), (gfx::BoundingBox{ 2, -1, -1, 4, 1, 1 }));
+    EXPECT_EQ(outer_group.getBounds(), (gfx::BoundingBox{ 2, -1, -1, 4, 1, 1 }));
+}
+
 // Test setting the material for a composite surface
 TEST(GraphicsCompositeSurface, SetMaterial)
 {
@@ -0,0 +1,153 @@
+#include "footprint_grid.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace gfx {
+    // Returns the extents of a bounding box along each axis
+    static std::array<double, 3> getMinExtents(const BoundingBox& box)
+    { return { box.getMinX(), box.getMinY(), box.getMinZ() }; }
+
+    static std::array<double, 3> getMaxExtents(const BoundingBox& box)
+    { return { box.getMaxX(), box.getMaxY(), box.getMaxZ() }; }
+
+    // Returns the cell along one axis of the grid which contains a coordinate, clamping coordinates beyond the bounds
+    // of the grid to its outermost cells. Every coordinate of an axis without any extent lies in its first cell.
+    static size_t calculateCellCoordinate(const double coordinate, const double min_extent, const double max_extent)
+    {
+        const double extent{ max_extent - min_extent };
+        if (!(extent > 0)) {
+            return 0;
+        }
+
+        constexpr auto resolution{ static_cast<double>(FootprintGrid::RESOLUTION) };
+        const double cell{ std::floor((coordinate - min_extent) / extent * resolution) };
+        return static_cast<size_t>(std::clamp(cell, 0.0, resolution - 1));
+    }
+
+    // Returns the index of the bit of a cell, with the X coordinate varying fastest
+    static size_t calculateCellIndex(const size_t x, const size_t y, const size_t z)
+    { return (z * FootprintGrid::RESOLUTION + y) * FootprintGrid::RESOLUTION + x; }
+
+    // Cell Lookup
+    bool FootprintGrid::isCellMarked(const size_t x, const size_t y, const size_t z) const
+    {
+        const size_t cell_index{ calculateCellIndex(x, y, z) };
+        return (m_cells.at(cell_index / 64) >> (cell_index % 64) & 1) != 0;
+    }
+
+    // Segment Recording
+    void FootprintGrid::addSegment(const Vector4& origin, const Vector4& direction, const double distance)
+    {
+        const std::array<double, 3> min_extents{ getMinExtents(m_bounds) };
+        const std::array<double, 3> max_extents{ getMaxExtents(m_bounds) };
+        const std::array<double, 3> origin_components{ origin.x(), origin.y(), origin.z() };
+        const std::array<double, 3> direction_components{ direction.x(), direction.y(), direction.z() };
+
+        // Clip the segment to each pair of bounding planes in turn. A grid covering nothing records nothing.
+        double t_min{ 0 };
+        double t_max{ distance };
+        for (size_t axis = 0; axis < 3; ++axis) {
+            if (min_extents[axis] > max_extents[axis]) {
+                return;
+            }
+
+            if (direction_components[axis] == 0) {
+                if (origin_components[axis] < min_extents[axis] || origin_components[axis] > max_extents[axis]) {
+                    return;
+                }
+                continue;
+            }
+
+            const double t_first{ (min_extents[axis] - origin_components[axis]) / direction_components[axis] };
+            const double t_second{ (max_extents[axis] - origin_components[axis]) / direction_components[axis] };
+            t_min = std::max(t_min, std::min(t_first, t_second));
+            t_max = std::min(t_max, std::max(t_first, t_second));
+        }
+        if (!(t_min <= t_max) || !std::isfinite(t_max)) {
+            return;
+        }
+
+        // Step along the clipped segment in pieces which cross at most one cell boundary along each axis, so that the
+        // cells around each piece are close to the cells the segment passes through
+        const Vector4 segment_start{ origin + direction * t_min };
+        double cell_span{ 0 };
+        for (size_t axis = 0; axis < 3; ++axis) {
+            const double extent{ max_extents[axis] - min_extents[axis] };
+            if (extent > 0) {
+                const double axis_span{ std::abs(direction_components[axis]) * (t_max - t_min) / extent };
+                cell_span = std::max(cell_span, axis_span * static_cast<double>(RESOLUTION));
+            }
+        }
+
+        const size_t piece_count{ std::max<size_t>(static_cast<size_t>(std::ceil(cell_span)), 1) };
+        Vector4 piece_start{ segment_start };
+        for (size_t piece = 1; piece <= piece_count; ++piece) {
+            const double piece_fraction{ static_cast<double>(piece) / static_cast<double>(piece_count) };
+            const Vector4 piece_end{ origin + direction * (t_min + (t_max - t_min) * piece_fraction) };
+            this->markCells(piece_start, piece_end);
+            piece_start = piece_end;
+        }
+    }
+
+    // Box Containment
+    bool FootprintGrid::containsBox(const BoundingBox& box) const
+    {
+        // The extents are compared exactly, since segments were clipped exactly to the bounds of the grid
+        const std::array<double, 3> min_extents{ getMinExtents(m_bounds) };
+        const std::array<double, 3> max_extents{ getMaxExtents(m_bounds) };
+        const std::array<double, 3> box_min_extents{ getMinExtents(box) };
+        const std::array<double, 3> box_max_extents{ getMaxExtents(box) };
+        for (size_t axis = 0; axis < 3; ++axis) {
+            if (!(min_extents[axis] <= box_min_extents[axis] && box_max_extents[axis] <= max_extents[axis])) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // Box Overlap
+    bool FootprintGrid::overlapsBox(const BoundingBox& box) const
+    {
+        if (!m_bounds.overlapsBox(box)) {
+            return false;
+        }
+
+        const size_t min_x{ calculateCellCoordinate(box.getMinX(), m_bounds.getMinX(), m_bounds.getMaxX()) };
+        const size_t min_y{ calculateCellCoordinate(box.getMinY(), m_bounds.getMinY(), m_bounds.getMaxY()) };
+        const size_t min_z{ calculateCellCoordinate(box.getMinZ(), m_bounds.getMinZ(), m_bounds.getMaxZ()) };
+        const size_t max_x{ calculateCellCoordinate(box.getMaxX(), m_bounds.getMinX(), m_bounds.getMaxX()) };
+        const size_t max_y{ calculateCellCoordinate(box.getMaxY(), m_bounds.getMinY(), m_bounds.getMaxY()) };
+        const size_t max_z{ calculateCellCoordinate(box.getMaxZ(), m_bounds.getMinZ(), m_bounds.getMaxZ()) };
+        for (size_t z = min_z; z <= max_z; ++z)
+            for (size_t y = min_y; y <= max_y; ++y)
+                for (size_t x = min_x; x <= max_x; ++x) {
+                    if (this->isCellMarked(x, y, z)) {
+                        return true;
+                    }
+                }
+
+        return false;
+    }
+
+    // Cell Marking
+    void FootprintGrid::markCells(const Vector4& first_point, const Vector4& second_point)
+    {
+        const auto [ min_x, max_x ] { std::minmax({
+            calculateCellCoordinate(first_point.x(), m_bounds.getMinX(), m_bounds.getMaxX()),
+            calculateCellCoordinate(second_point.x(), m_bounds.getMinX(), m_bounds.getMaxX()) }) };
+        const auto [ min_y, max_y ] { std::minmax({
+            calculateCellCoordinate(first_point.y(), m_bounds.getMinY(), m_bounds.getMaxY()),
+            calculateCellCoordinate(second_point.y(), m_bounds.getMinY(), m_bounds.getMaxY()) }) };
+        const auto [ min_z, max_z ] { std::minmax({
+            calculateCellCoordinate(first_point.z(), m_bounds.getMinZ(), m_bounds.getMaxZ()),
+            calculateCellCoordinate(second_point.z(), m_bounds.getMinZ(), m_bounds.getMaxZ()) }) };
+        for (size_t z = min_z; z <= max_z; ++z)
+            for (size_t y = min_y; y <= max_y; ++y)
+                for (size_t x = min_x; x <= max_x; ++x) {
+                    const size_t cell_index{ calculateCellIndex(x, y, z) };
+                    m_cells[cell_index / 64] |= uint64_t{ 1 } << (cell_index % 64);
+                }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "vector4.hpp"
+#include "bounding_box.hpp"
+
+namespace gfx {
+    // A coarse grid of cells over a region of space, marking each cell that the recorded ray segments pass through.
+    // Segments are clipped to the region, so a grid over the bounds of a scene tells which parts of the scene rays
+    // came near, without rays that leave the scene reaching everything beyond it.
+    class FootprintGrid
+    {
+    public:
+        // Number of cells along each axis of the grid
+        static constexpr size_t RESOLUTION{ 16 };
+
+        // Number of 64-bit words holding one bit for each cell
+        static constexpr size_t WORD_COUNT{ RESOLUTION * RESOLUTION * RESOLUTION / 64 };
+
+        /* Constructors */
+
+        // Default Constructor, for a grid covering nothing
+        FootprintGrid() = default;
+
+        // Bounds Constructor, for a grid without any marked cells
+        explicit FootprintGrid(const BoundingBox& bounds)
+                : m_bounds{ bounds }
+        {}
+
+        // Cells Constructor
+        FootprintGrid(const BoundingBox& bounds, const std::array<uint64_t, WORD_COUNT>& cells)
+                : m_bounds{ bounds }, m_cells{ cells }
+        {}
+
+        /* Accessors */
+
+        [[nodiscard]] const BoundingBox& getBounds() const
+        { return m_bounds; }
+
+        // Returns one bit for each cell of the grid, with the X coordinate of the cells varying fastest
+        [[nodiscard]] const std::array<uint64_t, WORD_COUNT>& getCells() const
+        { return m_cells; }
+
+        // Returns true if a recorded segment passes through the cell at the given coordinates
+        [[nodiscard]] bool isCellMarked(size_t x, size_t y, size_t z) const;
+
+        /* Mutators */
+
+        // Marks every cell passed through by the part of a ray within the bounds of the grid, from its origin up to a
+        // distance in units of its direction, which may be infinite
+        void addSegment(const Vector4& origin, const Vector4& direction, double distance);
+
+        /* Comparison Operator Overloads */
+
+        [[nodiscard]] bool operator==(const FootprintGrid& rhs) const = default;
+
+        /* Bounds Checking Operations */
+
+        // Returns true if a box lies entirely within the bounds of the grid, so that every segment reaching the box
+        // was recorded by the grid
+        [[nodiscard]] bool containsBox(const BoundingBox& box) const;
+
+        // Returns true if any marked cell overlaps or touches a box
+        [[nodiscard]] bool overlapsBox(const BoundingBox& box) const;
+
+    private:
+        /* Data Members */
+
+        BoundingBox m_bounds{ };
+        std::array<uint64_t, WORD_COUNT> m_cells{ };
+
+        /* Helper Methods */
+
+        // Marks every cell overlapping the box between two points
+        void markCells(const Vector4& first_point, const Vector4& second_point);
+    };
+}
\ No newline at end of file
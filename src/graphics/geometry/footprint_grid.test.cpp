@@ -0,0 +1,71 @@
+#include "gtest/gtest.h"
+#include "footprint_grid.hpp"
+
+#include <limits>
+
+// Tests recording segments which lie within the bounds of a grid
+TEST(GraphicsFootprintGrid, AddSegment)
+{
+    // Each cell of the grid is one unit wide along each axis
+    gfx::FootprintGrid grid{ gfx::BoundingBox{ 0, 0, 0, 16, 16, 16 } };
+    grid.addSegment(gfx::createPoint(0.5, 0.5, 0.5), gfx::createVector(1, 0, 0), 3);
+
+    EXPECT_TRUE(grid.isCellMarked(0, 0, 0));
+    EXPECT_TRUE(grid.isCellMarked(3, 0, 0));
+    EXPECT_FALSE(grid.isCellMarked(4, 0, 0));
+    EXPECT_FALSE(grid.isCellMarked(0, 1, 0));
+
+    // A diagonal segment only marks the cells along its path, rather than every cell of the box around it
+    grid.addSegment(gfx::createPoint(0.5, 0.5, 8.5), gfx::createVector(1, 1, 0), 15);
+    EXPECT_TRUE(grid.isCellMarked(0, 0, 8));
+    EXPECT_TRUE(grid.isCellMarked(7, 7, 8));
+    EXPECT_TRUE(grid.isCellMarked(15, 15, 8));
+    EXPECT_FALSE(grid.isCellMarked(15, 0, 8));
+    EXPECT_FALSE(grid.isCellMarked(0, 15, 8));
+    EXPECT_FALSE(grid.isCellMarked(7, 7, 9));
+}
+
+// Tests that segments are clipped to the bounds of a grid, including segments of infinite length
+TEST(GraphicsFootprintGrid, ClipSegment)
+{
+    constexpr double INF{ std::numeric_limits<double>::infinity() };
+    gfx::FootprintGrid grid{ gfx::BoundingBox{ 0, 0, 0, 16, 16, 16 } };
+
+    // A ray entering from outside of the grid and leaving it again only marks the cells it passes through
+    grid.addSegment(gfx::createPoint(-10, 4.5, 4.5), gfx::createVector(1, 0, 0), INF);
+    EXPECT_TRUE(grid.isCellMarked(0, 4, 4));
+    EXPECT_TRUE(grid.isCellMarked(15, 4, 4));
+    EXPECT_FALSE(grid.isCellMarked(0, 5, 4));
+
+    // Segments which miss the grid, or stop before reaching it, mark nothing
+    const gfx::FootprintGrid unmarked_grid{ gfx::BoundingBox{ 0, 0, 0, 16, 16, 16 } };
+    gfx::FootprintGrid missed_grid{ unmarked_grid };
+    missed_grid.addSegment(gfx::createPoint(-10, 20, 4.5), gfx::createVector(1, 0, 0), 100);
+    missed_grid.addSegment(gfx::createPoint(-10, 4.5, 4.5), gfx::createVector(1, 0, 0), 5);
+    EXPECT_EQ(missed_grid, unmarked_grid);
+
+    // A grid covering nothing records nothing
+    gfx::FootprintGrid empty_grid{ };
+    empty_grid.addSegment(gfx::createPoint(0, 0, 0), gfx::createVector(1, 1, 1), 1);
+    EXPECT_EQ(empty_grid, gfx::FootprintGrid{ });
+}
+
+// Tests comparing boxes with the bounds and marked cells of a grid
+TEST(GraphicsFootprintGrid, BoxChecks)
+{
+    constexpr double INF{ std::numeric_limits<double>::infinity() };
+    gfx::FootprintGrid grid{ gfx::BoundingBox{ 0, 0, 0, 16, 16, 16 } };
+    grid.addSegment(gfx::createPoint(0.5, 0.5, 0.5), gfx::createVector(0, 0, 1), 2);
+
+    EXPECT_TRUE(grid.containsBox(gfx::BoundingBox{ 0, 0, 0, 16, 16, 16 }));
+    EXPECT_TRUE(grid.containsBox(gfx::BoundingBox{ 4, 4, 4, 5, 5, 5 }));
+    EXPECT_FALSE(grid.containsBox(gfx::BoundingBox{ 4, 4, 4, 17, 5, 5 }));
+    EXPECT_FALSE(grid.containsBox(gfx::BoundingBox{ 4, 4, 4, INF, 5, 5 }));
+    EXPECT_FALSE(gfx::FootprintGrid{ }.containsBox(gfx::BoundingBox{ 4, 4, 4, 5, 5, 5 }));
+
+    EXPECT_TRUE(grid.overlapsBox(gfx::BoundingBox{ 0.2, 0.2, 1.2, 0.8, 0.8, 1.8 }));
+    EXPECT_TRUE(grid.overlapsBox(gfx::BoundingBox{ -5, -5, -5, 0.5, 0.5, 0.5 }));
+    EXPECT_FALSE(grid.overlapsBox(gfx::BoundingBox{ 2.2, 0.2, 0.2, 3.8, 0.8, 1.8 }));
+    EXPECT_FALSE(grid.overlapsBox(gfx::BoundingBox{ 0.2, 0.2, 3.2, 0.8, 0.8, 3.8 }));
+    EXPECT_FALSE(grid.overlapsBox(gfx::BoundingBox{ 20, 20, 20, 21, 21, 21 }));
+}
\ No newline at end of file
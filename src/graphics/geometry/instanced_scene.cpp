@@ -0,0 +1,217 @@
+#include "instanced_scene.hpp"
+
+#include <algorithm>
+
+#include "composite_surface.hpp"
+
+namespace gfx {
+    // Returns an object to compare with the other top-level objects of a world to find those sharing an asset.
+    // Composite surfaces are compared by their children alone, but surfaces also compare their own transforms, so
+    // they are compared as untransformed copies.
+    static std::shared_ptr<const Object> createAssetPrototype(const Object& object)
+    {
+        if (dynamic_cast<const CompositeSurface*>(&object)) {
+            return std::shared_ptr<const Object>{ std::shared_ptr<const Object>{ }, &object };
+        }
+
+        const std::shared_ptr<Object> prototype{ object.clone() };
+        prototype->setTransform(createIdentityMatrix());
+        return prototype;
+    }
+
+    // World Instancing Constructor
+    InstancedScene::InstancedScene(const World& world)
+            : m_light_sources{ world.getLightSources().begin(), world.getLightSources().end() },
+              m_area_lights{ world.getAreaLights().begin(), world.getAreaLights().end() },
+              m_light_sampling_settings{ world.getLightSamplingSettings() }
+    {
+        const auto build_start{ std::chrono::steady_clock::now() };
+
+        // Compile each distinct asset in its own space the first time one of its instances is found
+        std::vector<std::shared_ptr<const Object>> asset_prototypes{ };
+        for (size_t i = 0; i < world.getObjectCount(); ++i) {
+            const Object& object{ world.getObjectAt(i) };
+            const std::shared_ptr<const Object> prototype{ createAssetPrototype(object) };
+            const auto prototype_iter{ std::ranges::find_if(asset_prototypes, [&](const auto& asset_prototype) {
+                return *asset_prototype == *prototype;
+            }) };
+
+            const auto asset_index{ static_cast<size_t>(std::distance(asset_prototypes.begin(), prototype_iter)) };
+            if (prototype_iter == asset_prototypes.end()) {
+                asset_prototypes.push_back(prototype);
+                m_assets.push_back(std::make_shared<const CompiledScene>(object));
+                m_statistics.asset_primitive_count += m_assets.back()->getPrimitiveCount();
+            }
+            m_instances.emplace_back(asset_index, ClassifiedTransform{ object.getTransform() });
+        }
+
+        // Assets with infinite extents (e.g. planes) are tested against every ray, all others go in the top-level
+        // BVH. The bounds of a bounded asset are those of the root of its own BVH.
+        std::vector<bool> are_assets_bounded{ };
+        m_asset_bounds.reserve(m_assets.size());
+        for (const auto& asset : m_assets) {
+            are_assets_bounded.push_back(asset->getBuildStatistics().unbounded_primitive_count == 0 &&
+                                         asset->getBVH().getNodeCount() > 0);
+            m_asset_bounds.push_back(are_assets_bounded.back() ? asset->getBVH().getNodeAt(0).bounds : BoundingBox{ });
+        }
+        for (size_t i = 0; i < m_instances.size(); ++i) {
+            if (are_assets_bounded[m_instances[i].asset_index]) {
+                m_bounded_instances.push_back(i);
+            } else {
+                m_unbounded_instances.push_back(i);
+            }
+        }
+        this->rebuildTopLevelBVH();
+
+        // Record the build statistics
+        size_t asset_memory_usage{ 0 };
+        for (const auto& asset : m_assets) {
+            asset_memory_usage += asset->getBuildStatistics().memory_usage;
+        }
+        m_statistics.build_time = std::chrono::steady_clock::now() - build_start;
+        m_statistics.instance_count = m_instances.size();
+        m_statistics.unbounded_instance_count = m_unbounded_instances.size();
+        m_statistics.asset_count = m_assets.size();
+        m_statistics.memory_usage =
+                asset_memory_usage +
+                m_assets.capacity() * sizeof(std::shared_ptr<const CompiledScene>) +
+                m_asset_bounds.capacity() * sizeof(BoundingBox) +
+                m_instances.capacity() * sizeof(SceneInstance) +
+                m_bounded_instances.capacity() * sizeof(size_t) +
+                m_unbounded_instances.capacity() * sizeof(size_t) +
+                m_top_level_bvh.getMemoryUsage();
+    }
+
+    // Instance Transform Mutator
+    void InstancedScene::setInstanceTransform(const size_t instance_index, const Matrix4& transform_matrix)
+    {
+        m_instances.at(instance_index).transform = ClassifiedTransform{ transform_matrix };
+
+        // Unbounded instances are tested against every ray, so only moving a bounded instance changes the top level
+        if (std::ranges::binary_search(m_bounded_instances, instance_index)) {
+            this->rebuildTopLevelBVH();
+        }
+    }
+
+    // Top-Level BVH Builder
+    void InstancedScene::rebuildTopLevelBVH()
+    {
+        std::vector<BoundingBox> instance_bounds{ };
+        instance_bounds.reserve(m_bounded_instances.size());
+        for (const size_t instance_index : m_bounded_instances) {
+            const SceneInstance& instance{ m_instances[instance_index] };
+            instance_bounds.push_back(m_asset_bounds[instance.asset_index].transform(instance.transform.getMatrix()));
+        }
+
+        m_top_level_bvh = BoundingVolumeHierarchy{ instance_bounds };
+        m_statistics.top_level_node_count = m_top_level_bvh.getNodeCount();
+    }
+
+    // Instanced Scene Intersection Calculator
+    std::vector<Intersection> InstancedScene::getAllIntersections(const Ray& ray) const
+    {
+        std::vector<Intersection> scene_intersections{ };
+
+        // Every intersection along the line of the ray is needed to calculate refraction, as for compiled scenes
+        m_top_level_bvh.traverse(ray, [&](const size_t primitive_index) {
+            this->intersectInstance(m_instances[m_bounded_instances[primitive_index]], ray, scene_intersections);
+        });
+        for (const size_t instance_index : m_unbounded_instances) {
+            this->intersectInstance(m_instances[instance_index], ray, scene_intersections);
+        }
+
+        // Sort list and return
+        std::sort(scene_intersections.begin(), scene_intersections.end());
+        return scene_intersections;
+    }
+
+    // Instanced Scene Packet Intersection Calculator
+    PacketIntersections InstancedScene::getAllPacketIntersections(const RayPacket& packet) const
+    {
+        PacketIntersections packet_intersections{ };
+
+        m_top_level_bvh.traverse(packet, [&](const size_t primitive_index, const uint32_t lanes) {
+            this->intersectInstance(m_instances[m_bounded_instances[primitive_index]],
+                                    packet,
+                                    lanes,
+                                    packet_intersections);
+        });
+        for (const size_t instance_index : m_unbounded_instances) {
+            this->intersectInstance(m_instances[instance_index], packet, packet.active_lanes, packet_intersections);
+        }
+
+        // Sort each list and return
+        for (std::vector<Intersection>& lane_intersections : packet_intersections) {
+            std::sort(lane_intersections.begin(), lane_intersections.end());
+        }
+        return packet_intersections;
+    }
+
+    // Instanced Scene Occlusion Check
+    bool InstancedScene::isOccluded(const Ray& ray, const double distance) const
+    {
+        return this->findOccluder(ray, distance).has_value();
+    }
+
+    // Instanced Scene Occluder Finder
+    std::optional<size_t> InstancedScene::findOccluder(const Ray& ray, const double distance) const
+    {
+        std::optional<size_t> occluder{ };
+        const auto is_instance_occluding{ [&](const size_t instance_index) {
+            if (this->isOccludedBy(ray, distance, instance_index)) {
+                occluder = instance_index;
+            }
+            return occluder.has_value();
+        } };
+
+        if (!std::ranges::any_of(m_unbounded_instances, is_instance_occluding)) {
+            m_top_level_bvh.traverse(ray, 0, distance, [&](const size_t primitive_index) {
+                return is_instance_occluding(m_bounded_instances[primitive_index]);
+            });
+        }
+        return occluder;
+    }
+
+    // Instanced Scene Occluder Check
+    bool InstancedScene::isOccludedBy(const Ray& ray, const double distance, const size_t occluder) const
+    {
+        if (occluder >= m_instances.size()) {
+            return false;
+        }
+
+        // Transforming a ray keeps the distances along it, so the asset can be tested against the same range
+        const SceneInstance& instance{ m_instances[occluder] };
+        return m_assets[instance.asset_index]->isOccluded(ray.inverseTransform(instance.transform), distance);
+    }
+
+    // Single Instance Intersection Calculator
+    void InstancedScene::intersectInstance(const SceneInstance& instance,
+                                           const Ray& ray,
+                                           std::vector<Intersection>& intersections) const
+    {
+        // Move the ray into the space the asset was compiled in
+        const Ray instance_ray{ instance.transform.getType() == TransformType::Identity ?
+                                ray : ray.inverseTransform(instance.transform) };
+        for (const Intersection& intersection : m_assets[instance.asset_index]->getAllIntersections(instance_ray)) {
+            intersections.emplace_back(intersection.getT(), &intersection.getObject(), &instance.transform);
+        }
+    }
+
+    // Single Instance Packet Intersection Calculator
+    void InstancedScene::intersectInstance(const SceneInstance& instance,
+                                           const RayPacket& packet,
+                                           const uint32_t lanes,
+                                           PacketIntersections& intersections) const
+    {
+        RayPacket instance_packet{ packet.inverseTransform(instance.transform) };
+        instance_packet.active_lanes = lanes;
+
+        const PacketIntersections asset_intersections{
+            m_assets[instance.asset_index]->getAllPacketIntersections(instance_packet) };
+        for (size_t lane = 0; lane < RAY_PACKET_SIZE; ++lane) {
+            for (const Intersection& intersection : asset_intersections[lane]) {
+                intersections[lane].emplace_back(intersection.getT(), &intersection.getObject(), &instance.transform);
+            }
+        }
+    }
+}
\ No newline at end of file
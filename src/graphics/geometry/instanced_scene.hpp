@@ -0,0 +1,154 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <span>
+#include <optional>
+#include <vector>
+
+#include "world.hpp"
+#include "traceable_scene.hpp"
+#include "compiled_scene.hpp"
+#include "bounding_volume_hierarchy.hpp"
+#include "transform.hpp"
+
+namespace gfx {
+    // Places a shared asset of an instanced scene in the world
+    struct SceneInstance
+    {
+        size_t asset_index{ 0 };
+        ClassifiedTransform transform{ };       // The asset-to-world transform of the instance
+    };
+
+    // Statistics recorded while building an instanced scene
+    struct InstancedSceneStatistics
+    {
+        std::chrono::duration<double, std::milli> build_time{ 0 };
+        size_t instance_count{ 0 };
+        size_t unbounded_instance_count{ 0 };   // Instances with infinite bounds, kept outside of the top-level BVH
+        size_t asset_count{ 0 };                // Number of distinct assets shared by the instances
+        size_t asset_primitive_count{ 0 };      // Primitives across the distinct assets, each stored only once
+        size_t top_level_node_count{ 0 };
+        size_t memory_usage{ 0 };               // Bytes used by the assets, instances and top-level BVH
+    };
+
+    // A two-level snapshot of a world which is safe to share between threads while rendering. Top-level objects which
+    // differ only by their own transforms are instances of one asset, compiled once in its own space with its own
+    // bottom-level BVH, and a small top-level BVH is built over the world-space bounds of the instances. Rays are
+    // moved into the space of an instance on reaching it, so memory grows with the unique geometry of the world
+    // rather than with its number of objects, and moving an instance only rebuilds the top level.
+    class InstancedScene : public TraceableScene
+    {
+    public:
+        /* Constructors */
+
+        InstancedScene() = delete;
+
+        // Groups the top-level objects of a world by their assets, compiling each asset once
+        explicit InstancedScene(const World& world);
+
+        // Copy Constructor
+        InstancedScene(const InstancedScene&) = default;
+
+        // Move Constructor
+        InstancedScene(InstancedScene&&) = default;
+
+        /* Destructor */
+
+        ~InstancedScene() override = default;
+
+        /* Assignment Operators */
+
+        InstancedScene& operator=(const InstancedScene&) = default;
+        InstancedScene& operator=(InstancedScene&&) = default;
+
+        /* Accessors */
+
+        [[nodiscard]] std::span<const PointLight> getLightSources() const override
+        { return m_light_sources; }
+
+        [[nodiscard]] std::span<const AreaLight> getAreaLights() const override
+        { return m_area_lights; }
+
+        [[nodiscard]] const LightSamplingSettings& getLightSamplingSettings() const override
+        { return m_light_sampling_settings; }
+
+        [[nodiscard]] const LightBVH& getLightBVH() const override
+        { return m_light_bvh; }
+
+        // Returns the number of instances, one for each top-level object in the world the scene was built from
+        [[nodiscard]] size_t getInstanceCount() const
+        { return m_instances.size(); }
+
+        [[nodiscard]] const SceneInstance& getInstanceAt(const size_t index) const
+        { return m_instances.at(index); }
+
+        [[nodiscard]] size_t getAssetCount() const
+        { return m_assets.size(); }
+
+        [[nodiscard]] const CompiledScene& getAssetAt(const size_t index) const
+        { return *m_assets.at(index); }
+
+        [[nodiscard]] const BoundingVolumeHierarchy& getTopLevelBVH() const
+        { return m_top_level_bvh; }
+
+        [[nodiscard]] const InstancedSceneStatistics& getBuildStatistics() const
+        { return m_statistics; }
+
+        /* Mutators */
+
+        // Moves an instance to a new asset-to-world transform, rebuilding the top-level BVH if the instance is in it.
+        // Assets are shared with copies of the scene and left untouched.
+        void setInstanceTransform(size_t instance_index, const Matrix4& transform_matrix);
+
+        /* Ray-Tracing Operations */
+
+        // Returns a sorted list of all intersections with the instances in this scene with a passed-in Ray
+        [[nodiscard]] std::vector<Intersection> getAllIntersections(const Ray& ray) const override;
+
+        // Returns the sorted list of intersections for each active lane of a ray packet, tracing the packet through
+        // the top-level BVH and then through the asset of each instance it reaches
+        [[nodiscard]] PacketIntersections getAllPacketIntersections(const RayPacket& packet) const override;
+
+        // Returns true if any instance intersects the ray in the range [0, distance), stopping at the first one
+        [[nodiscard]] bool isOccluded(const Ray& ray, double distance) const override;
+
+        // Returns the index of the first instance found intersecting the ray in the range [0, distance)
+        [[nodiscard]] std::optional<size_t> findOccluder(const Ray& ray, double distance) const override;
+
+        // Returns true if the instance at the passed-in index intersects the ray in the range [0, distance)
+        [[nodiscard]] bool isOccludedBy(const Ray& ray, double distance, size_t occluder) const override;
+
+    private:
+        /* Data Members */
+
+        std::vector<PointLight> m_light_sources{ };
+        LightBVH m_light_bvh{ m_light_sources };
+        std::vector<AreaLight> m_area_lights{ };
+        LightSamplingSettings m_light_sampling_settings{ };
+        std::vector<std::shared_ptr<const CompiledScene>> m_assets{ };  // Shared with any copies of the scene
+        std::vector<BoundingBox> m_asset_bounds{ };         // The object-space bounds of each bounded asset
+        std::vector<SceneInstance> m_instances{ };
+        std::vector<size_t> m_bounded_instances{ };         // The instance referred to by each top-level BVH primitive
+        std::vector<size_t> m_unbounded_instances{ };       // Instances of assets which cannot be placed in the BVH
+        BoundingVolumeHierarchy m_top_level_bvh{ };
+        InstancedSceneStatistics m_statistics{ };
+
+        /* Helper Methods */
+
+        // Rebuilds the top-level BVH over the current world-space bounds of the bounded instances
+        void rebuildTopLevelBVH();
+
+        // Appends the intersections of a ray with the asset of a single instance, tagged with the instance so that
+        // they are shaded where the instance places them
+        void intersectInstance(const SceneInstance& instance,
+                               const Ray& ray,
+                               std::vector<Intersection>& intersections) const;
+
+        // Appends the intersections of the passed-in lanes of a ray packet with the asset of a single instance
+        void intersectInstance(const SceneInstance& instance,
+                               const RayPacket& packet,
+                               uint32_t lanes,
+                               PacketIntersections& intersections) const;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,161 @@
+#include "gtest/gtest.h"
+#include "instanced_scene.hpp"
+
+#include <vector>
+#include <span>
+#include <algorithm>
+#include <numbers>
+#include <stdexcept>
+
+#include "light.hpp"
+#include "sphere.hpp"
+#include "plane.hpp"
+#include "cube.hpp"
+#include "cone.hpp"
+#include "composite_surface.hpp"
+#include "compiled_scene.hpp"
+#include "ray.hpp"
+#include "transform.hpp"
+#include "intersection.hpp"
+
+// Returns a world made of several transformed copies of a few objects
+static gfx::World createInstancedWorld(const gfx::Matrix4& moved_group_transform)
+{
+    const gfx::Material glass{ gfx::Color{ 0.1, 0.1, 0.1 },
+                               gfx::MaterialProperties{ .reflectivity = 0.9,
+                                                        .transparency = 0.9,
+                                                        .refractive_index = 1.5 } };
+    const auto create_group{ [](const gfx::Matrix4& group_transform) {
+        const gfx::Cube cube{ gfx::createTranslationMatrix(-1, 0, 0) * gfx::createScalingMatrix(0.5) };
+        const gfx::Cone cone{ gfx::createTranslationMatrix(1, 0, 0), -1, 0, true };
+        return gfx::CompositeSurface{ group_transform, cube, cone };
+    } };
+
+    gfx::World world{ gfx::PointLight{ gfx::Color{ 1, 1, 1 }, gfx::createPoint(-10, 10, -10) } };
+    world.addObject(gfx::Sphere{ glass });
+    world.addObject(gfx::Sphere{ gfx::createTranslationMatrix(0, 0, 3), glass });
+    world.addObject(gfx::Sphere{ gfx::createScalingMatrix(0.5), gfx::Material{ gfx::Color{ 0.8, 1.0, 0.6 } } });
+    world.addObject(gfx::Plane{ gfx::createTranslationMatrix(0, -1, 0) });
+    world.addObject(create_group(gfx::createTranslationMatrix(0, 2, 0)));
+    world.addObject(create_group(moved_group_transform));
+    return world;
+}
+
+// Tests that top-level objects differing only by their own transforms share an asset
+TEST(GraphicsInstancedScene, ShareAssets)
+{
+    const gfx::World world{ createInstancedWorld(gfx::createTranslationMatrix(4, 2, 0)) };
+    const gfx::InstancedScene scene{ world };
+
+    ASSERT_EQ(scene.getInstanceCount(), 6);
+    ASSERT_EQ(scene.getAssetCount(), 4);
+    EXPECT_EQ(scene.getInstanceAt(0).asset_index, scene.getInstanceAt(1).asset_index);
+    EXPECT_NE(scene.getInstanceAt(0).asset_index, scene.getInstanceAt(2).asset_index);
+    EXPECT_EQ(scene.getInstanceAt(4).asset_index, scene.getInstanceAt(5).asset_index);
+    EXPECT_EQ(scene.getInstanceAt(1).transform.getMatrix(), gfx::createTranslationMatrix(0, 0, 3));
+
+    // Assets are compiled in their own space, without the transform of the object they were found in
+    const gfx::CompiledScene& sphere_asset{ scene.getAssetAt(scene.getInstanceAt(1).asset_index) };
+    ASSERT_EQ(sphere_asset.getPrimitiveCount(), 1);
+    EXPECT_EQ(sphere_asset.getPrimitiveAt(0).world_transform.getType(), gfx::TransformType::Identity);
+
+    const gfx::InstancedSceneStatistics& build_stats{ scene.getBuildStatistics() };
+    EXPECT_EQ(build_stats.instance_count, 6);
+    EXPECT_EQ(build_stats.unbounded_instance_count, 1);
+    EXPECT_EQ(build_stats.asset_count, 4);
+    EXPECT_EQ(build_stats.asset_primitive_count, 5);
+    EXPECT_EQ(build_stats.top_level_node_count, scene.getTopLevelBVH().getNodeCount());
+    EXPECT_EQ(scene.getTopLevelBVH().getPrimitiveCount(), 5);
+    EXPECT_GT(build_stats.memory_usage, 0);
+}
+
+// Tests that tracing and shading an instanced scene matches the compiled scene of the same world
+TEST(GraphicsInstancedScene, TracingMatchesCompiledScene)
+{
+    const gfx::World world{ createInstancedWorld(gfx::createTranslationMatrix(4, 2, 0) *
+                                                 gfx::createYRotationMatrix(std::numbers::pi / 3) *
+                                                 gfx::createScalingMatrix(1.5)) };
+    const gfx::InstancedScene scene{ world };
+    const gfx::CompiledScene scene_expected{ world };
+
+    const std::vector<gfx::Ray> rays{
+        gfx::Ray{ 0.2, 0.3, -5, 0, 0, 1 },
+        gfx::Ray{ 0, 0.1, -5, 0, 0, 1 },
+        gfx::Ray{ -1, 2, -5, 0, 0, 1 },
+        gfx::Ray{ 1, 1.6, -5, 0, 0, 1 },
+        gfx::Ray{ 4.5, 2, -5, 0, 0, 1 },
+        gfx::Ray{ 0, 5, -5, 0, -0.6, 0.8 },
+        gfx::Ray{ 10, 10, 10, 1, 0, 0 }
+    };
+    for (const gfx::Ray& ray : rays) {
+        const std::vector<gfx::Intersection> intersections_expected{ scene_expected.getAllIntersections(ray) };
+        const std::vector<gfx::Intersection> intersections_actual{ scene.getAllIntersections(ray) };
+
+        ASSERT_EQ(intersections_actual.size(), intersections_expected.size());
+        for (size_t i = 0; i < intersections_expected.size(); ++i) {
+            EXPECT_FLOAT_EQ(intersections_actual.at(i).getT(), intersections_expected.at(i).getT());
+            EXPECT_TRUE(intersections_actual.at(i).isInstanced());
+        }
+        EXPECT_EQ(scene.calculatePixelColor(ray), scene_expected.calculatePixelColor(ray));
+        EXPECT_EQ(scene.isOccluded(ray, 10), scene_expected.isOccluded(ray, 10));
+    }
+
+    // Packets gather the same intersections as single rays
+    for (size_t first_ray = 0; first_ray < rays.size(); first_ray += gfx::RAY_PACKET_SIZE) {
+        const size_t ray_count{ std::min(gfx::RAY_PACKET_SIZE, rays.size() - first_ray) };
+        const gfx::RayPacket packet{ std::span{ rays }.subspan(first_ray, ray_count) };
+        const gfx::PacketIntersections packet_intersections{ scene.getAllPacketIntersections(packet) };
+
+        for (size_t lane = 0; lane < ray_count; ++lane) {
+            const std::vector<gfx::Intersection> intersections_expected{
+                scene.getAllIntersections(rays[first_ray + lane]) };
+
+            ASSERT_EQ(packet_intersections[lane].size(), intersections_expected.size());
+            for (size_t i = 0; i < intersections_expected.size(); ++i) {
+                EXPECT_EQ(packet_intersections[lane].at(i), intersections_expected.at(i));
+            }
+        }
+        for (size_t lane = ray_count; lane < gfx::RAY_PACKET_SIZE; ++lane) {
+            EXPECT_TRUE(packet_intersections[lane].empty());
+        }
+    }
+}
+
+// Tests that moving an instance only rebuilds the top level, leaving the shared assets untouched
+TEST(GraphicsInstancedScene, SetInstanceTransform)
+{
+    const gfx::Matrix4 moved_group_transform{ gfx::createTranslationMatrix(-3, 1, 2) *
+                                              gfx::createZRotationMatrix(std::numbers::pi / 4) };
+    gfx::InstancedScene scene{ createInstancedWorld(gfx::createTranslationMatrix(4, 2, 0)) };
+    const gfx::InstancedScene original_scene{ scene };
+    const gfx::CompiledScene scene_expected{ createInstancedWorld(moved_group_transform) };
+
+    scene.setInstanceTransform(5, moved_group_transform);
+
+    ASSERT_EQ(scene.getAssetCount(), original_scene.getAssetCount());
+    for (size_t i = 0; i < scene.getAssetCount(); ++i) {
+        EXPECT_EQ(&scene.getAssetAt(i), &original_scene.getAssetAt(i));
+    }
+
+    const std::vector<gfx::Ray> rays{
+        gfx::Ray{ -3, 1, -5, 0, 0, 1 },
+        gfx::Ray{ -4, 0.5, -5, 0, 0, 1 },
+        gfx::Ray{ 5, 1.5, -5, 0, 0, 1 },
+        gfx::Ray{ -2.5, 5, 2, 0, -1, 0 }
+    };
+    for (const gfx::Ray& ray : rays) {
+        const std::vector<gfx::Intersection> intersections_expected{ scene_expected.getAllIntersections(ray) };
+        const std::vector<gfx::Intersection> intersections_actual{ scene.getAllIntersections(ray) };
+
+        ASSERT_EQ(intersections_actual.size(), intersections_expected.size());
+        for (size_t i = 0; i < intersections_expected.size(); ++i) {
+            EXPECT_FLOAT_EQ(intersections_actual.at(i).getT(), intersections_expected.at(i).getT());
+        }
+    }
+
+    // Copies of the scene keep their own instances
+    EXPECT_EQ(original_scene.getInstanceAt(5).transform.getMatrix(), gfx::createTranslationMatrix(4, 2, 0));
+    EXPECT_FALSE(original_scene.getAllIntersections(gfx::Ray{ 5, 1.5, -5, 0, 0, 1 }).empty());
+    EXPECT_TRUE(scene.getAllIntersections(gfx::Ray{ 5, 1.5, -5, 0, 0, 1 }).empty());
+    EXPECT_THROW(scene.setInstanceTransform(6, gfx::createIdentityMatrix()), std::out_of_range);
+}
\ No newline at end of file
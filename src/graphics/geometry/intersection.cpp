@@ -5,13 +5,37 @@
 namespace gfx {
     bool Intersection::operator==(const Intersection& rhs) const
     {
-        return utils::areEqual(m_t, rhs.getT()) && m_object_ptr == &rhs.getObject();
+        return
+                utils::areEqual(m_t, rhs.getT()) &&
+                m_object_ptr == &rhs.getObject() &&
+                m_instance_transform_ptr == rhs.getInstanceTransform();
+    }
+
+    Vector4 Intersection::getSurfaceNormalAt(const Vector4& world_point) const
+    {
+        if (!m_instance_transform_ptr) {
+            return m_object_ptr->getSurfaceNormalAt(world_point);
+        }
+
+        // Shared surfaces are positioned within their instance, so the point is moved into the space of the instance
+        // and the normal is moved back out of it
+        const Vector4 instance_point{ m_instance_transform_ptr->applyInverse(world_point) };
+        return normalize(m_instance_transform_ptr->applyToNormal(m_object_ptr->getSurfaceNormalAt(instance_point)));
+    }
+
+    Color Intersection::getObjectColorAt(const Vector4& world_point) const
+    {
+        if (!m_instance_transform_ptr) {
+            return m_object_ptr->getObjectColorAt(world_point);
+        }
+
+        return m_object_ptr->getObjectColorAt(m_instance_transform_ptr->applyInverse(world_point));
     }
 
     DetailedIntersection::DetailedIntersection(const Intersection& intersection, const Ray& ray)
             : Intersection(intersection),
               m_intersection_position{ ray.position(intersection.getT()) },
-              m_surface_normal{ intersection.getObject().getSurfaceNormalAt(m_intersection_position) },
+              m_surface_normal{ intersection.getSurfaceNormalAt(m_intersection_position) },
               m_view_vector{ -ray.getDirection() },
               m_reflection_vector{ },
               m_over_point{ },
@@ -34,6 +58,21 @@ namespace gfx {
         m_under_point = m_intersection_position - m_surface_normal * utils::EPSILON;
     }
 
+    DetailedIntersection::DetailedIntersection(const Intersection& intersection,
+                                               const Vector4& intersection_position,
+                                               const Vector4& surface_normal,
+                                               const Vector4& view_vector,
+                                               const bool is_inside_object)
+            : Intersection(intersection),
+              m_intersection_position{ intersection_position },
+              m_surface_normal{ surface_normal },
+              m_view_vector{ view_vector },
+              m_reflection_vector{ (-view_vector).reflect(surface_normal) },
+              m_over_point{ intersection_position + surface_normal * utils::EPSILON },
+              m_under_point{ intersection_position - surface_normal * utils::EPSILON },
+              m_is_inside_object{ is_inside_object }
+    {}
+
     std::optional<Intersection> getHit(std::vector<Intersection> intersections)
     {
         auto hit_iter = std::lower_bound(
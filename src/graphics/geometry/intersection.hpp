@@ -22,6 +22,11 @@ namespace gfx {
                 : m_t{ t }, m_object_ptr{ object_ptr }
         {}
 
+        // Instanced Constructor, for surfaces shared between instances which are positioned by the instance transform
+        Intersection(const double t, const Surface* object_ptr, const ClassifiedTransform* instance_transform_ptr)
+                : m_t{ t }, m_object_ptr{ object_ptr }, m_instance_transform_ptr{ instance_transform_ptr }
+        {}
+
         Intersection(const Intersection&) = default;
         Intersection(Intersection&&) = default;
 
@@ -42,6 +47,20 @@ namespace gfx {
         [[nodiscard]] const Surface& getObject() const
         { return *m_object_ptr; }
 
+        [[nodiscard]] bool isInstanced() const
+        { return m_instance_transform_ptr != nullptr; }
+
+        [[nodiscard]] const ClassifiedTransform* getInstanceTransform() const
+        { return m_instance_transform_ptr; }
+
+        /* Shading Operations */
+
+        // Returns the surface normal of the intersected surface at a world-space point
+        [[nodiscard]] Vector4 getSurfaceNormalAt(const Vector4& world_point) const;
+
+        // Returns the color of the intersected surface at a world-space point
+        [[nodiscard]] Color getObjectColorAt(const Vector4& world_point) const;
+
         /* Comparison Operator Overloads */
 
         [[nodiscard]] bool operator==(const Intersection& rhs) const;
@@ -57,6 +76,8 @@ namespace gfx {
 
         double m_t;
         const Surface* m_object_ptr;   // Shapes should always exist during the lifetime of the intersection
+        const ClassifiedTransform* m_instance_transform_ptr{ nullptr };    // Set when the surface was hit through
+                                                                            // an instance of a shared asset
     };
 
     // An extension of the intersection class containing pre-computed state information
@@ -68,6 +89,15 @@ namespace gfx {
 
         DetailedIntersection() = delete;
         DetailedIntersection(const Intersection& intersection, const Ray& ray);
+
+        // Restored Constructor, for an intersection whose pre-computed state was saved when it was first found. The
+        // surface normal must already face the viewer.
+        DetailedIntersection(const Intersection& intersection,
+                             const Vector4& intersection_position,
+                             const Vector4& surface_normal,
+                             const Vector4& view_vector,
+                             bool is_inside_object);
+
         DetailedIntersection(const DetailedIntersection&) = default;
         DetailedIntersection(DetailedIntersection&&) = default;
 
@@ -4,6 +4,8 @@
 #include "gtest/gtest.h"
 #include "intersection.hpp"
 
+#include <cmath>
+
 #include "sphere.hpp"
 #include "transform.hpp"
 #include "util_functions.hpp"
@@ -66,6 +68,24 @@ TEST(GraphicsIntersection, InequalityOperator)
     ASSERT_TRUE(intersection_a != intersection_b);
 }
 
+// Tests shading a surface shared between instances where the instance transform places it
+TEST(GraphicsIntersection, InstancedSurface)
+{
+    const gfx::Sphere sphere{ gfx::createScalingMatrix(2, 1, 1) };
+    const gfx::ClassifiedTransform instance_transform{ gfx::createTranslationMatrix(5, 0, 0) *
+                                                       gfx::createZRotationMatrix(M_PI / 2) };
+    const gfx::Intersection intersection{ 1.0, &sphere, &instance_transform };
+    const gfx::Sphere sphere_expected{ instance_transform.getMatrix() * sphere.getTransform() };
+
+    ASSERT_TRUE(intersection.isInstanced());
+    EXPECT_EQ(intersection.getInstanceTransform(), &instance_transform);
+    EXPECT_TRUE(intersection != (gfx::Intersection{ 1.0, &sphere }));
+
+    const gfx::Vector4 point{ gfx::createPoint(5 - std::sqrt(0.5), std::sqrt(2), 0) };
+    EXPECT_EQ(intersection.getSurfaceNormalAt(point), sphere_expected.getSurfaceNormalAt(point));
+    EXPECT_EQ(intersection.getObjectColorAt(point), sphere_expected.getObjectColorAt(point));
+}
+
 // Tests the standard constructor for detailed intersections (when the intersection is outside the object)
 TEST(GraphicsIntersection, DetailedStandardConstructorOutside)
 {
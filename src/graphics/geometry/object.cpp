@@ -1,12 +1,22 @@
 #include "object.hpp"
 
+#include <algorithm>
+
 #include "intersection.hpp"
 #include "composite_surface.hpp"
+#include "primitive_geometry.hpp"
 
 namespace gfx {
     BoundingBox Object::getLocalSpaceBounds() const
     {
-        return this->getBounds().transform(this->m_transform);
+        return this->getBounds().transform(m_transform.getMatrix());
+    }
+
+
+    void Object::setTransform(const Matrix4& transform_matrix)
+    {
+        m_transform = ClassifiedTransform{ transform_matrix };
+        this->refitParentBounds();
     }
 
 
@@ -21,13 +31,49 @@ namespace gfx {
 
     std::vector<Intersection> Object::getObjectIntersections(const Ray& ray) const
     {
+        // Objects without a transform can intersect the ray as-is
+        if (m_transform.getType() == TransformType::Identity)
+            return this->calculateIntersections(ray);
+
         // Transform the ray to object space
-        const Ray transformed_ray{ ray.transform(m_transform_inverse) };
+        const Ray transformed_ray{ ray.inverseTransform(m_transform) };
 
         // Calculate the intersections for this object and return
         return this->calculateIntersections(transformed_ray);
     }
 
+    std::vector<Intersection> Object::getObjectSpaceIntersections(const Ray& object_space_ray) const
+    {
+        return this->calculateIntersections(object_space_ray);
+    }
+
+
+    bool Object::isHitWithin(const Ray& ray, const double distance) const
+    {
+        // Transforming a ray keeps the distances along it, so the object can be tested against the same range
+        if (m_transform.getType() == TransformType::Identity)
+            return this->isObjectSpaceHitWithin(ray, distance);
+
+        return this->isObjectSpaceHitWithin(ray.inverseTransform(m_transform), distance);
+    }
+
+
+    bool Object::isObjectSpaceHitWithin(const Ray& transformed_ray, const double distance) const
+    {
+        const std::vector<Intersection> intersections{ this->calculateIntersections(transformed_ray) };
+        return std::ranges::any_of(intersections, [&](const Intersection& intersection) {
+            return isInOcclusionRange(intersection.getT(), distance);
+        });
+    }
+
+
+    void Object::refitParentBounds() const
+    {
+        if (m_parent) {
+            m_parent->refitBounds();
+        }
+    }
+
 
     Vector4 Object::transformToObjectSpace(const Vector4& point) const
     {
@@ -38,18 +84,14 @@ namespace gfx {
         }
 
         // Transform the point to object space and return
-        return m_transform_inverse * transformed_point;
+        return m_transform.applyInverse(transformed_point);
     }
 
 
     Vector4 Object::transformNormalToWorldSpace(const Vector4& local_normal) const
     {
         // Transform the normal vector from local space to world space
-        Vector4 world_normal{ m_transform_inverse.transpose() * local_normal };
-
-        // Reset the w-value in case the shape's transformation matrix included a translation
-        world_normal.resetW();
-        world_normal = normalize(world_normal);
+        Vector4 world_normal{ normalize(m_transform.applyToNormal(local_normal)) };
 
         // Recursively transform the normal through any parent object spaces in the tree
         if (m_parent) {
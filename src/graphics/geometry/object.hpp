@@ -3,6 +3,7 @@
 #include "matrix4.hpp"
 #include "vector4.hpp"
 #include "bounding_box.hpp"
+#include "transform.hpp"
 
 namespace gfx {
     /* Forward Declarations */
@@ -21,7 +22,6 @@ namespace gfx {
         // Standard Constructor
         explicit Object(const Matrix4& transform_matrix)
                 : m_transform{ transform_matrix },
-                  m_transform_inverse{ transform_matrix.inverse() },
                   m_parent{ nullptr }
         {}
 
@@ -39,7 +39,11 @@ namespace gfx {
         /* Accessors */
 
         [[nodiscard]] const Matrix4& getTransform() const
-        { return m_transform; }
+        { return m_transform.getMatrix(); }
+
+        // Returns the category of this object's transform, which determines how rays and normals are transformed
+        [[nodiscard]] TransformType getTransformType() const
+        { return m_transform.getType(); }
 
         [[nodiscard]] bool hasParent() const
         { return m_parent != nullptr; }
@@ -55,11 +59,8 @@ namespace gfx {
 
         /* Mutators */
 
-        void setTransform(const Matrix4& transform_matrix)
-        {
-            m_transform = transform_matrix;
-            m_transform_inverse = transform_matrix.inverse();
-        }
+        // Sets the transform, then refits the bounds of each enclosing group which no longer encloses this object
+        void setTransform(const Matrix4& transform_matrix);
 
         void setParent(CompositeSurface* const parent_group_ptr)
         { m_parent = parent_group_ptr; }
@@ -78,16 +79,27 @@ namespace gfx {
         // the passed-in ray intersects with this object
         [[nodiscard]] std::vector<Intersection> getObjectIntersections(const Ray& ray) const;
 
+        // Returns the intersections for a ray which has already been transformed into this object's space
+        [[nodiscard]] std::vector<Intersection> getObjectSpaceIntersections(const Ray& object_space_ray) const;
+
+        // Returns true if the passed-in ray intersects this object in the range [0, distance), without gathering the
+        // intersections where possible
+        [[nodiscard]] bool isHitWithin(const Ray& ray, double distance) const;
+
     private:
         /* Data Members */
 
-        Matrix4 m_transform{ gfx::createIdentityMatrix() };
-        Matrix4 m_transform_inverse{ gfx::createIdentityMatrix() };
+        // The transform is classified whenever it is set, so that the per-ray and per-normal transforms can skip
+        // the full matrix products for identity, translation, and uniform scaling transforms
+        ClassifiedTransform m_transform{ };
         CompositeSurface* m_parent{ nullptr };
 
         /* Helper Methods */
 
     protected:
+        // Refits the bounds of the group containing this object, if any, after this object's local space bounds change
+        void refitParentBounds() const;
+
         // Recursively transforms a point from its current space to the local space for this object,
         // ensuring transformations for each parent object are applied
         [[nodiscard]] Vector4 transformToObjectSpace(const Vector4& point) const;
@@ -97,6 +109,11 @@ namespace gfx {
         [[nodiscard]] Vector4 transformNormalToWorldSpace(const Vector4& local_normal) const;
 
     private:
+        /* Virtual Helper Methods */
+
+        // Checks for a hit with a ray already transformed into this object's space, by default from its intersections
+        [[nodiscard]] virtual bool isObjectSpaceHitWithin(const Ray& transformed_ray, double distance) const;
+
         /* Pure Virtual Helper Methods */
 
         [[nodiscard]] virtual std::vector<Intersection> calculateIntersections(const Ray& transformed_ray) const = 0;
@@ -15,4 +15,14 @@ namespace gfx {
         return Ray{ transform_matrix * m_origin,
                     transform_matrix * m_direction };
     }
+
+    // Inverse Transform Ray (Classified Transform)
+    Ray Ray::inverseTransform(const ClassifiedTransform& transform) const
+    {
+        if (transform.getType() == TransformType::GeneralAffine)
+            return this->transform(transform.getInverse());
+
+        return Ray{ transform.applyInverse(m_origin),
+                    transform.applyInverse(m_direction) };
+    }
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 
 #include "vector4.hpp"
 #include "matrix4.hpp"
+#include "transform.hpp"
 
 namespace gfx {
     class Ray
@@ -53,6 +54,10 @@ namespace gfx {
         // Returns a ray transformed by multiplying it with a passed-in transformation matrix
         [[nodiscard]] Ray transform(const Matrix4& transform_matrix) const;
 
+        // Returns a ray transformed by the inverse of a classified transform, skipping the matrix products
+        // whenever the transform type allows it
+        [[nodiscard]] Ray inverseTransform(const ClassifiedTransform& transform) const;
+
     private:
         /* Data Members */
         Vector4 m_origin{ 0.0, 0.0, 0.0, 1.0 };
@@ -0,0 +1,142 @@
+#include "ray_packet.hpp"
+
+#include <algorithm>
+
+namespace gfx {
+    // Ray List Constructor
+    RayPacket::RayPacket(const std::span<const Ray> rays)
+    {
+        const size_t lane_count{ std::min(rays.size(), RAY_PACKET_SIZE) };
+        for (size_t lane = 0; lane < lane_count; ++lane) {
+            this->setRayAt(lane, rays[lane]);
+        }
+    }
+
+    // Single Lane Accessor
+    Ray RayPacket::getRayAt(const size_t lane) const
+    {
+        return Ray{ origin_x[lane], origin_y[lane], origin_z[lane],
+                    direction_x[lane], direction_y[lane], direction_z[lane] };
+    }
+
+    // Single Lane Mutator
+    void RayPacket::setRayAt(const size_t lane, const Ray& ray)
+    {
+        origin_x[lane] = ray.getOrigin().x();
+        origin_y[lane] = ray.getOrigin().y();
+        origin_z[lane] = ray.getOrigin().z();
+        direction_x[lane] = ray.getDirection().x();
+        direction_y[lane] = ray.getDirection().y();
+        direction_z[lane] = ray.getDirection().z();
+        active_lanes |= 1u << lane;
+    }
+
+    // Returns one row of a matrix applied to the lanes of a point or vector with the given w-value, in the same order
+    // as the single-ray matrix-vector product. The lanes are worked on a pair at a time, so that each matrix entry is
+    // broadcast into a single register rather than spilled to the stack for a whole packet.
+    static PacketDouble transformLanes(const Matrix4& matrix,
+                                       const size_t row,
+                                       const PacketDouble& x,
+                                       const PacketDouble& y,
+                                       const PacketDouble& z,
+                                       const double w)
+    {
+        using PacketPairs = std::array<PacketPairDouble, RAY_PACKET_SIZE / 2>;
+        const auto x_pairs{ std::bit_cast<PacketPairs>(x) };
+        const auto y_pairs{ std::bit_cast<PacketPairs>(y) };
+        const auto z_pairs{ std::bit_cast<PacketPairs>(z) };
+        PacketPairs transformed_pairs{ };
+        for (size_t pair = 0; pair < transformed_pairs.size(); ++pair) {
+            transformed_pairs[pair] = matrix[row, 0] * x_pairs[pair] + matrix[row, 1] * y_pairs[pair] +
+                                      matrix[row, 2] * z_pairs[pair] + matrix[row, 3] * w;
+        }
+
+        return std::bit_cast<PacketDouble>(transformed_pairs);
+    }
+
+    // Inverse Transform Packet (Classified Transform)
+    RayPacket RayPacket::inverseTransform(const ClassifiedTransform& transform) const
+    {
+        RayPacket transformed_packet{ *this };
+
+        // Each expression mirrors the single-ray transforms exactly (including the products with the w-values),
+        // so that packet and single-ray tracing produce identical results
+        switch (transform.getType()) {
+            case TransformType::Identity:
+                break;
+            case TransformType::Translation: {
+                const Vector4 translation{ transform.getMatrix()[0, 3],
+                                           transform.getMatrix()[1, 3],
+                                           transform.getMatrix()[2, 3], 0 };
+                transformed_packet.origin_x = origin_x - translation.x() * 1.0;
+                transformed_packet.origin_y = origin_y - translation.y() * 1.0;
+                transformed_packet.origin_z = origin_z - translation.z() * 1.0;
+                transformed_packet.direction_x = direction_x - translation.x() * 0.0;
+                transformed_packet.direction_y = direction_y - translation.y() * 0.0;
+                transformed_packet.direction_z = direction_z - translation.z() * 0.0;
+                break;
+            }
+            case TransformType::UniformScale: {
+                const Vector4 translation{ transform.getMatrix()[0, 3],
+                                           transform.getMatrix()[1, 3],
+                                           transform.getMatrix()[2, 3], 0 };
+                const double scale{ transform.getMatrix()[0, 0] };
+                transformed_packet.origin_x = (origin_x - translation.x() * 1.0) / scale;
+                transformed_packet.origin_y = (origin_y - translation.y() * 1.0) / scale;
+                transformed_packet.origin_z = (origin_z - translation.z() * 1.0) / scale;
+                transformed_packet.direction_x = (direction_x - translation.x() * 0.0) / scale;
+                transformed_packet.direction_y = (direction_y - translation.y() * 0.0) / scale;
+                transformed_packet.direction_z = (direction_z - translation.z() * 0.0) / scale;
+                break;
+            }
+            case TransformType::GeneralAffine: {
+                const Matrix4& inverse{ transform.getInverse() };
+                transformed_packet.origin_x = transformLanes(inverse, 0, origin_x, origin_y, origin_z, 1.0);
+                transformed_packet.origin_y = transformLanes(inverse, 1, origin_x, origin_y, origin_z, 1.0);
+                transformed_packet.origin_z = transformLanes(inverse, 2, origin_x, origin_y, origin_z, 1.0);
+                transformed_packet.direction_x = transformLanes(inverse, 0, direction_x, direction_y, direction_z, 0.0);
+                transformed_packet.direction_y = transformLanes(inverse, 1, direction_x, direction_y, direction_z, 0.0);
+                transformed_packet.direction_z = transformLanes(inverse, 2, direction_x, direction_y, direction_z, 0.0);
+                break;
+            }
+        }
+
+        return transformed_packet;
+    }
+
+    // Packet-Box Intersection Distances
+    std::pair<PacketDouble, PacketDouble>
+    calculateBoxIntersectionTs(const RayPacket& packet, const Vector4& box_min_extent, const Vector4& box_max_extent)
+    {
+        // Slab test for a single axis on every lane, matching the single-ray getAxisIntersectionTs
+        const auto calculate_axis_ts{ [](const PacketDouble& origin, const PacketDouble& direction,
+                                         const double min_extent, const double max_extent) {
+            const PacketDouble near_t{ (min_extent - origin) / direction };
+            const PacketDouble far_t{ (max_extent - origin) / direction };
+            const PacketMask is_swapped{ areLanesGreater(near_t, far_t) };
+            return std::pair<PacketDouble, PacketDouble>{ selectLanes(is_swapped, far_t, near_t),
+                                                          selectLanes(is_swapped, near_t, far_t) };
+        } };
+
+        const auto [ x_t_min, x_t_max ] { calculate_axis_ts(packet.origin_x, packet.direction_x,
+                                                            box_min_extent.x(), box_max_extent.x()) };
+        const auto [ y_t_min, y_t_max ] { calculate_axis_ts(packet.origin_y, packet.direction_y,
+                                                            box_min_extent.y(), box_max_extent.y()) };
+        const auto [ z_t_min, z_t_max ] { calculate_axis_ts(packet.origin_z, packet.direction_z,
+                                                            box_min_extent.z(), box_max_extent.z()) };
+
+        return { calculateLaneMax(calculateLaneMax(x_t_min, y_t_min), z_t_min),
+                 calculateLaneMin(calculateLaneMin(x_t_max, y_t_max), z_t_max) };
+    }
+
+    // Packet-Box Intersection Test
+    uint32_t calculateBoxHitLanes(const RayPacket& packet,
+                                  const uint32_t lanes,
+                                  const Vector4& box_min_extent,
+                                  const Vector4& box_max_extent)
+    {
+        const auto [ t_min, t_max ] { calculateBoxIntersectionTs(packet, box_min_extent, box_max_extent) };
+
+        return getMaskLanes(areLanesLessOrEqual(t_min, t_max)) & lanes;
+    }
+}
\ No newline at end of file
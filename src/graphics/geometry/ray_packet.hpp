@@ -0,0 +1,190 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "ray.hpp"
+#include "transform.hpp"
+#include "util_functions.hpp"
+
+namespace gfx {
+    class Intersection;
+
+    // The number of rays traced together in a single packet
+    inline constexpr size_t RAY_PACKET_SIZE{ 4 };
+
+    // Holds one list of intersections per lane of a ray packet
+    using PacketIntersections = std::array<std::vector<Intersection>, RAY_PACKET_SIZE>;
+
+    // A value for each lane of a ray packet. Arithmetic on this vector type compiles to SIMD instructions, one for
+    // each pair of lanes on the baseline SSE2 and NEON targets (or one for the whole packet where AVX is enabled).
+    using PacketDouble = double __attribute__((vector_size(RAY_PACKET_SIZE * sizeof(double))));
+
+    // The result of comparing two packet values, with every bit of a lane set where the comparison holds
+    using PacketMask = decltype(PacketDouble{ } < PacketDouble{ });
+
+    // A pair of lanes, filling one 128-bit register. Packet values are compared a pair of lanes at a time, since
+    // compilers split comparisons wider than a register into a scalar comparison per lane.
+    using PacketPairDouble = double __attribute__((vector_size(2 * sizeof(double))));
+    using PacketPairMask = decltype(PacketPairDouble{ } < PacketPairDouble{ });
+
+    // A bundle of coherent rays stored in structure-of-arrays form, so that the packet kernels can operate on the
+    // lanes with SIMD arithmetic. All origins are points (w = 1) and all directions are vectors (w = 0).
+    struct RayPacket
+    {
+        /* Constructors */
+
+        // Default Constructor (No Active Lanes)
+        RayPacket() = default;
+
+        // Ray List Constructor, up to RAY_PACKET_SIZE rays fill the lanes in order and the remaining lanes are inactive
+        explicit RayPacket(std::span<const Ray> rays);
+
+        /* Data Members */
+
+        PacketDouble origin_x{ };
+        PacketDouble origin_y{ };
+        PacketDouble origin_z{ };
+        PacketDouble direction_x{ };
+        PacketDouble direction_y{ };
+        PacketDouble direction_z{ };
+        uint32_t active_lanes{ 0 };      // Bit mask with one bit set for each lane holding a ray
+
+        /* Accessors */
+
+        [[nodiscard]] bool isLaneActive(const size_t lane) const
+        { return (active_lanes >> lane) & 1u; }
+
+        // Returns the ray held in a single lane of the packet
+        [[nodiscard]] Ray getRayAt(size_t lane) const;
+
+        /* Mutators */
+
+        // Stores a ray in a single lane of the packet and marks the lane as active
+        void setRayAt(size_t lane, const Ray& ray);
+
+        /* Ray-Tracing Operations */
+
+        // Returns a packet with every lane transformed by the inverse of a classified transform, producing the same
+        // values as transforming each ray individually
+        [[nodiscard]] RayPacket inverseTransform(const ClassifiedTransform& transform) const;
+    };
+
+    /* Packet Lane Functions */
+
+    // These mirror the scalar functions of the same purpose lane by lane, including their tolerances and their
+    // handling of infinities and NaNs, so that packet kernels make the same decisions as single-ray kernels
+
+    // Returns the bit mask of the lanes where a comparison holds
+    [[nodiscard]] inline uint32_t getMaskLanes(const PacketMask& mask)
+    {
+        uint32_t lanes{ 0 };
+        for (size_t lane = 0; lane < RAY_PACKET_SIZE; ++lane) {
+            lanes |= static_cast<uint32_t>(mask[lane] != 0) << lane;
+        }
+
+        return lanes;
+    }
+
+    // Returns the lanes where a comparison, such as std::less<>, holds between two packet values
+    template <typename Comparison>
+    [[nodiscard]] inline PacketMask compareLanes(const PacketDouble& lhs,
+                                                 const PacketDouble& rhs,
+                                                 const Comparison comparison)
+    {
+        using PacketPairs = std::array<PacketPairDouble, RAY_PACKET_SIZE / 2>;
+        const auto lhs_pairs{ std::bit_cast<PacketPairs>(lhs) };
+        const auto rhs_pairs{ std::bit_cast<PacketPairs>(rhs) };
+        std::array<PacketPairMask, RAY_PACKET_SIZE / 2> pair_masks{ };
+        for (size_t pair = 0; pair < pair_masks.size(); ++pair) {
+            pair_masks[pair] = comparison(lhs_pairs[pair], rhs_pairs[pair]);
+        }
+
+        return std::bit_cast<PacketMask>(pair_masks);
+    }
+
+    // Returns the lanes of the first value where a mask is set, and the lanes of the second value elsewhere
+    [[nodiscard]] inline PacketDouble selectLanes(const PacketMask& mask,
+                                                  const PacketDouble& set_values,
+                                                  const PacketDouble& clear_values)
+    {
+        return std::bit_cast<PacketDouble>((std::bit_cast<PacketMask>(set_values) & mask) |
+                                           (std::bit_cast<PacketMask>(clear_values) & ~mask));
+    }
+
+    // Returns the absolute value of each lane, by clearing its sign bit
+    [[nodiscard]] inline PacketDouble calculateLaneAbs(const PacketDouble& values)
+    {
+        return std::bit_cast<PacketDouble>(std::bit_cast<PacketMask>(values) & std::numeric_limits<int64_t>::max());
+    }
+
+    // Returns the larger value of each pair of lanes like std::fmax, ignoring a NaN in either of them
+    [[nodiscard]] inline PacketDouble calculateLaneMax(const PacketDouble& lhs, const PacketDouble& rhs)
+    {
+        const PacketDouble ordered_rhs{ selectLanes(compareLanes(rhs, rhs, std::equal_to{ }), rhs, lhs) };
+        return selectLanes(compareLanes(lhs, ordered_rhs, std::greater{ }), lhs, ordered_rhs);
+    }
+
+    // Returns the smaller value of each pair of lanes like std::fmin, ignoring a NaN in either of them
+    [[nodiscard]] inline PacketDouble calculateLaneMin(const PacketDouble& lhs, const PacketDouble& rhs)
+    {
+        const PacketDouble ordered_rhs{ selectLanes(compareLanes(rhs, rhs, std::equal_to{ }), rhs, lhs) };
+        return selectLanes(compareLanes(lhs, ordered_rhs, std::less{ }), lhs, ordered_rhs);
+    }
+
+    // Returns the lanes which are equal within the relative tolerance of utils::areEqual(). Its two tolerances are
+    // folded into one by scaling the absolute tolerance by the larger magnitude only where that magnitude exceeds 1,
+    // and capping the scale so that an infinity is only ever equal to itself.
+    [[nodiscard]] inline PacketMask areLanesEqual(const PacketDouble& lhs, const PacketDouble& rhs)
+    {
+        const PacketDouble one{ PacketDouble{ } + 1.0 };
+        const PacketDouble largest{ PacketDouble{ } + std::numeric_limits<double>::max() };
+        const PacketDouble lhs_abs{ calculateLaneAbs(lhs) };
+        const PacketDouble rhs_abs{ calculateLaneAbs(rhs) };
+        const PacketDouble larger_abs{ selectLanes(compareLanes(lhs_abs, rhs_abs, std::greater{ }), lhs_abs, rhs_abs) };
+        const PacketDouble tolerance_scale{
+            selectLanes(compareLanes(larger_abs, one, std::less{ }), one,
+                        selectLanes(compareLanes(larger_abs, largest, std::greater{ }), largest, larger_abs)) };
+
+        return compareLanes(lhs, rhs, std::equal_to{ }) |
+               compareLanes(calculateLaneAbs(lhs - rhs), tolerance_scale * utils::EPSILON, std::less_equal{ });
+    }
+
+    // Returns the lanes where the left value is less than the right value, as decided by utils::isLess()
+    [[nodiscard]] inline PacketMask areLanesLess(const PacketDouble& lhs, const PacketDouble& rhs)
+    {
+        return ~areLanesEqual(lhs, rhs) & compareLanes(lhs, rhs, std::less{ });
+    }
+
+    // Returns the lanes where the left value is at most the right value, as decided by utils::isLessOrEqual()
+    [[nodiscard]] inline PacketMask areLanesLessOrEqual(const PacketDouble& lhs, const PacketDouble& rhs)
+    {
+        return areLanesEqual(lhs, rhs) | compareLanes(lhs, rhs, std::less{ });
+    }
+
+    // Returns the lanes where the left value is greater than the right value, as decided by utils::isGreater()
+    [[nodiscard]] inline PacketMask areLanesGreater(const PacketDouble& lhs, const PacketDouble& rhs)
+    {
+        return ~areLanesEqual(lhs, rhs) & compareLanes(lhs, rhs, std::greater{ });
+    }
+
+    /* Ray Packet Utility Functions */
+
+    // Returns the per-lane distances at which the rays of a packet enter and exit an axis-aligned box
+    [[nodiscard]] std::pair<PacketDouble, PacketDouble>
+    calculateBoxIntersectionTs(const RayPacket& packet, const Vector4& box_min_extent, const Vector4& box_max_extent);
+
+    // Returns the subset of the passed-in lanes of a packet which intersect an axis-aligned box anywhere along
+    // their lines, using the same tolerances as the single-ray bounding box test
+    [[nodiscard]] uint32_t calculateBoxHitLanes(const RayPacket& packet,
+                                                uint32_t lanes,
+                                                const Vector4& box_min_extent,
+                                                const Vector4& box_max_extent);
+}
\ No newline at end of file
@@ -0,0 +1,134 @@
+#include "gtest/gtest.h"
+#include "ray_packet.hpp"
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <utility>
+
+#include "ray.hpp"
+#include "transform.hpp"
+#include "util_functions.hpp"
+
+// Tests the default constructor
+TEST(GraphicsRayPacket, DefaultConstructor)
+{
+    const gfx::RayPacket packet{ };
+
+    EXPECT_EQ(packet.active_lanes, 0);
+    for (size_t lane = 0; lane < gfx::RAY_PACKET_SIZE; ++lane) {
+        EXPECT_FALSE(packet.isLaneActive(lane));
+    }
+}
+
+// Tests the ray list constructor
+TEST(GraphicsRayPacket, RayListConstructor)
+{
+    const std::array<gfx::Ray, 3> rays{ gfx::Ray{ 1, 2, 3, 0, 0, 1 },
+                                        gfx::Ray{ 4, 5, 6, 0, 1, 0 },
+                                        gfx::Ray{ 7, 8, 9, 1, 0, 0 } };
+    const gfx::RayPacket packet{ rays };
+
+    EXPECT_EQ(packet.active_lanes, 0b0111);
+    EXPECT_FALSE(packet.isLaneActive(3));
+    for (size_t lane = 0; lane < rays.size(); ++lane) {
+        EXPECT_TRUE(packet.isLaneActive(lane));
+        EXPECT_EQ(packet.getRayAt(lane), rays[lane]);
+    }
+}
+
+// Tests setting the ray in a single lane
+TEST(GraphicsRayPacket, SetRayAt)
+{
+    gfx::RayPacket packet{ };
+    const gfx::Ray ray{ 1, 2, 3, 0, 1, 0 };
+
+    packet.setRayAt(2, ray);
+
+    EXPECT_EQ(packet.active_lanes, 0b0100);
+    EXPECT_EQ(packet.getRayAt(2), ray);
+}
+
+// Tests that transforming a packet matches transforming each of its rays individually
+TEST(GraphicsRayPacket, InverseTransform)
+{
+    const std::array<gfx::Ray, 4> rays{ gfx::Ray{ 1, 2, 3, 0, 0, 1 },
+                                        gfx::Ray{ -4, 5, -6, 0.6, 0.8, 0 },
+                                        gfx::Ray{ 7, -8, 9, 1, 0, 0 },
+                                        gfx::Ray{ 0, 0, -5, 0, -0.6, 0.8 } };
+    const gfx::RayPacket packet{ rays };
+    const std::array<gfx::ClassifiedTransform, 4> transforms{
+        gfx::ClassifiedTransform{ gfx::createIdentityMatrix() },
+        gfx::ClassifiedTransform{ gfx::createTranslationMatrix(1, -2, 3) },
+        gfx::ClassifiedTransform{ gfx::createTranslationMatrix(1, -2, 3) * gfx::createScalingMatrix(-2) },
+        gfx::ClassifiedTransform{ gfx::createXRotationMatrix(std::numbers::pi / 3) *
+                                  gfx::createScalingMatrix(1, 2, 3) }
+    };
+
+    for (const gfx::ClassifiedTransform& transform : transforms) {
+        const gfx::RayPacket transformed_packet{ packet.inverseTransform(transform) };
+        for (size_t lane = 0; lane < rays.size(); ++lane) {
+            EXPECT_EQ(transformed_packet.getRayAt(lane), rays[lane].inverseTransform(transform));
+        }
+    }
+}
+
+// Tests finding the lanes of a packet which intersect a box
+TEST(GraphicsRayPacket, CalculateBoxHitLanes)
+{
+    const std::array<gfx::Ray, 4> rays{ gfx::Ray{ 0, 0, -5, 0, 0, 1 },
+                                        gfx::Ray{ 0, 2, -5, 0, 0, 1 },
+                                        gfx::Ray{ 0, 0, 5, 0, 0, 1 },
+                                        gfx::Ray{ -5, 0.5, 0, 1, 0, 0 } };
+    const gfx::RayPacket packet{ rays };
+    const gfx::Vector4 box_min{ gfx::createPoint(-1, -1, -1) };
+    const gfx::Vector4 box_max{ gfx::createPoint(1, 1, 1) };
+
+    // Lanes hit the box anywhere along their lines, including behind the ray origin
+    EXPECT_EQ(gfx::calculateBoxHitLanes(packet, packet.active_lanes, box_min, box_max), 0b1101);
+
+    // Only the passed-in lanes are tested
+    EXPECT_EQ(gfx::calculateBoxHitLanes(packet, 0b0011, box_min, box_max), 0b0001);
+}
+
+// Tests that the lane comparisons of packet values make the same decisions as the scalar comparisons
+TEST(GraphicsRayPacket, CompareLanes)
+{
+    const double infinity{ std::numeric_limits<double>::infinity() };
+    const double nan{ std::numeric_limits<double>::quiet_NaN() };
+    const std::array<std::pair<double, double>, 8> value_pairs{ std::pair{ 1.0, 1.0 + 1e-7 },
+                                                                std::pair{ 1e9, 1e9 + 1.0 },
+                                                                std::pair{ -2.0, 3.0 },
+                                                                std::pair{ 0.0, -0.0 },
+                                                                std::pair{ infinity, infinity },
+                                                                std::pair{ -infinity, 5.0 },
+                                                                std::pair{ nan, 1.0 },
+                                                                std::pair{ 4.0, nan } };
+
+    for (size_t first_pair = 0; first_pair < value_pairs.size(); first_pair += gfx::RAY_PACKET_SIZE) {
+        gfx::PacketDouble lhs{ };
+        gfx::PacketDouble rhs{ };
+        for (size_t lane = 0; lane < gfx::RAY_PACKET_SIZE; ++lane) {
+            lhs[lane] = value_pairs[first_pair + lane].first;
+            rhs[lane] = value_pairs[first_pair + lane].second;
+        }
+
+        const uint32_t equal_lanes{ gfx::getMaskLanes(gfx::areLanesEqual(lhs, rhs)) };
+        const uint32_t less_lanes{ gfx::getMaskLanes(gfx::areLanesLess(lhs, rhs)) };
+        const uint32_t less_or_equal_lanes{ gfx::getMaskLanes(gfx::areLanesLessOrEqual(lhs, rhs)) };
+        const uint32_t greater_lanes{ gfx::getMaskLanes(gfx::areLanesGreater(lhs, rhs)) };
+        const gfx::PacketDouble max{ gfx::calculateLaneMax(lhs, rhs) };
+        const gfx::PacketDouble min{ gfx::calculateLaneMin(lhs, rhs) };
+        for (size_t lane = 0; lane < gfx::RAY_PACKET_SIZE; ++lane) {
+            const auto [ f1, f2 ] { value_pairs[first_pair + lane] };
+            const auto isLaneSet{ [lane](const uint32_t lanes) { return ((lanes >> lane) & 1u) != 0; } };
+            EXPECT_EQ(isLaneSet(equal_lanes), utils::areEqual(f1, f2));
+            EXPECT_EQ(isLaneSet(less_lanes), utils::isLess(f1, f2));
+            EXPECT_EQ(isLaneSet(less_or_equal_lanes), utils::isLessOrEqual(f1, f2));
+            EXPECT_EQ(isLaneSet(greater_lanes), utils::isGreater(f1, f2));
+            EXPECT_EQ(max[lane], std::fmax(f1, f2));
+            EXPECT_EQ(min[lane], std::fmin(f1, f2));
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,110 @@
+#include "shadow_map.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <tuple>
+
+#include "traceable_scene.hpp"
+#include "ray.hpp"
+#include "intersection.hpp"
+
+namespace gfx {
+    // Each face of the cube map looks along one axis, with the two following axes (in order) across the face
+    static Vector4 calculateFaceDirection(const size_t face, const double s, const double t)
+    {
+        std::array<double, 3> direction{ };
+        const size_t axis{ face / 2 };
+        direction[axis] = face % 2 == 0 ? 1 : -1;
+        direction[(axis + 1) % 3] = s;
+        direction[(axis + 2) % 3] = t;
+        return normalize(createVector(direction[0], direction[1], direction[2]));
+    }
+
+    // Standard Constructor
+    ShadowMap::ShadowMap(const TraceableScene& scene, const Vector4& light_position, const ShadowMapSettings& settings)
+            : m_light_position{ light_position },
+              m_resolution{ std::max<size_t>(settings.resolution, 1) },
+              m_depth_bias{ settings.depth_bias },
+              m_depths(SHADOW_MAP_FACE_COUNT * m_resolution * m_resolution)
+    {
+        const auto resolution{ static_cast<double>(m_resolution) };
+        for (size_t face = 0; face < SHADOW_MAP_FACE_COUNT; ++face) {
+            for (size_t row = 0; row < m_resolution; ++row) {
+                for (size_t column = 0; column < m_resolution; ++column) {
+                    const double s{ 2 * (static_cast<double>(column) + 0.5) / resolution - 1 };
+                    const double t{ 2 * (static_cast<double>(row) + 0.5) / resolution - 1 };
+                    const Ray depth_ray{ m_light_position, calculateFaceDirection(face, s, t) };
+                    const auto possible_hit{ getHit(scene.getAllIntersections(depth_ray)) };
+
+                    m_depths[(face * m_resolution + row) * m_resolution + column] =
+                            possible_hit ?
+                            static_cast<float>(possible_hit.value().getT()) :
+                            std::numeric_limits<float>::infinity();
+                }
+            }
+        }
+    }
+
+    // Shadow Map Lookup
+    ShadowMapResult ShadowMap::lookUp(const Vector4& point) const
+    {
+        const Vector4 light_displacement{ point - m_light_position };
+        const std::array<double, 3> direction{ light_displacement.x(), light_displacement.y(), light_displacement.z() };
+        const double point_depth{ light_displacement.magnitude() };
+
+        // Find the face of the cube the direction passes through, and where on the face it does
+        const auto largest_component{ std::ranges::max_element(direction, { }, [](const double component) {
+            return std::abs(component);
+        }) };
+        const auto axis{ static_cast<size_t>(std::distance(direction.begin(), largest_component)) };
+        const double axis_length{ std::abs(direction[axis]) };
+        if (axis_length <= 0) {
+            return ShadowMapResult::Uncertain;
+        }
+        const size_t face{ 2 * axis + (direction[axis] < 0 ? 1 : 0) };
+        const double s{ direction[(axis + 1) % 3] / axis_length };
+        const double t{ direction[(axis + 2) % 3] / axis_length };
+
+        // Find the four texels whose centers surround the direction, and the weights interpolating between them
+        const auto resolution{ static_cast<double>(m_resolution) };
+        const auto find_texels{ [&](const double face_coordinate) {
+            const double texel_coordinate{ (face_coordinate + 1) / 2 * resolution - 0.5 };
+            const auto first_texel{ static_cast<size_t>(std::clamp(std::floor(texel_coordinate),
+                                                                   0.0,
+                                                                   std::max(resolution - 2, 0.0))) };
+            const size_t second_texel{ std::min(first_texel + 1, m_resolution - 1) };
+            const double weight{ std::clamp(texel_coordinate - static_cast<double>(first_texel), 0.0, 1.0) };
+            return std::tuple{ first_texel, second_texel, weight };
+        } };
+        const auto [ column_0, column_1, column_weight ] { find_texels(s) };
+        const auto [ row_0, row_1, row_weight ] { find_texels(t) };
+        const auto get_depth{ [&](const size_t column, const size_t row) {
+            return static_cast<double>(m_depths[(face * m_resolution + row) * m_resolution + column]);
+        } };
+        const double depth_00{ get_depth(column_0, row_0) };
+        const double depth_10{ get_depth(column_1, row_0) };
+        const double depth_01{ get_depth(column_0, row_1) };
+        const double depth_11{ get_depth(column_1, row_1) };
+
+        // A point is shadowed if every surrounding depth lies well in front of it
+        if (point_depth > std::max({ depth_00, depth_10, depth_01, depth_11 }) + m_depth_bias) {
+            return ShadowMapResult::Shadowed;
+        }
+
+        // A point is lit if it is itself the nearest surface toward the light, judged by interpolating the
+        // surrounding depths. The depths must also lie close to a plane, since an edge of an occluder between the
+        // texel centers breaks the interpolation.
+        const double depth_nonplanarity{ std::abs(depth_00 + depth_11 - depth_10 - depth_01) };
+        const double interpolated_depth{
+                std::lerp(std::lerp(depth_00, depth_10, column_weight),
+                          std::lerp(depth_01, depth_11, column_weight),
+                          row_weight) };
+        if (depth_nonplanarity <= m_depth_bias && point_depth <= interpolated_depth + m_depth_bias) {
+            return ShadowMapResult::Lit;
+        }
+
+        return ShadowMapResult::Uncertain;
+    }
+}
\ No newline at end of file
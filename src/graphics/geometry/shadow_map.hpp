@@ -0,0 +1,86 @@
+#pragma once
+
+#include <vector>
+
+#include "vector4.hpp"
+
+namespace gfx {
+    class TraceableScene;
+
+    // Controls the shadow maps precomputed for the point lights of a compiled scene
+    struct ShadowMapSettings
+    {
+        size_t resolution{ 0 };         // Texels along each edge of a cube map face, or zero to disable shadow maps
+        double depth_bias{ 0.05 };      // Depth differences within this distance are resolved with a shadow ray
+    };
+
+    // The answer of a shadow map to whether a point is shadowed from its light
+    enum class ShadowMapResult
+    {
+        Lit,
+        Shadowed,
+        Uncertain       // The point is near an edge in the depth map, so only a shadow ray can tell
+    };
+
+    // Number of faces of the cube map around a point light
+    inline constexpr size_t SHADOW_MAP_FACE_COUNT{ 6 };
+
+    // A cube map of the distances from a point light to the nearest surface in each direction, so that shadow queries
+    // toward the light become a depth lookup. A point is only reported lit or shadowed if the depths of the four
+    // texels around it clearly decide it, otherwise (e.g. near the edge of a shadow) it is left for a shadow ray.
+    class ShadowMap
+    {
+    public:
+        /* Constructors */
+
+        ShadowMap() = delete;
+
+        // Renders the depth of the nearest surface of a scene through the center of each texel around a light
+        ShadowMap(const TraceableScene& scene, const Vector4& light_position, const ShadowMapSettings& settings);
+
+        // Copy Constructor
+        ShadowMap(const ShadowMap&) = default;
+
+        // Move Constructor
+        ShadowMap(ShadowMap&&) = default;
+
+        /* Destructor */
+
+        ~ShadowMap() = default;
+
+        /* Assignment Operators */
+
+        ShadowMap& operator=(const ShadowMap&) = default;
+        ShadowMap& operator=(ShadowMap&&) = default;
+
+        /* Accessors */
+
+        [[nodiscard]] const Vector4& getLightPosition() const
+        { return m_light_position; }
+
+        [[nodiscard]] size_t getResolution() const
+        { return m_resolution; }
+
+        // Returns the distance from the light to the nearest surface through the center of a texel, which is infinite
+        // if nothing lies in that direction. Faces are ordered +X, -X, +Y, -Y, +Z, -Z.
+        [[nodiscard]] float getDepthAt(size_t face, size_t column, size_t row) const
+        { return m_depths.at((face * m_resolution + row) * m_resolution + column); }
+
+        // Returns the number of bytes used by the depths of the map
+        [[nodiscard]] size_t getMemoryUsage() const
+        { return m_depths.capacity() * sizeof(float); }
+
+        /* Shadow Operations */
+
+        // Compares the distance from the light to a point with the depths of the four texels around it
+        [[nodiscard]] ShadowMapResult lookUp(const Vector4& point) const;
+
+    private:
+        /* Data Members */
+
+        Vector4 m_light_position{ };
+        size_t m_resolution{ 0 };
+        double m_depth_bias{ 0 };
+        std::vector<float> m_depths{ };     // Stored as single-precision floats to halve the memory of the map
+    };
+}
\ No newline at end of file
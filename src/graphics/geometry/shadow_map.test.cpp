@@ -0,0 +1,96 @@
+#include "gtest/gtest.h"
+#include "shadow_map.hpp"
+
+#include <cmath>
+#include <vector>
+
+#include "light.hpp"
+#include "world.hpp"
+#include "compiled_scene.hpp"
+#include "sphere.hpp"
+#include "plane.hpp"
+#include "transform.hpp"
+
+// Returns a world with a sphere floating over a floor, lit from directly above
+static gfx::World createShadowMapWorld(const size_t resolution)
+{
+    gfx::World world{
+        gfx::PointLight{ gfx::Color{ 1, 1, 1 }, gfx::createPoint(0, 10, 0) },
+        gfx::Plane{ gfx::createTranslationMatrix(0, -1, 0) },
+        gfx::Sphere{ gfx::createTranslationMatrix(0, 2, 0) }
+    };
+    world.setShadowMapSettings(gfx::ShadowMapSettings{ .resolution = resolution, .depth_bias = 0.05 });
+    return world;
+}
+
+// Tests rendering the depths around a light into a cube map
+TEST(GraphicsShadowMap, Build)
+{
+    const gfx::World world{ createShadowMapWorld(16) };
+    const gfx::ShadowMap shadow_map{ world, gfx::createPoint(0, 10, 0), world.getShadowMapSettings() };
+
+    EXPECT_EQ(shadow_map.getResolution(), 16);
+    EXPECT_EQ(shadow_map.getMemoryUsage(), gfx::SHADOW_MAP_FACE_COUNT * 16 * 16 * sizeof(float));
+
+    // Straight down (-Y) the sphere is hit first, while nothing lies straight up (+Y)
+    EXPECT_NEAR(shadow_map.getDepthAt(3, 7, 7), 7, 0.3);
+    EXPECT_TRUE(std::isinf(shadow_map.getDepthAt(2, 7, 7)));
+
+    // Toward the corners of the lower face the floor is hit instead
+    EXPECT_NEAR(shadow_map.getDepthAt(3, 0, 0), 11 * std::sqrt(1 + 2 * 0.9375 * 0.9375), 1e-4);
+}
+
+// Tests that looking up a shadow map agrees with casting shadow rays, apart from points it leaves uncertain
+TEST(GraphicsShadowMap, LookUp)
+{
+    const gfx::World world{ createShadowMapWorld(64) };
+    const gfx::ShadowMap shadow_map{ world, gfx::createPoint(0, 10, 0), world.getShadowMapSettings() };
+
+    size_t uncertain_count{ 0 };
+    for (double x = -6; x <= 6; x += 0.25) {
+        const gfx::Vector4 point{ gfx::createPoint(x, -0.999, 0.1) };
+        const gfx::ShadowMapResult result{ shadow_map.lookUp(point) };
+        if (result == gfx::ShadowMapResult::Uncertain) {
+            ++uncertain_count;
+        } else {
+            EXPECT_EQ(result == gfx::ShadowMapResult::Shadowed, world.isShadowed(point)) << "x = " << x;
+        }
+    }
+
+    // Only points near the edge of the shadow of the sphere are left for shadow rays
+    EXPECT_LT(uncertain_count, 10);
+    EXPECT_EQ(shadow_map.lookUp(gfx::createPoint(0, -0.999, 0)), gfx::ShadowMapResult::Shadowed);
+    EXPECT_EQ(shadow_map.lookUp(gfx::createPoint(5, -0.999, 0)), gfx::ShadowMapResult::Lit);
+    EXPECT_EQ(shadow_map.lookUp(gfx::createPoint(0, 10, 0)), gfx::ShadowMapResult::Uncertain);
+}
+
+// Tests that a compiled scene answers most shadow queries from its shadow maps, without changing the result
+TEST(GraphicsShadowMap, CompiledSceneShadowQueries)
+{
+    const gfx::World world{ createShadowMapWorld(64) };
+    gfx::CompiledScene scene{ world };
+    ASSERT_EQ(scene.getShadowMaps().size(), 1);
+    EXPECT_EQ(scene.getBuildStatistics().shadow_map_count, 1);
+    EXPECT_TRUE(world.getShadowMaps().empty());
+
+    const std::vector<gfx::Ray> rays{
+        gfx::Ray{ 0, 0, -5, 0, -0.1, 1 },
+        gfx::Ray{ 0.5, 5, 0, 0, -1, 0 },
+        gfx::Ray{ 4, 5, 0, 0, -1, 0 },
+        gfx::Ray{ -3, 5, 1, 0, -1, 0 }
+    };
+    for (const gfx::Ray& ray : rays) {
+        EXPECT_EQ(scene.calculatePixelColor(ray), world.calculatePixelColor(ray));
+    }
+    EXPECT_GT(scene.getShadowRayStatistics().shadow_map_hit_count, 0);
+
+    // Moving an object renders the shadow maps again
+    scene.setObjectTransform(1, gfx::createTranslationMatrix(4, 2, 0));
+    scene.updateBVH();
+    EXPECT_EQ(scene.getShadowMaps()[0].lookUp(gfx::createPoint(5.5, -0.999, 0)), gfx::ShadowMapResult::Shadowed);
+    EXPECT_EQ(scene.getShadowMaps()[0].lookUp(gfx::createPoint(0, -0.999, 0)), gfx::ShadowMapResult::Lit);
+
+    // Shadow maps can also be removed
+    scene.buildShadowMaps(gfx::ShadowMapSettings{ });
+    EXPECT_TRUE(scene.getShadowMaps().empty());
+}
\ No newline at end of file
@@ -45,21 +45,30 @@ namespace gfx {
     // Ray-Cone Intersection Calculator
     std::vector<Intersection> Cone::calculateIntersections(const Ray& transformed_ray) const
     {
-        const Vector4 direction{ transformed_ray.getDirection() };
-        const Vector4 origin{ transformed_ray.getOrigin() };
+        std::vector<Intersection> intersections{ };
+        ConeGeometry{ m_y_min, m_y_max, m_is_closed }.intersect(transformed_ray, this, intersections);
+        return intersections;
+    }
+
+    // Ray-Cone Intersection Kernel
+    void ConeGeometry::intersect(const Ray& object_ray,
+                                 const Surface* surface,
+                                 std::vector<Intersection>& intersections) const
+    {
+        const Vector4 direction{ object_ray.getDirection() };
+        const Vector4 origin{ object_ray.getOrigin() };
+        const auto first_intersection{ static_cast<std::ptrdiff_t>(intersections.size()) };
 
         const double a{ std::pow(direction.x(), 2) - std::pow(direction.y(), 2) + std::pow(direction.z(), 2) };
         const double b{ (2 * origin.x() * direction.x()) - (2 * origin.y() * direction.y()) + (2 * origin.z() * direction.z()) };
         const double c{ std::pow(origin.x(), 2) - std::pow(origin.y(), 2) + std::pow(origin.z(), 2) };
 
-        std::vector<Intersection> intersections{ };
-
         // Check if ray  potentially intersects both cone halves
         if (utils::areNotEqual(a, 0.0)) {
             const double discriminant{ std::pow(b, 2) - (4 * a * c) };
             if (utils::isLess(discriminant, 0.0)) {
                 // Ray misses the cone
-                return intersections;
+                return;
             }
 
             // Calculate the intersection points for an unbounded cone
@@ -70,26 +79,25 @@ namespace gfx {
             }
 
             // Check that intersection points land within cone bounds (if applicable)
-            const double y_0{ transformed_ray.getOrigin().y() + t_0 * transformed_ray.getDirection().y() };
-            if (utils::isLess(this->m_y_min, y_0) && utils::isLess(y_0, this->m_y_max)) {
-                intersections.emplace_back(t_0, this);
+            const double y_0{ object_ray.getOrigin().y() + t_0 * object_ray.getDirection().y() };
+            if (utils::isLess(y_min, y_0) && utils::isLess(y_0, y_max)) {
+                intersections.emplace_back(t_0, surface);
             }
-            const double y_1{ transformed_ray.getOrigin().y() + t_1 * transformed_ray.getDirection().y() };
-            if (utils::isLess(this->m_y_min, y_1) && utils::isLess(y_1, this->m_y_max)) {
-                intersections.emplace_back(t_1, this);
+            const double y_1{ object_ray.getOrigin().y() + t_1 * object_ray.getDirection().y() };
+            if (utils::isLess(y_min, y_1) && utils::isLess(y_1, y_max)) {
+                intersections.emplace_back(t_1, surface);
             }
         }
         else if (utils::areNotEqual(b, 0.0)) {
             // Ray is parallel to one half of the cone, intersects the other
-            intersections.emplace_back(-c / (2 * b), this);
+            intersections.emplace_back(-c / (2 * b), surface);
         }
 
         // Calculate intersections for cone end caps (if applicable)
-        intersections.append_range(calculateEndCapIntersections(transformed_ray));
+        intersectEndCaps(object_ray, surface, intersections);
 
-        // Sort intersections and return
-        std::sort(intersections.begin(), intersections.end());
-        return intersections;
+        // Sort the newly added intersections
+        std::sort(intersections.begin() + first_intersection, intersections.end());
     }
 
     // Cone Object Equivalency Check
@@ -106,34 +114,32 @@ namespace gfx {
     }
 
     // End Cap Intersection Calculator
-    std::vector<Intersection> Cone::calculateEndCapIntersections(const Ray& transformed_ray) const
+    void ConeGeometry::intersectEndCaps(const Ray& object_ray,
+                                        const Surface* surface,
+                                        std::vector<Intersection>& intersections) const
     {
-        const double ray_direction_y_val{ transformed_ray.getDirection().y() };
-        if (!this->isClosed() || utils::areEqual(ray_direction_y_val, 0.0)) {
+        const double ray_direction_y_val{ object_ray.getDirection().y() };
+        if (!is_closed || utils::areEqual(ray_direction_y_val, 0.0)) {
             // Intersections only possible if the cone is capped and could potentially be intersected by the ray
-            return std::vector<Intersection>{ };
+            return;
         }
 
-        std::vector<Intersection> intersections{ };
-
         // Check for an intersection with the plane at the lower bound
-        const double ray_origin_y_val{ transformed_ray.getOrigin().y() };
-        const double t_lower{ (this->m_y_min - ray_origin_y_val) / ray_direction_y_val };
-        if (isWithinConeWalls(transformed_ray, t_lower, m_y_min)) {
-            intersections.emplace_back(t_lower, this);
+        const double ray_origin_y_val{ object_ray.getOrigin().y() };
+        const double t_lower{ (y_min - ray_origin_y_val) / ray_direction_y_val };
+        if (isWithinConeWalls(object_ray, t_lower, y_min)) {
+            intersections.emplace_back(t_lower, surface);
         }
 
         // Check for an intersection with the plane at the upper bound
-        const double t_upper{ (this->m_y_max - ray_origin_y_val) / ray_direction_y_val };
-        if (isWithinConeWalls(transformed_ray, t_upper, m_y_max)) {
-            intersections.emplace_back(t_upper, this);
+        const double t_upper{ (y_max - ray_origin_y_val) / ray_direction_y_val };
+        if (isWithinConeWalls(object_ray, t_upper, y_max)) {
+            intersections.emplace_back(t_upper, surface);
         }
-
-        return intersections;
     }
 
     // Check Point is Within Cone Boundaries
-    bool Cone::isWithinConeWalls(const Ray& ray, const double t, const double end_cap_y_val)
+    bool ConeGeometry::isWithinConeWalls(const Ray& ray, const double t, const double end_cap_y_val)
     {
         const double x { ray.getOrigin().x() + t * ray.getDirection().x() };
         const double z { ray.getOrigin().z() + t * ray.getDirection().z() };
@@ -98,6 +98,9 @@ namespace gfx {
 
         [[nodiscard]] BoundingBox getBounds() const override;
 
+        [[nodiscard]] PrimitiveGeometry getPrimitiveGeometry() const override
+        { return ConeGeometry{ m_y_min, m_y_max, m_is_closed }; }
+
         /* Mutators */
 
         // Adds a lower bound to the cone's local y-value
@@ -159,13 +162,5 @@ namespace gfx {
 
         [[nodiscard]] std::vector<Intersection> calculateIntersections(const Ray& transformed_ray) const override;
         [[nodiscard]] bool areEquivalent(const Object& other_object) const override;
-
-        /* Cone Helper Methods */
-
-        // Calculates the intersections with the end
-        [[nodiscard]] std::vector<Intersection> calculateEndCapIntersections(const Ray& transformed_ray) const;
-
-        // Returns true if a ray's position at t is within the radius of the cone at a given y-position
-        [[nodiscard]] static bool isWithinConeWalls(const Ray& ray, double t, double end_cap_y_val) ;
     };
 }
@@ -31,14 +31,55 @@ namespace gfx {
     // Ray-Cube Intersection Calculator
     std::vector<Intersection> Cube::calculateIntersections(const Ray& transformed_ray) const
     {
-        const auto [ t_min, t_max ] { calculateBoxIntersectionTs(transformed_ray,
+        std::vector<Intersection> intersections{ };
+        CubeGeometry{ }.intersect(transformed_ray, this, intersections);
+        return intersections;
+    }
+
+    // Ray-Cube Intersection Kernel
+    void CubeGeometry::intersect(const Ray& object_ray,
+                                 const Surface* surface,
+                                 std::vector<Intersection>& intersections) const
+    {
+        const auto [ t_min, t_max ] { calculateBoxIntersectionTs(object_ray,
                                                                  createPoint(-1, -1, -1),
                                                                  createPoint(1, 1, 1)) };
 
         if (utils::isGreater(t_min, t_max)) {
-            return std::vector<Intersection>{ };
-        } else {
-            return std::vector<Intersection>{ Intersection{ t_min, this }, Intersection{ t_max, this } };
+            return;
+        }
+
+        intersections.emplace_back(t_min, surface);
+        intersections.emplace_back(t_max, surface);
+    }
+
+    // Ray-Cube Any-Hit Kernel
+    bool CubeGeometry::isHitWithin(const Ray& object_ray, const double distance) const
+    {
+        const auto [ t_min, t_max ] { calculateBoxIntersectionTs(object_ray,
+                                                                 createPoint(-1, -1, -1),
+                                                                 createPoint(1, 1, 1)) };
+
+        return !utils::isGreater(t_min, t_max) &&
+               (isInOcclusionRange(t_min, distance) || isInOcclusionRange(t_max, distance));
+    }
+
+    // Ray-Cube Packet Intersection Kernel
+    void CubeGeometry::intersect(const RayPacket& object_packet,
+                                 const uint32_t lanes,
+                                 const Surface* surface,
+                                 PacketIntersections& intersections) const
+    {
+        const auto [ t_min, t_max ] { calculateBoxIntersectionTs(object_packet,
+                                                                 createPoint(-1, -1, -1),
+                                                                 createPoint(1, 1, 1)) };
+
+        const uint32_t hit_lanes{ lanes & ~getMaskLanes(areLanesGreater(t_min, t_max)) };
+        for (size_t lane = 0; lane < RAY_PACKET_SIZE; ++lane) {
+            if ((hit_lanes >> lane) & 1u) {
+                intersections[lane].emplace_back(t_min[lane], surface);
+                intersections[lane].emplace_back(t_max[lane], surface);
+            }
         }
     }
 
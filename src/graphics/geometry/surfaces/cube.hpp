@@ -34,6 +34,9 @@ namespace gfx {
         { return BoundingBox{ -1, -1, -1,
                               1, 1, 1 }; }
 
+        [[nodiscard]] PrimitiveGeometry getPrimitiveGeometry() const override
+        { return CubeGeometry{ }; }
+
         /* Object Operations */
 
         // Creates a clone of this cube to be stored in a world object list
@@ -100,6 +100,9 @@ namespace gfx {
         { return BoundingBox{ -1, m_y_min, -1,
                               1, m_y_max, 1 }; }
 
+        [[nodiscard]] PrimitiveGeometry getPrimitiveGeometry() const override
+        { return CylinderGeometry{ m_y_min, m_y_max, m_is_closed }; }
+
         /* Mutators */
 
         // Adds a lower bound to the cylinder's local y-value
@@ -161,13 +164,5 @@ namespace gfx {
 
         [[nodiscard]] std::vector<Intersection> calculateIntersections(const Ray& transformed_ray) const override;
         [[nodiscard]] bool areEquivalent(const Object& other_object) const override;
-
-        /* Cylinder Helper Methods */
-
-        // Calculates the intersections with the end
-        [[nodiscard]] std::vector<Intersection> calculateEndCapIntersections(const Ray& transformed_ray) const;
-
-        // Returns true if a ray's position at t is within a radius of 1 from the y-axis
-        [[nodiscard]] static bool isWithinCylinderWalls(const Ray& ray, double t) ;
     };
 }
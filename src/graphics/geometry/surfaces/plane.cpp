@@ -1,6 +1,7 @@
 #include "plane.hpp"
 
 #include <cmath>
+#include <functional>
 
 #include "intersection.hpp"
 #include "util_functions.hpp"
@@ -15,16 +16,54 @@ namespace gfx {
     // Ray-Plane Intersection Calculator
     std::vector<Intersection> Plane::calculateIntersections(const Ray& transformed_ray) const
     {
-        const double ray_y_direction = transformed_ray.getDirection().y();
+        std::vector<Intersection> intersections{ };
+        PlaneGeometry{ }.intersect(transformed_ray, this, intersections);
+        return intersections;
+    }
+
+    // Ray-Plane Intersection Kernel
+    void PlaneGeometry::intersect(const Ray& object_ray,
+                                  const Surface* surface,
+                                  std::vector<Intersection>& intersections) const
+    {
+        const double ray_y_direction = object_ray.getDirection().y();
 
         // Ray is parallel or coplanar to the plane
         if (std::abs(ray_y_direction) < utils::EPSILON) {
-            return std::vector<Intersection>{ };
+            return;
         }
 
         // Ray intersects plane (assume plane is defined as xz-plane)
-        return std::vector<Intersection>{ Intersection{ -transformed_ray.getOrigin().y() / ray_y_direction,
-                                                        this } };
+        intersections.emplace_back(-object_ray.getOrigin().y() / ray_y_direction, surface);
+    }
+
+    // Ray-Plane Any-Hit Kernel
+    bool PlaneGeometry::isHitWithin(const Ray& object_ray, const double distance) const
+    {
+        const double ray_y_direction = object_ray.getDirection().y();
+        return std::abs(ray_y_direction) >= utils::EPSILON &&
+               isInOcclusionRange(-object_ray.getOrigin().y() / ray_y_direction, distance);
+    }
+
+    // Ray-Plane Packet Intersection Kernel
+    void PlaneGeometry::intersect(const RayPacket& object_packet,
+                                  const uint32_t lanes,
+                                  const Surface* surface,
+                                  PacketIntersections& intersections) const
+    {
+        // Calculate the distance to the xz-plane for every lane at once
+        const PacketDouble t{ -object_packet.origin_y / object_packet.direction_y };
+
+        // Add the intersections for each requested lane which is not parallel or coplanar to the plane
+        const uint32_t hit_lanes{
+            lanes & getMaskLanes(compareLanes(calculateLaneAbs(object_packet.direction_y),
+                                              PacketDouble{ } + utils::EPSILON,
+                                              std::greater_equal{ })) };
+        for (size_t lane = 0; lane < RAY_PACKET_SIZE; ++lane) {
+            if ((hit_lanes >> lane) & 1u) {
+                intersections[lane].emplace_back(t[lane], surface);
+            }
+        }
     }
 
     // Plane Object Equivalency Check
@@ -36,6 +36,9 @@ namespace gfx {
         { return BoundingBox{ -std::numeric_limits<double>::infinity(), 0, -std::numeric_limits<double>::infinity(),
                               std::numeric_limits<double>::infinity(), 0, std::numeric_limits<double>::infinity() }; }
 
+        [[nodiscard]] PrimitiveGeometry getPrimitiveGeometry() const override
+        { return PlaneGeometry{ }; }
+
         /* Object Operations */
 
         // Creates a clone of this plane to be stored in a world object list
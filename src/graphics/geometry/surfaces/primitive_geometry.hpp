@@ -0,0 +1,150 @@
+#pragma once
+
+#include <optional>
+#include <variant>
+#include <vector>
+#include <limits>
+
+#include "vector4.hpp"
+#include "ray.hpp"
+#include "ray_packet.hpp"
+#include "util_functions.hpp"
+
+namespace gfx {
+    /* Forward Declarations */
+    class Surface;
+    class Intersection;
+
+    /* Primitive Geometry Descriptions */
+    // Plain, by-value descriptions of each primitive shape in object space. Each description can intersect a ray
+    // that has already been transformed into object space without any virtual dispatch, appending the resulting
+    // intersections (tagged with the passed-in surface) to the end of an existing list. The sphere, plane, cube and
+    // triangle descriptions also provide packet kernels, which intersect the passed-in lanes of a ray packet at once
+    // and append to the list of each lane, and any-hit kernels, which answer occlusion queries without gathering
+    // intersections.
+
+    // Returns true if an intersection distance lies in the range [0, distance) checked by occlusion queries
+    [[nodiscard]] inline bool isInOcclusionRange(const double t, const double distance)
+    { return t >= 0 && utils::isLess(t, distance); }
+
+    struct SphereGeometry
+    {
+        void intersect(const Ray& object_ray, const Surface* surface, std::vector<Intersection>& intersections) const;
+
+        // Returns true if the ray intersects the shape in the range [0, distance), stopping at the first such hit
+        [[nodiscard]] bool isHitWithin(const Ray& object_ray, double distance) const;
+
+        void intersect(const RayPacket& object_packet,
+                       uint32_t lanes,
+                       const Surface* surface,
+                       PacketIntersections& intersections) const;
+    };
+
+    struct PlaneGeometry
+    {
+        void intersect(const Ray& object_ray, const Surface* surface, std::vector<Intersection>& intersections) const;
+
+        // Returns true if the ray intersects the shape in the range [0, distance), stopping at the first such hit
+        [[nodiscard]] bool isHitWithin(const Ray& object_ray, double distance) const;
+
+        void intersect(const RayPacket& object_packet,
+                       uint32_t lanes,
+                       const Surface* surface,
+                       PacketIntersections& intersections) const;
+    };
+
+    struct CubeGeometry
+    {
+        void intersect(const Ray& object_ray, const Surface* surface, std::vector<Intersection>& intersections) const;
+
+        // Returns true if the ray intersects the shape in the range [0, distance), stopping at the first such hit
+        [[nodiscard]] bool isHitWithin(const Ray& object_ray, double distance) const;
+
+        void intersect(const RayPacket& object_packet,
+                       uint32_t lanes,
+                       const Surface* surface,
+                       PacketIntersections& intersections) const;
+    };
+
+    struct CylinderGeometry
+    {
+        double y_min{ -std::numeric_limits<double>::infinity() };
+        double y_max{ std::numeric_limits<double>::infinity() };
+        bool is_closed{ false };
+
+        void intersect(const Ray& object_ray, const Surface* surface, std::vector<Intersection>& intersections) const;
+
+    private:
+        // Appends the intersections with the end caps of a closed cylinder
+        void intersectEndCaps(const Ray& object_ray,
+                              const Surface* surface,
+                              std::vector<Intersection>& intersections) const;
+
+        // Returns true if a ray's position at t is within a radius of 1 from the y-axis
+        [[nodiscard]] static bool isWithinCylinderWalls(const Ray& ray, double t);
+    };
+
+    struct ConeGeometry
+    {
+        double y_min{ -std::numeric_limits<double>::infinity() };
+        double y_max{ std::numeric_limits<double>::infinity() };
+        bool is_closed{ false };
+
+        void intersect(const Ray& object_ray, const Surface* surface, std::vector<Intersection>& intersections) const;
+
+    private:
+        // Appends the intersections with the end caps of a closed cone
+        void intersectEndCaps(const Ray& object_ray,
+                              const Surface* surface,
+                              std::vector<Intersection>& intersections) const;
+
+        // Returns true if a ray's position at t is within the radius of the cone at an end cap's y-value
+        [[nodiscard]] static bool isWithinConeWalls(const Ray& ray, double t, double end_cap_y_val);
+    };
+
+    struct TriangleGeometry
+    {
+        Vector4 vertex_a{ };
+        Vector4 edge_a{ };
+        Vector4 edge_b{ };
+
+        void intersect(const Ray& object_ray, const Surface* surface, std::vector<Intersection>& intersections) const;
+
+        // Returns true if the ray intersects the shape in the range [0, distance), stopping at the first such hit
+        [[nodiscard]] bool isHitWithin(const Ray& object_ray, double distance) const;
+
+        void intersect(const RayPacket& object_packet,
+                       uint32_t lanes,
+                       const Surface* surface,
+                       PacketIntersections& intersections) const;
+
+    private:
+        // Returns the distance along the ray at which it crosses the triangle, or nothing if it misses
+        [[nodiscard]] std::optional<double> calculateIntersectionT(const Ray& object_ray) const;
+    };
+
+    // Stands in for surfaces without a closed geometry description (e.g. user-defined surfaces), which are
+    // intersected through the virtual Object interface instead
+    struct CustomGeometry
+    {
+        void intersect(const Ray& object_ray, const Surface* surface, std::vector<Intersection>& intersections) const;
+    };
+
+    // The closed set of primitive shapes which can be intersected without virtual dispatch
+    using PrimitiveGeometry = std::variant<
+            SphereGeometry,
+            PlaneGeometry,
+            CubeGeometry,
+            CylinderGeometry,
+            ConeGeometry,
+            TriangleGeometry,
+            CustomGeometry
+    >;
+
+    // Returns true if a primitive shape intersects an object-space ray in the range [0, distance), using the any-hit
+    // kernel of the shape if it has one
+    [[nodiscard]] bool isGeometryHitWithin(const PrimitiveGeometry& geometry,
+                                           const Surface* surface,
+                                           const Ray& object_ray,
+                                           double distance);
+}
\ No newline at end of file
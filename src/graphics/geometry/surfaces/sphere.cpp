@@ -1,6 +1,7 @@
 #include "sphere.hpp"
 
 #include <cmath>
+#include <functional>
 
 #include "intersection.hpp"
 #include "util_functions.hpp"
@@ -14,31 +15,102 @@ namespace gfx {
 
     // Ray-Sphere Intersection Calculator
     std::vector<Intersection> Sphere::calculateIntersections(const Ray& transformed_ray) const
+    {
+        std::vector<Intersection> intersections{ };
+        SphereGeometry{ }.intersect(transformed_ray, this, intersections);
+        return intersections;
+    }
+
+    // Ray-Sphere Intersection Kernel
+    void SphereGeometry::intersect(const Ray& object_ray,
+                                   const Surface* surface,
+                                   std::vector<Intersection>& intersections) const
     {
         // Get the distance from the origin to the center of the sphere
         const Vector4 sphere_center{ createPoint(0, 0, 0) };
-        const Vector4 sphere_center_distance{ transformed_ray.getOrigin() - sphere_center };
+        const Vector4 sphere_center_distance{ object_ray.getOrigin() - sphere_center };
 
         // Calculate the discriminant of the polynomial whose solutions are the intersections with the sphere
-        const double a{ dotProduct(transformed_ray.getDirection(), transformed_ray.getDirection()) };
-        const double b{ 2 * dotProduct(transformed_ray.getDirection(), sphere_center_distance) };
+        const double a{ dotProduct(object_ray.getDirection(), object_ray.getDirection()) };
+        const double b{ 2 * dotProduct(object_ray.getDirection(), sphere_center_distance) };
         const double c{ dotProduct(sphere_center_distance, sphere_center_distance) - 1 };
         const double discriminant{ std::pow(b, 2) - 4 * a * c };
 
-        // No Solutions, return empty vector
+        // No Solutions, no intersections to add
         if (utils::isLess(discriminant, 0.0)) {
-            return std::vector<Intersection>{};
+            return;
         }
-        // One Solution, return vector with intersection distance listed twice
+        // One Solution, add the intersection distance twice
         else if (utils::areEqual(discriminant, 0.0)) {
-            const Intersection intersection{ -b / (2 * a), this };
-            return std::vector<Intersection>{ intersection, intersection };
+            const Intersection intersection{ -b / (2 * a), surface };
+            intersections.push_back(intersection);
+            intersections.push_back(intersection);
         }
-        // Two Solutions, return vector with intersection distances
+        // Two Solutions, add both intersection distances
         else {
-            const Intersection intersection_a{ (-b - std::sqrt(discriminant)) / (2 * a), this };
-            const Intersection intersection_b{ (-b + std::sqrt(discriminant)) / (2 * a), this };
-            return std::vector<Intersection>{ intersection_a, intersection_b };
+            intersections.emplace_back((-b - std::sqrt(discriminant)) / (2 * a), surface);
+            intersections.emplace_back((-b + std::sqrt(discriminant)) / (2 * a), surface);
+        }
+    }
+
+    // Ray-Sphere Any-Hit Kernel
+    bool SphereGeometry::isHitWithin(const Ray& object_ray, const double distance) const
+    {
+        // Solve the same polynomial as the intersection kernel, so both agree on every hit
+        const Vector4 sphere_center_distance{ object_ray.getOrigin() - createPoint(0, 0, 0) };
+        const double a{ dotProduct(object_ray.getDirection(), object_ray.getDirection()) };
+        const double b{ 2 * dotProduct(object_ray.getDirection(), sphere_center_distance) };
+        const double c{ dotProduct(sphere_center_distance, sphere_center_distance) - 1 };
+        const double discriminant{ std::pow(b, 2) - 4 * a * c };
+
+        if (utils::isLess(discriminant, 0.0)) {
+            return false;
+        }
+        if (utils::areEqual(discriminant, 0.0)) {
+            return isInOcclusionRange(-b / (2 * a), distance);
+        }
+        return isInOcclusionRange((-b - std::sqrt(discriminant)) / (2 * a), distance) ||
+               isInOcclusionRange((-b + std::sqrt(discriminant)) / (2 * a), distance);
+    }
+
+    // Ray-Sphere Packet Intersection Kernel
+    void SphereGeometry::intersect(const RayPacket& object_packet,
+                                   const uint32_t lanes,
+                                   const Surface* surface,
+                                   PacketIntersections& intersections) const
+    {
+        // Calculate the polynomial coefficients and discriminant for every lane at once
+        const PacketDouble& o_x{ object_packet.origin_x };
+        const PacketDouble& o_y{ object_packet.origin_y };
+        const PacketDouble& o_z{ object_packet.origin_z };
+        const PacketDouble& d_x{ object_packet.direction_x };
+        const PacketDouble& d_y{ object_packet.direction_y };
+        const PacketDouble& d_z{ object_packet.direction_z };
+        const PacketDouble a{ d_x * d_x + d_y * d_y + d_z * d_z };
+        const PacketDouble b{ 2.0 * (d_x * o_x + d_y * o_y + d_z * o_z) };
+        const PacketDouble c{ o_x * o_x + o_y * o_y + o_z * o_z - 1.0 };
+        const PacketDouble discriminant{ b * b - 4.0 * a * c };
+
+        // Classify the lanes using the same tolerances as the single-ray kernel, which misses wherever the
+        // discriminant is less than zero without being equal to it
+        const PacketMask is_tangent{ areLanesEqual(discriminant, PacketDouble{ }) };
+        const PacketMask is_miss{ ~is_tangent & compareLanes(discriminant, PacketDouble{ }, std::less{ }) };
+        const uint32_t hit_lanes{ lanes & ~getMaskLanes(is_miss) };
+        const uint32_t tangent_lanes{ getMaskLanes(is_tangent) };
+        for (size_t lane = 0; lane < RAY_PACKET_SIZE; ++lane) {
+            if (!((hit_lanes >> lane) & 1u)) {
+                continue;
+            }
+
+            if ((tangent_lanes >> lane) & 1u) {
+                const Intersection intersection{ -b[lane] / (2 * a[lane]), surface };
+                intersections[lane].push_back(intersection);
+                intersections[lane].push_back(intersection);
+            } else {
+                const double root{ std::sqrt(discriminant[lane]) };
+                intersections[lane].emplace_back((-b[lane] - root) / (2 * a[lane]), surface);
+                intersections[lane].emplace_back((-b[lane] + root) / (2 * a[lane]), surface);
+            }
         }
     }
 
@@ -36,6 +36,9 @@ namespace gfx {
         { return BoundingBox{ -1, -1, -1,
                               1, 1, 1 }; }
 
+        [[nodiscard]] PrimitiveGeometry getPrimitiveGeometry() const override
+        { return SphereGeometry{ }; }
+
         /* Object Operations */
 
         // Creates a clone of this sphere to be stored in an object list
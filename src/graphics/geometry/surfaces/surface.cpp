@@ -1,6 +1,9 @@
 #include "surface.hpp"
 
+#include <algorithm>
+
 #include "composite_surface.hpp"
+#include "intersection.hpp"
 
 namespace gfx {
     const Material& Surface::getMaterial() const
@@ -29,4 +32,39 @@ namespace gfx {
         const Vector4 object_normal{ this->calculateSurfaceNormal(object_point) };
         return this->transformNormalToWorldSpace(object_normal);
     }
+
+    // Surface Any-Hit Check
+    bool Surface::isObjectSpaceHitWithin(const Ray& transformed_ray, const double distance) const
+    {
+        return isGeometryHitWithin(this->getPrimitiveGeometry(), this, transformed_ray, distance);
+    }
+
+    // Custom Surface Intersection Calculator
+    void CustomGeometry::intersect(const Ray& object_ray,
+                                   const Surface* surface,
+                                   std::vector<Intersection>& intersections) const
+    {
+        intersections.append_range(surface->getObjectSpaceIntersections(object_ray));
+    }
+
+    // Primitive Geometry Any-Hit Dispatcher
+    bool isGeometryHitWithin(const PrimitiveGeometry& geometry,
+                             const Surface* surface,
+                             const Ray& object_ray,
+                             const double distance)
+    {
+        return std::visit([&](const auto& shape) {
+            if constexpr (requires { shape.isHitWithin(object_ray, distance); }) {
+                return shape.isHitWithin(object_ray, distance);
+            } else {
+                // Shapes without an any-hit kernel gather their intersections into a buffer reused by each thread
+                thread_local std::vector<Intersection> shape_intersections{ };
+                shape_intersections.clear();
+                shape.intersect(object_ray, surface, shape_intersections);
+                return std::ranges::any_of(shape_intersections, [&](const Intersection& intersection) {
+                    return isInOcclusionRange(intersection.getT(), distance);
+                });
+            }
+        }, geometry);
+    }
 }
\ No newline at end of file
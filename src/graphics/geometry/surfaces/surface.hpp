@@ -8,6 +8,7 @@
 
 #include "material.hpp"
 #include "texture_map.hpp"
+#include "primitive_geometry.hpp"
 
 namespace gfx {
     class Surface : public Object
@@ -19,17 +20,17 @@ namespace gfx {
         Surface() = default;
 
         // Transform-Only Constructor
-        explicit Surface(const Matrix4& transform, TextureMap texture_mapping = ProjectionMap)
+        explicit Surface(const Matrix4& transform, TextureMap texture_mapping = { })
                 : Object(transform), m_material{ }, m_texture_mapping{ std::move(texture_mapping) }
         {}
 
         // Material-Only Constructor
-        explicit Surface(Material material, TextureMap texture_mapping = ProjectionMap)
+        explicit Surface(Material material, TextureMap texture_mapping = { })
                 : Object(), m_material{ std::move(material) }, m_texture_mapping{std::move( texture_mapping )}
         {}
 
         // Standard Constructor
-        Surface(const Matrix4& transform, Material material, TextureMap texture_mapping = ProjectionMap)
+        Surface(const Matrix4& transform, Material material, TextureMap texture_mapping = { })
                 : Object(transform),
                   m_material{ std::move(material) },
                   m_texture_mapping{std::move( texture_mapping )}
@@ -56,13 +57,25 @@ namespace gfx {
         [[nodiscard]] Vector3 getTextureCoordinateFor(const Vector4& point) const
         { return m_texture_mapping(point); }
 
+        // Returns the texture coordinate of a world-space point on this surface, as used to color it
+        [[nodiscard]] Vector3 getTextureCoordinateAt(const Vector4& world_point) const
+        { return m_texture_mapping(this->transformToObjectSpace(world_point)); }
+
         [[nodiscard]] Color getObjectColorAt(const Vector4& world_point) const;
 
+        // Returns a by-value description of this surface's object-space geometry, used when flattening scenes.
+        // Surfaces without a closed description are intersected through virtual dispatch instead.
+        [[nodiscard]] virtual PrimitiveGeometry getPrimitiveGeometry() const
+        { return CustomGeometry{ }; }
+
         /* Mutators */
 
         void setMaterial(const Material& material)
         { m_material = material; }
 
+        void setMaterial(Material&& material)
+        { m_material = std::move(material); }
+
         void setTextureMap(const TextureMap& texture_mapping)
         { m_texture_mapping = texture_mapping; }
 
@@ -75,7 +88,11 @@ namespace gfx {
         /* Data Members */
 
         Material m_material{ };
-        TextureMap m_texture_mapping{ ProjectionMap };
+        TextureMap m_texture_mapping{ };
+
+        /* Object Helper Method Overrides */
+
+        [[nodiscard]] bool isObjectSpaceHitWithin(const Ray& transformed_ray, double distance) const override;
 
         /* Pure Virtual Helper Methods */
 
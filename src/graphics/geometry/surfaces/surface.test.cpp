@@ -127,6 +127,22 @@ TEST(GraphicsSurface, SetTransform)
     ASSERT_EQ(surface.getTransform(), transform_expected);
 }
 
+// Tests that setting the transform of a surface reclassifies the transform type
+TEST(GraphicsSurface, SetTransformClassifiesTransform)
+{
+    TestSurface surface{ };
+    ASSERT_EQ(surface.getTransformType(), gfx::TransformType::Identity);
+
+    surface.setTransform(gfx::createTranslationMatrix(1, 2, 3));
+    ASSERT_EQ(surface.getTransformType(), gfx::TransformType::Translation);
+
+    surface.setTransform(gfx::createTranslationMatrix(1, 2, 3) * gfx::createScalingMatrix(4));
+    ASSERT_EQ(surface.getTransformType(), gfx::TransformType::UniformScale);
+
+    surface.setTransform(gfx::createXRotationMatrix(M_PI_4));
+    ASSERT_EQ(surface.getTransformType(), gfx::TransformType::GeneralAffine);
+}
+
 // Tests setting the material of a surface
 TEST(GraphicsSurface, SetMaterial)
 {
@@ -166,6 +182,34 @@ TEST(GraphicsSurface, GetIntersectionsTransformsRay)
     ASSERT_EQ(ray_b_transformed_actual, ray_b_transformed_expected);
 }
 
+// Tests that the transform fast paths produce the same rays and normals as the full matrix transforms
+TEST(GraphicsSurface, TransformFastPathsMatchMatrixTransforms)
+{
+    const gfx::Ray ray{ 1, -2, -5,
+                        0.3, 0.4, 0.866025 };
+    const gfx::Vector4 world_point{ gfx::createPoint(0.5, 1.25, -2) };
+
+    const std::vector<gfx::Matrix4> transforms{
+        gfx::createTranslationMatrix(5, -1, 2),
+        gfx::createTranslationMatrix(5, -1, 2) * gfx::createScalingMatrix(2.5),
+        gfx::createTranslationMatrix(-3, 0, 1) * gfx::createScalingMatrix(-0.5)
+    };
+
+    for (const auto& transform : transforms) {
+        const TestSurface surface{ transform };
+        ASSERT_NE(surface.getTransformType(), gfx::TransformType::GeneralAffine);
+
+        const auto discarded_intersections{ surface.getObjectIntersections(ray) };
+        EXPECT_EQ(surface.getTransformedRay(), ray.transform(transform.inverse()));
+
+        const gfx::Vector4 object_point{ transform.inverse() * world_point };
+        gfx::Vector4 normal_expected{ transform.inverse().transpose() *
+                                      gfx::createVector(object_point.x(), object_point.y(), object_point.z()) };
+        normal_expected.resetW();
+        EXPECT_EQ(surface.getSurfaceNormalAt(world_point), gfx::normalize(normal_expected));
+    }
+}
+
 // Tests that getSurfaceNormal transforms a vector to and from object space
 TEST(GraphicsSurface, GetSurfaceNormalTransformsVector)
 {
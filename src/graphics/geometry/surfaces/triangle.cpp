@@ -15,33 +15,102 @@ namespace gfx {
     // Ray-Triangle Intersection Calculator
     std::vector<Intersection> Triangle::calculateIntersections(const Ray& transformed_ray) const
     {
-        const Vector4 ray_direction{ transformed_ray.getDirection() };
-        const Vector4 ray_cross_edge_b{ ray_direction.crossProduct(m_edge_b) };
-        const double determinant{ dotProduct(m_edge_a, ray_cross_edge_b) } ;
+        std::vector<Intersection> intersections{ };
+        TriangleGeometry{ m_vertex_a, m_edge_a, m_edge_b }.intersect(transformed_ray, this, intersections);
+        return intersections;
+    }
+
+    // Ray-Triangle Intersection Kernel
+    void TriangleGeometry::intersect(const Ray& object_ray,
+                                     const Surface* surface,
+                                     std::vector<Intersection>& intersections) const
+    {
+        if (const std::optional<double> t{ this->calculateIntersectionT(object_ray) }) {
+            intersections.emplace_back(t.value(), surface);
+        }
+    }
+
+    // Ray-Triangle Any-Hit Kernel
+    bool TriangleGeometry::isHitWithin(const Ray& object_ray, const double distance) const
+    {
+        const std::optional<double> t{ this->calculateIntersectionT(object_ray) };
+        return t && isInOcclusionRange(t.value(), distance);
+    }
+
+    // Ray-Triangle Intersection Distance Calculator
+    std::optional<double> TriangleGeometry::calculateIntersectionT(const Ray& object_ray) const
+    {
+        const Vector4 ray_direction{ object_ray.getDirection() };
+        const Vector4 ray_cross_edge_b{ ray_direction.crossProduct(edge_b) };
+        const double determinant{ dotProduct(edge_a, ray_cross_edge_b) } ;
 
         if (utils::areEqual(determinant, 0.0))
             // Ray is parallel to the triangle plane
-            return std::vector<Intersection>{ };
+            return std::nullopt;
 
-        const Vector4 ray_origin{ transformed_ray.getOrigin() };
+        const Vector4 ray_origin{ object_ray.getOrigin() };
         const double inverse_determinant{ 1.0 / determinant };
-        const Vector4 vertex_a_to_origin{ ray_origin - m_vertex_a };
+        const Vector4 vertex_a_to_origin{ ray_origin - vertex_a };
         const double u { inverse_determinant * dotProduct(vertex_a_to_origin, ray_cross_edge_b) };
 
         if (utils::isLess(u, 0.0) || utils::isGreater(u, 1.0))
             // Ray misses Edge B (Vertex A to Vertex C)
-            return std::vector<Intersection>{ };
+            return std::nullopt;
 
-        const Vector4 origin_cross_edge_a{ vertex_a_to_origin.crossProduct(m_edge_a) };
+        const Vector4 origin_cross_edge_a{ vertex_a_to_origin.crossProduct(edge_a) };
         const double v { inverse_determinant * dotProduct(ray_direction, origin_cross_edge_a) };
 
         if (utils::isLess(v, 0.0) || utils::isGreater(u + v, 1.0))
             // Ray misses Edges B & C
-            return std::vector<Intersection>{ };
+            return std::nullopt;
 
         // Ray intersects the triangle
-        const double t { inverse_determinant * dotProduct(m_edge_b, origin_cross_edge_a) };
-        return std::vector<Intersection>{ { t, this } };
+        return inverse_determinant * dotProduct(edge_b, origin_cross_edge_a);
+    }
+
+    // Ray-Triangle Packet Intersection Kernel
+    void TriangleGeometry::intersect(const RayPacket& object_packet,
+                                     const uint32_t lanes,
+                                     const Surface* surface,
+                                     PacketIntersections& intersections) const
+    {
+        // Calculate the barycentric coordinates and distance for every lane at once
+        const PacketDouble& d_x{ object_packet.direction_x };
+        const PacketDouble& d_y{ object_packet.direction_y };
+        const PacketDouble& d_z{ object_packet.direction_z };
+
+        // ray direction × edge B
+        const PacketDouble p_x{ d_y * edge_b.z() - d_z * edge_b.y() };
+        const PacketDouble p_y{ d_z * edge_b.x() - d_x * edge_b.z() };
+        const PacketDouble p_z{ d_x * edge_b.y() - d_y * edge_b.x() };
+        const PacketDouble determinant{ edge_a.x() * p_x + edge_a.y() * p_y + edge_a.z() * p_z };
+
+        // Vertex A to ray origin
+        const PacketDouble inverse_determinant{ 1.0 / determinant };
+        const PacketDouble s_x{ object_packet.origin_x - vertex_a.x() };
+        const PacketDouble s_y{ object_packet.origin_y - vertex_a.y() };
+        const PacketDouble s_z{ object_packet.origin_z - vertex_a.z() };
+        const PacketDouble u{ inverse_determinant * (s_x * p_x + s_y * p_y + s_z * p_z) };
+
+        // (Vertex A to ray origin) × edge A
+        const PacketDouble q_x{ s_y * edge_a.z() - s_z * edge_a.y() };
+        const PacketDouble q_y{ s_z * edge_a.x() - s_x * edge_a.z() };
+        const PacketDouble q_z{ s_x * edge_a.y() - s_y * edge_a.x() };
+        const PacketDouble v{ inverse_determinant * (d_x * q_x + d_y * q_y + d_z * q_z) };
+        const PacketDouble t{ inverse_determinant * (edge_b.x() * q_x + edge_b.y() * q_y + edge_b.z() * q_z) };
+
+        // Add the intersections for each requested lane which lands inside all three edges
+        const PacketDouble zero{ };
+        const PacketDouble one{ zero + 1.0 };
+        const PacketMask is_miss{ areLanesEqual(determinant, zero) |
+                                  areLanesLess(u, zero) | areLanesGreater(u, one) |
+                                  areLanesLess(v, zero) | areLanesGreater(u + v, one) };
+        const uint32_t hit_lanes{ lanes & ~getMaskLanes(is_miss) };
+        for (size_t lane = 0; lane < RAY_PACKET_SIZE; ++lane) {
+            if ((hit_lanes >> lane) & 1u) {
+                intersections[lane].emplace_back(t[lane], surface);
+            }
+        }
     }
 
     // Triangle Object Equivalency Check
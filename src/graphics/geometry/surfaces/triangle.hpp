@@ -56,6 +56,9 @@ namespace gfx {
         [[nodiscard]] BoundingBox getBounds() const override
         { return m_bounds; }
 
+        [[nodiscard]] PrimitiveGeometry getPrimitiveGeometry() const override
+        { return TriangleGeometry{ m_vertex_a, m_edge_a, m_edge_b }; }
+
         /* Object Operations */
 
         // Creates a clone of this sphere to be stored in an object list
@@ -0,0 +1,522 @@
+#include "traceable_scene.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+#include "surface.hpp"
+#include "util_functions.hpp"
+#include "shading_functions.hpp"
+
+namespace gfx {
+    // The occluders last found by the shadow rays of a thread toward each light of the scene it last shaded
+    struct ShadowOccluderCache
+    {
+        const TraceableScene* scene{ nullptr };
+        std::vector<std::optional<size_t>> occluders{ };
+    };
+
+    static thread_local ShadowOccluderCache shadow_occluder_cache{ };
+
+    // The footprint the rays shaded by a thread are recorded into, if any
+    static thread_local RayFootprint* recorded_ray_footprint{ nullptr };
+
+    // Adds the segment of a ray up to a distance (in units of its direction) to the bounds and grid of a footprint,
+    // extending the bounds to infinity along each axis the ray travels if the distance is infinite. The grid only
+    // records the part of the segment within its own bounds.
+    static void addRaySegment(RayFootprint& ray_footprint, const Ray& ray, const double distance)
+    {
+        const Vector4& origin{ ray.getOrigin() };
+        ray_footprint.grid.addSegment(origin, ray.getDirection(), distance);
+        ray_footprint.bounds.addPoint(origin);
+        if (std::isfinite(distance)) {
+            ray_footprint.bounds.addPoint(ray.position(distance));
+            return;
+        }
+
+        const auto extend_axis{ [](const double origin_component, const double direction_component) {
+            if (direction_component == 0) {
+                return origin_component;
+            }
+            return direction_component > 0 ?
+                std::numeric_limits<double>::infinity() : -std::numeric_limits<double>::infinity();
+        } };
+        const Vector4& direction{ ray.getDirection() };
+        ray_footprint.bounds.addPoint(createPoint(extend_axis(origin.x(), direction.x()),
+                                                  extend_axis(origin.y(), direction.y()),
+                                                  extend_axis(origin.z(), direction.z())));
+    }
+
+    // Returns a deterministic pseudo-random value in [0, 1) for one dimension of a light sample at a surface point, so
+    // that repeated renders of the same scene produce identical images
+    static double calculateLightSampleValue(const Vector4& point, const size_t sample_index, const uint32_t dimension)
+    {
+        // Hash the point's coordinates with the SplitMix64 finalizer
+        uint64_t hash{ std::bit_cast<uint64_t>(point.x()) * 0x9E3779B97F4A7C15ull };
+        hash ^= std::bit_cast<uint64_t>(point.y()) * 0xC2B2AE3D27D4EB4Full;
+        hash ^= std::bit_cast<uint64_t>(point.z()) * 0x165667B19E3779F9ull;
+        hash ^= sample_index * 0xD6E8FEB86659FD93ull;
+        hash ^= static_cast<uint64_t>(dimension) * 0xA0761D6478BD642Full;
+        hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ull;
+        hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBull;
+        hash ^= hash >> 31;
+
+        // Use the upper 53 bits as the mantissa of a double in [0, 1)
+        return static_cast<double>(hash >> 11) * 0x1.0p-53;
+    }
+
+    // Returns the coordinates of a light sample within a set of stratified samples. The unit square is divided into a
+    // grid with at least as many cells as samples, and each sample is jittered within its own cell. Sets which are
+    // combined into one estimate pass distinct first sample indices, so that their jitter is independent.
+    static std::pair<double, double> calculateStratifiedLightSample(const Vector4& point,
+                                                                    const size_t first_sample_index,
+                                                                    const size_t sample_index,
+                                                                    const size_t sample_count,
+                                                                    const uint32_t dimension)
+    {
+        const auto column_count{ static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(sample_count)))) };
+        const size_t row_count{ (sample_count + column_count - 1) / column_count };
+        const auto cell_x{ static_cast<double>(sample_index % column_count) };
+        const auto cell_y{ static_cast<double>(sample_index / column_count) };
+
+        const size_t jitter_index{ first_sample_index + sample_index };
+
+        return std::pair<double, double>{
+                (cell_x + calculateLightSampleValue(point, jitter_index, dimension)) /
+                        static_cast<double>(column_count),
+                (cell_y + calculateLightSampleValue(point, jitter_index, dimension + 1)) /
+                        static_cast<double>(row_count) };
+    }
+
+    void TraceableScene::setRayFootprint(RayFootprint* const ray_footprint)
+    {
+        recorded_ray_footprint = ray_footprint;
+    }
+
+    PacketIntersections TraceableScene::getAllPacketIntersections(const RayPacket& packet) const
+    {
+        PacketIntersections packet_intersections{ };
+        for (size_t lane = 0; lane < RAY_PACKET_SIZE; ++lane) {
+            if (packet.isLaneActive(lane)) {
+                packet_intersections[lane] = this->getAllIntersections(packet.getRayAt(lane));
+            }
+        }
+
+        return packet_intersections;
+    }
+
+    bool TraceableScene::isOccluded(const Ray& ray, const double distance) const
+    {
+        // If the nearest intersection in front of the ray occurs before the distance, the ray is occluded
+        const auto possible_hit{ getHit(this->getAllIntersections(ray)) };
+        return possible_hit && utils::isLess(possible_hit.value().getT(), distance);
+    }
+
+    const PointLight& TraceableScene::getLightSource() const
+    {
+        const std::span<const PointLight> light_sources{ this->getLightSources() };
+        if (light_sources.empty()) {
+            throw std::out_of_range("The scene has no point light sources");
+        }
+        return light_sources.front();
+    }
+
+    bool TraceableScene::isShadowed(const Vector4& point) const
+    {
+        return this->isShadowed(point, this->getLightSource());
+    }
+
+    bool TraceableScene::isShadowed(const Vector4& point, const PointLight& light) const
+    {
+        // Only the lights of the scene itself have a cache slot
+        const std::span<const PointLight> light_sources{ this->getLightSources() };
+        if (std::less{ }(&light, light_sources.data()) || !std::less{ }(&light, std::to_address(light_sources.end()))) {
+            // Get the direction vector to the light source
+            const Vector4 light_source_displacement{ light.position - point };
+
+            // Cast a ray towards the light source to see if it intersects with any other object
+            const Ray shadow_ray( point, normalize(light_source_displacement));
+            return this->isOccluded(shadow_ray, light_source_displacement.magnitude());
+        }
+
+        const auto light_index{ static_cast<size_t>(&light - light_sources.data()) };
+        ShadowRayStatistics shadow_ray_statistics{ };
+        return this->isShadowed(point, light.position, light_index, shadow_ray_statistics);
+    }
+
+    bool TraceableScene::isShadowed(const Vector4& point,
+                                    const Vector4& light_position,
+                                    const size_t occluder_cache_slot,
+                                    ShadowRayStatistics& shadow_ray_statistics) const
+    {
+        // Shadows do not depend on the materials of their occluders, so only the extent of the shadow ray is recorded
+        if (recorded_ray_footprint) {
+            recorded_ray_footprint->bounds.addPoint(point);
+            recorded_ray_footprint->bounds.addPoint(light_position);
+            recorded_ray_footprint->grid.addSegment(point, light_position - point, 1);
+        }
+
+        // Only points near an edge in the shadow map of a point light need a shadow ray
+        const std::span<const ShadowMap> shadow_maps{ this->getShadowMaps() };
+        if (occluder_cache_slot < shadow_maps.size()) {
+            const ShadowMapResult shadow_map_result{ shadow_maps[occluder_cache_slot].lookUp(point) };
+            if (shadow_map_result != ShadowMapResult::Uncertain) {
+                ++shadow_ray_statistics.shadow_map_hit_count;
+                return shadow_map_result == ShadowMapResult::Shadowed;
+            }
+        }
+
+        // Get the direction vector to the light source
+        const Vector4 light_source_displacement{ light_position - point };
+        const Ray shadow_ray( point, normalize(light_source_displacement));
+        const double light_distance{ light_source_displacement.magnitude() };
+
+        // The cache of each thread starts over whenever the thread moves on to shading another scene
+        ShadowOccluderCache& occluder_cache{ shadow_occluder_cache };
+        if (occluder_cache.scene != this) {
+            occluder_cache.scene = this;
+            occluder_cache.occluders.clear();
+        }
+        if (occluder_cache_slot >= occluder_cache.occluders.size()) {
+            occluder_cache.occluders.resize(occluder_cache_slot + 1);
+        }
+
+        // Neighboring points are usually shadowed by the same object, so test the last occluder of the light first
+        std::optional<size_t>& cached_occluder{ occluder_cache.occluders[occluder_cache_slot] };
+        if (cached_occluder && this->isOccludedBy(shadow_ray, light_distance, cached_occluder.value())) {
+            ++shadow_ray_statistics.occluder_cache_hit_count;
+            return true;
+        }
+
+        // Otherwise traverse the scene, keeping the previous occluder if the point is lit
+        const std::optional<size_t> occluder{ this->findOccluder(shadow_ray, light_distance) };
+        if (occluder) {
+            cached_occluder = occluder;
+        }
+        return occluder.has_value();
+    }
+
+    Color TraceableScene::calculatePixelColor(const Ray& ray, const int remaining_bounces) const
+    {
+        // Get the list of intersections for the ray and calculate the color from them
+        return this->calculatePixelColor(ray, this->getAllIntersections(ray), remaining_bounces);
+    }
+
+    Color TraceableScene::calculatePixelColor(const Ray& ray,
+                                              const std::vector<Intersection>& world_intersections,
+                                              const int remaining_bounces) const
+    {
+        // Check the list of intersections for a hit
+        auto possible_hit{ getHit(world_intersections) };
+
+        // Record every object the ray passes through, and the ray itself up to its hit
+        if (recorded_ray_footprint) {
+            for (const Intersection& intersection : world_intersections) {
+                recorded_ray_footprint->surfaces.insert(&intersection.getObject());
+            }
+            addRaySegment(*recorded_ray_footprint,
+                          ray,
+                          possible_hit ? possible_hit.value().getT() : std::numeric_limits<double>::infinity());
+        }
+
+        // Hit found calculate the color at that position, pre-computing values to utilize in shadow, reflection, and
+        // refraction calculations
+        if (possible_hit) {
+            return this->calculateHitColor(DetailedIntersection{ possible_hit.value(), ray },
+                                           world_intersections,
+                                           remaining_bounces);
+        }
+        // No hit found, return black
+        else {
+            return black();
+        }
+    }
+
+    Color TraceableScene::calculateHitColor(const DetailedIntersection& hit,
+                                            const std::vector<Intersection>& ray_intersections,
+                                            const int remaining_bounces) const
+    {
+        const Color reflected_color{ this->calculateReflectedColorAt(hit, remaining_bounces) };
+        const Color refracted_color{ this->calculateRefractedColorAt(hit, ray_intersections, remaining_bounces) };
+
+        // Calculate the surface color using the shading model
+        Color surface_color{ this->calculateSurfaceColorAt(hit) };
+
+        // Apply Fresnel Effect for reflective transparent materials,
+        const Material& hit_material{ hit.getObject().getMaterial() };
+        if (utils::isGreater(hit_material.getProperties().reflectivity, 0.0) &&
+            utils::isGreater(hit_material.getProperties().transparency, 0.0))
+        {
+            const auto [ n1, n2 ] { getRefractiveIndices(hit, ray_intersections) };
+            const double reflectance{ calculateReflectance(hit.getViewVector(), hit.getSurfaceNormal(), n1, n2) };
+            return surface_color + (reflected_color * reflectance) + (refracted_color * (1 - reflectance));
+        }
+
+        // Otherwise return calculated color
+        return surface_color + reflected_color + refracted_color;
+    }
+
+    std::array<Color, RAY_PACKET_SIZE> TraceableScene::calculatePixelColors(const RayPacket& packet,
+                                                                            const int remaining_bounces) const
+    {
+        // Trace the primary rays together, then shade each lane individually
+        const PacketIntersections packet_intersections{ this->getAllPacketIntersections(packet) };
+
+        std::array<Color, RAY_PACKET_SIZE> pixel_colors{ };
+        for (size_t lane = 0; lane < RAY_PACKET_SIZE; ++lane) {
+            if (packet.isLaneActive(lane)) {
+                pixel_colors[lane] = this->calculatePixelColor(packet.getRayAt(lane),
+                                                               packet_intersections[lane],
+                                                               remaining_bounces);
+            }
+        }
+
+        return pixel_colors;
+    }
+
+    ShadowRayStatistics TraceableScene::getShadowRayStatistics() const
+    {
+        return ShadowRayStatistics{ m_shadow_ray_count.load(std::memory_order_relaxed),
+                                    m_area_light_evaluation_count.load(std::memory_order_relaxed),
+                                    m_penumbra_count.load(std::memory_order_relaxed),
+                                    m_occluder_cache_hit_count.load(std::memory_order_relaxed),
+                                    m_shadow_map_hit_count.load(std::memory_order_relaxed) };
+    }
+
+    Color TraceableScene::calculateSurfaceColorAt(const DetailedIntersection& intersection) const
+    {
+        const Color object_color{ intersection.getObjectColorAt(intersection.getOverPoint()) };
+
+        // Count the shadow rays of this point locally, so the shared counters are only updated once per point
+        ShadowRayStatistics shadow_ray_statistics{ };
+        Color surface_color{ this->calculatePointLightColorAt(intersection, object_color, shadow_ray_statistics) };
+        const std::span<const AreaLight> area_lights{ this->getAreaLights() };
+        for (size_t i = 0; i < area_lights.size(); ++i) {
+            surface_color += this->calculateAreaLightColorAt(
+                    intersection, object_color, area_lights[i], static_cast<uint32_t>(i), shadow_ray_statistics);
+        }
+
+        if (shadow_ray_statistics.shadow_ray_count > 0) {
+            m_shadow_ray_count.fetch_add(shadow_ray_statistics.shadow_ray_count, std::memory_order_relaxed);
+            m_area_light_evaluation_count.fetch_add(shadow_ray_statistics.area_light_evaluation_count,
+                                                    std::memory_order_relaxed);
+            m_penumbra_count.fetch_add(shadow_ray_statistics.penumbra_count, std::memory_order_relaxed);
+            m_occluder_cache_hit_count.fetch_add(shadow_ray_statistics.occluder_cache_hit_count,
+                                                 std::memory_order_relaxed);
+            m_shadow_map_hit_count.fetch_add(shadow_ray_statistics.shadow_map_hit_count, std::memory_order_relaxed);
+        }
+        return surface_color;
+    }
+
+    Color TraceableScene::calculatePointLightColorAt(const DetailedIntersection& intersection,
+                                                     const Color& object_color,
+                                                     ShadowRayStatistics& shadow_ray_statistics) const
+    {
+        const Vector4 point{ intersection.getOverPoint() };
+        const Vector4 surface_normal{ intersection.getSurfaceNormal() };
+        const Vector4 view_vector{ intersection.getViewVector() };
+        const MaterialProperties& material_properties{ intersection.getObject().getMaterial().getProperties() };
+        const LightSamplingSettings& sampling_settings{ this->getLightSamplingSettings() };
+
+        // With more lights than samples, only a few lights chosen from the light BVH in proportion to their
+        // contributions cast shadow rays, while every light reaching the point adds its ambient light. Each sample is
+        // weighted by the inverse of its probability, so the direct light matches that of shading every light on
+        // average.
+        const size_t sample_count{ sampling_settings.sampled_light_count };
+        if (sample_count > 0 && this->getLightSources().size() > sample_count) {
+            const LightBVH& light_bvh{ this->getLightBVH() };
+            Color surface_color{ object_color * light_bvh.calculateTotalIntensityAt(point) *
+                                 material_properties.ambient };
+            for (size_t sample_index = 0; sample_index < sample_count; ++sample_index) {
+                const std::optional<LightSample> light_sample{
+                        light_bvh.sampleLight(point,
+                                              surface_normal,
+                                              calculateLightSampleValue(point, sample_index, 0),
+                                              sampling_settings.contribution_threshold) };
+                if (!light_sample) {
+                    continue;
+                }
+
+                const PointLight& light{ this->getLightSources()[light_sample->light_index] };
+                ++shadow_ray_statistics.shadow_ray_count;
+                if (!this->isShadowed(point, light.position, light_sample->light_index, shadow_ray_statistics)) {
+                    const Color direct_color{
+                            calculateSurfaceColor(object_color,
+                                                  material_properties,
+                                                  light,
+                                                  point,
+                                                  surface_normal,
+                                                  view_vector) -
+                            calculateSurfaceColor(object_color,
+                                                  material_properties,
+                                                  light,
+                                                  point,
+                                                  surface_normal,
+                                                  view_vector,
+                                                  true) };
+                    surface_color +=
+                            direct_color * (1 / (light_sample->probability * static_cast<double>(sample_count)));
+                }
+            }
+
+            return surface_color;
+        }
+
+        // Otherwise lights which do not reach the point add nothing, while lights behind the surface or too dim to
+        // matter only add ambient light, which does not need a shadow ray
+        Color surface_color{ 0, 0, 0 };
+        const std::span<const PointLight> light_sources{ this->getLightSources() };
+        for (size_t light_index = 0; light_index < light_sources.size(); ++light_index) {
+            const PointLight& light{ light_sources[light_index] };
+            const Vector4 light_displacement{ light.position - point };
+            const double attenuation{ calculateLightAttenuation(light, light_displacement.magnitude()) };
+            if (attenuation <= 0) {
+                continue;
+            }
+
+            const double light_normal_cosine{ dotProduct(normalize(light_displacement), surface_normal) };
+            const double contribution{ estimateLightContribution(light.intensity * attenuation, light_normal_cosine) };
+            bool is_shadowed{ true };
+            if (!utils::isLess(light_normal_cosine, 0.0) && contribution >= sampling_settings.contribution_threshold) {
+                is_shadowed = this->isShadowed(point, light.position, light_index, shadow_ray_statistics);
+                ++shadow_ray_statistics.shadow_ray_count;
+            }
+            surface_color += calculateSurfaceColor(
+                    object_color, material_properties, light, point, surface_normal, view_vector, is_shadowed);
+        }
+
+        return surface_color;
+    }
+
+    Color TraceableScene::calculateAreaLightColorAt(const DetailedIntersection& intersection,
+                                                    const Color& object_color,
+                                                    const AreaLight& light,
+                                                    const uint32_t light_index,
+                                                    ShadowRayStatistics& shadow_ray_statistics) const
+    {
+        const Vector4 point{ intersection.getOverPoint() };
+        const Vector4 surface_normal{ intersection.getSurfaceNormal() };
+        const Vector4 view_vector{ intersection.getViewVector() };
+        const MaterialProperties& material_properties{ intersection.getObject().getMaterial().getProperties() };
+
+        // The ambient light does not depend on where the light is sampled, so it is added once for the whole light.
+        // Lights entirely behind the surface or too dim to matter add nothing else.
+        const Color ambient_color{ calculateSurfaceColor(object_color,
+                                                         material_properties,
+                                                         PointLight{ light.intensity, light.position },
+                                                         point,
+                                                         surface_normal,
+                                                         view_vector,
+                                                         true) };
+        if (isAreaLightBehind(light, point, surface_normal) ||
+            estimateLightContribution(light.intensity, 1) < this->getLightSamplingSettings().contribution_threshold)
+        {
+            return ambient_color;
+        }
+        ++shadow_ray_statistics.area_light_evaluation_count;
+
+        // Returns the number of unshadowed samples in a set of stratified samples of the light, adding the direct
+        // light from each of them to a running sum
+        const uint32_t dimension{ 1 + 2 * light_index };
+        const size_t occluder_cache_slot{ this->getLightSources().size() + light_index };
+        const auto sample_direct_light{ [&](const size_t first_sample_index,
+                                            const size_t sample_count,
+                                            Color& direct_color_sum) {
+            size_t lit_sample_count{ 0 };
+            for (size_t sample_index = 0; sample_index < sample_count; ++sample_index) {
+                const auto [ u, v ] {
+                    calculateStratifiedLightSample(point, first_sample_index, sample_index, sample_count, dimension) };
+                const PointLight sample_light{ light.intensity,
+                                               calculateAreaLightSamplePosition(light, point, u, v) };
+                if (!this->isShadowed(point, sample_light.position, occluder_cache_slot, shadow_ray_statistics)) {
+                    direct_color_sum += calculateSurfaceColor(object_color,
+                                                              material_properties,
+                                                              sample_light,
+                                                              point,
+                                                              surface_normal,
+                                                              view_vector) - ambient_color;
+                    ++lit_sample_count;
+                }
+            }
+
+            shadow_ray_statistics.shadow_ray_count += sample_count;
+            return lit_sample_count;
+        } };
+
+        // Points whose probes agree are taken to be fully lit or fully shadowed
+        const size_t sample_count{ std::max<size_t>(light.sample_count, 1) };
+        const size_t probe_count{ std::min(AREA_LIGHT_PROBE_COUNT, sample_count) };
+        Color direct_color_sum{ 0, 0, 0 };
+        const size_t lit_probe_count{ sample_direct_light(0, probe_count, direct_color_sum) };
+        if (lit_probe_count == 0 || lit_probe_count == probe_count || probe_count == sample_count) {
+            return ambient_color + direct_color_sum * (1 / static_cast<double>(probe_count));
+        }
+
+        // Otherwise the point is in the penumbra and the light is sampled fully. The probes cover the whole light as
+        // well, so they count toward the sample count and only the rest of the samples are cast as a second set.
+        ++shadow_ray_statistics.penumbra_count;
+        static_cast<void>(sample_direct_light(probe_count, sample_count - probe_count, direct_color_sum));
+        return ambient_color + direct_color_sum * (1 / static_cast<double>(sample_count));
+    }
+
+    Color TraceableScene::calculateReflectedColorAt(const DetailedIntersection& intersection, int remaining_bounces) const
+    {
+        // Bounce a ray to see what colors the reflective surface picks up
+        const Material& object_material{ intersection.getObject().getMaterial() };
+        const double object_reflectivity{ object_material.getProperties().reflectivity };
+        if (utils::areNotEqual(object_reflectivity, 0.0) && remaining_bounces > 0) {
+            const Ray reflection_vector{ intersection.getOverPoint(),
+                                         intersection.getReflectionVector() };
+            return object_reflectivity * this->calculatePixelColor(reflection_vector, remaining_bounces - 1);
+        }
+        // Non-reflective surface, return black
+        else {
+            return black();
+        }
+    }
+
+    Color TraceableScene::calculateRefractedColorAt(const DetailedIntersection& intersection,
+                                           const std::vector<Intersection>& possible_overlaps,
+                                           const int remaining_bounces) const
+    {
+        const Material& object_material{ intersection.getObject().getMaterial() };
+        const double object_transparency{ object_material.getProperties().transparency };
+        if (utils::areNotEqual(object_transparency, 0.0) && remaining_bounces > 0) {
+            // Calculate the trig values for the angles of refraction using Snell's Law: θᵢ/θᵣ = n2/n1
+            // Assume θᵢ is the angle of incidence and θᵣ is the angle of refraction
+            const auto [ n1, n2 ] { getRefractiveIndices(intersection, possible_overlaps) };
+            const Vector4 view_vector{ intersection.getViewVector() };
+            const Vector4 normal_vector{ intersection.getSurfaceNormal() };
+
+            // θᵢ is formed by the view vector and the normal, so the cos(θᵢ) is their dot product
+            const double cos_i{ dotProduct(view_vector, normal_vector) };
+
+            // Using the identity sin²θ + cos²θ = 1 gives us sin²(θᵣ) = (n1 / n2)² * (1 - cos²(θᵢ))
+            const double n_ratio{ n1 / n2 };
+            const double sin2_r{ std::pow(n_ratio, 2) * (1 - std::pow(cos_i, 2)) };
+
+            // Total internal reflection occurs when no real solution exists for θᵣ, i.e. when sin²(θᵣ) exceeds 1
+            if (utils::isGreater(sin2_r, 1.0)) {
+                return black();
+            }
+
+            // Use the refraction formula to calculate the refraction direction and create the refraction ray
+            const double cos_r{ std::sqrt(1 - sin2_r) };
+            const Ray refraction_ray{ intersection.getUnderPoint(),
+                                      normal_vector * (n_ratio * cos_i - cos_r) - view_vector * n_ratio };
+
+            // Recursively calculate the refracted color
+            return object_transparency * this->calculatePixelColor(refraction_ray, remaining_bounces - 1) ;
+        } else {
+            // Opaque object or maximum recursion, return black
+            return black();
+        }
+    }
+}
\ No newline at end of file
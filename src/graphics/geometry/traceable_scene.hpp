@@ -0,0 +1,192 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <unordered_set>
+#include <vector>
+
+#include "light.hpp"
+#include "light_bvh.hpp"
+#include "shadow_map.hpp"
+#include "vector4.hpp"
+#include "color.hpp"
+#include "ray.hpp"
+#include "ray_packet.hpp"
+#include "intersection.hpp"
+#include "bounding_box.hpp"
+#include "footprint_grid.hpp"
+
+namespace gfx {
+    // Counts the shadow rays cast while shading the surfaces of a scene
+    struct ShadowRayStatistics
+    {
+        size_t shadow_ray_count{ 0 };
+        size_t area_light_evaluation_count{ 0 };    // Surface points shaded by an area light facing them
+        size_t penumbra_count{ 0 };                 // Evaluations whose probes found the point partially shadowed,
+                                                    // which then received the full sample count of the light
+        size_t occluder_cache_hit_count{ 0 };       // Shadow rays found blocked by the last occluder of their light,
+                                                    // without traversing the scene
+        size_t shadow_map_hit_count{ 0 };           // Shadow rays answered by a depth lookup in a shadow map, without
+                                                    // being cast
+    };
+
+    // Collects what the rays traced on a thread touch, so that a render can tell which edits of its scene affect it
+    struct RayFootprint
+    {
+        std::unordered_set<const Surface*> surfaces{ };     // Intersected by primary or secondary rays, including the
+                                                            // intersections in front of and behind each hit
+        BoundingBox bounds{ };                              // Encloses every primary, secondary and shadow ray segment,
+                                                            // extending to infinity along rays which leave the scene
+        FootprintGrid grid{ };                              // Marks the cells those segments pass through within the
+                                                            // bounds the recorder gives the grid, usually the scene's
+    };
+
+    class TraceableScene
+    {
+    public:
+        /* Destructor */
+
+        virtual ~TraceableScene() = default;
+
+        /* Accessors */
+
+        [[nodiscard]] virtual std::span<const PointLight> getLightSources() const = 0;
+
+        [[nodiscard]] virtual std::span<const AreaLight> getAreaLights() const = 0;
+
+        [[nodiscard]] virtual const LightSamplingSettings& getLightSamplingSettings() const = 0;
+
+        // Returns the hierarchy over the point light sources, used to choose which lights to sample when the scene
+        // has more of them than the sampling settings allow
+        [[nodiscard]] virtual const LightBVH& getLightBVH() const = 0;
+
+        // Returns the shadow map of each point light source, or nothing if the scene has no shadow maps
+        [[nodiscard]] virtual std::span<const ShadowMap> getShadowMaps() const
+        { return { }; }
+
+        // Returns the first point light source of the scene, throwing if it has none (such as a scene lit only by
+        // area lights)
+        [[nodiscard]] const PointLight& getLightSource() const;
+
+        // Returns the number of shadow rays cast while shading the scene so far, across all threads
+        [[nodiscard]] ShadowRayStatistics getShadowRayStatistics() const;
+
+        /* Mutators */
+
+        // Starts recording the rays traced by the calling thread into a footprint, or stops recording if it is null.
+        // Rays are only recorded while shading, so the occlusion and intersection queries of other callers are not.
+        static void setRayFootprint(RayFootprint* ray_footprint);
+
+        /* Ray-Tracing Operations */
+
+        // Returns a sorted list of all intersections with objects in this scene with a passed-in Ray
+        [[nodiscard]] virtual std::vector<Intersection> getAllIntersections(const Ray& ray) const = 0;
+
+        // Returns the sorted list of intersections for each active lane of a ray packet. By default each lane is
+        // traced as a single ray.
+        [[nodiscard]] virtual PacketIntersections getAllPacketIntersections(const RayPacket& packet) const;
+
+        // Returns true if any object intersects the ray in the range [0, distance)
+        [[nodiscard]] virtual bool isOccluded(const Ray& ray, double distance) const;
+
+        // Returns an identifier for an object intersecting the ray in the range [0, distance), stopping at the first
+        // one, or nothing if the ray is unoccluded. The identifier is only meaningful to the same scene.
+        [[nodiscard]] virtual std::optional<size_t> findOccluder(const Ray& ray, double distance) const = 0;
+
+        // Returns true if the object with an identifier found by findOccluder intersects the ray in [0, distance)
+        [[nodiscard]] virtual bool isOccludedBy(const Ray& ray, double distance, size_t occluder) const = 0;
+
+        // Returns true if the passed-in position is in the shadow of the first light source, throwing if the scene
+        // has no point light sources
+        [[nodiscard]] bool isShadowed(const Vector4& point) const;
+
+        // Returns true if the passed-in position is in the shadow of a light source. Lights with a shadow map are
+        // looked up in it first. Each thread also remembers the last object found blocking each light of the scene,
+        // and tests it before traversing the whole scene.
+        [[nodiscard]] bool isShadowed(const Vector4& point, const PointLight& light) const;
+
+        // Returns the pixel color for the ray hit using pre-computed vector data for that point in world space
+        [[nodiscard]] Color calculatePixelColor(const Ray& ray, int remaining_bounces = 5) const;
+
+        // Returns the pixel color for a ray whose sorted list of intersections has already been found
+        [[nodiscard]] Color calculatePixelColor(const Ray& ray,
+                                                const std::vector<Intersection>& ray_intersections,
+                                                int remaining_bounces = 5) const;
+
+        // Returns the pixel color at a ray's hit whose pre-computed state has already been found. The sorted list of
+        // intersections of the ray is only used if the hit surface is transparent, so it may be left empty otherwise.
+        [[nodiscard]] Color calculateHitColor(const DetailedIntersection& hit,
+                                              const std::vector<Intersection>& ray_intersections,
+                                              int remaining_bounces = 5) const;
+
+        // Returns the pixel color for each active lane of a packet of primary rays. The packet is only traced
+        // together up to the primary hits, after which each lane is shaded (and any secondary rays are traced)
+        // on its own, since the lanes no longer share a common path.
+        [[nodiscard]] std::array<Color, RAY_PACKET_SIZE> calculatePixelColors(const RayPacket& packet,
+                                                                              int remaining_bounces = 5) const;
+
+        // Returns the surface color at a ray-object intersection lit by the light sources of the scene. Shadow rays
+        // are only cast toward the lights which face the surface and are estimated to contribute enough to it, and
+        // may be limited to a subset of the point lights chosen from the light BVH in time logarithmic in their count.
+        // Area lights are first probed with a few shadow rays, and only points found in their penumbra receive the
+        // rest of the full sample count of the light.
+        [[nodiscard]] Color calculateSurfaceColorAt(const DetailedIntersection& intersection) const;
+
+        // Returns the reflected color at a ray-object intersection
+        [[nodiscard]] Color calculateReflectedColorAt(const DetailedIntersection& intersection,
+                                                      int remaining_bounces = 5) const;
+
+        // Returns the refracted color at a ray-object intersection
+        [[nodiscard]] Color calculateRefractedColorAt(const DetailedIntersection& intersection,
+                                                      const std::vector<Intersection>& possible_overlaps,
+                                                      int remaining_bounces = 5) const;
+
+    protected:
+        /* Constructors */
+
+        // Copies and moves of a scene start counting their own shadow rays
+        TraceableScene() = default;
+        TraceableScene(const TraceableScene&) {}
+        TraceableScene(TraceableScene&&) noexcept {}
+
+        /* Assignment Operators */
+
+        TraceableScene& operator=(const TraceableScene&) { return *this; }
+        TraceableScene& operator=(TraceableScene&&) noexcept { return *this; }
+
+    private:
+        /* Data Members */
+
+        mutable std::atomic<size_t> m_shadow_ray_count{ 0 };
+        mutable std::atomic<size_t> m_area_light_evaluation_count{ 0 };
+        mutable std::atomic<size_t> m_penumbra_count{ 0 };
+        mutable std::atomic<size_t> m_occluder_cache_hit_count{ 0 };
+        mutable std::atomic<size_t> m_shadow_map_hit_count{ 0 };
+
+        /* Helper Methods */
+
+        // Returns true if a point is in the shadow of a light position, first looking it up in the shadow map of the
+        // passed-in cache slot and then testing the occluder this thread last found in the slot. Point lights use
+        // their own index as their slot, and the samples of each area light share the slot after the point lights and
+        // any area lights before it.
+        [[nodiscard]] bool isShadowed(const Vector4& point,
+                                      const Vector4& light_position,
+                                      size_t occluder_cache_slot,
+                                      ShadowRayStatistics& shadow_ray_statistics) const;
+
+        // Returns the light added to a surface point by the point light sources of the scene
+        [[nodiscard]] Color calculatePointLightColorAt(const DetailedIntersection& intersection,
+                                                       const Color& object_color,
+                                                       ShadowRayStatistics& shadow_ray_statistics) const;
+
+        // Returns the light added to a surface point by a single area light, probing it before sampling it fully
+        [[nodiscard]] Color calculateAreaLightColorAt(const DetailedIntersection& intersection,
+                                                      const Color& object_color,
+                                                      const AreaLight& light,
+                                                      uint32_t light_index,
+                                                      ShadowRayStatistics& shadow_ray_statistics) const;
+    };
+}
\ No newline at end of file
@@ -2,17 +2,20 @@
 
 #include <vector>
 #include <memory>
+#include <span>
+#include <optional>
 
 #include "light.hpp"
 #include "vector4.hpp"
 #include "ray.hpp"
 #include "intersection.hpp"
+#include "traceable_scene.hpp"
 
 namespace gfx {
     class Object;
     class Intersection;
 
-    class World
+    class World : public TraceableScene
     {
     public:
         /* Constructors */
@@ -27,16 +30,12 @@ namespace gfx {
         template<typename... ObjectPtrs>
         explicit World(const std::shared_ptr<Object>& first_object_ptr,
                        const ObjectPtrs&... remaining_object_ptrs)
-                : m_light_source{ Color{ 1, 1, 1 },
-                                  createPoint(-10, 10, -10) },
-                m_objects { first_object_ptr, remaining_object_ptrs...  }
+                : m_objects { first_object_ptr, remaining_object_ptrs...  }
         {}
 
         template<typename... ObjectRefs>
         explicit World(const Object& first_object_ref,
                        const ObjectRefs&... remaining_object_refs)
-                : m_light_source{ Color{ 1, 1, 1 },
-                                  createPoint(-10, 10, -10) }
         { addObjects(first_object_ref, remaining_object_refs...); }
 
         // Standard Constructors
@@ -44,7 +43,7 @@ namespace gfx {
         World(const PointLight& light_source,
               const std::shared_ptr<Object>& first_object,
               const ObjectPtrs&... remaining_objects)
-                : m_light_source{ light_source },
+                : m_light_sources{ light_source },
                 m_objects { first_object, remaining_objects...  }
         {}
 
@@ -52,7 +51,7 @@ namespace gfx {
         World(const PointLight& light_source,
               const Object& first_object,
               const ObjectRefs&... remaining_objects)
-                : m_light_source{ light_source }
+                : m_light_sources{ light_source }
         { addObjects(first_object, remaining_objects...); }
 
         // Copy Constructor
@@ -63,7 +62,7 @@ namespace gfx {
 
         /* Destructor */
 
-        ~World() = default;
+        ~World() override = default;
 
         /* Assignment Operators */
 
@@ -72,8 +71,21 @@ namespace gfx {
 
         /* Accessors */
 
-        [[nodiscard]] const PointLight& getLightSource() const
-        { return m_light_source; }
+        [[nodiscard]] std::span<const PointLight> getLightSources() const override
+        { return m_light_sources; }
+
+        [[nodiscard]] std::span<const AreaLight> getAreaLights() const override
+        { return m_area_lights; }
+
+        [[nodiscard]] const LightSamplingSettings& getLightSamplingSettings() const override
+        { return m_light_sampling_settings; }
+
+        [[nodiscard]] const LightBVH& getLightBVH() const override
+        { return m_light_bvh; }
+
+        // Returns the settings of the shadow maps rendered when the world is compiled
+        [[nodiscard]] const ShadowMapSettings& getShadowMapSettings() const
+        { return m_shadow_map_settings; }
 
         [[nodiscard]] size_t getObjectCount() const
         { return m_objects.size(); }
@@ -90,31 +102,40 @@ namespace gfx {
         void addObject(const Object& object);
         void addObject(const std::shared_ptr<Object>& object);
 
-        /* Ray-Tracing Operations */
+        // Adds a light source to those already lighting the world, rebuilding the light BVH
+        void addLightSource(const PointLight& light_source);
 
-        // Returns a sorted list of all intersections with objects in this world with a passed-in Ray
-        [[nodiscard]] std::vector<Intersection> getAllIntersections(const Ray& ray) const;
+        // Replaces the point light sources of the world, which may be left without any if it has area lights
+        void setLightSources(const std::vector<PointLight>& light_sources);
 
-        // Returns true if the passed-in position is in shadow
-        [[nodiscard]] bool isShadowed(const Vector4& point) const;
+        // Adds an area light to those already lighting the world
+        void addAreaLight(const AreaLight& area_light);
 
-        // Returns the pixel color for the ray hit using pre-computed vector data for that point in world space
-        [[nodiscard]] Color calculatePixelColor(const Ray& ray, int remaining_bounces = 5) const;
+        void setLightSamplingSettings(const LightSamplingSettings& light_sampling_settings)
+        { m_light_sampling_settings = light_sampling_settings; }
+
+        void setShadowMapSettings(const ShadowMapSettings& shadow_map_settings)
+        { m_shadow_map_settings = shadow_map_settings; }
+
+        /* Ray-Tracing Operations */
+
+        // Returns a sorted list of all intersections with objects in this world with a passed-in Ray
+        [[nodiscard]] std::vector<Intersection> getAllIntersections(const Ray& ray) const override;
 
-        // Returns the reflected color at a ray-object intersection
-        [[nodiscard]] Color calculateReflectedColorAt(const DetailedIntersection& intersection,
-                                                      int remaining_bounces = 5) const;
+        // Returns the index of the first object found intersecting the ray in the range [0, distance)
+        [[nodiscard]] std::optional<size_t> findOccluder(const Ray& ray, double distance) const override;
 
-        // Returns the refracted color at a ray-object intersection
-        [[nodiscard]] Color calculateRefractedColorAt(const DetailedIntersection& intersection,
-                                                      const std::vector<Intersection>& possible_overlaps,
-                                                      int remaining_bounces = 5) const;
+        // Returns true if the object at the passed-in index intersects the ray in the range [0, distance)
+        [[nodiscard]] bool isOccludedBy(const Ray& ray, double distance, size_t occluder) const override;
 
     private:
         /* Data Members */
 
-        PointLight m_light_source{ Color{ 1, 1, 1 },
-                                   createPoint(-10, 10, -10) };
+        std::vector<PointLight> m_light_sources{ PointLight{ Color{ 1, 1, 1 }, createPoint(-10, 10, -10) } };
+        LightBVH m_light_bvh{ m_light_sources };
+        std::vector<AreaLight> m_area_lights{ };
+        LightSamplingSettings m_light_sampling_settings{ };
+        ShadowMapSettings m_shadow_map_settings{ };
         std::vector<std::shared_ptr<Object>> m_objects{ };
 
         /* Helper Methods */
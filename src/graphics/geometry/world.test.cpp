@@ -1,6 +1,9 @@
 #include "gtest/gtest.h"
 #include "world.hpp"
 
+#include <cmath>
+#include <stdexcept>
+#include <tuple>
 #include <vector>
 
 #include "light.hpp"
@@ -11,6 +14,7 @@
 #include "intersection.hpp"
 #include "plane.hpp"
 #include "pattern_texture_3d.hpp"
+#include "shading_functions.hpp"
 
 static const gfx::World default_world {
     gfx::PointLight { gfx::Color{ 1, 1, 1 },
@@ -455,4 +459,175 @@ TEST(GraphicsWorld, CalculatePixelColorReflectiveTransparentMaterial)
     const gfx::Color pixel_color_actual{ world.calculatePixelColor(ray) };
 
     EXPECT_EQ(pixel_color_actual, pixel_color_expected);
+}
+
+// Tests that each light source of a world adds its own light to a surface
+TEST(GraphicsWorld, CalculatePixelColorMultipleLightSources)
+{
+    const gfx::PointLight light_source_a{ gfx::Color{ 1, 1, 1 }, gfx::createPoint(-10, 10, -10) };
+    const gfx::PointLight light_source_b{ gfx::Color{ 0.5, 0.2, 0.1 }, gfx::createPoint(5, 2, -10) };
+    const gfx::Sphere sphere_a{ gfx::Material{ gfx::Color{ 0.8, 1.0, 0.6 },
+                                               gfx::MaterialProperties{ .diffuse = 0.7, .specular = 0.2 } } };
+    const gfx::Sphere sphere_b{ gfx::createScalingMatrix(0.5) };
+
+    const gfx::World world_a{ light_source_a, sphere_a, sphere_b };
+    const gfx::World world_b{ light_source_b, sphere_a, sphere_b };
+    gfx::World world{ light_source_a, sphere_a, sphere_b };
+    world.addLightSource(light_source_b);
+
+    ASSERT_EQ(world.getLightSources().size(), 2);
+    EXPECT_EQ(world.getLightSource().position, light_source_a.position);
+
+    const gfx::Ray ray{ 0, 0, -5,
+                        0, 0, 1 };
+    EXPECT_EQ(world.calculatePixelColor(ray), world_a.calculatePixelColor(ray) + world_b.calculatePixelColor(ray));
+}
+
+// Tests that lights behind a surface or below the contribution threshold only add their ambient light
+TEST(GraphicsWorld, CalculateSurfaceColorLightCulling)
+{
+    const gfx::PointLight bright_light{ gfx::Color{ 1, 1, 1 }, gfx::createPoint(-10, 10, -10) };
+    const gfx::PointLight dim_light{ gfx::Color{ 0.01, 0.01, 0.01 }, gfx::createPoint(10, 10, -10) };
+    const gfx::PointLight back_light{ gfx::Color{ 1, 1, 1 }, gfx::createPoint(0, 0, 10) };
+    const gfx::PointLight distant_light{ gfx::Color{ 1, 1, 1 }, gfx::createPoint(0, 0, -100), 50 };
+    const gfx::Sphere sphere{ };
+
+    gfx::World world{ bright_light, sphere };
+    world.addLightSource(dim_light);
+    world.addLightSource(back_light);
+    world.addLightSource(distant_light);
+    world.setLightSamplingSettings(gfx::LightSamplingSettings{ .contribution_threshold = 0.05 });
+
+    const gfx::Ray ray{ 0, 0, -5,
+                        0, 0, 1 };
+    const std::vector<gfx::Intersection> world_intersections{ world.getAllIntersections(ray) };
+    const gfx::DetailedIntersection hit{ world_intersections.at(0), ray };
+
+    const auto shade{ [&](const gfx::PointLight& light, const bool is_shadowed) {
+        return gfx::calculateSurfaceColor(
+                hit, light, hit.getOverPoint(), hit.getSurfaceNormal(), hit.getViewVector(), is_shadowed);
+    } };
+    const gfx::Color color_expected{ shade(bright_light, false) + shade(dim_light, true) + shade(back_light, true) };
+
+    EXPECT_EQ(world.calculateSurfaceColorAt(hit), color_expected);
+}
+
+// Tests that sampling a subset of the lights weights each sample by the inverse of its probability
+TEST(GraphicsWorld, CalculateSurfaceColorLightSampling)
+{
+    const gfx::PointLight light_source{ gfx::Color{ 0.5, 0.5, 0.5 }, gfx::createPoint(-10, 10, -10) };
+    const gfx::Sphere sphere{ };
+
+    gfx::World world{ light_source, sphere };
+    world.addLightSource(light_source);
+    world.addLightSource(light_source);
+    const gfx::Ray ray{ 0, 0, -5,
+                        0, 0, 1 };
+    const gfx::Color pixel_color_expected{ world.calculatePixelColor(ray) };
+
+    // Each identical light is equally likely, so every sample stands in for all three of them
+    world.setLightSamplingSettings(gfx::LightSamplingSettings{ .sampled_light_count = 1 });
+    EXPECT_EQ(world.calculatePixelColor(ray), pixel_color_expected);
+
+    world.setLightSamplingSettings(gfx::LightSamplingSettings{ .sampled_light_count = 2 });
+    EXPECT_EQ(world.calculatePixelColor(ray), pixel_color_expected);
+}
+
+// Tests that sampling the lights of a fully shadowed point leaves only the ambient light of every light
+TEST(GraphicsWorld, CalculateSurfaceColorLightSamplingShadowed)
+{
+    const std::vector<gfx::PointLight> light_sources{
+        gfx::PointLight{ gfx::Color{ 0.5, 0.5, 0.5 }, gfx::createPoint(0, 10, 0) },
+        gfx::PointLight{ gfx::Color{ 0.2, 0.4, 0.6 }, gfx::createPoint(0.5, 10, 0) },
+        gfx::PointLight{ gfx::Color{ 0.3, 0.1, 0.2 }, gfx::createPoint(-0.5, 10, 0.5) }
+    };
+    gfx::World world{ gfx::Plane{ }, gfx::Sphere{ gfx::createTranslationMatrix(0, 5, 0) } };
+    world.setLightSources(light_sources);
+    world.setLightSamplingSettings(gfx::LightSamplingSettings{ .sampled_light_count = 1 });
+
+    const gfx::Ray ray{ 0, 1, 0,
+                        0, -1, 0 };
+    const gfx::DetailedIntersection hit{ getHit(world.getAllIntersections(ray)).value(), ray };
+    gfx::Color color_expected{ 0, 0, 0 };
+    for (const gfx::PointLight& light_source : light_sources) {
+        color_expected += gfx::calculateSurfaceColor(
+                hit, light_source, hit.getOverPoint(), hit.getSurfaceNormal(), hit.getViewVector(), true);
+    }
+
+    const gfx::Color color_actual{ world.calculateSurfaceColorAt(hit) };
+    EXPECT_TRUE(std::isfinite(color_actual.r()) && std::isfinite(color_actual.g()) && std::isfinite(color_actual.b()));
+    EXPECT_EQ(color_actual, color_expected);
+}
+
+// Tests that asking a world lit only by area lights for its first point light throws, rather than reading past the
+// end of its light sources
+TEST(GraphicsWorld, AreaLightOnlyWorld)
+{
+    gfx::World world{ gfx::Plane{ } };
+    world.setLightSources({ });
+    world.addAreaLight(gfx::AreaLight{ .position = gfx::createPoint(0, 10, 0),
+                                       .edge_u = gfx::createVector(2, 0, 0),
+                                       .edge_v = gfx::createVector(0, 0, 2) });
+
+    EXPECT_TRUE(world.getLightSources().empty());
+    EXPECT_THROW(static_cast<void>(world.getLightSource()), std::out_of_range);
+    EXPECT_THROW(static_cast<void>(world.isShadowed(gfx::createPoint(0, 1, 0))), std::out_of_range);
+}
+
+// Tests that area lights are probed before being sampled, and only fully sampled from points in their penumbra, where
+// the probes count toward the full sample count
+TEST(GraphicsWorld, CalculateSurfaceColorAreaLight)
+{
+    const gfx::AreaLight area_light{ .position = gfx::createPoint(0, 10, 0),
+                                     .edge_u = gfx::createVector(2, 0, 0),
+                                     .edge_v = gfx::createVector(0, 0, 2),
+                                     .sample_count = 16 };
+    gfx::World world{ gfx::Plane{ }, gfx::Sphere{ gfx::createTranslationMatrix(0, 5, 0) } };
+    world.setLightSources({ });
+    world.addAreaLight(area_light);
+
+    // Returns the color of the floor below a point, with the number of shadow rays and penumbra points it added
+    const auto shade_floor{ [&world](const double x) {
+        const gfx::Ray ray{ x, 1, 0,
+                            0, -1, 0 };
+        const gfx::DetailedIntersection hit{ getHit(world.getAllIntersections(ray)).value(), ray };
+        const gfx::ShadowRayStatistics statistics_before{ world.getShadowRayStatistics() };
+        const gfx::Color surface_color{ world.calculateSurfaceColorAt(hit) };
+        const gfx::ShadowRayStatistics statistics_after{ world.getShadowRayStatistics() };
+
+        const gfx::Color ambient_color{ gfx::calculateSurfaceColor(hit,
+                                                                   gfx::PointLight{ gfx::white(),
+                                                                                    gfx::createPoint(0, 10, 0) },
+                                                                   hit.getOverPoint(),
+                                                                   hit.getSurfaceNormal(),
+                                                                   hit.getViewVector(),
+                                                                   true) };
+        return std::tuple{ surface_color,
+                           ambient_color,
+                           statistics_after.shadow_ray_count - statistics_before.shadow_ray_count,
+                           statistics_after.penumbra_count - statistics_before.penumbra_count };
+    } };
+
+    // The sphere hides the whole light from the point below it, so only the probes are cast
+    const auto [ umbra_color, umbra_ambient_color, umbra_ray_count, umbra_penumbra_count ] { shade_floor(0) };
+    EXPECT_EQ(umbra_color, umbra_ambient_color);
+    EXPECT_EQ(umbra_ray_count, gfx::AREA_LIGHT_PROBE_COUNT);
+    EXPECT_EQ(umbra_penumbra_count, 0);
+
+    // The whole light is visible from a point far from the sphere
+    const auto [ lit_color, lit_ambient_color, lit_ray_count, lit_penumbra_count ] { shade_floor(10) };
+    EXPECT_GT(lit_color.r(), lit_ambient_color.r());
+    EXPECT_EQ(lit_ray_count, gfx::AREA_LIGHT_PROBE_COUNT);
+    EXPECT_EQ(lit_penumbra_count, 0);
+
+    // Only part of the light is visible from a point near the edge of the shadow of the sphere
+    const auto [ penumbra_color, penumbra_ambient_color, penumbra_ray_count, penumbra_count ] { shade_floor(2) };
+    EXPECT_GT(penumbra_color.r(), penumbra_ambient_color.r());
+    EXPECT_EQ(penumbra_ray_count, area_light.sample_count);
+    EXPECT_EQ(penumbra_count, 1);
+    EXPECT_EQ(world.getShadowRayStatistics().area_light_evaluation_count, 3);
+
+    // Copies of a scene count their own shadow rays
+    const gfx::World world_copy{ world };
+    EXPECT_EQ(world_copy.getShadowRayStatistics().shadow_ray_count, 0);
 }
\ No newline at end of file
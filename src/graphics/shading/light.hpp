@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstddef>
+#include <limits>
+
 #include "color.hpp"
 #include "vector4.hpp"
 
@@ -7,5 +10,36 @@ namespace gfx {
     struct PointLight {
         Color intensity{ 1, 1, 1 };
         Vector4 position{ 0, 0, 0, 1 };
+        double range{ std::numeric_limits<double>::infinity() };    // The distance at which the light fades out
+    };
+
+    // The shapes an area light can take
+    enum class AreaLightShape
+    {
+        Rectangle,
+        Sphere
+    };
+
+    // A light with an extent, which casts soft shadows
+    struct AreaLight {
+        AreaLightShape shape{ AreaLightShape::Rectangle };
+        Color intensity{ 1, 1, 1 };
+        Vector4 position{ 0, 0, 0, 1 };         // The center of the light
+        Vector4 edge_u{ 1, 0, 0, 0 };           // The full edges of a rectangular light
+        Vector4 edge_v{ 0, 0, 1, 0 };
+        double radius{ 1 };                     // The radius of a spherical light
+        size_t sample_count{ 16 };              // Shadow rays cast toward the light from points in its penumbra
+    };
+
+    // The number of shadow rays first cast toward an area light to find whether a point is fully lit, fully shadowed
+    // or in its penumbra
+    inline constexpr size_t AREA_LIGHT_PROBE_COUNT{ 4 };
+
+    // Controls how many of the lights of a scene are shaded at each surface point
+    struct LightSamplingSettings {
+        double contribution_threshold{ 0 };     // Lights with a lower estimated contribution are only shaded as
+                                                // ambient light, without a shadow ray
+        size_t sampled_light_count{ 0 };        // When non-zero and exceeded by the number of point lights, this
+                                                // many lights are sampled per point from the scene's light BVH
     };
 }
\ No newline at end of file
@@ -0,0 +1,257 @@
+#include "light_bvh.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+#include "shading_functions.hpp"
+#include "util_functions.hpp"
+
+namespace gfx {
+    // Returns an upper bound on the cosine between a surface normal and the direction from a point to anywhere in a
+    // box, found from the cone of directions toward the sphere enclosing the box. The bound is exact when the box
+    // encloses a single point, and negative when the whole box lies behind the surface.
+    static double calculateCosineBound(const BoundingBox& box, const Vector4& point, const Vector4& surface_normal)
+    {
+        const Vector4 box_diagonal{ box.getMaxExtentPoint() - box.getMinExtentPoint() };
+        const Vector4 box_center{ box.getMinExtentPoint() + box_diagonal * 0.5 };
+        const double box_radius{ box_diagonal.magnitude() * 0.5 };
+        const Vector4 center_displacement{ box_center - point };
+        const double center_distance{ center_displacement.magnitude() };
+        if (utils::isLessOrEqual(center_distance, box_radius)) {
+            return 1;
+        }
+
+        const double normal_angle{
+                std::acos(std::clamp(dotProduct(center_displacement / center_distance, surface_normal), -1.0, 1.0)) };
+        const double cone_angle{ std::asin(box_radius / center_distance) };
+        return std::cos(std::max(normal_angle - cone_angle, 0.0));
+    }
+
+    // Returns the distance from a point to the nearest point of a box, which is zero for points inside the box
+    static double calculateBoxDistance(const BoundingBox& box, const Vector4& point)
+    {
+        const double distance_x{ std::max({ box.getMinX() - point.x(), 0.0, point.x() - box.getMaxX() }) };
+        const double distance_y{ std::max({ box.getMinY() - point.y(), 0.0, point.y() - box.getMaxY() }) };
+        const double distance_z{ std::max({ box.getMinZ() - point.z(), 0.0, point.z() - box.getMaxZ() }) };
+        return std::sqrt(distance_x * distance_x + distance_y * distance_y + distance_z * distance_z);
+    }
+
+    // Standard Constructor
+    LightBVH::LightBVH(const std::span<const PointLight> lights)
+            : m_lights{ lights.begin(), lights.end() }
+    {
+        if (m_lights.empty()) {
+            return;
+        }
+
+        std::vector<uint32_t> light_indices(m_lights.size());
+        for (size_t i = 0; i < light_indices.size(); ++i) {
+            light_indices[i] = static_cast<uint32_t>(i);
+        }
+
+        m_nodes.reserve(2 * m_lights.size());
+        this->buildNode(light_indices, 0, light_indices.size());
+        m_nodes.shrink_to_fit();
+    }
+
+    // Recursive Node Builder
+    uint32_t LightBVH::buildNode(std::vector<uint32_t>& light_indices, const size_t begin, const size_t end)
+    {
+        const auto node_index{ static_cast<uint32_t>(m_nodes.size()) };
+        m_nodes.emplace_back();
+
+        // Total the lights in this node, enclosing their positions and the regions they reach
+        Node node{ };
+        node.is_unbounded = true;
+        size_t unbounded_light_count{ 0 };
+        for (size_t i = begin; i < end; ++i) {
+            const PointLight& light{ m_lights[light_indices[i]] };
+            node.bounds.addPoint(light.position);
+            node.intensity += light.intensity;
+            node.power += estimateLightContribution(light.intensity, 1);
+            node.range = std::max(node.range, light.range);
+            if (std::isinf(light.range)) {
+                ++unbounded_light_count;
+                node.influence_bounds = BoundingBox{ -std::numeric_limits<double>::infinity(),
+                                                     -std::numeric_limits<double>::infinity(),
+                                                     -std::numeric_limits<double>::infinity(),
+                                                     std::numeric_limits<double>::infinity(),
+                                                     std::numeric_limits<double>::infinity(),
+                                                     std::numeric_limits<double>::infinity() };
+            } else {
+                node.is_unbounded = false;
+                const Vector4 range_extent{ light.range, light.range, light.range, 0 };
+                node.influence_bounds.mergeWithBox(BoundingBox{ light.position - range_extent,
+                                                                light.position + range_extent });
+            }
+        }
+
+        // Each leaf holds a single light
+        const size_t light_count{ end - begin };
+        if (light_count == 1) {
+            node.offset = light_indices[begin];
+            node.is_leaf = true;
+            m_nodes[node_index] = node;
+            return node_index;
+        }
+
+        size_t middle{ begin + light_count / 2 };
+        if (unbounded_light_count > 0 && unbounded_light_count < light_count) {
+            // Separate the lights which reach every point from those which do not
+            middle = static_cast<size_t>(std::distance(
+                    light_indices.begin(),
+                    std::stable_partition(light_indices.begin() + static_cast<std::ptrdiff_t>(begin),
+                                          light_indices.begin() + static_cast<std::ptrdiff_t>(end),
+                                          [&](const uint32_t light_index) {
+                                              return std::isinf(m_lights[light_index].range);
+                                          })));
+        } else {
+            // Split at the median position along the axis where the lights are most spread out
+            const std::array<double, 3> position_spread{ node.bounds.getMaxX() - node.bounds.getMinX(),
+                                                         node.bounds.getMaxY() - node.bounds.getMinY(),
+                                                         node.bounds.getMaxZ() - node.bounds.getMinZ() };
+            const auto split_axis{ std::distance(position_spread.begin(),
+                                                 std::max_element(position_spread.begin(), position_spread.end())) };
+
+            std::nth_element(light_indices.begin() + static_cast<std::ptrdiff_t>(begin),
+                             light_indices.begin() + static_cast<std::ptrdiff_t>(middle),
+                             light_indices.begin() + static_cast<std::ptrdiff_t>(end),
+                             [&](const uint32_t lhs, const uint32_t rhs) {
+                                 const Vector4& lhs_position{ m_lights[lhs].position };
+                                 const Vector4& rhs_position{ m_lights[rhs].position };
+                                 switch (split_axis) {
+                                     case 0:
+                                         return lhs_position.x() < rhs_position.x();
+                                     case 1:
+                                         return lhs_position.y() < rhs_position.y();
+                                     default:
+                                         return lhs_position.z() < rhs_position.z();
+                                 }
+                             });
+        }
+
+        // The left child is built first so that it is stored directly after this node
+        this->buildNode(light_indices, begin, middle);
+        node.offset = this->buildNode(light_indices, middle, end);
+        m_nodes[node_index] = node;
+
+        return node_index;
+    }
+
+    // Total Intensity Calculator
+    Color LightBVH::calculateTotalIntensityAt(const Vector4& point) const
+    {
+        Color total_intensity{ 0, 0, 0 };
+        if (m_nodes.empty()) {
+            return total_intensity;
+        }
+
+        // Depth-first traversal using a fixed-size stack. Median splits keep the tree balanced, and the split
+        // separating unbounded lights happens at most once along any path, so 64 entries suffice for 32-bit indices.
+        std::array<uint32_t, 64> node_stack{ };
+        size_t stack_size{ 0 };
+        node_stack[stack_size++] = 0;
+        while (stack_size > 0) {
+            const uint32_t node_index{ node_stack[--stack_size] };
+            const Node& node{ m_nodes[node_index] };
+
+            // Unbounded subtrees reach every point at full intensity, so they are never descended into
+            if (node.is_unbounded) {
+                total_intensity += node.intensity;
+            } else if (node.influence_bounds.containsPoint(point)) {
+                if (node.isLeaf()) {
+                    const PointLight& light{ m_lights[node.offset] };
+                    const double light_distance{ (light.position - point).magnitude() };
+                    total_intensity += light.intensity * calculateLightAttenuation(light, light_distance);
+                } else {
+                    node_stack[stack_size++] = node.offset;
+                    node_stack[stack_size++] = node_index + 1;
+                }
+            }
+        }
+
+        return total_intensity;
+    }
+
+    // Light Sampler
+    std::optional<LightSample> LightBVH::sampleLight(const Vector4& point,
+                                                     const Vector4& surface_normal,
+                                                     double sample_value,
+                                                     const double contribution_threshold) const
+    {
+        if (m_nodes.empty()) {
+            return std::nullopt;
+        }
+
+        // Descend to a leaf, choosing each child in proportion to its importance and reusing the sample value by
+        // rescaling the part of [0, 1) which chose the child back to [0, 1)
+        uint32_t node_index{ 0 };
+        double probability{ 1 };
+        while (!m_nodes[node_index].isLeaf()) {
+            const uint32_t left_child_index{ node_index + 1 };
+            const uint32_t right_child_index{ m_nodes[node_index].offset };
+            const double left_importance{ this->estimateNodeImportance(
+                    m_nodes[left_child_index], point, surface_normal, contribution_threshold) };
+            const double right_importance{ this->estimateNodeImportance(
+                    m_nodes[right_child_index], point, surface_normal, contribution_threshold) };
+            if (left_importance + right_importance <= 0) {
+                return std::nullopt;
+            }
+
+            const double left_probability{ left_importance / (left_importance + right_importance) };
+            if (sample_value < left_probability) {
+                sample_value /= left_probability;
+                probability *= left_probability;
+                node_index = left_child_index;
+            } else {
+                sample_value = (sample_value - left_probability) / (1 - left_probability);
+                probability *= 1 - left_probability;
+                node_index = right_child_index;
+            }
+            sample_value = std::min(sample_value, std::nextafter(1.0, 0.0));
+        }
+
+        // The estimates of interior nodes are only bounds, so the chosen light may still not reach the point
+        const Node& leaf{ m_nodes[node_index] };
+        if (this->estimateNodeImportance(leaf, point, surface_normal, contribution_threshold) <= 0) {
+            return std::nullopt;
+        }
+
+        return LightSample{ leaf.offset, probability };
+    }
+
+    // Node Importance Estimator
+    double LightBVH::estimateNodeImportance(const Node& node,
+                                            const Vector4& point,
+                                            const Vector4& surface_normal,
+                                            const double contribution_threshold) const
+    {
+        if (!node.influence_bounds.containsPoint(point)) {
+            return 0;
+        }
+
+        // Leaves are estimated the same way as when every light is shaded, including the contribution threshold
+        if (node.isLeaf()) {
+            const PointLight& light{ m_lights[node.offset] };
+            const Vector4 light_displacement{ light.position - point };
+            const double attenuation{ calculateLightAttenuation(light, light_displacement.magnitude()) };
+            const double light_normal_cosine{ dotProduct(normalize(light_displacement), surface_normal) };
+            const double contribution{ estimateLightContribution(light.intensity * attenuation, light_normal_cosine) };
+            return utils::isLess(light_normal_cosine, 0.0) || contribution < contribution_threshold ? 0 : contribution;
+        }
+
+        // Interior nodes are bounded by their full power, lit at the smallest angle any of their lights could make and
+        // attenuated as if their longest-reaching light were at the nearest point of their bounds, so nearer clusters
+        // are preferred over equally powerful ones further away
+        const double cosine_bound{ calculateCosineBound(node.bounds, point, surface_normal) };
+        if (utils::isLess(cosine_bound, 0.0)) {
+            return 0;
+        }
+
+        const double attenuation_bound{
+                calculateLightAttenuation(PointLight{ .range = node.range }, calculateBoxDistance(node.bounds, point)) };
+        return node.power * cosine_bound * attenuation_bound;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "bounding_box.hpp"
+#include "light.hpp"
+#include "color.hpp"
+#include "vector4.hpp"
+
+namespace gfx {
+    // A light chosen from a light BVH, along with the probability of it having been chosen
+    struct LightSample
+    {
+        size_t light_index{ 0 };
+        double probability{ 0 };
+    };
+
+    // A hierarchy over the point lights of a scene, with each node storing the total power and bounds of the lights
+    // below it. Choosing a light to sample at a surface point descends a single path from the root, picking each child
+    // in proportion to an estimate of how much its lights add to the point, so it takes O(log L) time for L lights.
+    class LightBVH
+    {
+    public:
+        /* Light BVH Node */
+        // Nodes are stored depth-first in a single array, so the left child of an interior node always immediately
+        // follows its parent and only the index of the right child needs to be stored
+
+        struct Node
+        {
+            BoundingBox bounds{ };              // Encloses the positions of the lights below the node
+            BoundingBox influence_bounds{ };    // Encloses every point the lights below the node can reach
+            Color intensity{ 0, 0, 0 };         // The total intensity of the lights below the node
+            double power{ 0 };                  // The total luminance of the lights below the node
+            double range{ 0 };                  // The largest range of the lights below the node
+            uint32_t offset{ 0 };               // Index of the right child (interior nodes) or the light (leaves)
+            bool is_leaf{ false };
+            bool is_unbounded{ false };         // True if every light below the node has an infinite range
+
+            [[nodiscard]] bool isLeaf() const
+            { return is_leaf; }
+        };
+
+        /* Constructors */
+
+        // Default Constructor
+        LightBVH() = default;
+
+        // Builds a hierarchy with a single light in each leaf. Lights with infinite and finite ranges are kept in
+        // separate subtrees, so that queries never need to descend into the lights which reach every point.
+        explicit LightBVH(std::span<const PointLight> lights);
+
+        // Copy Constructor
+        LightBVH(const LightBVH&) = default;
+
+        // Move Constructor
+        LightBVH(LightBVH&&) = default;
+
+        /* Destructor */
+
+        ~LightBVH() = default;
+
+        /* Assignment Operators */
+
+        LightBVH& operator=(const LightBVH&) = default;
+        LightBVH& operator=(LightBVH&&) = default;
+
+        /* Accessors */
+
+        [[nodiscard]] bool isEmpty() const
+        { return m_nodes.empty(); }
+
+        [[nodiscard]] size_t getNodeCount() const
+        { return m_nodes.size(); }
+
+        [[nodiscard]] const Node& getNodeAt(const size_t index) const
+        { return m_nodes.at(index); }
+
+        [[nodiscard]] size_t getLightCount() const
+        { return m_lights.size(); }
+
+        /* Light Selection Operations */
+
+        // Returns the total intensity of the lights reaching a point, attenuated by their distances. Only the lights
+        // with finite ranges reaching the point are visited, so the time taken grows with those lights alone.
+        [[nodiscard]] Color calculateTotalIntensityAt(const Vector4& point) const;
+
+        // Chooses a light to sample at a surface point from a value in [0, 1), in proportion to its estimated
+        // contribution to the point. Lights behind the surface, out of range or contributing less than the threshold
+        // are never chosen. Returns nothing if the descent ends at such a light, or no light reaches the point.
+        [[nodiscard]] std::optional<LightSample> sampleLight(const Vector4& point,
+                                                             const Vector4& surface_normal,
+                                                             double sample_value,
+                                                             double contribution_threshold = 0) const;
+
+    private:
+        /* Data Members */
+
+        std::vector<Node> m_nodes{ };
+        std::vector<PointLight> m_lights{ };
+
+        /* Helper Methods */
+
+        // Recursively builds the subtree for the lights in the index range [begin, end) of the passed-in list of
+        // light indices, returning its index
+        uint32_t buildNode(std::vector<uint32_t>& light_indices, size_t begin, size_t end);
+
+        // Returns an upper bound on the contribution of the lights below a node to a surface point, which is exact
+        // for leaves
+        [[nodiscard]] double estimateNodeImportance(const Node& node,
+                                                    const Vector4& point,
+                                                    const Vector4& surface_normal,
+                                                    double contribution_threshold) const;
+    };
+}
\ No newline at end of file
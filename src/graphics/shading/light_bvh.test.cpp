@@ -0,0 +1,176 @@
+#include "gtest/gtest.h"
+#include "light_bvh.hpp"
+
+#include <vector>
+#include <optional>
+
+#include "light.hpp"
+#include "shading_functions.hpp"
+#include "vector4.hpp"
+#include "color.hpp"
+
+// Returns a grid of lights above the XZ plane, with a range on every other light
+static std::vector<gfx::PointLight> createLightGrid()
+{
+    std::vector<gfx::PointLight> lights{ };
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            lights.push_back(gfx::PointLight{ gfx::Color{ 0.1 * (i + 1), 0.1 * (j + 1), 0.5 },
+                                              gfx::createPoint(4 * i, 2, 4 * j) });
+            if ((i + j) % 2 == 0) {
+                lights.back().range = 6;
+            }
+        }
+    }
+
+    return lights;
+}
+
+// Tests building a light BVH, with a single light in each leaf
+TEST(GraphicsLightBVH, Build)
+{
+    const std::vector<gfx::PointLight> lights{ createLightGrid() };
+    const gfx::LightBVH light_bvh{ lights };
+
+    EXPECT_TRUE(gfx::LightBVH{ }.isEmpty());
+    ASSERT_FALSE(light_bvh.isEmpty());
+    EXPECT_EQ(light_bvh.getLightCount(), lights.size());
+    EXPECT_EQ(light_bvh.getNodeCount(), 2 * lights.size() - 1);
+
+    double power_expected{ 0 };
+    for (const gfx::PointLight& light : lights) {
+        power_expected += gfx::estimateLightContribution(light.intensity, 1);
+    }
+    EXPECT_DOUBLE_EQ(light_bvh.getNodeAt(0).power, power_expected);
+    EXPECT_FALSE(light_bvh.getNodeAt(0).is_unbounded);
+
+    // Lights with and without ranges are split into separate subtrees at the root
+    EXPECT_TRUE(light_bvh.getNodeAt(1).is_unbounded);
+    EXPECT_FALSE(light_bvh.getNodeAt(light_bvh.getNodeAt(0).offset).is_unbounded);
+}
+
+// Tests totaling the attenuated intensities of the lights reaching a point
+TEST(GraphicsLightBVH, CalculateTotalIntensityAt)
+{
+    const std::vector<gfx::PointLight> lights{ createLightGrid() };
+    const gfx::LightBVH light_bvh{ lights };
+
+    for (const gfx::Vector4& point : { gfx::createPoint(0, 0, 0),
+                                       gfx::createPoint(5, 0, 3),
+                                       gfx::createPoint(-20, 0, 40) }) {
+        gfx::Color intensity_expected{ 0, 0, 0 };
+        for (const gfx::PointLight& light : lights) {
+            intensity_expected +=
+                    light.intensity * gfx::calculateLightAttenuation(light, (light.position - point).magnitude());
+        }
+
+        EXPECT_EQ(light_bvh.calculateTotalIntensityAt(point), intensity_expected);
+    }
+}
+
+// Tests that sampling a light BVH chooses each light reaching a point in proportion to its contribution
+TEST(GraphicsLightBVH, SampleLight)
+{
+    const std::vector<gfx::PointLight> lights{ createLightGrid() };
+    const gfx::LightBVH light_bvh{ lights };
+    const gfx::Vector4 point{ gfx::createPoint(5, 0, 3) };
+    const gfx::Vector4 surface_normal{ gfx::createVector(0, 1, 0) };
+
+    // Count the lights chosen from evenly spaced sample values
+    constexpr size_t sample_count{ 10000 };
+    std::vector<size_t> light_sample_counts(lights.size(), 0);
+    for (size_t i = 0; i < sample_count; ++i) {
+        const double sample_value{ (static_cast<double>(i) + 0.5) / sample_count };
+        const std::optional<gfx::LightSample> light_sample{
+            light_bvh.sampleLight(point, surface_normal, sample_value) };
+        if (light_sample) {
+            ASSERT_LT(light_sample->light_index, lights.size());
+            EXPECT_GT(light_sample->probability, 0);
+            ++light_sample_counts[light_sample->light_index];
+        }
+    }
+
+    // Lights out of range are never chosen
+    size_t chosen_sample_count{ 0 };
+    for (size_t i = 0; i < lights.size(); ++i) {
+        const gfx::PointLight& light{ lights[i] };
+        if (gfx::calculateLightAttenuation(light, (light.position - point).magnitude()) <= 0) {
+            EXPECT_EQ(light_sample_counts[i], 0);
+        }
+        chosen_sample_count += light_sample_counts[i];
+    }
+    EXPECT_GT(chosen_sample_count, 0);
+
+    // Lights behind the surface are never chosen
+    EXPECT_FALSE(light_bvh.sampleLight(point, gfx::createVector(0, -1, 0), 0.5).has_value());
+
+    // A single light in range is always chosen with certainty, unless it is too dim
+    const std::vector<gfx::PointLight> single_light{ lights.front() };
+    const gfx::LightBVH single_light_bvh{ single_light };
+    const gfx::Vector4 single_light_point{ gfx::createPoint(1, 0, 1) };
+    const std::optional<gfx::LightSample> light_sample{
+        single_light_bvh.sampleLight(single_light_point, surface_normal, 0.7) };
+    ASSERT_TRUE(light_sample.has_value());
+    EXPECT_EQ(light_sample->light_index, 0);
+    EXPECT_DOUBLE_EQ(light_sample->probability, 1);
+    EXPECT_FALSE(single_light_bvh.sampleLight(single_light_point, surface_normal, 0.7, 10).has_value());
+    EXPECT_FALSE(single_light_bvh.sampleLight(point, surface_normal, 0.7).has_value());
+}
+
+// Tests that the probabilities of choosing each light sum to one over the lights which may be chosen
+TEST(GraphicsLightBVH, SampleLightProbabilities)
+{
+    const std::vector<gfx::PointLight> lights{ createLightGrid() };
+    const gfx::LightBVH light_bvh{ lights };
+    const gfx::Vector4 point{ gfx::createPoint(-3, 0, -3) };
+    const gfx::Vector4 surface_normal{ gfx::createVector(0, 1, 0) };
+
+    // Weighting each chosen light by the inverse of its probability gives an unbiased estimate of the light count
+    constexpr size_t sample_count{ 20000 };
+    double estimated_light_count{ 0 };
+    for (size_t i = 0; i < sample_count; ++i) {
+        const double sample_value{ (static_cast<double>(i) + 0.5) / sample_count };
+        const std::optional<gfx::LightSample> light_sample{
+            light_bvh.sampleLight(point, surface_normal, sample_value) };
+        if (light_sample) {
+            estimated_light_count += 1 / light_sample->probability;
+        }
+    }
+    estimated_light_count /= sample_count;
+
+    size_t reaching_light_count{ 0 };
+    for (const gfx::PointLight& light : lights) {
+        if (gfx::calculateLightAttenuation(light, (light.position - point).magnitude()) > 0) {
+            ++reaching_light_count;
+        }
+    }
+    EXPECT_NEAR(estimated_light_count, static_cast<double>(reaching_light_count), 0.05);
+}
+// Tests that the nearer of two equally powerful clusters of lights is chosen more often
+TEST(GraphicsLightBVH, SampleNearerCluster)
+{
+    std::vector<gfx::PointLight> lights{ };
+    for (const double height : { 2.0, 8.0 }) {
+        for (const double x : { -0.5, 0.5 }) {
+            lights.push_back(gfx::PointLight{ gfx::Color{ 1, 1, 1 }, gfx::createPoint(x, height, 0), 10 });
+        }
+    }
+    const gfx::LightBVH light_bvh{ lights };
+    const gfx::Vector4 point{ gfx::createPoint(0, 0, 0) };
+    const gfx::Vector4 surface_normal{ gfx::createVector(0, 1, 0) };
+
+    // Both clusters lie straight above the point, so only their distances tell them apart
+    constexpr size_t sample_count{ 1000 };
+    size_t near_sample_count{ 0 };
+    for (size_t i = 0; i < sample_count; ++i) {
+        const double sample_value{ (static_cast<double>(i) + 0.5) / sample_count };
+        const std::optional<gfx::LightSample> light_sample{
+            light_bvh.sampleLight(point, surface_normal, sample_value) };
+        ASSERT_TRUE(light_sample.has_value());
+        if (lights[light_sample->light_index].position.y() < 5) {
+            ++near_sample_count;
+        }
+    }
+
+    EXPECT_GT(near_sample_count, sample_count * 4 / 5);
+}
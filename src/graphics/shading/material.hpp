@@ -85,7 +85,7 @@ namespace gfx {
         // Move Assignment Operator
         Material& operator=(Material&& rhs) noexcept
         {
-            if (rhs == *this)
+            if (this == &rhs)
                 return *this;
 
             m_texture = std::move(rhs.m_texture);
@@ -99,6 +99,10 @@ namespace gfx {
         [[nodiscard]] const Texture& getTexture() const
         { return *m_texture; }
 
+        // Returns the owning pointer to the texture, allowing materials to share a single texture instance
+        [[nodiscard]] const std::shared_ptr<Texture>& getTexturePtr() const
+        { return m_texture; }
+
         [[nodiscard]] const MaterialProperties& getProperties() const
         { return m_properties; }
 
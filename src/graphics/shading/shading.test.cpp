@@ -137,6 +137,79 @@ TEST(GraphicsShading, SurfaceInShadow)
     EXPECT_EQ(color_actual, color_expected);
 }
 
+// Tests the attenuation of lights with and without a range
+TEST(GraphicsShading, CalculateLightAttenuation)
+{
+    const gfx::PointLight infinite_light{ gfx::Color{ 1, 1, 1 }, gfx::createPoint(0, 0, -10) };
+    const gfx::PointLight ranged_light{ gfx::Color{ 1, 1, 1 }, gfx::createPoint(0, 0, -10), 10 };
+
+    EXPECT_FLOAT_EQ(gfx::calculateLightAttenuation(infinite_light, 1000), 1);
+    EXPECT_FLOAT_EQ(gfx::calculateLightAttenuation(ranged_light, 0), 1);
+    EXPECT_FLOAT_EQ(gfx::calculateLightAttenuation(ranged_light, 5), 0.5625);
+    EXPECT_FLOAT_EQ(gfx::calculateLightAttenuation(ranged_light, 10), 0);
+    EXPECT_FLOAT_EQ(gfx::calculateLightAttenuation(ranged_light, 20), 0);
+
+    // The attenuation scales all of the light reaching a surface, and none reaches surfaces beyond the range
+    const gfx::Sphere sphere{ };
+    const gfx::Vector4 surface_position{ 0, 0, 0, 1 };
+    const gfx::Vector4 surface_normal{ 0, 0, -1, 0 };
+    const gfx::Vector4 view_vector{ 0, 0, -1, 0 };
+    const gfx::PointLight near_light{ gfx::Color{ 1, 1, 1 }, gfx::createPoint(0, 0, -5), 10 };
+
+    const gfx::Color color_expected{ 1.06875, 1.06875, 1.06875 };
+    EXPECT_EQ(gfx::calculateSurfaceColor(sphere, near_light, surface_position, surface_normal, view_vector),
+              color_expected);
+    EXPECT_EQ(gfx::calculateSurfaceColor(sphere, ranged_light, surface_position, surface_normal, view_vector),
+              gfx::black());
+}
+
+// Tests the positions of samples on rectangular and spherical area lights
+TEST(GraphicsShading, CalculateAreaLightSamplePosition)
+{
+    const gfx::AreaLight rectangle_light{ .position = gfx::createPoint(0, 10, 0),
+                                          .edge_u = gfx::createVector(2, 0, 0),
+                                          .edge_v = gfx::createVector(0, 0, 4) };
+    const gfx::Vector4 lit_point{ gfx::createPoint(0, 0, 0) };
+
+    EXPECT_EQ(gfx::calculateAreaLightSamplePosition(rectangle_light, lit_point, 0, 0), gfx::createPoint(-1, 10, -2));
+    EXPECT_EQ(gfx::calculateAreaLightSamplePosition(rectangle_light, lit_point, 0.5, 0.5), gfx::createPoint(0, 10, 0));
+    EXPECT_EQ(gfx::calculateAreaLightSamplePosition(rectangle_light, lit_point, 1, 0.25), gfx::createPoint(1, 10, -1));
+
+    // Spherical lights are sampled on the disk facing the lit point
+    const gfx::AreaLight sphere_light{ .shape = gfx::AreaLightShape::Sphere,
+                                       .position = gfx::createPoint(0, 10, 0),
+                                       .radius = 2 };
+    EXPECT_EQ(gfx::calculateAreaLightSamplePosition(sphere_light, lit_point, 0, 0.3), gfx::createPoint(0, 10, 0));
+    for (const double v : { 0.0, 0.25, 0.6, 0.9 }) {
+        const gfx::Vector4 sample_position{ gfx::calculateAreaLightSamplePosition(sphere_light, lit_point, 1, v) };
+        EXPECT_FLOAT_EQ(sample_position.y(), 10);
+        EXPECT_FLOAT_EQ((sample_position - sphere_light.position).magnitude(), 2);
+    }
+}
+
+// Tests finding whether an area light lies entirely behind a surface
+TEST(GraphicsShading, IsAreaLightBehind)
+{
+    const gfx::Vector4 surface_position{ gfx::createPoint(0, 0, 0) };
+    const gfx::Vector4 surface_normal{ gfx::createVector(0, 1, 0) };
+
+    const gfx::AreaLight tilted_light{ .position = gfx::createPoint(0, -1, 0),
+                                       .edge_u = gfx::createVector(4, 4, 0),
+                                       .edge_v = gfx::createVector(0, 0, 1) };
+    const gfx::AreaLight low_light{ .position = gfx::createPoint(0, -1, 0) };
+    EXPECT_FALSE(gfx::isAreaLightBehind(tilted_light, surface_position, surface_normal));
+    EXPECT_TRUE(gfx::isAreaLightBehind(low_light, surface_position, surface_normal));
+
+    const gfx::AreaLight large_sphere_light{ .shape = gfx::AreaLightShape::Sphere,
+                                             .position = gfx::createPoint(3, -1, 0),
+                                             .radius = 2 };
+    const gfx::AreaLight small_sphere_light{ .shape = gfx::AreaLightShape::Sphere,
+                                             .position = gfx::createPoint(3, -1, 0),
+                                             .radius = 0.5 };
+    EXPECT_FALSE(gfx::isAreaLightBehind(large_sphere_light, surface_position, surface_normal));
+    EXPECT_TRUE(gfx::isAreaLightBehind(small_sphere_light, surface_position, surface_normal));
+}
+
 // Tests calculating surface color on a stripe-patterned surface
 TEST(GraphicsShading, StripePatternedSurface)
 {
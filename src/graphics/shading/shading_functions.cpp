@@ -1,28 +1,105 @@
 #include "shading_functions.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <list>
-#include <unordered_map>
+#include <map>
+#include <numbers>
+#include <utility>
 
 #include "util_functions.hpp"
 
 namespace gfx {
-    Color calculateSurfaceColor(const Surface& object,
+    double calculateLightAttenuation(const PointLight& light, const double distance)
+    {
+        if (std::isinf(light.range)) {
+            return 1;
+        }
+
+        // Square a window which falls from one at the light to zero at its range
+        const double window{ std::max(1 - std::pow(distance / light.range, 2), 0.0) };
+        return window * window;
+    }
+
+    double estimateLightContribution(const Color& light_intensity, const double light_normal_cosine)
+    {
+        const double luminance{ 0.2126 * light_intensity.r() +
+                                0.7152 * light_intensity.g() +
+                                0.0722 * light_intensity.b() };
+        return luminance * std::max(light_normal_cosine, 0.0);
+    }
+
+    Vector4 calculateAreaLightSamplePosition(const AreaLight& light,
+                                             const Vector4& lit_point,
+                                             const double u,
+                                             const double v)
+    {
+        switch (light.shape) {
+            case AreaLightShape::Rectangle:
+                return light.position + light.edge_u * (u - 0.5) + light.edge_v * (v - 0.5);
+            case AreaLightShape::Sphere: {
+                // Build two axes spanning the disk facing the lit point, starting from whichever world axis is least
+                // parallel to the direction of the point
+                const Vector4 disk_normal{ normalize(lit_point - light.position) };
+                const Vector4 helper_axis{ std::abs(disk_normal.x()) < 0.9 ? createVector(1, 0, 0) :
+                                                                              createVector(0, 1, 0) };
+                const Vector4 disk_axis_u{ normalize(disk_normal.crossProduct(helper_axis)) };
+                const Vector4 disk_axis_v{ disk_normal.crossProduct(disk_axis_u) };
+
+                // Map the sample coordinates to polar coordinates which are uniform over the area of the disk
+                const double sample_radius{ light.radius * std::sqrt(u) };
+                const double sample_angle{ 2 * std::numbers::pi * v };
+                return light.position +
+                       disk_axis_u * (sample_radius * std::cos(sample_angle)) +
+                       disk_axis_v * (sample_radius * std::sin(sample_angle));
+            }
+        }
+
+        return light.position;
+    }
+
+    bool isAreaLightBehind(const AreaLight& light, const Vector4& point_position, const Vector4& surface_normal)
+    {
+        const double center_distance{ dotProduct(light.position - point_position, surface_normal) };
+        switch (light.shape) {
+            case AreaLightShape::Rectangle:
+                // The rectangle is behind the surface if all four of its corners are
+                for (const double u : { -0.5, 0.5 }) {
+                    for (const double v : { -0.5, 0.5 }) {
+                        const Vector4 corner{ light.position + light.edge_u * u + light.edge_v * v };
+                        if (utils::isGreaterOrEqual(dotProduct(corner - point_position, surface_normal), 0.0)) {
+                            return false;
+                        }
+                    }
+                }
+                return true;
+            case AreaLightShape::Sphere:
+                return utils::isLess(center_distance, -light.radius);
+        }
+
+        return utils::isLess(center_distance, 0.0);
+    }
+
+    Color calculateSurfaceColor(const Color& object_color,
+                                const MaterialProperties& material_properties,
                                 const PointLight& light,
                                 const Vector4& point_position,
                                 const Vector4& surface_normal,
                                 const Vector4& view_vector,
                                 const bool is_shadowed)
     {
+        // The intensity of the light which reaches the point
+        const Vector4 light_displacement{ light.position - point_position };
+        const Color light_intensity{
+                light.intensity * calculateLightAttenuation(light, light_displacement.magnitude()) };
+
         // The base surface color from direct light
-        const Color object_color{ object.getObjectColorAt(point_position) };
-        const Color effective_color{ object_color * light.intensity };
+        const Color effective_color{ object_color * light_intensity };
 
         // The direction vector to the light source
-        const Vector4 light_vector{ normalize(light.position - point_position) };
+        const Vector4 light_vector{ normalize(light_displacement) };
 
         // Simulate the ambient color as a percentage of the base surface color
-        const MaterialProperties& material_properties{ object.getMaterial().getProperties() };
         const Color ambient{ effective_color * material_properties.ambient };
 
         // Check if the light is on the same side of the surface as the viewpoint
@@ -40,7 +117,7 @@ namespace gfx {
             if (utils::isGreater(light_view_cosine, 0.0)) {
                 // Specular reflection is dependent on the specular exponent which is a factor of the shininess value
                 const double specular_exponent{ std::pow(light_view_cosine, material_properties.shininess) };
-                specular = light.intensity * material_properties.specular * specular_exponent;
+                specular = light_intensity * material_properties.specular * specular_exponent;
             }
         }
 
@@ -48,13 +125,47 @@ namespace gfx {
         return ambient + diffuse + specular;
     }
 
+    Color calculateSurfaceColor(const Surface& object,
+                                const PointLight& light,
+                                const Vector4& point_position,
+                                const Vector4& surface_normal,
+                                const Vector4& view_vector,
+                                const bool is_shadowed)
+    {
+        return calculateSurfaceColor(object.getObjectColorAt(point_position),
+                                     object.getMaterial().getProperties(),
+                                     light,
+                                     point_position,
+                                     surface_normal,
+                                     view_vector,
+                                     is_shadowed);
+    }
+
+    Color calculateSurfaceColor(const Intersection& intersection,
+                                const PointLight& light,
+                                const Vector4& point_position,
+                                const Vector4& surface_normal,
+                                const Vector4& view_vector,
+                                const bool is_shadowed)
+    {
+        return calculateSurfaceColor(intersection.getObjectColorAt(point_position),
+                                     intersection.getObject().getMaterial().getProperties(),
+                                     light,
+                                     point_position,
+                                     surface_normal,
+                                     view_vector,
+                                     is_shadowed);
+    }
+
     std::pair<double, double> getRefractiveIndices(const Intersection& hit,
                                                    const std::vector<Intersection>& possible_overlaps)
     {
         // The order in which objects are added must be maintained, but we use a map to facilitate quick removal
-        // of objects from the list at arbitrary positions without having to repeatedly search the list
+        // of objects from the list at arbitrary positions without having to repeatedly search the list. Instances
+        // share their surfaces, so objects are identified by both their surface and instance.
+        using ObjectKey = std::pair<const Surface*, const ClassifiedTransform*>;
         std::list<const Surface*> containing_objects_list{ };
-        std::unordered_map<const Surface*, std::list<const Surface*>::iterator> object_list_iterator_map{ };
+        std::map<ObjectKey, std::list<const Surface*>::iterator> object_list_iterator_map{ };
 
         // Assume the exited medium is air
         double n1 = 1.0;
@@ -67,15 +178,16 @@ namespace gfx {
             }
 
             const Surface* object_ptr{ &intersection.getObject() };
-            if (object_list_iterator_map.contains(object_ptr)) {
+            const ObjectKey object_key{ object_ptr, intersection.getInstanceTransform() };
+            if (object_list_iterator_map.contains(object_key)) {
                 // The ray has exited this object, remove it from the list
-                auto list_iter{ object_list_iterator_map[object_ptr] };
+                auto list_iter{ object_list_iterator_map[object_key] };
                 containing_objects_list.erase(list_iter);
-                object_list_iterator_map.erase(object_ptr);
+                object_list_iterator_map.erase(object_key);
             } else {
                 // The ray is entering this object, append it to the end of the list
                 containing_objects_list.push_back(object_ptr);
-                object_list_iterator_map[object_ptr] = std::prev(containing_objects_list.end());
+                object_list_iterator_map[object_key] = std::prev(containing_objects_list.end());
             }
 
             if (intersection == hit && !containing_objects_list.empty()) {
@@ -3,10 +3,42 @@
 #include "color.hpp"
 #include "surface.hpp"
 #include "light.hpp"
+#include "material.hpp"
 #include "vector4.hpp"
 #include "intersection.hpp"
 
 namespace gfx {
+    // Returns the fraction of a light's intensity which reaches a point at some distance from it. Lights with an
+    // infinite range do not fade, while the intensity of others falls smoothly to zero at their range.
+    [[nodiscard]] double calculateLightAttenuation(const PointLight& light, double distance);
+
+    // Returns an estimate of the direct light a light of some intensity adds to a surface it meets at an angle with a
+    // passed-in cosine, weighting its channels by their relative luminance
+    [[nodiscard]] double estimateLightContribution(const Color& light_intensity, double light_normal_cosine);
+
+    // Returns a point on an area light for a pair of sample coordinates in [0, 1). Rectangular lights are sampled
+    // across their whole surface, while spherical lights are sampled across the disk they present to the passed-in
+    // point being lit.
+    [[nodiscard]] Vector4 calculateAreaLightSamplePosition(const AreaLight& light,
+                                                           const Vector4& lit_point,
+                                                           double u,
+                                                           double v);
+
+    // Returns true if every point of an area light lies behind the surface at a point with the passed-in normal
+    [[nodiscard]] bool isAreaLightBehind(const AreaLight& light,
+                                         const Vector4& point_position,
+                                         const Vector4& surface_normal);
+
+    // Returns the color of a surface point with a known base color and material, calculated using the Phong Shading
+    // Model
+    [[nodiscard]] Color calculateSurfaceColor(const Color& object_color,
+                                              const MaterialProperties& material_properties,
+                                              const PointLight& light,
+                                              const Vector4& point_position,
+                                              const Vector4& surface_normal,
+                                              const Vector4& view_vector,
+                                              bool is_shadowed = false);
+
     // Returns the surface color of an object at a surface point, calculated using the Phong Shading Model
     [[nodiscard]] Color calculateSurfaceColor(const Surface& object,
                                               const PointLight& light,
@@ -15,6 +47,14 @@ namespace gfx {
                                               const Vector4& view_vector,
                                               bool is_shadowed = false);
 
+    // Returns the surface color at a ray-object intersection, accounting for any instance the intersected surface
+    // was hit through
+    [[nodiscard]] Color calculateSurfaceColor(const Intersection& intersection,
+                                              const PointLight& light,
+                                              const Vector4& point_position,
+                                              const Vector4& surface_normal,
+                                              const Vector4& view_vector,
+                                              bool is_shadowed = false);
 
     // Returns a pair containing the refractive indices for a ray-object intersection within
     // a group of intersections of potentially overlapping objects
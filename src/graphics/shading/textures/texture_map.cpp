@@ -1,15 +1,43 @@
 #include "texture_map.hpp"
 
-#include <cmath>
+#include <stdexcept>
+#include <utility>
 
 namespace gfx {
-    Vector3 ProjectionMap(const Vector4& object_point)
+    // Standard Constructor
+    TextureMap::TextureMap(const TextureMapType type)
+            : m_type{ type }
     {
-        return create2DPoint(object_point.x(), object_point.y());
+        if (type == TextureMapType::Custom) {
+            throw std::invalid_argument("Custom texture maps must be created from their mapping function");
+        }
     }
 
-    Vector3 PlanarMap(const Vector4& object_point)
+    // Function Pointer Constructor
+    TextureMap::TextureMap(Vector3 (* const mapping_function)(const Vector4&))
     {
-        return create2DPoint(std::fmod(object_point.x(), 1), std::fmod(object_point.z(), 1));
+        if (mapping_function == ProjectionMap) {
+            m_type = TextureMapType::Projection;
+        } else if (mapping_function == PlanarMap) {
+            m_type = TextureMapType::Planar;
+        } else if (mapping_function == SphericalMap) {
+            m_type = TextureMapType::Spherical;
+        } else if (mapping_function == CylindricalMap) {
+            m_type = TextureMapType::Cylindrical;
+        } else if (mapping_function == CubicMap) {
+            m_type = TextureMapType::Cubic;
+        } else {
+            *this = TextureMap{ MappingFunction{ mapping_function } };
+        }
+    }
+
+    // Custom Mapping Constructor
+    TextureMap::TextureMap(MappingFunction mapping_function)
+            : m_type{ TextureMapType::Custom },
+              m_mapping_function{ std::make_shared<const MappingFunction>(std::move(mapping_function)) }
+    {
+        if (!*m_mapping_function) {
+            throw std::invalid_argument("Custom texture maps require a mapping function");
+        }
     }
 }
\ No newline at end of file
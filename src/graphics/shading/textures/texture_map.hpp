@@ -1,16 +1,139 @@
 #pragma once
 
+#include <cmath>
 #include <functional>
+#include <memory>
+#include <numbers>
 
 #include "vector3.hpp"
 #include "vector4.hpp"
 
 namespace gfx {
-    using TextureMap = std::function<Vector3(const Vector4&)>;
+    /* Texture Mapping Functions */
 
     // A direct mapping of the object x- and y-coordinates to texture space
-    [[nodiscard]] Vector3 ProjectionMap(const Vector4& object_point);
+    [[nodiscard]] inline Vector3 ProjectionMap(const Vector4& object_point)
+    {
+        return create2DPoint(object_point.x(), object_point.y());
+    }
 
-    // A planar projection of the
-    [[nodiscard]] Vector3 PlanarMap(const Vector4& object_point);
-}
+    // A planar projection of the object x- and z-coordinates, repeating every unit
+    [[nodiscard]] inline Vector3 PlanarMap(const Vector4& object_point)
+    {
+        return create2DPoint(std::fmod(object_point.x(), 1), std::fmod(object_point.z(), 1));
+    }
+
+    // The longitude and latitude of the object point around the origin, each scaled to [0, 1]
+    [[nodiscard]] inline Vector3 SphericalMap(const Vector4& object_point)
+    {
+        const double theta{ std::atan2(object_point.x(), object_point.z()) };
+        const double radius{ std::sqrt(object_point.x() * object_point.x() +
+                                       object_point.y() * object_point.y() +
+                                       object_point.z() * object_point.z()) };
+        const double phi{ radius > 0 ? std::acos(object_point.y() / radius) : 0.0 };
+        return create2DPoint(0.5 - theta / (2 * std::numbers::pi), 1 - phi / std::numbers::pi);
+    }
+
+    // The angle of the object point around the y-axis scaled to [0, 1], and its height repeating every unit
+    [[nodiscard]] inline Vector3 CylindricalMap(const Vector4& object_point)
+    {
+        const double theta{ std::atan2(object_point.x(), object_point.z()) };
+        return create2DPoint(0.5 - theta / (2 * std::numbers::pi), object_point.y() - std::floor(object_point.y()));
+    }
+
+    // The position of the object point within the face of the unit cube it lies on, seen from outside the cube,
+    // with each coordinate scaled to [0, 1]
+    [[nodiscard]] inline Vector3 CubicMap(const Vector4& object_point)
+    {
+        const double x{ object_point.x() };
+        const double y{ object_point.y() };
+        const double z{ object_point.z() };
+        const double abs_x{ std::abs(x) };
+        const double abs_y{ std::abs(y) };
+        const double abs_z{ std::abs(z) };
+        const auto to_face_coordinate{ [](const double coordinate) { return (coordinate + 1) / 2; } };
+        if (abs_x >= abs_y && abs_x >= abs_z) {
+            return x > 0 ? create2DPoint(to_face_coordinate(-z), to_face_coordinate(y)) :
+                           create2DPoint(to_face_coordinate(z), to_face_coordinate(y));
+        }
+        if (abs_y >= abs_z) {
+            return y > 0 ? create2DPoint(to_face_coordinate(x), to_face_coordinate(-z)) :
+                           create2DPoint(to_face_coordinate(x), to_face_coordinate(z));
+        }
+        return z > 0 ? create2DPoint(to_face_coordinate(x), to_face_coordinate(y)) :
+                       create2DPoint(to_face_coordinate(-x), to_face_coordinate(y));
+    }
+
+    // The kinds of mapping from object space to texture space
+    enum class TextureMapType
+    {
+        Projection,
+        Planar,
+        Spherical,
+        Cylindrical,
+        Cubic,
+        Custom          // A user-defined function, called through type erasure
+    };
+
+    // Maps object-space points to texture space. The built-in mappings are selected by their type and evaluated
+    // inline, so texture maps are cheap to copy and call. User-defined mapping functions remain possible, but are
+    // shared between copies and called through std::function.
+    class TextureMap
+    {
+    public:
+        using MappingFunction = std::function<Vector3(const Vector4&)>;
+
+        /* Constructors */
+
+        // Default Constructor
+        TextureMap() = default;
+
+        // Standard Constructor, which cannot be used for custom mappings
+        TextureMap(TextureMapType type);
+
+        // Function Pointer Constructor, which recognizes the built-in mapping functions
+        TextureMap(Vector3 (*mapping_function)(const Vector4&));
+
+        // Custom Mapping Constructor
+        explicit TextureMap(MappingFunction mapping_function);
+
+        /* Accessors */
+
+        [[nodiscard]] TextureMapType getType() const
+        { return m_type; }
+
+        /* Comparison Operator Overloads */
+
+        // Custom mappings are only equal to copies of themselves
+        [[nodiscard]] bool operator==(const TextureMap& rhs) const
+        { return m_type == rhs.m_type && m_mapping_function == rhs.m_mapping_function; }
+
+        /* Mapping Operations */
+
+        // Returns the texture coordinate of an object-space point
+        [[nodiscard]] Vector3 operator()(const Vector4& object_point) const
+        {
+            switch (m_type) {
+                case TextureMapType::Projection:
+                    return ProjectionMap(object_point);
+                case TextureMapType::Planar:
+                    return PlanarMap(object_point);
+                case TextureMapType::Spherical:
+                    return SphericalMap(object_point);
+                case TextureMapType::Cylindrical:
+                    return CylindricalMap(object_point);
+                case TextureMapType::Cubic:
+                    return CubicMap(object_point);
+                case TextureMapType::Custom:
+                    break;
+            }
+            return (*m_mapping_function)(object_point);
+        }
+
+    private:
+        /* Data Members */
+
+        TextureMapType m_type{ TextureMapType::Projection };
+        std::shared_ptr<const MappingFunction> m_mapping_function{ };    // Only set for custom mappings
+    };
+}
\ No newline at end of file
@@ -1,6 +1,9 @@
 #include "gtest/gtest.h"
 #include "texture_map.hpp"
 
+#include <cmath>
+#include <stdexcept>
+
 // Test using the projection mapping to map object space coordinates to texture space
 TEST(GraphicsTextureMap, ProjectionMap)
 {
@@ -13,4 +16,48 @@ TEST(GraphicsTextureMap, ProjectionMap)
     const gfx::Vector3 texture_coordinate_b_expected{ gfx::create2DPoint(0, 0) };
     const gfx::Vector3 texture_coordinate_b_actual{ gfx::ProjectionMap(object_coordinate_b) };
     EXPECT_EQ(texture_coordinate_b_actual, texture_coordinate_b_expected);
+}
+
+// Tests mapping points with the spherical, cylindrical and cubic mappings
+TEST(GraphicsTextureMap, CurvedMaps)
+{
+    const gfx::Vector3 spherical_front{ gfx::SphericalMap(gfx::createPoint(0, 0, -1)) };
+    EXPECT_DOUBLE_EQ(spherical_front.x(), 0.0);
+    EXPECT_DOUBLE_EQ(spherical_front.y(), 0.5);
+    const gfx::Vector3 spherical_top{ gfx::SphericalMap(gfx::createPoint(0, 1, 0)) };
+    EXPECT_DOUBLE_EQ(spherical_top.y(), 1.0);
+    const gfx::Vector3 spherical_side{ gfx::SphericalMap(gfx::createPoint(-std::sqrt(0.5), std::sqrt(0.5), 0)) };
+    EXPECT_DOUBLE_EQ(spherical_side.x(), 0.75);
+    EXPECT_DOUBLE_EQ(spherical_side.y(), 0.75);
+
+    const gfx::Vector3 cylindrical{ gfx::CylindricalMap(gfx::createPoint(0, 1.25, 1)) };
+    EXPECT_DOUBLE_EQ(cylindrical.x(), 0.5);
+    EXPECT_DOUBLE_EQ(cylindrical.y(), 0.25);
+
+    EXPECT_EQ(gfx::CubicMap(gfx::createPoint(1, 0.5, -0.5)), gfx::create2DPoint(0.75, 0.75));
+    EXPECT_EQ(gfx::CubicMap(gfx::createPoint(-0.5, -1, 0.5)), gfx::create2DPoint(0.25, 0.75));
+    EXPECT_EQ(gfx::CubicMap(gfx::createPoint(0.5, 0.5, 1)), gfx::create2DPoint(0.75, 0.75));
+}
+
+// Tests that texture maps dispatch to the mapping of their type, or to a custom mapping function
+TEST(GraphicsTextureMap, Dispatch)
+{
+    const gfx::Vector4 point{ gfx::createPoint(0.3, -0.6, 0.8) };
+    EXPECT_EQ(gfx::TextureMap{ }(point), gfx::ProjectionMap(point));
+    EXPECT_EQ(gfx::TextureMap{ gfx::TextureMapType::Planar }(point), gfx::PlanarMap(point));
+    EXPECT_EQ(gfx::TextureMap{ gfx::TextureMapType::Spherical }(point), gfx::SphericalMap(point));
+    EXPECT_EQ(gfx::TextureMap{ gfx::TextureMapType::Cylindrical }(point), gfx::CylindricalMap(point));
+    EXPECT_EQ(gfx::TextureMap{ gfx::TextureMapType::Cubic }(point), gfx::CubicMap(point));
+
+    // The built-in mapping functions are recognized, rather than called through type erasure
+    EXPECT_EQ(gfx::TextureMap{ gfx::CubicMap }.getType(), gfx::TextureMapType::Cubic);
+    EXPECT_EQ(gfx::TextureMap{ gfx::CubicMap }, gfx::TextureMap{ gfx::TextureMapType::Cubic });
+
+    const gfx::TextureMap custom_map{ gfx::TextureMap::MappingFunction{ [](const gfx::Vector4& object_point) {
+        return gfx::create2DPoint(object_point.z(), object_point.x());
+    } } };
+    EXPECT_EQ(custom_map.getType(), gfx::TextureMapType::Custom);
+    EXPECT_EQ(custom_map(point), gfx::create2DPoint(0.8, 0.3));
+    EXPECT_EQ(gfx::TextureMap{ custom_map }, custom_map);
+    EXPECT_THROW(gfx::TextureMap{ gfx::TextureMapType::Custom }, std::invalid_argument);
 }
\ No newline at end of file
@@ -8,36 +8,436 @@
 ----------------------------------------------------------------*/
 
 #include <iostream>
-#include <fstream>
 #include <cstdlib>
 #include <print>
 #include <optional>
+#include <vector>
+#include <string_view>
+#include <stdexcept>
+#include <chrono>
+#include <utility>
+#include <thread>
+#include <algorithm>
+#include <filesystem>
+#include <memory>
+#include <cstdint>
 
 #include "parse.hpp"
+#include "command_line.hpp"
 #include "canvas.hpp"
+#include "compiled_scene.hpp"
+#include "instanced_scene.hpp"
 #include "rendering_functions.hpp"
+#include "distributed_rendering.hpp"
+#include "render_server.hpp"
+#include "scene_cache.hpp"
+#include "render_checkpoint.hpp"
+#include "binary_encoding.hpp"
+#include "sequence_rendering.hpp"
+#include "g_buffer.hpp"
+#include "incremental_rendering.hpp"
+#include "tile_cache.hpp"
 
 int main(int argc, char** argv)
 {
-    // Validate number of arguments
-    if (argc != 3) {
-        std::println(std::cerr, "Error: Invalid number of arguments.");
+    // Parse the command line arguments
+    const std::vector<std::string_view> arguments(argv + 1, argv + argc);
+    data::RenderOptions options{ };
+    try {
+        options = data::parseCommandLine(arguments);
+    }
+    catch (const std::invalid_argument& error) {
+        std::println(std::cerr, "Error: {}", error.what());
         return EXIT_FAILURE;
     }
 
+    // Stitch cropped renders together into a full frame
+    if (options.mode == data::CommandMode::MergeCrops) {
+        std::vector<rt::PPMImage> crops{ };
+        try {
+            for (const std::string& merge_input_path : options.merge_input_paths) {
+                crops.push_back(rt::readPPMFile(merge_input_path));
+            }
+            rt::writePPMFile(rt::mergeCrops(crops), options.output_file_path);
+        }
+        catch (const std::invalid_argument& error) {
+            std::println(std::cerr, "Error: {}", error.what());
+            return EXIT_FAILURE;
+        }
+
+        std::println("Merged {} crops into {}", crops.size(), options.output_file_path);
+        return EXIT_SUCCESS;
+    }
+
+    // Render tiles leased by a coordinator until it has completed the frame
+    if (options.mode == data::CommandMode::Worker) {
+        try {
+            const size_t rendered_tile_count{ rt::runRenderWorker(*options.endpoint) };
+            std::println("Worker rendered {} tiles", rendered_tile_count);
+        }
+        catch (const std::exception& error) {
+            std::println(std::cerr, "Worker error: {}", error.what());
+            return EXIT_FAILURE;
+        }
+
+        return EXIT_SUCCESS;
+    }
+
+    // Serve render jobs from clients until one of them requests a shutdown
+    if (options.mode == data::CommandMode::Serve) {
+        const rt::RenderServerSettings server_settings{
+            *options.endpoint,
+            options.server_thread_count.value_or(std::max(std::thread::hardware_concurrency(), 1u)),
+            options.scene_cache_capacity.value_or(rt::DEFAULT_SCENE_CACHE_CAPACITY) };
+        std::println("Render server listening on {} with {} threads",
+                     rt::formatEndpoint(server_settings.endpoint),
+                     server_settings.thread_count);
+        try {
+            rt::runRenderServer(server_settings);
+        }
+        catch (const std::exception& error) {
+            std::println(std::cerr, "Error: {}", error.what());
+            return EXIT_FAILURE;
+        }
+
+        return EXIT_SUCCESS;
+    }
+
+    // Send a single request to a render server and print its reply
+    if (options.mode == data::CommandMode::SendRequest) {
+        try {
+            std::println("{}", rt::sendServerRequest(*options.endpoint, options.server_request));
+        }
+        catch (const std::exception& error) {
+            std::println(std::cerr, "Error: {}", error.what());
+            return EXIT_FAILURE;
+        }
+
+        return EXIT_SUCCESS;
+    }
+
     // Read in scene data
-    std::string_view input_file_path{ argv[1] };
-    std::ifstream input_file{ input_file_path };
-    json scene_data = json::parse(input_file);
-    Scene scene{ data::parseSceneData(scene_data) };
+    Scene scene{ data::readSceneFile(options.input_file_path) };
+
+    // Render each frame of an animated scene, compiling the scene once and updating it in place between frames
+    if (options.is_sequence) {
+        const rt::SequenceRenderSettings sequence_settings{
+            options.output_file_path,
+            options.frame_range,
+            std::max(std::thread::hardware_concurrency(), 1u) };
+        try {
+            const rt::SequenceRenderReport report{ rt::renderSequence(
+                scene,
+                options.sampling_settings,
+                sequence_settings,
+                options.crop_region,
+                [](const size_t frame, const std::filesystem::path& output_file_path) {
+                    std::println("Rendered frame {} to {}", frame, output_file_path.string());
+                }) };
+            std::println("Rendered {} frames in {:.3f} s ({:.3f} ms compiling the scene, {:.3f} ms updating it with {} "
+                         "BVH rebuilds)",
+                         report.frame_count,
+                         report.total_time.count(),
+                         std::chrono::duration<double, std::milli>{ report.compile_time }.count(),
+                         std::chrono::duration<double, std::milli>{ report.update_time }.count(),
+                         report.bvh_rebuild_count);
+        }
+        catch (const std::exception& error) {
+            std::println(std::cerr, "Error: {}", error.what());
+            return EXIT_FAILURE;
+        }
 
-    // Render the scene to a canvas
-    rt::Canvas image{ rt::render(scene.world, scene.camera) };
+        return EXIT_SUCCESS;
+    }
+
+    // Compile the world into an immutable snapshot for rendering, sharing the geometry of repeated objects if asked
+    std::unique_ptr<const gfx::TraceableScene> compiled_scene{ };
+    const gfx::CompiledScene* flattened_scene_ptr{ nullptr };
+    if (options.is_instanced) {
+        auto instanced_scene{ std::make_unique<const gfx::InstancedScene>(scene.world) };
+        const gfx::InstancedSceneStatistics& build_stats{ instanced_scene->getBuildStatistics() };
+        std::println("Compiled {} instances ({} unbounded) of {} assets with {} primitives and {} top-level BVH nodes "
+                     "in {:.3f} ms ({} KiB)",
+                     build_stats.instance_count,
+                     build_stats.unbounded_instance_count,
+                     build_stats.asset_count,
+                     build_stats.asset_primitive_count,
+                     build_stats.top_level_node_count,
+                     build_stats.build_time.count(),
+                     build_stats.memory_usage / 1024);
+        compiled_scene = std::move(instanced_scene);
+    } else {
+        auto flattened_scene{ std::make_unique<const gfx::CompiledScene>(gfx::compileScene(scene.world)) };
+        const gfx::SceneBuildStatistics& build_stats{ flattened_scene->getBuildStatistics() };
+        std::println("Compiled {} primitives ({} unbounded) with {} materials and {} BVH nodes in {:.3f} ms ({} KiB)",
+                     build_stats.primitive_count,
+                     build_stats.unbounded_primitive_count,
+                     build_stats.material_count,
+                     build_stats.bvh_node_count,
+                     build_stats.build_time.count(),
+                     build_stats.memory_usage / 1024);
+        if (build_stats.shadow_map_count > 0) {
+            std::println("Rendered {0} shadow maps ({1}x{1} per face) in {2:.3f} ms",
+                         build_stats.shadow_map_count,
+                         scene.world.getShadowMapSettings().resolution,
+                         build_stats.shadow_map_build_time.count());
+        }
+        flattened_scene_ptr = flattened_scene.get();
+        compiled_scene = std::move(flattened_scene);
+    }
+
+    // Relighting shades the region of the viewport saved in a G-buffer, which must match the camera's viewport
+    std::optional<rt::GBuffer> relit_g_buffer{ };
+    if (options.relight_g_buffer_path) {
+        try {
+            relit_g_buffer.emplace(rt::readGBufferFile(*options.relight_g_buffer_path));
+        }
+        catch (const std::exception& error) {
+            std::println(std::cerr, "Error: {}", error.what());
+            return EXIT_FAILURE;
+        }
+        if (relit_g_buffer->viewport_width != scene.camera.getViewportWidth() ||
+            relit_g_buffer->viewport_height != scene.camera.getViewportHeight()) {
+            std::println(std::cerr, "Error: The G-buffer was captured with a different camera viewport");
+            return EXIT_FAILURE;
+        }
+        if (relit_g_buffer->region != scene.camera.getViewportRect()) {
+            options.crop_region = relit_g_buffer->region;
+        }
+    }
+
+    // Crops must lie within the camera viewport, and carry their offset within the full frame into the output
+    if (options.crop_region && !scene.camera.isWithinViewport(*options.crop_region)) {
+        std::println(std::cerr, "Error: The crop region extends past the edges of the camera viewport");
+        return EXIT_FAILURE;
+    }
+    const std::optional<rt::CropMetadata> crop_metadata{
+        options.crop_region.transform([&scene](const rt::PixelRect& region) {
+            return rt::CropMetadata{ region.x,
+                                     region.y,
+                                     scene.camera.getViewportWidth(),
+                                     scene.camera.getViewportHeight() };
+        }) };
+
+    // Render the scene to a canvas, adaptively supersampling each pixel. Progressive renders rewrite the output file
+    // with the refined image after each pass, and time-budgeted renders report the quality they reached.
+    const rt::SamplingSettings& sampling_settings{ options.sampling_settings };
+    const rt::ProgressCallback write_preview{ [&](const rt::ProgressivePass& pass) {
+        std::println("Pass {}: {} samples traced with a pixel stride of {}",
+                     pass.pass_number,
+                     pass.total_sample_count,
+                     pass.pixel_stride);
+        rt::writePPMFile(pass.preview, options.output_file_path, crop_metadata);
+    } };
+    const rt::RenderResult render_result{ [&]() {
+        if (options.worker_count) {
+            const rt::DistributedRenderSettings distributed_settings{
+                *options.worker_count,
+                options.endpoint.value_or(rt::createDefaultEndpoint()),
+                argv[0],
+                std::chrono::duration<double>{ options.lease_timeout_seconds } };
+            std::println("Distributing tiles to {} workers, listening on {}",
+                         distributed_settings.worker_count,
+                         rt::formatEndpoint(distributed_settings.endpoint));
+            std::optional<rt::DistributedRenderResult> distributed_result{ };
+            try {
+                distributed_result.emplace(rt::renderDistributed(options.input_file_path,
+                                                                 scene.camera,
+                                                                 sampling_settings,
+                                                                 distributed_settings,
+                                                                 options.crop_region));
+            }
+            catch (const std::exception& error) {
+                std::println(std::cerr, "Error: {}", error.what());
+                std::exit(EXIT_FAILURE);
+            }
+            const rt::DistributedRenderReport& report{ distributed_result->report };
+            std::println("Rendered {} tiles across {} worker connections in {:.3f} s",
+                         report.tile_count,
+                         report.worker_connection_count,
+                         report.total_time.count());
+            std::println("Lost {} workers, revoked {} leases and discarded {} duplicate results",
+                         report.lost_worker_count,
+                         report.revoked_lease_count,
+                         report.discarded_result_count);
+            return std::move(distributed_result->render_result);
+        }
+        if (options.checkpoint_path) {
+            std::optional<rt::CheckpointedRenderResult> checkpointed_result{ };
+            try {
+                const rt::CheckpointSettings checkpoint_settings{
+                    *options.checkpoint_path,
+                    std::chrono::duration<double>{ options.checkpoint_interval_seconds },
+                    rt::calculateFileContentHash(options.input_file_path),
+                    options.is_resuming };
+                checkpointed_result.emplace(rt::renderWithCheckpoints(*compiled_scene,
+                                                                      scene.camera,
+                                                                      sampling_settings,
+                                                                      checkpoint_settings,
+                                                                      options.crop_region));
+            }
+            catch (const std::exception& error) {
+                std::println(std::cerr, "Error: {}", error.what());
+                std::exit(EXIT_FAILURE);
+            }
+            std::println("Resumed {} samples from {} and wrote {} checkpoints",
+                         checkpointed_result->resumed_sample_count,
+                         *options.checkpoint_path,
+                         checkpointed_result->checkpoint_count);
+            return std::move(checkpointed_result->render_result);
+        }
+        if (options.incremental_state_path) {
+            std::optional<rt::IncrementalRenderResult> incremental_result{ };
+            try {
+                incremental_result.emplace(rt::renderIncrementally(*flattened_scene_ptr,
+                                                                   scene.camera,
+                                                                   sampling_settings,
+                                                                   data::readSceneDataFile(options.input_file_path),
+                                                                   *options.incremental_state_path,
+                                                                   options.crop_region));
+            }
+            catch (const std::exception& error) {
+                std::println(std::cerr, "Error: {}", error.what());
+                std::exit(EXIT_FAILURE);
+            }
+            std::println("Rendered {} of {} tiles and reused the rest from {}",
+                         incremental_result->rendered_tile_count,
+                         incremental_result->tile_count,
+                         *options.incremental_state_path);
+            return std::move(incremental_result->render_result);
+        }
+        if (options.tile_cache_path) {
+            std::optional<rt::CachedRenderResult> cached_result{ };
+            std::optional<rt::TileCache> tile_cache{ };
+            try {
+                tile_cache.emplace(*options.tile_cache_path,
+                                   options.tile_cache_size_mib.transform([](const size_t size_mib) {
+                                       return uint64_t{ size_mib } << 20;
+                                   }).value_or(rt::DEFAULT_TILE_CACHE_SIZE_LIMIT));
+                cached_result.emplace(rt::renderWithTileCache(
+                    *flattened_scene_ptr,
+                    scene.camera,
+                    sampling_settings,
+                    rt::calculateSceneWorldHash(data::readSceneDataFile(options.input_file_path)),
+                    *tile_cache,
+                    options.crop_region));
+            }
+            catch (const std::exception& error) {
+                std::println(std::cerr, "Error: {}", error.what());
+                std::exit(EXIT_FAILURE);
+            }
+            const rt::TileCacheStatistics cache_stats{ tile_cache->getStatistics() };
+            std::println("Read {} of {} tiles from the tile cache in {} and evicted {} tiles ({} tiles, {} KiB "
+                         "cached)",
+                         cached_result->cached_tile_count,
+                         cached_result->tile_count,
+                         *options.tile_cache_path,
+                         cache_stats.eviction_count,
+                         cache_stats.entry_count,
+                         cache_stats.total_size / 1024);
+            return std::move(cached_result->render_result);
+        }
+        if (options.time_budget_seconds) {
+            rt::BudgetedRenderResult budgeted_result{
+                rt::renderWithTimeBudget(*compiled_scene,
+                                         scene.camera,
+                                         sampling_settings,
+                                         std::chrono::duration<double>{ *options.time_budget_seconds },
+                                         options.crop_region) };
+            const rt::RenderQualityReport& quality{ budgeted_result.quality_report };
+            std::println("Rendered the base image in {:.3f} s", quality.base_image_time.count());
+            std::println("Refined {} of {} tiles ({} completed) in {:.3f} s total{}",
+                         quality.refined_tile_count,
+                         quality.tile_count,
+                         quality.completed_tile_count,
+                         quality.total_time.count(),
+                         quality.is_budget_exhausted ? ", stopped at the deadline" : "");
+            std::println("Estimated mean pixel noise (standard error of luminance): {:.5f}", quality.mean_standard_error);
+            return std::move(budgeted_result.render_result);
+        }
+
+        if (relit_g_buffer) {
+            std::optional<rt::RenderResult> relit_result{ };
+            try {
+                relit_result.emplace(rt::relight(*flattened_scene_ptr, *relit_g_buffer));
+            }
+            catch (const std::exception& error) {
+                std::println(std::cerr, "Error: {}", error.what());
+                std::exit(EXIT_FAILURE);
+            }
+            std::println("Relit {} pixels from {} without tracing primary rays",
+                         relit_result->sample_counts.size(),
+                         *options.relight_g_buffer_path);
+            return std::move(*relit_result);
+        }
+        if (options.g_buffer_output_path) {
+            // Shade the captured G-buffer, so that primary rays are traced only once
+            const rt::GBuffer g_buffer{ rt::captureGBuffer(*flattened_scene_ptr, scene.camera, options.crop_region) };
+            try {
+                rt::writeGBufferFile(g_buffer, *options.g_buffer_output_path);
+            }
+            catch (const std::exception& error) {
+                std::println(std::cerr, "Error: {}", error.what());
+                std::exit(EXIT_FAILURE);
+            }
+            std::println("Saved the primary hits of {} pixels to {}",
+                         g_buffer.pixels.size(),
+                         *options.g_buffer_output_path);
+            return rt::relight(*flattened_scene_ptr, g_buffer);
+        }
+        if (options.is_deferred) {
+            return rt::renderDeferred(*compiled_scene,
+                                      scene.camera,
+                                      options.crop_region,
+                                      std::max(std::thread::hardware_concurrency(), 1u));
+        }
+
+        return options.is_progressive ?
+            rt::renderProgressive(
+                *compiled_scene, scene.camera, sampling_settings, write_preview, options.crop_region) :
+            rt::renderAdaptive(*compiled_scene, scene.camera, sampling_settings, options.crop_region);
+    }() };
+
+    // Deferred, G-buffer and relit renders shade one sample per pixel regardless of the sampling settings
+    if (!options.is_deferred && !options.g_buffer_output_path && !relit_g_buffer) {
+        const double pixel_count{ static_cast<double>(render_result.sample_counts.size()) };
+        std::println("Traced {} samples ({:.2f} per pixel, {} to {} allowed)",
+                     render_result.total_sample_count,
+                     static_cast<double>(render_result.total_sample_count) / pixel_count,
+                     sampling_settings.min_samples,
+                     sampling_settings.max_samples);
+    }
+
+    // Distributed renders shade the scene in the worker processes, so only local renders count their shadow rays
+    if (!options.worker_count) {
+        const gfx::ShadowRayStatistics shadow_stats{ compiled_scene->getShadowRayStatistics() };
+        std::println("Cast {} shadow rays ({:.2f} per sample), {} of {} area light evaluations in penumbra",
+                     shadow_stats.shadow_ray_count,
+                     static_cast<double>(shadow_stats.shadow_ray_count) /
+                             static_cast<double>(std::max<size_t>(render_result.total_sample_count, 1)),
+                     shadow_stats.penumbra_count,
+                     shadow_stats.area_light_evaluation_count);
+        std::println("Resolved {} shadow rays ({:.1f}%) with the last occluder of their light and {} ({:.1f}%) with "
+                     "shadow maps",
+                     shadow_stats.occluder_cache_hit_count,
+                     100.0 * static_cast<double>(shadow_stats.occluder_cache_hit_count) /
+                             static_cast<double>(std::max<size_t>(shadow_stats.shadow_ray_count, 1)),
+                     shadow_stats.shadow_map_hit_count,
+                     100.0 * static_cast<double>(shadow_stats.shadow_map_hit_count) /
+                             static_cast<double>(std::max<size_t>(shadow_stats.shadow_ray_count, 1)));
+    }
 
     // Export data to PPM file
-    const std::string_view output_file_path{ argv[2] };
-    std::ofstream out_file{ output_file_path, std::ios_base::trunc};
-    out_file << rt::exportAsPPM(image);
+    rt::writePPMFile(render_result.image, options.output_file_path, crop_metadata);
+
+    // Export the sample count heatmap, if requested
+    if (options.sample_heatmap_path) {
+        const rt::Canvas heatmap{ rt::createSampleHeatmap(render_result.sample_counts,
+                                                          render_result.image.width(),
+                                                          render_result.image.height(),
+                                                          sampling_settings) };
+        rt::writePPMFile(heatmap, *options.sample_heatmap_path, crop_metadata);
+    }
 
     return EXIT_SUCCESS;
 }
\ No newline at end of file
@@ -0,0 +1,47 @@
+#include "animation.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#include "transform.hpp"
+
+namespace rt {
+    // Transform Track Standard Constructor
+    TransformTrack::TransformTrack(std::vector<TransformKeyframe> keyframes)
+            : m_keyframes{ std::move(keyframes) }
+    {
+        if (m_keyframes.empty()) {
+            throw std::invalid_argument("A transform track requires at least one keyframe");
+        }
+
+        std::ranges::sort(m_keyframes, {}, &TransformKeyframe::frame);
+        const auto duplicate{ std::ranges::adjacent_find(m_keyframes, {}, &TransformKeyframe::frame) };
+        if (duplicate != m_keyframes.end()) {
+            throw std::invalid_argument("Two keyframes of a transform track cannot share a frame");
+        }
+    }
+
+    // Transform Track Evaluator
+    gfx::Matrix4 TransformTrack::evaluate(const double frame) const
+    {
+        // Find the first keyframe after the frame, holding the transforms of the keyframes at either end
+        const auto next_keyframe{ std::ranges::upper_bound(m_keyframes, frame, {}, &TransformKeyframe::frame) };
+        if (next_keyframe == m_keyframes.begin()) {
+            return m_keyframes.front().transform;
+        }
+        if (next_keyframe == m_keyframes.end()) {
+            return m_keyframes.back().transform;
+        }
+
+        // Keyframed transforms are returned exactly, rather than after a round trip through their decompositions
+        const TransformKeyframe& previous_keyframe{ *std::prev(next_keyframe) };
+        if (previous_keyframe.frame == frame) {
+            return previous_keyframe.transform;
+        }
+
+        const double t{ (frame - previous_keyframe.frame) / (next_keyframe->frame - previous_keyframe.frame) };
+        return gfx::interpolateTransforms(previous_keyframe.transform, next_keyframe->transform, t);
+    }
+}
\ No newline at end of file
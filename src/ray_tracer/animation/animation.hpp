@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include "matrix4.hpp"
+
+namespace rt {
+    // Fixes the transform of an object or camera at a single frame of an animation
+    struct TransformKeyframe
+    {
+        double frame;
+        gfx::Matrix4 transform;
+    };
+
+    // A sequence of keyframes describing how a transform changes over the frames of an animation
+    class TransformTrack
+    {
+    public:
+        /* Constructors */
+
+        TransformTrack() = delete;
+
+        // Sorts the keyframes by frame, throwing if there are none or two of them share a frame
+        explicit TransformTrack(std::vector<TransformKeyframe> keyframes);
+
+        /* Accessors */
+
+        [[nodiscard]] const std::vector<TransformKeyframe>& getKeyframes() const
+        { return m_keyframes; }
+
+        /* Evaluation Methods */
+
+        // Returns the transform at a frame, interpolated between the keyframes either side of it. The first and last
+        // keyframes hold their transforms before and after the track.
+        [[nodiscard]] gfx::Matrix4 evaluate(double frame) const;
+
+    private:
+        /* Data Members */
+
+        std::vector<TransformKeyframe> m_keyframes;
+    };
+
+    // Animates the transform of a top-level object of the world
+    struct ObjectAnimation
+    {
+        size_t object_index;
+        rt::TransformTrack track;
+    };
+
+    // Describes how a scene changes over the frames of an animation. Objects without a track keep the transforms they
+    // were authored with.
+    struct Animation
+    {
+        size_t frame_count;
+        std::optional<rt::TransformTrack> camera_track{ };      // Holds camera-to-world transforms, the inverses of
+                                                                // the camera's view transforms
+        std::vector<rt::ObjectAnimation> object_animations{ };
+    };
+}
\ No newline at end of file
@@ -0,0 +1,70 @@
+#include "gtest/gtest.h"
+#include "animation.hpp"
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "transform.hpp"
+#include "matrix4.hpp"
+#include "parse.hpp"
+
+// Tests evaluating a transform track between, at and beyond its keyframes
+TEST(RayTracerAnimation, EvaluateTransformTrack)
+{
+    const rt::TransformTrack track{ {
+        rt::TransformKeyframe{ 10, gfx::createTranslationMatrix(4, 0, 0) },
+        rt::TransformKeyframe{ 2, gfx::createTranslationMatrix(0, 0, 0) },
+        rt::TransformKeyframe{ 12, gfx::createTranslationMatrix(4, 0, 0) * gfx::createScalingMatrix(3) }
+    } };
+
+    ASSERT_EQ(track.getKeyframes().front().frame, 2);
+    ASSERT_EQ(track.getKeyframes().back().frame, 12);
+
+    EXPECT_EQ(track.evaluate(0), gfx::createTranslationMatrix(0, 0, 0));
+    EXPECT_EQ(track.evaluate(4), gfx::createTranslationMatrix(1, 0, 0));
+    EXPECT_EQ(track.evaluate(10), gfx::createTranslationMatrix(4, 0, 0));
+    EXPECT_EQ(track.evaluate(11), gfx::createTranslationMatrix(4, 0, 0) * gfx::createScalingMatrix(2));
+    EXPECT_EQ(track.evaluate(20), gfx::createTranslationMatrix(4, 0, 0) * gfx::createScalingMatrix(3));
+
+    EXPECT_THROW(rt::TransformTrack{ std::vector<rt::TransformKeyframe>{ } }, std::invalid_argument);
+    EXPECT_THROW((rt::TransformTrack{ {
+        rt::TransformKeyframe{ 1, gfx::createIdentityMatrix() },
+        rt::TransformKeyframe{ 1, gfx::createScalingMatrix(2) }
+    } }), std::invalid_argument);
+}
+
+// Tests parsing the keyframed camera and object transforms of an animated scene
+TEST(RayTracerAnimation, ParseAnimationData)
+{
+    const json animation_data = json::parse(R"({
+        "frame_count": 24,
+        "camera": [
+            { "frame": 0, "transform": { "input_base": [0, 0, -5], "output_base": [0, 0, 0], "up_vector": [0, 1, 0] } },
+            { "frame": 23, "transform": { "input_base": [0, 0, -9], "output_base": [0, 0, 0], "up_vector": [0, 1, 0] } }
+        ],
+        "objects": [
+            {
+                "object": 1,
+                "keyframes": [
+                    { "frame": 0, "transform": [ { "type": "translate", "values": [0, 1, 0] } ] },
+                    { "frame": 12, "transform": [ { "type": "translate", "values": [0, 3, 0] } ] }
+                ]
+            }
+        ]
+    })");
+
+    const rt::Animation animation{ data::parseAnimationData(animation_data, 2) };
+
+    EXPECT_EQ(animation.frame_count, 24);
+    ASSERT_TRUE(animation.camera_track);
+    EXPECT_EQ(animation.camera_track->evaluate(0),
+              gfx::createTranslationMatrix(0, 0, -5) * gfx::createYRotationMatrix(M_PI));
+    ASSERT_EQ(animation.object_animations.size(), 1);
+    EXPECT_EQ(animation.object_animations[0].object_index, 1);
+    EXPECT_EQ(animation.object_animations[0].track.evaluate(6), gfx::createTranslationMatrix(0, 2, 0));
+
+    EXPECT_THROW(static_cast<void>(data::parseAnimationData(animation_data, 1)), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(data::parseAnimationData(json::parse(R"({ "frame_count": 0 })"), 2)),
+                 std::invalid_argument);
+}
\ No newline at end of file
@@ -0,0 +1,108 @@
+#include "sequence_rendering.hpp"
+
+#include <format>
+#include <memory>
+#include <stdexcept>
+
+#include "render_job_scheduler.hpp"
+
+namespace rt {
+    // The number of digits frame numbers are padded to when the output path pattern does not specify it
+    static constexpr size_t DEFAULT_FRAME_NUMBER_WIDTH{ 4 };
+
+    // Frame Path Formatter
+    std::filesystem::path formatFramePath(const std::string_view output_path_pattern, const size_t frame)
+    {
+        std::string output_path{ output_path_pattern };
+        const size_t run_end{ output_path.rfind('#') };
+        if (run_end != std::string::npos) {
+            const size_t run_begin{ output_path.find_last_not_of('#', run_end) + 1 };
+            const size_t run_length{ run_end - run_begin + 1 };
+            return output_path.replace(run_begin, run_length, std::format("{:0{}}", frame, run_length));
+        }
+
+        // Insert the frame number between the stem and extension of the file name, leaving the directories untouched
+        std::filesystem::path frame_path{ output_path };
+        frame_path.replace_filename(std::format("{}_{:0{}}{}",
+                                                frame_path.stem().string(),
+                                                frame,
+                                                DEFAULT_FRAME_NUMBER_WIDTH,
+                                                frame_path.extension().string()));
+        return frame_path;
+    }
+
+    // Animation Frame Applier
+    gfx::BVHUpdate applyAnimationFrame(const rt::Animation& animation,
+                                       const double frame,
+                                       gfx::CompiledScene& compiled_scene,
+                                       rt::Camera& camera)
+    {
+        if (animation.camera_track) {
+            camera.setTransform(animation.camera_track->evaluate(frame).inverse());
+        }
+
+        for (const rt::ObjectAnimation& object_animation : animation.object_animations) {
+            compiled_scene.setObjectTransform(object_animation.object_index, object_animation.track.evaluate(frame));
+        }
+        return compiled_scene.updateBVH();
+    }
+
+    // Sequence Renderer
+    rt::SequenceRenderReport renderSequence(const Scene& scene,
+                                            const rt::SamplingSettings& settings,
+                                            const rt::SequenceRenderSettings& sequence_settings,
+                                            const std::optional<rt::PixelRect>& region,
+                                            const rt::FrameCallback& on_frame_rendered)
+    {
+        if (!scene.animation) {
+            throw std::invalid_argument("The scene does not describe an animation");
+        }
+        const rt::Animation& animation{ *scene.animation };
+        const auto [ first_frame, last_frame ] {
+            sequence_settings.frame_range.value_or(std::pair<size_t, size_t>{ 0, animation.frame_count - 1 }) };
+        if (first_frame > last_frame || last_frame >= animation.frame_count) {
+            throw std::invalid_argument(std::format("The frame range must lie within the {} frames of the animation",
+                                                    animation.frame_count));
+        }
+
+        const auto render_start{ std::chrono::steady_clock::now() };
+        const auto compiled_scene{ std::make_shared<gfx::CompiledScene>(scene.world) };
+        rt::SequenceRenderReport report{ 0, 0, std::chrono::steady_clock::now() - render_start, { }, { } };
+
+        // Each frame is waited for before the scene is updated for the next one, so the scene never changes while
+        // the threads are rendering it
+        rt::RenderJobScheduler scheduler{ sequence_settings.thread_count };
+        rt::Camera camera{ scene.camera };
+        for (size_t frame = first_frame; frame <= last_frame; ++frame) {
+            const auto update_start{ std::chrono::steady_clock::now() };
+            if (applyAnimationFrame(animation, static_cast<double>(frame), *compiled_scene, camera) ==
+                    gfx::BVHUpdate::Rebuild) {
+                ++report.bvh_rebuild_count;
+            }
+            report.update_time += std::chrono::steady_clock::now() - update_start;
+
+            const rt::RenderJobRequest request{
+                .scene = compiled_scene,
+                .camera = camera,
+                .output_file_path = formatFramePath(sequence_settings.output_path_pattern, frame),
+                .sampling_settings = settings,
+                .crop_region = region };
+
+            const std::optional<rt::RenderJobStatus> status{ scheduler.waitForJob(scheduler.submitJob(request)) };
+            if (status->state != rt::JobState::Completed) {
+                throw std::runtime_error(std::format("Unable to write frame {} to '{}': {}",
+                                                     frame,
+                                                     request.output_file_path.string(),
+                                                     status->error_message));
+            }
+
+            ++report.frame_count;
+            if (on_frame_rendered) {
+                on_frame_rendered(frame, request.output_file_path);
+            }
+        }
+
+        report.total_time = std::chrono::steady_clock::now() - render_start;
+        return report;
+    }
+}
\ No newline at end of file
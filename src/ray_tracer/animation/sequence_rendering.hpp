@@ -0,0 +1,66 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "parse.hpp"
+#include "animation.hpp"
+#include "camera.hpp"
+#include "sampling.hpp"
+#include "rendering_functions.hpp"
+#include "compiled_scene.hpp"
+
+namespace rt {
+    // Controls which frames of an animated scene are rendered, and where they are written
+    struct SequenceRenderSettings
+    {
+        std::string output_path_pattern;                            // Formatted into each frame's path by
+                                                                    // formatFramePath
+        std::optional<std::pair<size_t, size_t>> frame_range{ };    // The first and last frames to render, or all
+        size_t thread_count{ 1 };
+    };
+
+    // Describes how the time spent rendering an animation sequence was divided
+    struct SequenceRenderReport
+    {
+        size_t frame_count;
+        size_t bvh_rebuild_count;                       // Frames whose moves degraded the BVH enough to rebuild it
+        std::chrono::duration<double> compile_time;     // Spent compiling the scene, once for the whole sequence
+        std::chrono::duration<double> update_time;      // Spent moving objects and updating the BVH between frames
+        std::chrono::duration<double> total_time;
+    };
+
+    // Invoked after each frame of a sequence has been written
+    using FrameCallback = std::function<void(size_t frame, const std::filesystem::path& output_file_path)>;
+
+    /* Sequence Rendering Functions */
+
+    // Returns the output path of a frame, formed by replacing the last run of '#' characters in a pattern with the
+    // frame number, zero-padded to the length of the run. Without a run of '#', "_<frame>" is inserted before the
+    // extension of the file name, with the frame number padded to 4 digits.
+    [[nodiscard]] std::filesystem::path formatFramePath(std::string_view output_path_pattern, size_t frame);
+
+    // Moves the camera and animated top-level objects of a compiled scene to where an animation places them at a
+    // frame, then updates the BVH of the scene around the moved primitives, returning whether it was refitted or
+    // rebuilt
+    gfx::BVHUpdate applyAnimationFrame(const rt::Animation& animation,
+                                       double frame,
+                                       gfx::CompiledScene& compiled_scene,
+                                       rt::Camera& camera);
+
+    // Renders the frames of an animated scene back to back, writing each to its own numbered output file. The scene
+    // is compiled once, then updated in place between frames, with each frame's tiles rendered with adaptive
+    // supersampling on a single thread pool shared by the whole sequence. Throws if the scene is not animated, the
+    // frame range lies outside of the animation, or a frame cannot be written.
+    [[nodiscard]] rt::SequenceRenderReport renderSequence(const Scene& scene,
+                                                          const rt::SamplingSettings& settings,
+                                                          const rt::SequenceRenderSettings& sequence_settings,
+                                                          const std::optional<rt::PixelRect>& region = std::nullopt,
+                                                          const rt::FrameCallback& on_frame_rendered = { });
+}
\ No newline at end of file
@@ -0,0 +1,113 @@
+#include "gtest/gtest.h"
+#include "sequence_rendering.hpp"
+
+#include <filesystem>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "parse.hpp"
+#include "canvas.hpp"
+#include "compiled_scene.hpp"
+
+// Returns the data of a small scene with its sphere and camera moved along the x-axis by an offset
+static json createTestSceneData(const double offset)
+{
+    json scene_data = json::parse(R"({
+        "world": {
+            "light_source": { "intensity": [1, 1, 1], "position": [-10, 10, -10] },
+            "objects": [
+                { "shape": "sphere", "material": { "color": [0.8, 1.0, 0.6], "diffuse": 0.7, "specular": 0.2 } },
+                { "shape": "plane", "transform": [ { "type": "translate", "values": [0, -1, 0] } ] }
+            ]
+        },
+        "camera": {
+            "viewport_width": 40,
+            "viewport_height": 30,
+            "field_of_view": 1.0471975512,
+            "transform": { "input_base": [0, 1.5, -5], "output_base": [0, 0, 0], "up_vector": [0, 1, 0] }
+        }
+    })");
+
+    scene_data["world"]["objects"][0]["transform"] = json::array({ { { "type", "translate" },
+                                                                     { "values", { offset, 0, 0 } } } });
+    scene_data["camera"]["transform"]["input_base"] = { offset, 1.5, -5 };
+    scene_data["camera"]["transform"]["output_base"] = { offset, 0, 0 };
+    return scene_data;
+}
+
+// Tests formatting the output paths of frames
+TEST(RayTracerSequenceRendering, FormatFramePath)
+{
+    EXPECT_EQ(rt::formatFramePath("frames/shot_###.ppm", 7), "frames/shot_007.ppm");
+    EXPECT_EQ(rt::formatFramePath("frames/shot_#.ppm", 1234), "frames/shot_1234.ppm");
+    EXPECT_EQ(rt::formatFramePath("take#2/shot_##.ppm", 5), "take#2/shot_05.ppm");
+    EXPECT_EQ(rt::formatFramePath("frames/shot.ppm", 42), "frames/shot_0042.ppm");
+    EXPECT_EQ(rt::formatFramePath("shot", 3), "shot_0003");
+}
+
+// Tests that each frame of a sequence matches rendering the scene compiled with its objects where the frame places
+// them. Written images are quantized, so they are compared in their exported form.
+TEST(RayTracerSequenceRendering, RenderSequence)
+{
+    json scene_data = createTestSceneData(0);
+    scene_data["animation"] = json::parse(R"({
+        "frame_count": 3,
+        "camera": [
+            {
+                "frame": 0,
+                "transform": { "input_base": [0, 1.5, -5], "output_base": [0, 0, 0], "up_vector": [0, 1, 0] }
+            },
+            {
+                "frame": 2,
+                "transform": { "input_base": [2, 1.5, -5], "output_base": [2, 0, 0], "up_vector": [0, 1, 0] }
+            }
+        ],
+        "objects": [
+            {
+                "object": 0,
+                "keyframes": [
+                    { "frame": 0, "transform": [ { "type": "translate", "values": [0, 0, 0] } ] },
+                    { "frame": 2, "transform": [ { "type": "translate", "values": [2, 0, 0] } ] }
+                ]
+            }
+        ]
+    })");
+    const Scene scene{ data::parseSceneData(scene_data) };
+    const rt::SamplingSettings settings{ .min_samples = 2, .max_samples = 2 };
+    const rt::SequenceRenderSettings sequence_settings{
+        (std::filesystem::temp_directory_path() / "sequence_test_##.ppm").string(), std::nullopt, 2 };
+
+    std::vector<size_t> rendered_frames{ };
+    const rt::SequenceRenderReport report{ rt::renderSequence(
+        scene, settings, sequence_settings, std::nullopt, [&](const size_t frame, const std::filesystem::path&) {
+            rendered_frames.push_back(frame);
+        }) };
+
+    ASSERT_EQ(report.frame_count, 3);
+    ASSERT_EQ(rendered_frames, (std::vector<size_t>{ 0, 1, 2 }));
+    EXPECT_GE(report.total_time, report.compile_time + report.update_time);
+    for (const size_t frame : rendered_frames) {
+        const Scene expected_scene{ data::parseSceneData(createTestSceneData(static_cast<double>(frame))) };
+        const gfx::CompiledScene expected_compiled_scene{ expected_scene.world };
+        const rt::RenderResult expected{ rt::renderAdaptive(expected_compiled_scene, expected_scene.camera, settings) };
+        const rt::PPMImage image{
+            rt::readPPMFile(rt::formatFramePath(sequence_settings.output_path_pattern, frame)) };
+
+        EXPECT_EQ(rt::exportAsPPM(image.canvas), rt::exportAsPPM(expected.image));
+    }
+
+    // A subset of the frames can be rendered, but only from within the animation
+    const rt::SequenceRenderSettings range_settings{
+        sequence_settings.output_path_pattern, std::pair<size_t, size_t>{ 1, 1 }, 1 };
+    EXPECT_EQ(rt::renderSequence(scene, settings, range_settings).frame_count, 1);
+
+    const rt::SequenceRenderSettings invalid_range_settings{
+        sequence_settings.output_path_pattern, std::pair<size_t, size_t>{ 2, 3 }, 1 };
+    EXPECT_THROW(static_cast<void>(rt::renderSequence(scene, settings, invalid_range_settings)), std::invalid_argument);
+
+    const Scene static_scene{ data::parseSceneData(createTestSceneData(0)) };
+    EXPECT_THROW(static_cast<void>(rt::renderSequence(static_scene, settings, sequence_settings)),
+                 std::invalid_argument);
+}
\ No newline at end of file
@@ -0,0 +1,377 @@
+#include "command_line.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <format>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace data {
+    // Returns the value following an option, throwing if the option is the last argument
+    static std::string_view getOptionValue(const std::span<const std::string_view> arguments, size_t& index)
+    {
+        if (index + 1 >= arguments.size()) {
+            throw std::invalid_argument(std::format("Missing value for option '{}'", arguments[index]));
+        }
+
+        return arguments[++index];
+    }
+
+    // Converts the entire text of an option value into a number, throwing if it is not a valid number
+    template<typename T>
+    static T parseNumericValue(const std::string_view option, const std::string_view value)
+    {
+        T result{ };
+        const auto [end, error]{ std::from_chars(value.data(), value.data() + value.size(), result) };
+        if (error != std::errc{ } || end != value.data() + value.size()) {
+            throw std::invalid_argument(std::format("Invalid value '{}' for option '{}'", value, option));
+        }
+
+        return result;
+    }
+
+    // Converts an option value of the form "<x>,<y>,<width>,<height>" into a pixel region
+    static rt::PixelRect parsePixelRectValue(const std::string_view option, const std::string_view value)
+    {
+        std::array<size_t, 4> components{ };
+        std::string_view remaining_value{ value };
+        for (size_t i = 0; i < components.size(); ++i) {
+            const size_t separator{ i + 1 < components.size() ? remaining_value.find(',') : remaining_value.size() };
+            if (separator == std::string_view::npos) {
+                throw std::invalid_argument(std::format("Invalid value '{}' for option '{}'", value, option));
+            }
+
+            components[i] = parseNumericValue<size_t>(option, remaining_value.substr(0, separator));
+            remaining_value.remove_prefix(std::min(separator + 1, remaining_value.size()));
+        }
+
+        const rt::PixelRect region{ components[0], components[1], components[2], components[3] };
+        if (region.width == 0 || region.height == 0) {
+            throw std::invalid_argument(std::format("Option '{}' requires a non-empty region", option));
+        }
+
+        return region;
+    }
+
+    // Converts an option value of the form "<first>-<last>" into an inclusive range of frames
+    static std::pair<size_t, size_t> parseFrameRangeValue(const std::string_view option, const std::string_view value)
+    {
+        const size_t separator{ value.find('-') };
+        if (separator == std::string_view::npos) {
+            throw std::invalid_argument(std::format("Invalid value '{}' for option '{}'", value, option));
+        }
+
+        const std::pair<size_t, size_t> frame_range{ parseNumericValue<size_t>(option, value.substr(0, separator)),
+                                                     parseNumericValue<size_t>(option, value.substr(separator + 1)) };
+        if (frame_range.first > frame_range.second) {
+            throw std::invalid_argument(
+                std::format("Option '{}' requires the first frame to precede the last", option));
+        }
+
+        return frame_range;
+    }
+
+    // Command Line Parser
+    RenderOptions parseCommandLine(const std::span<const std::string_view> arguments)
+    {
+        // Merging only takes the output path and the paths of the crops to merge
+        if (!arguments.empty() && arguments[0] == "--merge") {
+            if (arguments.size() < 3) {
+                throw std::invalid_argument("Expected an output file path and at least one input file path to merge");
+            }
+
+            RenderOptions options{ };
+            options.mode = CommandMode::MergeCrops;
+            options.output_file_path = arguments[1];
+            options.merge_input_paths.assign(arguments.begin() + 2, arguments.end());
+            return options;
+        }
+
+        // Workers receive everything else from the coordinator they connect to
+        if (!arguments.empty() && arguments[0] == "--worker") {
+            if (arguments.size() != 2) {
+                throw std::invalid_argument("Expected only the endpoint of the coordinator to connect to");
+            }
+
+            RenderOptions options{ };
+            options.mode = CommandMode::Worker;
+            options.endpoint = rt::parseEndpoint(arguments[1]);
+            return options;
+        }
+
+        // Render servers receive their scenes and settings from clients, so only take the resources they may use
+        if (!arguments.empty() && arguments[0] == "--serve") {
+            if (arguments.size() < 2) {
+                throw std::invalid_argument("Expected the endpoint for the render server to listen on");
+            }
+
+            RenderOptions options{ };
+            options.mode = CommandMode::Serve;
+            options.endpoint = rt::parseEndpoint(arguments[1]);
+            for (size_t index = 2; index < arguments.size(); ++index) {
+                const std::string_view option{ arguments[index] };
+                if (option == "--threads") {
+                    options.server_thread_count = parseNumericValue<size_t>(option, getOptionValue(arguments, index));
+                }
+                else if (option == "--scene-cache-size") {
+                    options.scene_cache_capacity = parseNumericValue<size_t>(option, getOptionValue(arguments, index));
+                }
+                else {
+                    throw std::invalid_argument(std::format("Unknown option '{}'", option));
+                }
+            }
+
+            if (options.server_thread_count == 0 || options.scene_cache_capacity == 0) {
+                throw std::invalid_argument("--threads and --scene-cache-size must be at least 1");
+            }
+            return options;
+        }
+
+        if (!arguments.empty() && arguments[0] == "--send") {
+            if (arguments.size() != 3) {
+                throw std::invalid_argument("Expected only the endpoint of the render server and the request to send");
+            }
+
+            RenderOptions options{ };
+            options.mode = CommandMode::SendRequest;
+            options.endpoint = rt::parseEndpoint(arguments[1]);
+            options.server_request = arguments[2];
+            return options;
+        }
+
+        if (arguments.size() < 2) {
+            throw std::invalid_argument("Expected an input file path and an output file path");
+        }
+
+        RenderOptions options{ };
+        options.input_file_path = arguments[0];
+        options.output_file_path = arguments[1];
+
+        // Define string-to-case mapping for possible options
+        enum class Cases {
+            MinSamples, MaxSamples, VarianceThreshold, ContrastThreshold, SampleHeatmap, Progressive, TimeBudget, Crop,
+            Workers, Listen, LeaseTimeout, Checkpoint, CheckpointInterval, Resume, Sequence, Frames,
+            Instancing, Deferred, SaveGBuffer, Relight, Incremental, TileCache, TileCacheSize
+        };
+        static const std::unordered_map<std::string_view, Cases> stringToCaseMap{
+                { "--min-spp",              Cases::MinSamples },
+                { "--max-spp",              Cases::MaxSamples },
+                { "--variance-threshold",   Cases::VarianceThreshold },
+                { "--contrast-threshold",   Cases::ContrastThreshold },
+                { "--sample-heatmap",       Cases::SampleHeatmap },
+                { "--progressive",          Cases::Progressive },
+                { "--time-budget",          Cases::TimeBudget },
+                { "--crop",                 Cases::Crop },
+                { "--workers",              Cases::Workers },
+                { "--listen",               Cases::Listen },
+                { "--lease-timeout",        Cases::LeaseTimeout },
+                { "--checkpoint",           Cases::Checkpoint },
+                { "--checkpoint-interval",  Cases::CheckpointInterval },
+                { "--resume",               Cases::Resume },
+                { "--sequence",             Cases::Sequence },
+                { "--frames",               Cases::Frames },
+                { "--instancing",           Cases::Instancing },
+                { "--deferred",             Cases::Deferred },
+                { "--save-g-buffer",        Cases::SaveGBuffer },
+                { "--relight",              Cases::Relight },
+                { "--incremental",          Cases::Incremental },
+                { "--tile-cache",           Cases::TileCache },
+                { "--tile-cache-size",      Cases::TileCacheSize }
+        };
+
+        rt::SamplingSettings& sampling_settings{ options.sampling_settings };
+        bool is_max_samples_set{ false };
+        bool is_lease_timeout_set{ false };
+        bool is_checkpoint_interval_set{ false };
+        for (size_t index = 2; index < arguments.size(); ++index) {
+            // Convert the string to a Case for use in the switch statement
+            const std::string_view option{ arguments[index] };
+            auto it{ stringToCaseMap.find(option) };
+            if (it == stringToCaseMap.end()) {
+                throw std::invalid_argument(std::format("Unknown option '{}'", option));
+            }
+
+            switch (it->second) {
+                case Cases::MinSamples:
+                    sampling_settings.min_samples = parseNumericValue<size_t>(option, getOptionValue(arguments, index));
+                    break;
+                case Cases::MaxSamples:
+                    sampling_settings.max_samples = parseNumericValue<size_t>(option, getOptionValue(arguments, index));
+                    is_max_samples_set = true;
+                    break;
+                case Cases::VarianceThreshold:
+                    sampling_settings.variance_threshold =
+                        parseNumericValue<double>(option, getOptionValue(arguments, index));
+                    break;
+                case Cases::ContrastThreshold:
+                    sampling_settings.contrast_threshold =
+                        parseNumericValue<double>(option, getOptionValue(arguments, index));
+                    break;
+                case Cases::SampleHeatmap:
+                    options.sample_heatmap_path = getOptionValue(arguments, index);
+                    break;
+                case Cases::Progressive:
+                    options.is_progressive = true;
+                    break;
+                case Cases::TimeBudget:
+                    options.time_budget_seconds = parseNumericValue<double>(option, getOptionValue(arguments, index));
+                    break;
+                case Cases::Crop:
+                    options.crop_region = parsePixelRectValue(option, getOptionValue(arguments, index));
+                    break;
+                case Cases::Workers:
+                    options.worker_count = parseNumericValue<size_t>(option, getOptionValue(arguments, index));
+                    break;
+                case Cases::Listen:
+                    options.endpoint = rt::parseEndpoint(getOptionValue(arguments, index));
+                    break;
+                case Cases::LeaseTimeout:
+                    options.lease_timeout_seconds = parseNumericValue<double>(option, getOptionValue(arguments, index));
+                    is_lease_timeout_set = true;
+                    break;
+                case Cases::Checkpoint:
+                    options.checkpoint_path = getOptionValue(arguments, index);
+                    break;
+                case Cases::CheckpointInterval:
+                    options.checkpoint_interval_seconds =
+                        parseNumericValue<double>(option, getOptionValue(arguments, index));
+                    is_checkpoint_interval_set = true;
+                    break;
+                case Cases::Resume:
+                    options.is_resuming = true;
+                    break;
+                case Cases::Sequence:
+                    options.is_sequence = true;
+                    break;
+                case Cases::Frames:
+                    options.frame_range = parseFrameRangeValue(option, getOptionValue(arguments, index));
+                    break;
+                case Cases::Instancing:
+                    options.is_instanced = true;
+                    break;
+                case Cases::Deferred:
+                    options.is_deferred = true;
+                    break;
+                case Cases::SaveGBuffer:
+                    options.g_buffer_output_path = getOptionValue(arguments, index);
+                    break;
+                case Cases::Relight:
+                    options.relight_g_buffer_path = getOptionValue(arguments, index);
+                    break;
+                case Cases::Incremental:
+                    options.incremental_state_path = getOptionValue(arguments, index);
+                    break;
+                case Cases::TileCache:
+                    options.tile_cache_path = getOptionValue(arguments, index);
+                    break;
+                case Cases::TileCacheSize:
+                    options.tile_cache_size_mib = parseNumericValue<size_t>(option, getOptionValue(arguments, index));
+                    break;
+            }
+        }
+
+        // Without an explicit maximum, pixels are sampled exactly the minimum number of times, unless a time budget
+        // is available for extra samples
+        if (!is_max_samples_set) {
+            sampling_settings.max_samples = options.time_budget_seconds ?
+                std::max(DEFAULT_BUDGETED_MAX_SAMPLES, sampling_settings.min_samples) : sampling_settings.min_samples;
+        }
+        if (sampling_settings.min_samples == 0 || sampling_settings.max_samples < sampling_settings.min_samples) {
+            throw std::invalid_argument("Sample counts must satisfy 1 <= --min-spp <= --max-spp");
+        }
+
+        if (options.time_budget_seconds && !(*options.time_budget_seconds > 0.0)) {
+            throw std::invalid_argument("The time budget must be a positive number of seconds");
+        }
+        if (options.time_budget_seconds && options.is_progressive) {
+            throw std::invalid_argument("--time-budget cannot be combined with --progressive");
+        }
+
+        // Distributed renders always sample adaptively, with each worker rendering whole tiles
+        if (options.worker_count && (options.is_progressive || options.time_budget_seconds)) {
+            throw std::invalid_argument("--workers cannot be combined with --progressive or --time-budget");
+        }
+        if (!options.worker_count && (options.endpoint || is_lease_timeout_set)) {
+            throw std::invalid_argument("--listen and --lease-timeout require --workers");
+        }
+        if (!(options.lease_timeout_seconds > 0.0)) {
+            throw std::invalid_argument("The lease timeout must be a positive number of seconds");
+        }
+
+        // Checkpointed renders save the progress of an adaptive render
+        const bool is_tiled_render{ !options.is_progressive && !options.time_budget_seconds && !options.worker_count };
+        if (options.checkpoint_path && !is_tiled_render) {
+            throw std::invalid_argument(
+                "--checkpoint cannot be combined with --progressive, --time-budget or --workers");
+        }
+        if (!options.checkpoint_path && (options.is_resuming || is_checkpoint_interval_set)) {
+            throw std::invalid_argument("--resume and --checkpoint-interval require --checkpoint");
+        }
+        if (!(options.checkpoint_interval_seconds >= 0.0)) {
+            throw std::invalid_argument("The checkpoint interval must not be a negative number of seconds");
+        }
+
+        // Sequences render each frame's tiles with adaptive sampling on a shared thread pool, writing only the frames
+        if (options.is_sequence && (!is_tiled_render || options.checkpoint_path || options.sample_heatmap_path)) {
+            throw std::invalid_argument("--sequence cannot be combined with --progressive, --time-budget, --workers, "
+                                        "--checkpoint or --sample-heatmap");
+        }
+        if (!options.is_sequence && options.frame_range) {
+            throw std::invalid_argument("--frames requires --sequence");
+        }
+
+        // Workers compile the scene for themselves, and sequences move the objects of a compiled scene between frames
+        if (options.is_instanced && (options.worker_count || options.is_sequence)) {
+            throw std::invalid_argument("--instancing cannot be combined with --workers or --sequence");
+        }
+
+        // Deferred renders shade a single hit buffer per tile, so they trace exactly one sample through each pixel
+        if (options.is_deferred && (!is_tiled_render || options.checkpoint_path || options.is_sequence)) {
+            throw std::invalid_argument("--deferred cannot be combined with --progressive, --time-budget, --workers, "
+                                        "--checkpoint or --sequence");
+        }
+        if (options.is_deferred && sampling_settings.max_samples > 1) {
+            throw std::invalid_argument("--deferred requires a single sample per pixel");
+        }
+
+        // G-buffers hold the primary hit of one sample per pixel, found in a flattened scene. Relighting shades the
+        // region of the viewport the G-buffer was captured for.
+        const bool uses_g_buffer{ options.g_buffer_output_path || options.relight_g_buffer_path };
+        if (uses_g_buffer && (!is_tiled_render || options.checkpoint_path || options.is_sequence ||
+                              options.is_instanced || options.is_deferred)) {
+            throw std::invalid_argument("--save-g-buffer and --relight cannot be combined with --progressive, "
+                                        "--time-budget, --workers, --checkpoint, --sequence, --instancing or "
+                                        "--deferred");
+        }
+        if (uses_g_buffer && sampling_settings.max_samples > 1) {
+            throw std::invalid_argument("--save-g-buffer and --relight require a single sample per pixel");
+        }
+        if (options.relight_g_buffer_path && (options.g_buffer_output_path || options.crop_region)) {
+            throw std::invalid_argument("--relight cannot be combined with --save-g-buffer or --crop");
+        }
+
+        // Incremental renders record the footprint of each tile while rendering it with adaptive sampling, and
+        // compare the objects of a flattened scene
+        if (options.incremental_state_path && (!is_tiled_render || options.checkpoint_path || options.is_sequence ||
+                                               options.is_instanced || options.is_deferred || uses_g_buffer)) {
+            throw std::invalid_argument("--incremental cannot be combined with --progressive, --time-budget, "
+                                        "--workers, --checkpoint, --sequence, --instancing, --deferred, "
+                                        "--save-g-buffer or --relight");
+        }
+
+        // Cached renders look up each tile of a flattened scene before rendering it with adaptive sampling
+        if (options.tile_cache_path && (!is_tiled_render || options.checkpoint_path || options.is_sequence ||
+                                        options.is_instanced || options.is_deferred || uses_g_buffer ||
+                                        options.incremental_state_path)) {
+            throw std::invalid_argument("--tile-cache cannot be combined with --progressive, --time-budget, "
+                                        "--workers, --checkpoint, --sequence, --instancing, --deferred, "
+                                        "--save-g-buffer, --relight or --incremental");
+        }
+        if (!options.tile_cache_path && options.tile_cache_size_mib) {
+            throw std::invalid_argument("--tile-cache-size requires --tile-cache");
+        }
+
+        return options;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <span>
+#include <string>
+#include <string_view>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "sampling.hpp"
+#include "camera.hpp"
+#include "socket.hpp"
+
+namespace data {
+    // The maximum number of samples per pixel for time-budgeted renders which do not set one explicitly
+    inline constexpr size_t DEFAULT_BUDGETED_MAX_SAMPLES{ 64 };
+
+    // How long a distributed render lets a worker hold a tile before leasing it to another worker, unless set
+    // explicitly
+    inline constexpr double DEFAULT_LEASE_TIMEOUT_SECONDS{ 60.0 };
+
+    // How often a checkpointed render persists its progress, unless set explicitly
+    inline constexpr double DEFAULT_CHECKPOINT_INTERVAL_SECONDS{ 60.0 };
+
+    // The operations the ray tracer can perform
+    enum class CommandMode
+    {
+        Render,         // Render a scene file to an image
+        MergeCrops,     // Stitch cropped renders together into a full frame
+        Worker,         // Render tiles leased by a distributed render's coordinator
+        Serve,          // Run a render server which keeps scenes compiled between jobs
+        SendRequest     // Send a single request to a render server and print its reply
+    };
+
+    // Holds the settings for a single invocation of the ray tracer, as described by its command line arguments
+    struct RenderOptions
+    {
+        CommandMode mode{ CommandMode::Render };
+        std::string input_file_path;
+        std::string output_file_path;
+        rt::SamplingSettings sampling_settings{ };
+        std::optional<std::string> sample_heatmap_path{ };
+        bool is_progressive{ false };
+        std::optional<double> time_budget_seconds{ };
+        std::optional<rt::PixelRect> crop_region{ };
+        std::vector<std::string> merge_input_paths{ };
+        std::optional<size_t> worker_count{ };          // Set for distributed renders
+        std::optional<rt::Endpoint> endpoint{ };        // Where a coordinator listens, or a worker connects
+        double lease_timeout_seconds{ DEFAULT_LEASE_TIMEOUT_SECONDS };
+        std::optional<size_t> server_thread_count{ };
+        std::optional<size_t> scene_cache_capacity{ };
+        std::string server_request{ };                  // The JSON request line sent to a render server
+        std::optional<std::string> checkpoint_path{ };
+        double checkpoint_interval_seconds{ DEFAULT_CHECKPOINT_INTERVAL_SECONDS };
+        bool is_resuming{ false };
+        bool is_sequence{ false };                      // The output file path is a pattern for each frame's path
+        std::optional<std::pair<size_t, size_t>> frame_range{ };
+        bool is_instanced{ false };                     // Objects share the geometry of identical assets
+        bool is_deferred{ false };                      // Primary hits are shaded in batches sorted by material
+        std::optional<std::string> g_buffer_output_path{ };
+        std::optional<std::string> relight_g_buffer_path{ };
+        std::optional<std::string> incremental_state_path{ };
+        std::optional<std::string> tile_cache_path{ };  // The directory of the tile cache
+        std::optional<size_t> tile_cache_size_mib{ };
+    };
+
+    /* Command Line Functions */
+
+    // Returns the render options described by the passed-in command line arguments (excluding the program name).
+    // To merge crops, the arguments are "--merge <output path> <input path>...", and to run as a worker of a
+    // distributed render they are "--worker <endpoint>". A render server is run with "--serve <endpoint> [--threads
+    // <count>] [--scene-cache-size <count>]", and sent a request with "--send <endpoint> <JSON request>". To render,
+    // the arguments start with the input and output file paths, followed by any of these options:
+    //   --min-spp <count>              Minimum number of samples traced through each pixel
+    //   --max-spp <count>              Maximum number of samples traced through each pixel (defaults to the minimum)
+    //   --variance-threshold <value>   Standard error of a pixel's luminance above which it receives more samples
+    //   --contrast-threshold <value>   Luminance difference to a neighbor above which a pixel receives more samples
+    //   --sample-heatmap <path>        Path of an image visualizing the number of samples traced through each pixel
+    //   --progressive                  Render in progressively refined passes, rewriting the output after each one
+    //   --time-budget <seconds>        Spend at most this long refining the noisiest tiles after the base image
+    //                                  (the maximum sample count defaults to DEFAULT_BUDGETED_MAX_SAMPLES)
+    //   --crop <x>,<y>,<width>,<height>  Render only this region of the viewport, storing its offset in the output
+    //   --workers <count>              Distribute tiles across this many spawned worker processes (0 to only use
+    //                                  workers started separately with --worker)
+    //   --listen <endpoint>            Where to listen for workers, as "unix:<path>" or "tcp:<host>:<port>"
+    //   --lease-timeout <seconds>      How long a worker may hold a tile before it is leased to another worker
+    //   --checkpoint <path>            Periodically save the progress of the render to this file
+    //   --checkpoint-interval <seconds>  Shortest time between two checkpoints
+    //   --resume                       Continue from the progress saved in the checkpoint file, if it exists
+    //   --sequence                     Render every frame of the scene's animation, numbering the output file paths
+    //                                  (see rt::formatFramePath)
+    //   --frames <first>-<last>        Render only this range of frames of the sequence
+    //   --instancing                   Trace a two-level scene, compiling objects which differ only by their
+    //                                  transforms once and sharing their geometry (see gfx::InstancedScene)
+    //   --deferred                     Trace the primary hits of each tile before shading them in batches sorted by
+    //                                  material, with one sample through the center of each pixel (see
+    //                                  rt::renderDeferred)
+    //   --save-g-buffer <path>         Save the primary hit of each pixel to a G-buffer file, with one sample through
+    //                                  the center of each pixel
+    //   --relight <path>               Shade the primary hits saved in a G-buffer file with the lights and materials
+    //                                  of the scene, without tracing primary rays (see rt::relight)
+    //   --incremental <path>           Render again only the tiles the edits since the render saved in this file
+    //                                  affect, then save the new render to it (see rt::renderIncrementally)
+    //   --tile-cache <directory>       Read the tiles rendered by earlier runs from this tile cache, and store the
+    //                                  tiles which were not found in it (see rt::TileCache)
+    //   --tile-cache-size <MiB>        Size above which the least recently used tiles are evicted from the tile cache
+    [[nodiscard]] RenderOptions parseCommandLine(std::span<const std::string_view> arguments);
+}
\ No newline at end of file
@@ -0,0 +1,316 @@
+#include "gtest/gtest.h"
+#include "command_line.hpp"
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <stdexcept>
+#include <utility>
+
+// Tests parsing the input and output file paths without any options
+TEST(RayTracerCommandLine, ParseFilePaths)
+{
+    const std::vector<std::string_view> arguments{ "scene.json", "image.ppm" };
+
+    const data::RenderOptions options{ data::parseCommandLine(arguments) };
+
+    ASSERT_EQ(options.input_file_path, "scene.json");
+    ASSERT_EQ(options.output_file_path, "image.ppm");
+    ASSERT_EQ(options.sampling_settings.min_samples, 1);
+    ASSERT_EQ(options.sampling_settings.max_samples, 1);
+    ASSERT_FALSE(options.sample_heatmap_path.has_value());
+    ASSERT_FALSE(options.is_progressive);
+    ASSERT_FALSE(options.time_budget_seconds.has_value());
+    ASSERT_FALSE(options.crop_region.has_value());
+    ASSERT_EQ(options.mode, data::CommandMode::Render);
+    ASSERT_FALSE(options.worker_count.has_value());
+}
+
+// Tests parsing the sampling and output options
+TEST(RayTracerCommandLine, ParseSamplingOptions)
+{
+    const std::vector<std::string_view> arguments{
+        "scene.json", "image.ppm",
+        "--min-spp", "4",
+        "--max-spp", "64",
+        "--variance-threshold", "0.005",
+        "--contrast-threshold", "0.2",
+        "--sample-heatmap", "heatmap.ppm",
+        "--progressive"
+    };
+
+    const data::RenderOptions options{ data::parseCommandLine(arguments) };
+
+    ASSERT_EQ(options.sampling_settings.min_samples, 4);
+    ASSERT_EQ(options.sampling_settings.max_samples, 64);
+    ASSERT_EQ(options.sampling_settings.variance_threshold, 0.005);
+    ASSERT_EQ(options.sampling_settings.contrast_threshold, 0.2);
+    ASSERT_EQ(options.sample_heatmap_path, "heatmap.ppm");
+    ASSERT_TRUE(options.is_progressive);
+
+    // The maximum sample count defaults to the minimum
+    const std::vector<std::string_view> arguments_min_only{ "scene.json", "image.ppm", "--min-spp", "16" };
+    const data::RenderOptions options_min_only{ data::parseCommandLine(arguments_min_only) };
+
+    ASSERT_EQ(options_min_only.sampling_settings.min_samples, 16);
+    ASSERT_EQ(options_min_only.sampling_settings.max_samples, 16);
+}
+
+// Tests parsing a time budget
+TEST(RayTracerCommandLine, ParseTimeBudget)
+{
+    const std::vector<std::string_view> arguments{ "scene.json", "image.ppm", "--time-budget", "2.5" };
+
+    const data::RenderOptions options{ data::parseCommandLine(arguments) };
+
+    ASSERT_EQ(options.time_budget_seconds, 2.5);
+    ASSERT_EQ(options.sampling_settings.min_samples, 1);
+    ASSERT_EQ(options.sampling_settings.max_samples, data::DEFAULT_BUDGETED_MAX_SAMPLES);
+
+    // An explicit maximum sample count still applies
+    const std::vector<std::string_view> arguments_max{
+        "scene.json", "image.ppm", "--time-budget", "10", "--max-spp", "8" };
+    const data::RenderOptions options_max{ data::parseCommandLine(arguments_max) };
+
+    ASSERT_EQ(options_max.sampling_settings.max_samples, 8);
+}
+
+// Tests parsing a crop region
+TEST(RayTracerCommandLine, ParseCropRegion)
+{
+    const std::vector<std::string_view> arguments{ "scene.json", "image.ppm", "--crop", "64,32,128,96" };
+
+    const data::RenderOptions options{ data::parseCommandLine(arguments) };
+
+    ASSERT_EQ(options.crop_region, rt::PixelRect(64, 32, 128, 96));
+}
+
+// Tests parsing the arguments for merging crops
+TEST(RayTracerCommandLine, ParseMerge)
+{
+    const std::vector<std::string_view> arguments{ "--merge", "frame.ppm", "crop_a.ppm", "crop_b.ppm" };
+
+    const data::RenderOptions options{ data::parseCommandLine(arguments) };
+
+    ASSERT_EQ(options.mode, data::CommandMode::MergeCrops);
+    ASSERT_EQ(options.output_file_path, "frame.ppm");
+    ASSERT_EQ(options.merge_input_paths, std::vector<std::string>({ "crop_a.ppm", "crop_b.ppm" }));
+}
+
+// Tests parsing the options of a distributed render, and the arguments of its workers
+TEST(RayTracerCommandLine, ParseDistributedOptions)
+{
+    const std::vector<std::string_view> arguments{
+        "scene.json", "image.ppm", "--workers", "8", "--listen", "tcp:127.0.0.1:7400", "--lease-timeout", "12.5" };
+
+    const data::RenderOptions options{ data::parseCommandLine(arguments) };
+
+    ASSERT_EQ(options.mode, data::CommandMode::Render);
+    ASSERT_EQ(options.worker_count, 8);
+    ASSERT_EQ(options.endpoint, rt::Endpoint(rt::EndpointType::Tcp, "127.0.0.1", 7400));
+    ASSERT_EQ(options.lease_timeout_seconds, 12.5);
+
+    const std::vector<std::string_view> arguments_worker{ "--worker", "unix:/tmp/coordinator.sock" };
+    const data::RenderOptions options_worker{ data::parseCommandLine(arguments_worker) };
+
+    ASSERT_EQ(options_worker.mode, data::CommandMode::Worker);
+    ASSERT_EQ(options_worker.endpoint, rt::Endpoint(rt::EndpointType::UnixSocket, "/tmp/coordinator.sock"));
+}
+
+// Tests parsing the options of a checkpointed render
+TEST(RayTracerCommandLine, ParseCheckpointOptions)
+{
+    const std::vector<std::string_view> arguments{
+        "scene.json", "image.ppm", "--checkpoint", "render.ckpt", "--checkpoint-interval", "300", "--resume" };
+
+    const data::RenderOptions options{ data::parseCommandLine(arguments) };
+
+    ASSERT_EQ(options.checkpoint_path, "render.ckpt");
+    ASSERT_EQ(options.checkpoint_interval_seconds, 300.0);
+    ASSERT_TRUE(options.is_resuming);
+
+    const std::vector<std::string_view> arguments_default{ "scene.json", "image.ppm", "--checkpoint", "render.ckpt" };
+    const data::RenderOptions options_default{ data::parseCommandLine(arguments_default) };
+
+    ASSERT_EQ(options_default.checkpoint_interval_seconds, data::DEFAULT_CHECKPOINT_INTERVAL_SECONDS);
+    ASSERT_FALSE(options_default.is_resuming);
+}
+
+// Tests parsing the options of an animation sequence render
+TEST(RayTracerCommandLine, ParseSequenceOptions)
+{
+    const std::vector<std::string_view> arguments{
+        "scene.json", "frame_###.ppm", "--sequence", "--frames", "12-47", "--crop", "0,0,10,10" };
+
+    const data::RenderOptions options{ data::parseCommandLine(arguments) };
+
+    ASSERT_TRUE(options.is_sequence);
+    ASSERT_EQ(options.frame_range, (std::pair<size_t, size_t>{ 12, 47 }));
+    ASSERT_EQ(options.crop_region, (rt::PixelRect{ 0, 0, 10, 10 }));
+
+    const std::vector<std::string_view> arguments_all{ "scene.json", "frame.ppm", "--sequence" };
+    const data::RenderOptions options_all{ data::parseCommandLine(arguments_all) };
+
+    ASSERT_TRUE(options_all.is_sequence);
+    ASSERT_FALSE(options_all.frame_range);
+}
+
+// Tests parsing the option for tracing a two-level scene
+TEST(RayTracerCommandLine, ParseInstancingOption)
+{
+    const std::vector<std::string_view> arguments{ "scene.json", "image.ppm", "--instancing", "--progressive" };
+
+    const data::RenderOptions options{ data::parseCommandLine(arguments) };
+
+    ASSERT_TRUE(options.is_instanced);
+    ASSERT_TRUE(options.is_progressive);
+    ASSERT_FALSE(data::parseCommandLine(std::vector<std::string_view>{ "scene.json", "image.ppm" }).is_instanced);
+}
+
+// Tests parsing the option for shading primary hits in batches sorted by material
+TEST(RayTracerCommandLine, ParseDeferredOption)
+{
+    const std::vector<std::string_view> arguments{ "scene.json", "image.ppm", "--deferred", "--crop", "0,0,8,8" };
+
+    const data::RenderOptions options{ data::parseCommandLine(arguments) };
+
+    ASSERT_TRUE(options.is_deferred);
+    ASSERT_EQ(options.sampling_settings.max_samples, 1);
+    ASSERT_FALSE(data::parseCommandLine(std::vector<std::string_view>{ "scene.json", "image.ppm" }).is_deferred);
+}
+
+// Tests parsing the options for saving a G-buffer and relighting it
+TEST(RayTracerCommandLine, ParseGBufferOptions)
+{
+    const std::vector<std::string_view> arguments{ "scene.json", "image.ppm", "--save-g-buffer", "image.gbuf" };
+
+    const data::RenderOptions options{ data::parseCommandLine(arguments) };
+
+    ASSERT_EQ(options.g_buffer_output_path, "image.gbuf");
+    ASSERT_FALSE(options.relight_g_buffer_path);
+
+    const std::vector<std::string_view> arguments_relight{ "scene.json", "relit.ppm", "--relight", "image.gbuf" };
+    const data::RenderOptions options_relight{ data::parseCommandLine(arguments_relight) };
+
+    ASSERT_EQ(options_relight.relight_g_buffer_path, "image.gbuf");
+    ASSERT_FALSE(options_relight.g_buffer_output_path);
+}
+
+// Tests parsing the option for rendering only the tiles affected by edits of the scene
+TEST(RayTracerCommandLine, ParseIncrementalOption)
+{
+    const std::vector<std::string_view> arguments{
+        "scene.json", "image.ppm", "--incremental", "image.state", "--max-spp", "4", "--crop", "0,0,64,32" };
+
+    const data::RenderOptions options{ data::parseCommandLine(arguments) };
+
+    ASSERT_EQ(options.incremental_state_path, "image.state");
+    ASSERT_EQ(options.sampling_settings.max_samples, 4);
+    ASSERT_EQ(options.crop_region, rt::PixelRect(0, 0, 64, 32));
+}
+
+// Tests parsing the options for reading and storing tiles in a tile cache
+TEST(RayTracerCommandLine, ParseTileCacheOptions)
+{
+    const std::vector<std::string_view> arguments{
+        "scene.json", "image.ppm", "--tile-cache", "tiles", "--tile-cache-size", "256" };
+
+    const data::RenderOptions options{ data::parseCommandLine(arguments) };
+
+    ASSERT_EQ(options.tile_cache_path, "tiles");
+    ASSERT_EQ(options.tile_cache_size_mib, 256);
+
+    const std::vector<std::string_view> arguments_default{ "scene.json", "image.ppm", "--tile-cache", "tiles" };
+    const data::RenderOptions options_default{ data::parseCommandLine(arguments_default) };
+
+    ASSERT_EQ(options_default.tile_cache_path, "tiles");
+    ASSERT_FALSE(options_default.tile_cache_size_mib);
+}
+
+// Tests parsing the options for running a render server and sending it requests
+TEST(RayTracerCommandLine, ParseRenderServerOptions)
+{
+    const std::vector<std::string_view> arguments{
+        "--serve", "unix:/tmp/server.sock", "--threads", "6", "--scene-cache-size", "3" };
+
+    const data::RenderOptions options{ data::parseCommandLine(arguments) };
+
+    ASSERT_EQ(options.mode, data::CommandMode::Serve);
+    ASSERT_EQ(options.endpoint, rt::Endpoint(rt::EndpointType::UnixSocket, "/tmp/server.sock"));
+    ASSERT_EQ(options.server_thread_count, 6);
+    ASSERT_EQ(options.scene_cache_capacity, 3);
+
+    const std::vector<std::string_view> arguments_send{ "--send", "unix:/tmp/server.sock", R"({"command":"stats"})" };
+    const data::RenderOptions options_send{ data::parseCommandLine(arguments_send) };
+
+    ASSERT_EQ(options_send.mode, data::CommandMode::SendRequest);
+    ASSERT_EQ(options_send.endpoint, rt::Endpoint(rt::EndpointType::UnixSocket, "/tmp/server.sock"));
+    ASSERT_EQ(options_send.server_request, R"({"command":"stats"})");
+}
+
+// Tests that invalid command lines cause an error
+TEST(RayTracerCommandLine, ParseInvalidCommandLine)
+{
+    const std::vector<std::vector<std::string_view>> invalid_argument_lists{
+        { "scene.json" },
+        { "scene.json", "image.ppm", "--unknown" },
+        { "scene.json", "image.ppm", "--min-spp" },
+        { "scene.json", "image.ppm", "--min-spp", "four" },
+        { "scene.json", "image.ppm", "--min-spp", "4x" },
+        { "scene.json", "image.ppm", "--min-spp", "0" },
+        { "scene.json", "image.ppm", "--min-spp", "8", "--max-spp", "4" },
+        { "scene.json", "image.ppm", "--time-budget", "0" },
+        { "scene.json", "image.ppm", "--time-budget", "-3" },
+        { "scene.json", "image.ppm", "--time-budget", "5", "--progressive" },
+        { "scene.json", "image.ppm", "--crop", "0,0,10" },
+        { "scene.json", "image.ppm", "--crop", "0,0,10,10,10" },
+        { "scene.json", "image.ppm", "--crop", "0,0,0,10" },
+        { "--merge", "frame.ppm" },
+        { "scene.json", "image.ppm", "--workers", "4", "--progressive" },
+        { "scene.json", "image.ppm", "--deferred", "--progressive" },
+        { "scene.json", "image.ppm", "--deferred", "--min-spp", "4" },
+        { "scene.json", "image.ppm", "--save-g-buffer" },
+        { "scene.json", "image.ppm", "--save-g-buffer", "image.gbuf", "--progressive" },
+        { "scene.json", "image.ppm", "--save-g-buffer", "image.gbuf", "--max-spp", "4" },
+        { "scene.json", "image.ppm", "--relight", "image.gbuf", "--instancing" },
+        { "scene.json", "image.ppm", "--relight", "image.gbuf", "--crop", "0,0,8,8" },
+        { "scene.json", "image.ppm", "--incremental" },
+        { "scene.json", "image.ppm", "--incremental", "image.state", "--progressive" },
+        { "scene.json", "image.ppm", "--incremental", "image.state", "--checkpoint", "image.ckpt" },
+        { "scene.json", "image.ppm", "--incremental", "image.state", "--instancing" },
+        { "scene.json", "image.ppm", "--tile-cache" },
+        { "scene.json", "image.ppm", "--tile-cache", "tiles", "--progressive" },
+        { "scene.json", "image.ppm", "--tile-cache", "tiles", "--incremental", "image.state" },
+        { "scene.json", "image.ppm", "--tile-cache-size", "256" },
+        { "scene.json", "image.ppm", "--tile-cache", "tiles", "--tile-cache-size", "-1" },
+        { "scene.json", "image.ppm", "--workers", "4", "--lease-timeout", "0" },
+        { "scene.json", "image.ppm", "--workers", "4", "--listen", "localhost:7400" },
+        { "scene.json", "image.ppm", "--listen", "unix:/tmp/coordinator.sock" },
+        { "--worker" },
+        { "--worker", "tcp:localhost" },
+        { "--serve" },
+        { "--serve", "unix:/tmp/server.sock", "--threads", "0" },
+        { "--serve", "unix:/tmp/server.sock", "--scene-cache-size" },
+        { "--serve", "unix:/tmp/server.sock", "--min-spp", "4" },
+        { "--send", "unix:/tmp/server.sock" },
+        { "scene.json", "image.ppm", "--resume" },
+        { "scene.json", "image.ppm", "--checkpoint-interval", "30" },
+        { "scene.json", "image.ppm", "--checkpoint", "render.ckpt", "--checkpoint-interval", "-1" },
+        { "scene.json", "image.ppm", "--checkpoint", "render.ckpt", "--progressive" },
+        { "scene.json", "image.ppm", "--checkpoint", "render.ckpt", "--workers", "2" },
+        { "scene.json", "image.ppm", "--frames", "0-10" },
+        { "scene.json", "image.ppm", "--sequence", "--frames", "10" },
+        { "scene.json", "image.ppm", "--sequence", "--frames", "10-2" },
+        { "scene.json", "image.ppm", "--sequence", "--progressive" },
+        { "scene.json", "image.ppm", "--sequence", "--checkpoint", "render.ckpt" },
+        { "scene.json", "image.ppm", "--sequence", "--sample-heatmap", "heatmap.ppm" },
+        { "scene.json", "image.ppm", "--instancing", "--workers", "2" },
+        { "scene.json", "image.ppm", "--instancing", "--sequence" }
+    };
+
+    for (const std::vector<std::string_view>& arguments : invalid_argument_lists) {
+        EXPECT_THROW({
+            const data::RenderOptions options{ data::parseCommandLine(arguments) };
+        }, std::invalid_argument);
+    }
+}
\ No newline at end of file
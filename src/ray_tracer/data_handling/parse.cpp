@@ -1,6 +1,9 @@
 #include "parse.hpp"
 
 #include <string_view>
+#include <fstream>
+#include <format>
+#include <stdexcept>
 #include <unordered_map>
 
 #include "transform.hpp"
@@ -19,18 +22,34 @@ namespace data {
     // Scene Data Parser
     Scene parseSceneData(const json& scene_data)
     {
-        // Get the light source data
-        const json& light_source_data{ scene_data["world"]["light_source"] };
-        const std::vector<double> intensity_vals{
-                light_source_data["intensity"].get<std::vector<double>>() };
-        const std::vector<double> position_vals{
-                light_source_data["position"].get<std::vector<double>>() };
-        const gfx::PointLight light_source{
-                gfx::Color{ intensity_vals[0], intensity_vals[1], intensity_vals[2] },
-                gfx::createPoint(position_vals[0], position_vals[1], position_vals[2]) };
+        // Get the light source data, either a single light or a list of lights, and any area lights
+        const json& world_data{ scene_data["world"] };
+        const json light_source_data_list = world_data.contains("light_sources") ?
+                                            world_data["light_sources"] :
+                                            json::array({ world_data["light_source"] });
+        const json area_light_data_list = world_data.contains("area_lights") ?
+                                          world_data["area_lights"] :
+                                          json::array();
+        if (light_source_data_list.empty() && area_light_data_list.empty()) {
+            throw std::invalid_argument("A world requires at least one light source");
+        }
 
-        // Create the world with the light source
-        gfx::World world{ light_source };
+        // Create the world with the light sources
+        gfx::World world{ };
+        std::vector<gfx::PointLight> light_sources{ };
+        for (const auto& light_source_data : light_source_data_list) {
+            light_sources.push_back(parseLightSourceData(light_source_data));
+        }
+        world.setLightSources(light_sources);
+        for (const auto& area_light_data : area_light_data_list) {
+            world.addAreaLight(parseAreaLightData(area_light_data));
+        }
+        if (world_data.contains("light_sampling")) {
+            world.setLightSamplingSettings(parseLightSamplingData(world_data["light_sampling"]));
+        }
+        if (world_data.contains("shadow_maps")) {
+            world.setShadowMapSettings(parseShadowMapData(world_data["shadow_maps"]));
+        }
 
         // Add all the objects to the scene
         const json& object_data_list{ scene_data["world"]["objects"] };
@@ -38,31 +57,195 @@ namespace data {
             world.addObject(parseObjectData(object_data));
         }
 
-        // Get the camera data
-        const json& camera_data{ scene_data["camera"] };
-        const std::vector<double> input_base_vals{ camera_data["transform"]["input_base"].get<std::vector<double>>() };
-        const std::vector<double> output_base_vals{
-                camera_data["transform"]["output_base"].get<std::vector<double>>() };
-        const std::vector<double> up_vector_vals{ camera_data["transform"]["up_vector"].get<std::vector<double>>() };
+        // Create the camera
+        const rt::Camera camera{ parseCameraData(scene_data["camera"]) };
 
-        // Build the view transform matrix
-        const gfx::Matrix4 view_transform_matrix{
-            gfx::createViewTransformMatrix(
+        // Read the animation, if the scene is animated
+        std::optional<rt::Animation> animation{ };
+        if (scene_data.contains("animation")) {
+            animation = parseAnimationData(scene_data["animation"], world.getObjectCount());
+        }
+
+        return Scene{ world, camera, animation };
+    }
+
+    // Light Source Data Parser
+    gfx::PointLight parseLightSourceData(const json& light_source_data)
+    {
+        const std::vector<double> intensity_vals{ light_source_data["intensity"].get<std::vector<double>>() };
+        const std::vector<double> position_vals{ light_source_data["position"].get<std::vector<double>>() };
+
+        gfx::PointLight light_source{
+                gfx::Color{ intensity_vals[0], intensity_vals[1], intensity_vals[2] },
+                gfx::createPoint(position_vals[0], position_vals[1], position_vals[2]) };
+        if (light_source_data.contains("range")) {
+            light_source.range = light_source_data["range"].get<double>();
+            if (light_source.range <= 0) {
+                throw std::invalid_argument("The range of a light source must be positive");
+            }
+        }
+
+        return light_source;
+    }
+
+    // Area Light Data Parser
+    gfx::AreaLight parseAreaLightData(const json& area_light_data)
+    {
+        static const std::unordered_map<std::string_view, gfx::AreaLightShape> area_light_shape_map{
+                { "rectangle", gfx::AreaLightShape::Rectangle },
+                { "sphere", gfx::AreaLightShape::Sphere }
+        };
+
+        const auto shape_iter{ area_light_shape_map.find(area_light_data["shape"].get<std::string_view>()) };
+        if (shape_iter == area_light_shape_map.end()) {
+            throw std::invalid_argument("Invalid area light shape, check spelling in scene data input file");
+        }
+
+        const std::vector<double> intensity_vals{ area_light_data["intensity"].get<std::vector<double>>() };
+        const std::vector<double> position_vals{ area_light_data["position"].get<std::vector<double>>() };
+        gfx::AreaLight area_light{
+                .shape = shape_iter->second,
+                .intensity = gfx::Color{ intensity_vals[0], intensity_vals[1], intensity_vals[2] },
+                .position = gfx::createPoint(position_vals[0], position_vals[1], position_vals[2]) };
+
+        if (area_light.shape == gfx::AreaLightShape::Rectangle) {
+            const std::vector<double> edge_u_vals{ area_light_data["edges"][0].get<std::vector<double>>() };
+            const std::vector<double> edge_v_vals{ area_light_data["edges"][1].get<std::vector<double>>() };
+            area_light.edge_u = gfx::createVector(edge_u_vals[0], edge_u_vals[1], edge_u_vals[2]);
+            area_light.edge_v = gfx::createVector(edge_v_vals[0], edge_v_vals[1], edge_v_vals[2]);
+        } else {
+            area_light.radius = area_light_data["radius"].get<double>();
+            if (area_light.radius <= 0) {
+                throw std::invalid_argument("The radius of a spherical area light must be positive");
+            }
+        }
+
+        if (area_light_data.contains("sample_count")) {
+            area_light.sample_count = area_light_data["sample_count"].get<size_t>();
+            if (area_light.sample_count == 0) {
+                throw std::invalid_argument("An area light requires at least one shadow sample");
+            }
+        }
+
+        return area_light;
+    }
+
+    // Light Sampling Data Parser
+    gfx::LightSamplingSettings parseLightSamplingData(const json& light_sampling_data)
+    {
+        gfx::LightSamplingSettings light_sampling_settings{ };
+        if (light_sampling_data.contains("contribution_threshold")) {
+            light_sampling_settings.contribution_threshold =
+                    light_sampling_data["contribution_threshold"].get<double>();
+        }
+        if (light_sampling_data.contains("sampled_light_count")) {
+            light_sampling_settings.sampled_light_count = light_sampling_data["sampled_light_count"].get<size_t>();
+        }
+
+        return light_sampling_settings;
+    }
+
+    // Shadow Map Data Parser
+    gfx::ShadowMapSettings parseShadowMapData(const json& shadow_map_data)
+    {
+        gfx::ShadowMapSettings shadow_map_settings{ .resolution = shadow_map_data["resolution"].get<size_t>() };
+        if (shadow_map_settings.resolution == 0) {
+            throw std::invalid_argument("The resolution of a shadow map must be positive");
+        }
+        if (shadow_map_data.contains("depth_bias")) {
+            shadow_map_settings.depth_bias = shadow_map_data["depth_bias"].get<double>();
+            if (shadow_map_settings.depth_bias < 0) {
+                throw std::invalid_argument("The depth bias of a shadow map cannot be negative");
+            }
+        }
+
+        return shadow_map_settings;
+    }
+
+    // Returns the view transform matrix described by the input base, output base and up vector of a camera transform
+    static gfx::Matrix4 parseViewTransformData(const json& transform_data)
+    {
+        const std::vector<double> input_base_vals{ transform_data["input_base"].get<std::vector<double>>() };
+        const std::vector<double> output_base_vals{ transform_data["output_base"].get<std::vector<double>>() };
+        const std::vector<double> up_vector_vals{ transform_data["up_vector"].get<std::vector<double>>() };
+
+        return gfx::createViewTransformMatrix(
                 gfx::createPoint(input_base_vals[0], input_base_vals[1], input_base_vals[2]),
                 gfx::createPoint(output_base_vals[0], output_base_vals[1], output_base_vals[2]),
-                gfx::createVector(up_vector_vals[0], up_vector_vals[1], up_vector_vals[2])
-                )
-        };
+                gfx::createVector(up_vector_vals[0], up_vector_vals[1], up_vector_vals[2]));
+    }
 
-        // Create the camera
-        const rt::Camera camera{
+    // Camera Data Parser
+    rt::Camera parseCameraData(const json& camera_data)
+    {
+        // Build the view transform matrix
+        const gfx::Matrix4 view_transform_matrix{ parseViewTransformData(camera_data["transform"]) };
+
+        return rt::Camera{
                 camera_data["viewport_width"],
                 camera_data["viewport_height"],
                 camera_data["field_of_view"],
                 view_transform_matrix
         };
+    }
+
+    // Animation Data Parser
+    rt::Animation parseAnimationData(const json& animation_data, const size_t object_count)
+    {
+        rt::Animation animation{ animation_data.at("frame_count").get<size_t>() };
+        if (animation.frame_count == 0) {
+            throw std::invalid_argument("An animation requires at least one frame");
+        }
+
+        // Camera keyframes are described like the camera's transform, but interpolated as camera-to-world transforms
+        // so that the camera moves in a straight line between them
+        if (animation_data.contains("camera")) {
+            std::vector<rt::TransformKeyframe> camera_keyframes{ };
+            for (const auto& keyframe_data : animation_data["camera"]) {
+                camera_keyframes.emplace_back(keyframe_data.at("frame").get<double>(),
+                                              parseViewTransformData(keyframe_data.at("transform")).inverse());
+            }
+            animation.camera_track.emplace(std::move(camera_keyframes));
+        }
+
+        // Object keyframes replace the whole transform of a top-level object
+        if (animation_data.contains("objects")) {
+            for (const auto& object_animation_data : animation_data["objects"]) {
+                const size_t object_index{ object_animation_data.at("object").get<size_t>() };
+                if (object_index >= object_count) {
+                    throw std::invalid_argument(std::format("Cannot animate object {} of a world with {} objects",
+                                                            object_index,
+                                                            object_count));
+                }
 
-        return Scene{ world, camera };
+                std::vector<rt::TransformKeyframe> object_keyframes{ };
+                for (const auto& keyframe_data : object_animation_data.at("keyframes")) {
+                    object_keyframes.emplace_back(keyframe_data.at("frame").get<double>(),
+                                                  buildChained3DTransformMatrix(keyframe_data.at("transform")));
+                }
+                animation.object_animations.emplace_back(object_index,
+                                                         rt::TransformTrack{ std::move(object_keyframes) });
+            }
+        }
+
+        return animation;
+    }
+
+    // Scene Data File Reader
+    json readSceneDataFile(const std::filesystem::path& file_path)
+    {
+        std::ifstream input_file{ file_path };
+        if (!input_file) {
+            throw std::invalid_argument(std::format("Unable to open scene file '{}'", file_path.string()));
+        }
+
+        return json::parse(input_file);
+    }
+
+    // Scene File Reader
+    Scene readSceneFile(const std::filesystem::path& file_path)
+    {
+        return parseSceneData(readSceneDataFile(file_path));
     }
 
     // Renderable Object Parser
@@ -112,21 +295,33 @@ namespace data {
         };
         const bool is_closed{ object_data.contains("is_closed") && object_data["is_closed"].get<bool>() };
 
-        // Create and return the object
+        // Create the object
+        std::shared_ptr<gfx::Surface> surface_ptr{ };
         switch (shape_type) {
             case Cases::Plane:
-                return std::make_shared<gfx::Plane>(gfx::Plane{ transform_matrix, material });
+                surface_ptr = std::make_shared<gfx::Plane>(gfx::Plane{ transform_matrix, material });
+                break;
             case Cases::Sphere:
-                return std::make_shared<gfx::Sphere>(gfx::Sphere{ transform_matrix, material });
+                surface_ptr = std::make_shared<gfx::Sphere>(gfx::Sphere{ transform_matrix, material });
+                break;
             case Cases::Cube:
-                return std::make_shared<gfx::Cube>(gfx::Cube{ transform_matrix, material });
+                surface_ptr = std::make_shared<gfx::Cube>(gfx::Cube{ transform_matrix, material });
+                break;
             case Cases::Cylinder:
-                return std::make_shared<gfx::Cylinder>(gfx::Cylinder{transform_matrix, material,
-                                                                     y_min, y_max, is_closed });
+                surface_ptr = std::make_shared<gfx::Cylinder>(gfx::Cylinder{transform_matrix, material,
+                                                                            y_min, y_max, is_closed });
+                break;
             case Cases::Cone:
-                return std::make_shared<gfx::Cone>(gfx::Cone{transform_matrix, material,
-                                                             y_min, y_max, is_closed });
+                surface_ptr = std::make_shared<gfx::Cone>(gfx::Cone{transform_matrix, material,
+                                                                    y_min, y_max, is_closed });
+                break;
+        }
+
+        // Set the texture mapping, if present
+        if (object_data.contains("texture_map")) {
+            surface_ptr->setTextureMap(parseTextureMapData(object_data["texture_map"]));
         }
+        return surface_ptr;
     }
 
     // Composite Surface Builder
@@ -195,6 +390,24 @@ namespace data {
         return gfx::Color{ color_data[0], color_data[1], color_data[2] };
     }
 
+    // Texture Map Parser
+    gfx::TextureMap parseTextureMapData(const json& texture_map_data)
+    {
+        static const std::unordered_map<std::string_view, gfx::TextureMapType> stringToTypeMap{
+                { "projection",  gfx::TextureMapType::Projection },
+                { "planar",      gfx::TextureMapType::Planar },
+                { "spherical",   gfx::TextureMapType::Spherical },
+                { "cylindrical", gfx::TextureMapType::Cylindrical },
+                { "cubic",       gfx::TextureMapType::Cubic }
+        };
+
+        auto it{ stringToTypeMap.find(texture_map_data.get<std::string_view>()) };
+        if (it == stringToTypeMap.end()) {
+            throw std::invalid_argument("Invalid texture map type, check spelling in scene data input file");
+        }
+        return gfx::TextureMap{ it->second };
+    }
+
     // Texture Data Parser
     std::shared_ptr<gfx::Texture> parseTextureData(const json& texture_data)
     {
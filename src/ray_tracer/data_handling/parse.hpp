@@ -1,11 +1,15 @@
 #pragma once
 
 #include <memory>
+#include <filesystem>
+#include <optional>
 
 #include "nlohmann/json.hpp"
 
 #include "world.hpp"
+#include "light.hpp"
 #include "camera.hpp"
+#include "animation.hpp"
 #include "surface.hpp"
 #include "pattern_texture_3d.hpp"
 #include "color.hpp"
@@ -18,6 +22,7 @@ using json = nlohmann::json;
 struct Scene{
     gfx::World world;
     rt::Camera camera;
+    std::optional<rt::Animation> animation{ };
 };
 
 namespace data {
@@ -27,6 +32,33 @@ namespace data {
     // containing the world and camera defined by the scene data
     [[nodiscard]] Scene parseSceneData(const json& scene_data);
 
+    // Returns a point light described by the passed-in JSON data, throwing if its range is not positive
+    [[nodiscard]] gfx::PointLight parseLightSourceData(const json& light_source_data);
+
+    // Returns a rectangular or spherical area light described by the passed-in JSON data, throwing if its shape is
+    // unknown or its radius or sample count is not positive
+    [[nodiscard]] gfx::AreaLight parseAreaLightData(const json& area_light_data);
+
+    // Returns the light sampling settings described by the passed-in JSON data
+    [[nodiscard]] gfx::LightSamplingSettings parseLightSamplingData(const json& light_sampling_data);
+
+    // Returns the shadow map settings described by the passed-in JSON data. Throws if the resolution is not positive
+    // or the depth bias is negative.
+    [[nodiscard]] gfx::ShadowMapSettings parseShadowMapData(const json& shadow_map_data);
+
+    // Returns a camera described by the passed-in JSON data
+    [[nodiscard]] rt::Camera parseCameraData(const json& camera_data);
+
+    // Returns the keyframed camera and object transforms described by the passed-in JSON data, throwing if a track
+    // refers to an object outside of the world's top-level objects
+    [[nodiscard]] rt::Animation parseAnimationData(const json& animation_data, size_t object_count);
+
+    // Reads the JSON data of the scene file at the passed-in path, throwing if it cannot be opened
+    [[nodiscard]] json readSceneDataFile(const std::filesystem::path& file_path);
+
+    // Reads and parses the JSON scene file at the passed-in path, throwing if it cannot be opened
+    [[nodiscard]] Scene readSceneFile(const std::filesystem::path& file_path);
+
     // Returns a pointer to a newly created shape described by the passed-in JSON data
     [[nodiscard]] std::shared_ptr<gfx::Object> parseObjectData(const json& object_data);
 
@@ -42,6 +74,9 @@ namespace data {
     // Returns a color object described by the passed in JSON data
     [[nodiscard]] gfx::Color parseColorData(const json& color_data);
 
+    // Returns the texture mapping named by the passed-in JSON data
+    [[nodiscard]] gfx::TextureMap parseTextureMapData(const json& texture_map_data);
+
     // Returns a pointer to a newly created textures described by the passed-in JSON data
     [[nodiscard]] std::shared_ptr<gfx::Texture> parseTextureData(const json& texture_data);
 
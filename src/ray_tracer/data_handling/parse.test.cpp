@@ -2,6 +2,7 @@
 #include "parse.hpp"
 
 #include <cmath>
+#include <stdexcept>
 
 #include <nlohmann/json.hpp>
 
@@ -445,6 +446,23 @@ TEST(RayTracerParse, ParseConeData)
     EXPECT_EQ(cone_actual, cone_expected);
 }
 
+// Tests setting the texture mapping of a shape from parsed JSON data
+TEST(RayTracerParse, ParseTextureMapData)
+{
+    const json sphere_data{
+            { "shape", "sphere"},
+            { "texture_map", "spherical" }
+    };
+    const gfx::Sphere sphere{ dynamic_cast<const gfx::Sphere&>(*data::parseObjectData(sphere_data)) };
+    EXPECT_EQ(sphere.getTextureMapping().getType(), gfx::TextureMapType::Spherical);
+
+    const json cube_data{ { "shape", "cube"} };
+    const gfx::Cube cube{ dynamic_cast<const gfx::Cube&>(*data::parseObjectData(cube_data)) };
+    EXPECT_EQ(cube.getTextureMapping().getType(), gfx::TextureMapType::Projection);
+
+    EXPECT_THROW(static_cast<void>(data::parseTextureMapData("conical")), std::invalid_argument);
+}
+
 // Tests building a composite surface from parsed JSON data
 TEST(RayTracerParse, BuildCompositeSurface)
 {
@@ -484,4 +502,116 @@ TEST(RayTracerParse, BuildCompositeSurface)
 
     const auto composite_surface_actual_ptr{ data::parseCompositeSurfaceData(composite_surface_data)};
     EXPECT_EQ(*composite_surface_actual_ptr, composite_surface_expected);
+}
+
+// Tests parsing the light sources of a scene, given either as a single light or as a list of lights
+TEST(RayTracerParse, ParseLightSourceData)
+{
+    const json light_source_data = json::parse(R"({
+        "intensity": [1, 0.5, 0.5], "position": [0, 10, -5], "range": 20
+    })");
+    const gfx::PointLight light_source{ data::parseLightSourceData(light_source_data) };
+
+    EXPECT_EQ(light_source.intensity, gfx::Color(1, 0.5, 0.5));
+    EXPECT_EQ(light_source.position, gfx::createPoint(0, 10, -5));
+    EXPECT_DOUBLE_EQ(light_source.range, 20);
+    EXPECT_TRUE(std::isinf(data::parseLightSourceData(json::parse(R"({
+        "intensity": [1, 1, 1], "position": [0, 0, 0]
+    })")).range));
+    EXPECT_THROW(static_cast<void>(data::parseLightSourceData(json::parse(R"({
+        "intensity": [1, 1, 1], "position": [0, 0, 0], "range": 0
+    })"))), std::invalid_argument);
+
+    json scene_data = json::parse(R"({
+        "world": {
+            "light_sources": [
+                { "intensity": [1, 1, 1], "position": [-10, 10, -10] },
+                { "intensity": [0.2, 0.2, 0.2], "position": [10, 10, -10], "range": 30 }
+            ],
+            "light_sampling": { "contribution_threshold": 0.01, "sampled_light_count": 4 },
+            "objects": [ { "shape": "sphere" } ]
+        },
+        "camera": {
+            "viewport_width": 10,
+            "viewport_height": 10,
+            "field_of_view": 1.0471975512,
+            "transform": { "input_base": [0, 1.5, -5], "output_base": [0, 0, 0], "up_vector": [0, 1, 0] }
+        }
+    })");
+    const Scene scene{ data::parseSceneData(scene_data) };
+
+    ASSERT_EQ(scene.world.getLightSources().size(), 2);
+    EXPECT_EQ(scene.world.getLightSources()[1].position, gfx::createPoint(10, 10, -10));
+    EXPECT_DOUBLE_EQ(scene.world.getLightSources()[1].range, 30);
+    EXPECT_DOUBLE_EQ(scene.world.getLightSamplingSettings().contribution_threshold, 0.01);
+    EXPECT_EQ(scene.world.getLightSamplingSettings().sampled_light_count, 4);
+
+    scene_data["world"]["light_sources"] = json::array();
+    EXPECT_THROW(static_cast<void>(data::parseSceneData(scene_data)), std::invalid_argument);
+}
+
+// Tests parsing rectangular and spherical area lights
+TEST(RayTracerParse, ParseAreaLightData)
+{
+    const gfx::AreaLight rectangle_light{ data::parseAreaLightData(json::parse(R"({
+        "shape": "rectangle", "intensity": [1, 1, 1], "position": [0, 10, 0], "edges": [[2, 0, 0], [0, 0, 3]],
+        "sample_count": 25
+    })")) };
+    EXPECT_EQ(rectangle_light.shape, gfx::AreaLightShape::Rectangle);
+    EXPECT_EQ(rectangle_light.position, gfx::createPoint(0, 10, 0));
+    EXPECT_EQ(rectangle_light.edge_u, gfx::createVector(2, 0, 0));
+    EXPECT_EQ(rectangle_light.edge_v, gfx::createVector(0, 0, 3));
+    EXPECT_EQ(rectangle_light.sample_count, 25);
+
+    const gfx::AreaLight sphere_light{ data::parseAreaLightData(json::parse(R"({
+        "shape": "sphere", "intensity": [0.5, 0.5, 0.5], "position": [1, 2, 3], "radius": 0.5
+    })")) };
+    EXPECT_EQ(sphere_light.shape, gfx::AreaLightShape::Sphere);
+    EXPECT_EQ(sphere_light.intensity, gfx::Color(0.5, 0.5, 0.5));
+    EXPECT_DOUBLE_EQ(sphere_light.radius, 0.5);
+    EXPECT_EQ(sphere_light.sample_count, gfx::AreaLight{ }.sample_count);
+
+    EXPECT_THROW(static_cast<void>(data::parseAreaLightData(json::parse(R"({
+        "shape": "disk", "intensity": [1, 1, 1], "position": [0, 0, 0]
+    })"))), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(data::parseAreaLightData(json::parse(R"({
+        "shape": "sphere", "intensity": [1, 1, 1], "position": [0, 0, 0], "radius": 1, "sample_count": 0
+    })"))), std::invalid_argument);
+
+    // A world lit only by area lights has no point light sources
+    const Scene scene{ data::parseSceneData(json::parse(R"({
+        "world": {
+            "light_sources": [],
+            "area_lights": [ { "shape": "sphere", "intensity": [1, 1, 1], "position": [0, 10, 0], "radius": 1 } ],
+            "objects": [ { "shape": "sphere" } ]
+        },
+        "camera": {
+            "viewport_width": 10,
+            "viewport_height": 10,
+            "field_of_view": 1.0471975512,
+            "transform": { "input_base": [0, 1.5, -5], "output_base": [0, 0, 0], "up_vector": [0, 1, 0] }
+        }
+    })")) };
+    EXPECT_TRUE(scene.world.getLightSources().empty());
+    EXPECT_EQ(scene.world.getAreaLights().size(), 1);
+}
+
+// Tests parsing the settings of the shadow maps of a world
+TEST(RayTracerParse, ParseShadowMapData)
+{
+    const gfx::ShadowMapSettings shadow_map_settings{ data::parseShadowMapData(json::parse(R"({
+        "resolution": 256, "depth_bias": 0.1
+    })")) };
+    EXPECT_EQ(shadow_map_settings.resolution, 256);
+    EXPECT_DOUBLE_EQ(shadow_map_settings.depth_bias, 0.1);
+
+    const gfx::ShadowMapSettings default_bias_settings{ data::parseShadowMapData(json::parse(R"({
+        "resolution": 64
+    })")) };
+    EXPECT_DOUBLE_EQ(default_bias_settings.depth_bias, gfx::ShadowMapSettings{ }.depth_bias);
+
+    EXPECT_THROW(static_cast<void>(data::parseShadowMapData(json::parse(R"({ "resolution": 0 })"))),
+                 std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(data::parseShadowMapData(json::parse(R"({ "resolution": 64, "depth_bias": -1 })"))),
+                 std::invalid_argument);
 }
\ No newline at end of file
@@ -0,0 +1,77 @@
+#include "scene_diff.hpp"
+
+#include <algorithm>
+#include <span>
+#include <string>
+
+namespace data {
+    // Returns a copy of a JSON object without the passed-in keys
+    static json eraseKeys(const json& object_data, const std::span<const std::string_view> keys)
+    {
+        json remaining_data = object_data;
+        if (remaining_data.is_object()) {
+            for (const std::string_view key : keys) {
+                remaining_data.erase(std::string{ key });
+            }
+        }
+
+        return remaining_data;
+    }
+
+    // Scene Data Diff
+    SceneEdit diffSceneData(const json& previous_scene_data, const json& scene_data)
+    {
+        SceneEdit scene_edit{ };
+        if (previous_scene_data == scene_data) {
+            return scene_edit;
+        }
+
+        // Anything outside of the lights and objects of the world, such as the camera, changes every pixel
+        constexpr std::array<std::string_view, 1> WORLD_KEYS{ "world" };
+        const json& previous_world_data{ previous_scene_data.at("world") };
+        const json& world_data{ scene_data.at("world") };
+        if (eraseKeys(previous_scene_data, WORLD_KEYS) != eraseKeys(scene_data, WORLD_KEYS)) {
+            scene_edit.is_full_render_required = true;
+            return scene_edit;
+        }
+
+        std::array<std::string_view, LIGHT_DATA_KEYS.size() + 1> non_object_keys{ };
+        std::ranges::copy(LIGHT_DATA_KEYS, non_object_keys.begin());
+        non_object_keys.back() = "objects";
+        if (eraseKeys(previous_world_data, non_object_keys) != eraseKeys(world_data, non_object_keys)) {
+            scene_edit.is_full_render_required = true;
+            return scene_edit;
+        }
+
+        scene_edit.are_lights_changed = std::ranges::any_of(LIGHT_DATA_KEYS, [&](const std::string_view key) {
+            const std::string key_string{ key };
+            return previous_world_data.contains(key_string) != world_data.contains(key_string) ||
+                   (world_data.contains(key_string) && previous_world_data[key_string] != world_data[key_string]);
+        });
+
+        // Objects are matched by their position in the object list, so inserting or removing one changes them all
+        const json& previous_object_data_list{ previous_world_data.at("objects") };
+        const json& object_data_list{ world_data.at("objects") };
+        if (previous_object_data_list.size() != object_data_list.size()) {
+            scene_edit.is_full_render_required = true;
+            return scene_edit;
+        }
+
+        constexpr std::array<std::string_view, 1> MATERIAL_KEYS{ "material" };
+        for (size_t i = 0; i < object_data_list.size(); ++i) {
+            const json& previous_object_data{ previous_object_data_list.at(i) };
+            const json& object_data{ object_data_list.at(i) };
+            if (previous_object_data == object_data) {
+                continue;
+            }
+
+            if (eraseKeys(previous_object_data, MATERIAL_KEYS) == eraseKeys(object_data, MATERIAL_KEYS)) {
+                scene_edit.material_object_indices.push_back(i);
+            } else {
+                scene_edit.moved_object_indices.push_back(i);
+            }
+        }
+
+        return scene_edit;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+#include "parse.hpp"
+
+namespace data {
+    // Describes how the scene data of a render differs from the scene data of a previous render
+    struct SceneEdit
+    {
+        bool is_full_render_required{ false };          // The camera, animation or list of objects changed, or
+                                                        // anything else the edit cannot be narrowed down from
+        bool are_lights_changed{ false };               // The light sources or how they are sampled changed
+        std::vector<size_t> material_object_indices{ }; // Top-level objects whose only change is to their material
+        std::vector<size_t> moved_object_indices{ };    // Top-level objects whose transform or shape changed
+
+        // Returns true if the scene data is identical
+        [[nodiscard]] bool isEmpty() const
+        {
+            return !is_full_render_required && !are_lights_changed && material_object_indices.empty() &&
+                   moved_object_indices.empty();
+        }
+    };
+
+    // The keys of the world data which describe its lights, rather than its objects
+    inline constexpr std::array<std::string_view, 5> LIGHT_DATA_KEYS{
+        "light_source", "light_sources", "area_lights", "light_sampling", "shadow_maps" };
+
+    /* Scene Diff Functions */
+
+    // Returns the edit turning one JSON scene description into another, comparing the top-level objects of the two
+    // worlds one by one. Objects must keep their positions in the object list for their edits to be told apart.
+    [[nodiscard]] SceneEdit diffSceneData(const json& previous_scene_data, const json& scene_data);
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+#include "gtest/gtest.h"
+#include "scene_diff.hpp"
+
+#include <vector>
+
+// Returns the description of a scene with two spheres over a floor
+static json createTestSceneData()
+{
+    return json::parse(R"({
+        "world": {
+            "light_source": { "intensity": [1, 1, 1], "position": [-10, 10, -10] },
+            "objects": [
+                { "shape": "sphere", "material": { "color": [0.8, 1.0, 0.6] } },
+                { "shape": "sphere", "transform": [ { "type": "translate", "values": [2, 0, 0] } ] },
+                { "shape": "plane", "transform": [ { "type": "translate", "values": [0, -1, 0] } ] }
+            ]
+        },
+        "camera": {
+            "viewport_width": 64,
+            "viewport_height": 32,
+            "field_of_view": 1.0471975512,
+            "transform": { "input_base": [0, 1.5, -5], "output_base": [0, 0, 0], "up_vector": [0, 1, 0] }
+        }
+    })");
+}
+
+// Tests that identical scenes have no edit
+TEST(RayTracerSceneDiff, DiffIdenticalScenes)
+{
+    const data::SceneEdit scene_edit{ data::diffSceneData(createTestSceneData(), createTestSceneData()) };
+
+    ASSERT_TRUE(scene_edit.isEmpty());
+}
+
+// Tests telling apart edits of the materials and transforms of objects
+TEST(RayTracerSceneDiff, DiffObjectEdits)
+{
+    const json previous_scene_data = createTestSceneData();
+    json scene_data = createTestSceneData();
+    scene_data["world"]["objects"].at(0)["material"]["color"] = json::array({ 1, 0, 0 });
+    scene_data["world"]["objects"].at(1)["material"] = json::parse(R"({ "reflectivity": 0.5 })");
+    scene_data["world"]["objects"].at(2)["transform"].at(0)["values"] = json::array({ 0, -2, 0 });
+
+    const data::SceneEdit scene_edit{ data::diffSceneData(previous_scene_data, scene_data) };
+
+    ASSERT_FALSE(scene_edit.is_full_render_required);
+    ASSERT_FALSE(scene_edit.are_lights_changed);
+    ASSERT_EQ(scene_edit.material_object_indices, std::vector<size_t>({ 0, 1 }));
+    ASSERT_EQ(scene_edit.moved_object_indices, std::vector<size_t>{ 2 });
+
+    // Changing the shape of an object moves it
+    scene_data["world"]["objects"].at(0)["shape"] = "cube";
+    const data::SceneEdit scene_edit_shape{ data::diffSceneData(previous_scene_data, scene_data) };
+    ASSERT_EQ(scene_edit_shape.material_object_indices, std::vector<size_t>{ 1 });
+    ASSERT_EQ(scene_edit_shape.moved_object_indices, std::vector<size_t>({ 0, 2 }));
+}
+
+// Tests that edits of the lights are told apart from edits which require a full render
+TEST(RayTracerSceneDiff, DiffLightAndCameraEdits)
+{
+    const json previous_scene_data = createTestSceneData();
+    json scene_data = createTestSceneData();
+    scene_data["world"]["light_source"]["position"] = json::array({ 10, 10, -10 });
+    scene_data["world"]["area_lights"] = json::array();
+
+    const data::SceneEdit scene_edit_lights{ data::diffSceneData(previous_scene_data, scene_data) };
+    ASSERT_FALSE(scene_edit_lights.is_full_render_required);
+    ASSERT_TRUE(scene_edit_lights.are_lights_changed);
+    ASSERT_TRUE(scene_edit_lights.material_object_indices.empty());
+    ASSERT_TRUE(scene_edit_lights.moved_object_indices.empty());
+
+    json scene_data_camera = createTestSceneData();
+    scene_data_camera["camera"]["field_of_view"] = 0.8;
+    ASSERT_TRUE(data::diffSceneData(previous_scene_data, scene_data_camera).is_full_render_required);
+
+    json scene_data_objects = createTestSceneData();
+    scene_data_objects["world"]["objects"].erase(1);
+    ASSERT_TRUE(data::diffSceneData(previous_scene_data, scene_data_objects).is_full_render_required);
+}
\ No newline at end of file
@@ -0,0 +1,348 @@
+#include "distributed_rendering.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <format>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <poll.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "parse.hpp"
+#include "compiled_scene.hpp"
+#include "tile_leasing.hpp"
+#include "tile_protocol.hpp"
+
+extern char** environ;
+
+namespace rt {
+    // Holds the connection to a single worker, alongside the data it has sent which does not yet form a message
+    struct WorkerConnection
+    {
+        size_t worker_id;
+        rt::Socket socket;
+        rt::MessageBuffer buffer;
+    };
+
+    // Owns the worker processes spawned by a coordinator, killing any which are still running on destruction
+    class WorkerProcessGroup
+    {
+    public:
+        /* Constructors */
+
+        WorkerProcessGroup() = default;
+        WorkerProcessGroup(const WorkerProcessGroup&) = delete;
+
+        /* Destructor */
+
+        ~WorkerProcessGroup()
+        {
+            terminate(std::chrono::seconds{ 0 });
+        }
+
+        /* Assignment Operators */
+
+        WorkerProcessGroup& operator=(const WorkerProcessGroup&) = delete;
+
+        /* Accessors */
+
+        [[nodiscard]] size_t getSpawnedCount() const
+        { return m_spawned_count; }
+
+        /* Process Methods */
+
+        // Starts a worker process which connects to the passed-in endpoint
+        void spawn(const std::filesystem::path& executable, const rt::Endpoint& endpoint)
+        {
+            std::string executable_string{ executable.string() };
+            std::string mode_argument{ "--worker" };
+            std::string endpoint_argument{ rt::formatEndpoint(endpoint) };
+            std::array<char*, 4> arguments{
+                executable_string.data(), mode_argument.data(), endpoint_argument.data(), nullptr };
+
+            pid_t process_id{ };
+            const int error{
+                posix_spawnp(&process_id, executable_string.c_str(), nullptr, nullptr, arguments.data(), environ) };
+            if (error != 0) {
+                throw std::system_error(error,
+                                        std::generic_category(),
+                                        std::format("Unable to spawn worker '{}'", executable_string));
+            }
+
+            m_running_process_ids.push_back(process_id);
+            ++m_spawned_count;
+        }
+
+        // Collects the exit status of any workers which have exited, returning the number still running
+        size_t reapExited()
+        {
+            std::erase_if(m_running_process_ids, [](const pid_t process_id) {
+                return waitpid(process_id, nullptr, WNOHANG) != 0;
+            });
+
+            return m_running_process_ids.size();
+        }
+
+        // Waits up to a grace period for the workers to exit by themselves, then kills the rest
+        void terminate(const std::chrono::duration<double> grace_period)
+        {
+            const auto deadline{ std::chrono::steady_clock::now() + grace_period };
+            while (reapExited() > 0 && std::chrono::steady_clock::now() < deadline) {
+                std::this_thread::sleep_for(LEASE_RETRY_INTERVAL);
+            }
+
+            for (const pid_t process_id : m_running_process_ids) {
+                kill(process_id, SIGKILL);
+                waitpid(process_id, nullptr, 0);
+            }
+            m_running_process_ids.clear();
+        }
+
+    private:
+        /* Data Members */
+
+        std::vector<pid_t> m_running_process_ids{ };
+        size_t m_spawned_count{ 0 };
+    };
+
+    // Responds to a message from a worker, copying the pixels of accepted tile results into the frame. Throws if the
+    // worker breaks the protocol or can no longer be sent messages.
+    static void serveWorkerMessage(WorkerConnection& connection,
+                                   const rt::Message& message,
+                                   rt::TileLeaseTable& lease_table,
+                                   rt::RenderResult& frame,
+                                   rt::DistributedRenderReport& report)
+    {
+        switch (message.type) {
+            case MessageType::LeaseRequest: {
+                const std::optional<rt::TileLease> lease{
+                    lease_table.acquireLease(connection.worker_id, TileLeaseTable::Clock::now()) };
+                sendMessage(connection.socket, lease ? encodeTileLease(*lease) : createMessage(MessageType::Wait));
+                break;
+            }
+            case MessageType::TileResult: {
+                const rt::TileResult tile_result{ decodeTileResult(message) };
+                const rt::RenderResult& tile_render{ tile_result.render_result };
+                if (lease_table.getLeasedTile(tile_result.lease_id) != tile_render.region) {
+                    throw std::invalid_argument("Tile result does not match the tile that was leased");
+                }
+                if (!lease_table.completeLease(tile_result.lease_id)) {
+                    ++report.discarded_result_count;
+                    break;
+                }
+
+                copyRenderRegion(tile_render, frame);
+                break;
+            }
+            default:
+                throw std::invalid_argument(
+                    std::format("Unexpected message of type {} from a worker", std::to_underlying(message.type)));
+        }
+    }
+
+    Endpoint createDefaultEndpoint()
+    {
+        const std::filesystem::path socket_path{
+            std::filesystem::temp_directory_path() / std::format("ray_tracer_{}.sock", getpid()) };
+        return rt::Endpoint{ EndpointType::UnixSocket, socket_path.string() };
+    }
+
+    rt::DistributedRenderResult renderDistributed(const std::filesystem::path& scene_file_path,
+                                                  const rt::Camera& camera,
+                                                  const rt::SamplingSettings& settings,
+                                                  const rt::DistributedRenderSettings& distributed_settings,
+                                                  const std::optional<rt::PixelRect>& region)
+    {
+        using Clock = TileLeaseTable::Clock;
+        const Clock::time_point start_time{ Clock::now() };
+
+        // Reject work the workers would fail on before starting any of them
+        if (settings.min_samples == 0 || settings.max_samples < settings.min_samples) {
+            throw std::invalid_argument("Sample counts must satisfy 1 <= minimum samples <= maximum samples");
+        }
+        const rt::PixelRect frame_region{ region.value_or(camera.getViewportRect()) };
+        if (!camera.isWithinViewport(frame_region)) {
+            throw std::invalid_argument("Region extends past the edges of the camera viewport");
+        }
+
+        const auto lease_timeout{ std::chrono::duration_cast<Clock::duration>(distributed_settings.lease_timeout) };
+        rt::TileLeaseTable lease_table{ frame_region, LEASED_TILE_SIZE, lease_timeout };
+        rt::RenderResult frame{ rt::Canvas{ frame_region.width, frame_region.height },
+                                frame_region,
+                                std::vector<size_t>(frame_region.width * frame_region.height),
+                                0 };
+        rt::DistributedRenderReport report{ };
+        report.tile_count = lease_table.getTileCount();
+
+        // Workers may run in another directory, so send them the absolute path of the scene file
+        const rt::Message job_message{ encodeRenderJob(
+            rt::RenderJob{ std::filesystem::absolute(scene_file_path).string(), settings }) };
+
+        const rt::Socket listener{ listenOnEndpoint(distributed_settings.endpoint) };
+        const EndpointFileRemover endpoint_file_remover{ distributed_settings.endpoint };
+        WorkerProcessGroup worker_processes{ };
+        for (size_t i = 0; i < distributed_settings.worker_count; ++i) {
+            worker_processes.spawn(distributed_settings.worker_executable, distributed_settings.endpoint);
+        }
+
+        // Workers which are waiting for a lease ask for one every retry interval, so a frame without a message or new
+        // connection for longer than the lease timeout has no worker left which is able to complete it
+        Clock::time_point last_worker_activity_time{ start_time };
+
+        std::vector<WorkerConnection> connections{ };
+        size_t next_worker_id{ 0 };
+        while (!lease_table.isComplete()) {
+            std::vector<pollfd> poll_descriptors{ pollfd{ listener.getDescriptor(), POLLIN, 0 } };
+            for (const WorkerConnection& connection : connections) {
+                poll_descriptors.push_back(pollfd{ connection.socket.getDescriptor(), POLLIN, 0 });
+            }
+            if (poll(poll_descriptors.data(), poll_descriptors.size(), COORDINATOR_POLL_INTERVAL.count()) < 0 &&
+                errno != EINTR) {
+                throw std::system_error(errno, std::generic_category(), "Unable to wait for workers");
+            }
+
+            // Serve the messages of each worker, dropping workers which disconnect or break the protocol and
+            // returning their tiles to the pending queue
+            for (size_t i = 0; i < connections.size(); ++i) {
+                if (poll_descriptors[i + 1].revents == 0) {
+                    continue;
+                }
+
+                WorkerConnection& connection{ connections[i] };
+                bool is_connected{ receiveAvailableData(connection.socket, connection.buffer) };
+                try {
+                    while (is_connected && !lease_table.isComplete()) {
+                        const std::optional<rt::Message> message{ connection.buffer.extractMessage() };
+                        if (!message) {
+                            break;
+                        }
+                        last_worker_activity_time = Clock::now();
+                        serveWorkerMessage(connection, *message, lease_table, frame, report);
+                    }
+                }
+                catch (const std::exception&) {
+                    is_connected = false;
+                }
+
+                if (!is_connected) {
+                    lease_table.releaseWorkerLeases(connection.worker_id);
+                    connection.socket.close();
+                    ++report.lost_worker_count;
+                }
+            }
+            std::erase_if(connections, [](const WorkerConnection& connection) { return !connection.socket.isOpen(); });
+
+            // Accept new workers, starting each one on the render job
+            if ((poll_descriptors[0].revents & POLLIN) != 0) {
+                WorkerConnection connection{ next_worker_id++, acceptConnection(listener), rt::MessageBuffer{ } };
+                try {
+                    sendMessage(connection.socket, job_message);
+                    connections.push_back(std::move(connection));
+                    ++report.worker_connection_count;
+                    last_worker_activity_time = Clock::now();
+                }
+                catch (const std::system_error&) {
+                    ++report.lost_worker_count;
+                }
+            }
+
+            if (worker_processes.getSpawnedCount() > 0 && worker_processes.reapExited() == 0 && connections.empty()) {
+                throw std::runtime_error("Every worker exited before the frame was complete");
+            }
+
+            // Expire leases here as well as when workers ask for one, so stalled workers are noticed without relying
+            // on the other workers to ask
+            const Clock::time_point now{ Clock::now() };
+            lease_table.expireLeases(now);
+            if (now - last_worker_activity_time > lease_timeout) {
+                throw std::runtime_error("No worker responded within the lease timeout before the frame was complete");
+            }
+        }
+
+        // Release the workers, giving those still busy with a tile that was completed elsewhere time to notice
+        for (WorkerConnection& connection : connections) {
+            try {
+                sendMessage(connection.socket, createMessage(MessageType::Shutdown));
+            }
+            catch (const std::system_error&) {
+                // The worker has already gone, which is all shutting it down would achieve
+            }
+            connection.socket.close();
+        }
+        worker_processes.terminate(WORKER_SHUTDOWN_GRACE_PERIOD);
+
+        report.revoked_lease_count = lease_table.getRevokedLeaseCount();
+        report.total_time = Clock::now() - start_time;
+        return rt::DistributedRenderResult{ std::move(frame), report };
+    }
+
+    size_t runRenderWorker(const rt::Endpoint& endpoint)
+    {
+        const rt::Socket socket{ connectToEndpoint(endpoint) };
+        rt::MessageBuffer buffer{ };
+        const std::optional<rt::Message> job_message{ receiveMessage(socket, buffer) };
+        if (!job_message) {
+            return 0;
+        }
+
+        // Load the scene once, rendering every leased tile from the same compiled snapshot
+        const rt::RenderJob job{ decodeRenderJob(*job_message) };
+        const Scene scene{ data::readSceneFile(job.scene_file_path) };
+        const gfx::CompiledScene compiled_scene{ gfx::compileScene(scene.world) };
+
+        // The coordinator closes its connections as soon as the frame is complete, so a failure to send only means
+        // the work is done
+        const auto trySendMessage{ [&socket](const rt::Message& message) {
+            try {
+                sendMessage(socket, message);
+                return true;
+            }
+            catch (const std::system_error&) {
+                return false;
+            }
+        } };
+
+        size_t rendered_tile_count{ 0 };
+        while (true) {
+            if (!trySendMessage(createMessage(MessageType::LeaseRequest))) {
+                return rendered_tile_count;
+            }
+
+            const std::optional<rt::Message> message{ receiveMessage(socket, buffer) };
+            if (!message) {
+                return rendered_tile_count;
+            }
+
+            switch (message->type) {
+                case MessageType::TileLease: {
+                    const rt::TileLease lease{ decodeTileLease(*message) };
+                    rt::TileResult tile_result{
+                        lease.lease_id,
+                        renderAdaptive(compiled_scene, scene.camera, job.sampling_settings, lease.tile) };
+                    if (!trySendMessage(encodeTileResult(tile_result))) {
+                        return rendered_tile_count;
+                    }
+                    ++rendered_tile_count;
+                    break;
+                }
+                case MessageType::Wait:
+                    std::this_thread::sleep_for(LEASE_RETRY_INTERVAL);
+                    break;
+                case MessageType::Shutdown:
+                    return rendered_tile_count;
+                default:
+                    throw std::invalid_argument(std::format("Unexpected message of type {} from the coordinator",
+                                                            std::to_underlying(message->type)));
+            }
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+
+#include "camera.hpp"
+#include "sampling.hpp"
+#include "rendering_functions.hpp"
+#include "socket.hpp"
+
+namespace rt {
+    // How long a worker waits before asking for another lease when none is available
+    inline constexpr std::chrono::milliseconds LEASE_RETRY_INTERVAL{ 50 };
+
+    // How often the coordinator checks on its worker processes while no messages arrive
+    inline constexpr std::chrono::milliseconds COORDINATOR_POLL_INTERVAL{ 250 };
+
+    // How long spawned workers are given to exit after the frame is complete before they are killed
+    inline constexpr std::chrono::seconds WORKER_SHUTDOWN_GRACE_PERIOD{ 2 };
+
+    // Controls how a frame is distributed across worker processes
+    struct DistributedRenderSettings
+    {
+        size_t worker_count;                            // Workers to spawn, in addition to any which connect themselves
+        rt::Endpoint endpoint;                          // Where the coordinator listens for workers
+        std::filesystem::path worker_executable;        // The ray tracer executable run by each spawned worker
+        std::chrono::duration<double> lease_timeout;    // How long a worker may hold a tile before it is leased again
+    };
+
+    // Describes how the work of a distributed render was shared out
+    struct DistributedRenderReport
+    {
+        size_t tile_count;
+        size_t worker_connection_count;
+        size_t lost_worker_count;           // Workers which disconnected before the frame was complete
+        size_t revoked_lease_count;         // Leases which expired or were held by a lost worker
+        size_t discarded_result_count;      // Results for tiles which another worker had already completed
+        std::chrono::duration<double> total_time;
+    };
+
+    // Holds the result of a distributed render alongside a description of how it was shared out
+    struct DistributedRenderResult
+    {
+        rt::RenderResult render_result;
+        rt::DistributedRenderReport report;
+    };
+
+    /* Distributed Rendering Functions */
+
+    // Returns a Unix socket endpoint in the temporary directory which is unique to the current process
+    [[nodiscard]] rt::Endpoint createDefaultEndpoint();
+
+    // Renders a scene file by leasing its tiles to worker processes, acting as their coordinator. The coordinator
+    // spawns the requested number of workers running "<worker executable> --worker <endpoint>", and also accepts
+    // workers started elsewhere. Each worker loads the scene once, then repeatedly leases a tile, renders it with
+    // adaptive supersampling and streams back its pixels. Tiles held by a worker which disconnects, or which are not
+    // returned before the lease timeout, are leased to another worker. Throws if every spawned worker exits before
+    // the frame is complete while no other worker is connected, or if no worker sends a message or connects for
+    // longer than the lease timeout.
+    [[nodiscard]] rt::DistributedRenderResult
+    renderDistributed(const std::filesystem::path& scene_file_path,
+                      const rt::Camera& camera,
+                      const rt::SamplingSettings& settings,
+                      const rt::DistributedRenderSettings& distributed_settings,
+                      const std::optional<rt::PixelRect>& region = std::nullopt);
+
+    // Connects to a coordinator and renders the tiles it leases until it reports the frame is complete or
+    // disconnects, returning the number of tiles rendered
+    size_t runRenderWorker(const rt::Endpoint& endpoint);
+}
\ No newline at end of file
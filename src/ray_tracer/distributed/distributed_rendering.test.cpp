@@ -0,0 +1,175 @@
+#include "gtest/gtest.h"
+#include "distributed_rendering.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <optional>
+#include <system_error>
+#include <thread>
+
+#include "parse.hpp"
+#include "compiled_scene.hpp"
+#include "tile_protocol.hpp"
+
+// Writes a small scene file for the workers of a distributed render to load
+static std::filesystem::path writeTestSceneFile()
+{
+    const std::filesystem::path scene_file_path{
+        std::filesystem::temp_directory_path() / "distributed_rendering_test_scene.json" };
+    std::ofstream scene_file{ scene_file_path, std::ios_base::trunc };
+    scene_file << R"({
+        "world": {
+            "light_source": { "intensity": [1, 1, 1], "position": [-10, 10, -10] },
+            "objects": [
+                { "shape": "sphere", "material": { "color": [0.8, 1.0, 0.6], "diffuse": 0.7, "specular": 0.2 } },
+                { "shape": "plane", "transform": [ { "type": "translate", "values": [0, -1, 0] } ] }
+            ]
+        },
+        "camera": {
+            "viewport_width": 75,
+            "viewport_height": 40,
+            "field_of_view": 1.0471975512,
+            "transform": { "input_base": [0, 1.5, -5], "output_base": [0, 0, 0], "up_vector": [0, 1, 0] }
+        }
+    })";
+
+    return scene_file_path;
+}
+
+// Runs a worker, retrying until the coordinator has started listening, unless the frame was completed before the
+// worker could connect
+static size_t runWorkerWhenReady(const rt::Endpoint& endpoint, const std::atomic<bool>& is_frame_complete)
+{
+    while (!is_frame_complete) {
+        try {
+            return rt::runRenderWorker(endpoint);
+        }
+        catch (const std::system_error&) {
+            std::this_thread::sleep_for(rt::LEASE_RETRY_INTERVAL);
+        }
+    }
+
+    return 0;
+}
+
+// Tests that a frame distributed across workers matches the frame rendered in a single process
+TEST(RayTracerDistributedRendering, RenderWithWorkers)
+{
+    const std::filesystem::path scene_file_path{ writeTestSceneFile() };
+    const Scene scene{ data::readSceneFile(scene_file_path) };
+    const rt::SamplingSettings settings{ .min_samples = 4, .max_samples = 4 };
+    const rt::DistributedRenderSettings distributed_settings{
+        0, rt::createDefaultEndpoint(), "", std::chrono::seconds{ 30 } };
+
+    std::future<rt::DistributedRenderResult> coordinator{ std::async(std::launch::async, [&]() {
+        return rt::renderDistributed(scene_file_path, scene.camera, settings, distributed_settings);
+    }) };
+    std::atomic<bool> is_frame_complete{ false };
+    const auto runWorker{ [&]() { return runWorkerWhenReady(distributed_settings.endpoint, is_frame_complete); } };
+    std::future<size_t> worker_a{ std::async(std::launch::async, runWorker) };
+    std::future<size_t> worker_b{ std::async(std::launch::async, runWorker) };
+
+    const rt::DistributedRenderResult result{ coordinator.get() };
+    is_frame_complete = true;
+    const rt::RenderResult expected{
+        rt::renderAdaptive(gfx::compileScene(scene.world), scene.camera, settings) };
+
+    // Tiles are 32 pixels wide, so the frame is split into 3x2 tiles. One worker may complete all of them before
+    // the other connects.
+    EXPECT_EQ(worker_a.get() + worker_b.get(), 6);
+    EXPECT_EQ(result.report.tile_count, 6);
+    EXPECT_GE(result.report.worker_connection_count, 1);
+    EXPECT_EQ(result.report.lost_worker_count, 0);
+    EXPECT_EQ(result.render_result.total_sample_count, expected.total_sample_count);
+    EXPECT_EQ(result.render_result.sample_counts, expected.sample_counts);
+    for (size_t y = 0; y < 40; ++y)
+        for (size_t x = 0; x < 75; ++x) {
+            EXPECT_EQ((result.render_result.image[x, y]), (expected.image[x, y]));
+        }
+    EXPECT_FALSE(std::filesystem::exists(distributed_settings.endpoint.address));
+
+    std::filesystem::remove(scene_file_path);
+}
+
+// Tests that the tiles of a worker which disconnects are rendered by another worker
+TEST(RayTracerDistributedRendering, ReleaseLostWorkerTiles)
+{
+    const std::filesystem::path scene_file_path{ writeTestSceneFile() };
+    const Scene scene{ data::readSceneFile(scene_file_path) };
+    const rt::SamplingSettings settings{ };
+    const rt::PixelRect region{ 5, 5, 40, 30 };
+    const rt::DistributedRenderSettings distributed_settings{
+        0, rt::createDefaultEndpoint(), "", std::chrono::seconds{ 30 } };
+
+    std::future<rt::DistributedRenderResult> coordinator{ std::async(std::launch::async, [&]() {
+        return rt::renderDistributed(scene_file_path, scene.camera, settings, distributed_settings, region);
+    }) };
+
+    // Lease a tile, then disconnect without returning it
+    std::optional<rt::Socket> lost_worker_socket{ };
+    while (!lost_worker_socket) {
+        try {
+            lost_worker_socket = rt::connectToEndpoint(distributed_settings.endpoint);
+        }
+        catch (const std::system_error&) {
+            std::this_thread::sleep_for(rt::LEASE_RETRY_INTERVAL);
+        }
+    }
+    rt::MessageBuffer buffer{ };
+    ASSERT_EQ(rt::receiveMessage(*lost_worker_socket, buffer)->type, rt::MessageType::RenderJob);
+    rt::sendMessage(*lost_worker_socket, rt::createMessage(rt::MessageType::LeaseRequest));
+    ASSERT_EQ(rt::receiveMessage(*lost_worker_socket, buffer)->type, rt::MessageType::TileLease);
+    lost_worker_socket.reset();
+
+    const std::atomic<bool> is_frame_complete{ false };
+    EXPECT_EQ(runWorkerWhenReady(distributed_settings.endpoint, is_frame_complete), 2);
+
+    const rt::DistributedRenderResult result{ coordinator.get() };
+    const rt::Canvas expected{ rt::render(gfx::compileScene(scene.world), scene.camera, region) };
+
+    EXPECT_EQ(result.render_result.region, region);
+    EXPECT_EQ(result.report.lost_worker_count, 1);
+    EXPECT_EQ(result.report.revoked_lease_count, 1);
+    for (size_t y = 0; y < region.height; ++y)
+        for (size_t x = 0; x < region.width; ++x) {
+            EXPECT_EQ((result.render_result.image[x, y]), (expected[x, y]));
+        }
+
+    std::filesystem::remove(scene_file_path);
+}
+// Tests that the coordinator gives up on a frame once its only worker stops responding
+TEST(RayTracerDistributedRendering, FailWithoutRespondingWorkers)
+{
+    const std::filesystem::path scene_file_path{ writeTestSceneFile() };
+    const Scene scene{ data::readSceneFile(scene_file_path) };
+    const rt::SamplingSettings settings{ };
+    const rt::DistributedRenderSettings distributed_settings{
+        0, rt::createDefaultEndpoint(), "", std::chrono::milliseconds{ 500 } };
+
+    std::future<rt::DistributedRenderResult> coordinator{ std::async(std::launch::async, [&]() {
+        return rt::renderDistributed(scene_file_path, scene.camera, settings, distributed_settings);
+    }) };
+
+    // Lease a tile, then stall while keeping the connection open
+    std::optional<rt::Socket> stalled_worker_socket{ };
+    while (!stalled_worker_socket) {
+        try {
+            stalled_worker_socket = rt::connectToEndpoint(distributed_settings.endpoint);
+        }
+        catch (const std::system_error&) {
+            std::this_thread::sleep_for(rt::LEASE_RETRY_INTERVAL);
+        }
+    }
+    rt::MessageBuffer buffer{ };
+    ASSERT_EQ(rt::receiveMessage(*stalled_worker_socket, buffer)->type, rt::MessageType::RenderJob);
+    rt::sendMessage(*stalled_worker_socket, rt::createMessage(rt::MessageType::LeaseRequest));
+    ASSERT_EQ(rt::receiveMessage(*stalled_worker_socket, buffer)->type, rt::MessageType::TileLease);
+
+    ASSERT_EQ(coordinator.wait_for(std::chrono::seconds{ 30 }), std::future_status::ready);
+    EXPECT_THROW(static_cast<void>(coordinator.get()), std::runtime_error);
+
+    std::filesystem::remove(scene_file_path);
+}
@@ -0,0 +1,253 @@
+#include "socket.hpp"
+
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace rt {
+    // Throws a system error describing the current value of errno
+    [[noreturn]] static void throwSystemError(const std::string_view operation, const Endpoint& endpoint)
+    {
+        throw std::system_error(errno,
+                                std::generic_category(),
+                                std::format("Unable to {} '{}'", operation, formatEndpoint(endpoint)));
+    }
+
+    // Returns the address of a Unix socket endpoint, throwing if its path does not fit in the address structure
+    static sockaddr_un createUnixSocketAddress(const Endpoint& endpoint)
+    {
+        sockaddr_un address{ };
+        address.sun_family = AF_UNIX;
+        if (endpoint.address.size() >= sizeof(address.sun_path)) {
+            throw std::invalid_argument(std::format("Socket path '{}' is too long", endpoint.address));
+        }
+
+        std::memcpy(address.sun_path, endpoint.address.c_str(), endpoint.address.size() + 1);
+        return address;
+    }
+
+    // Sends the small request and lease messages of TCP connections immediately rather than batching them, which
+    // would otherwise add a round trip delay to every lease
+    static void disableSendCoalescing(const Socket& socket)
+    {
+        const int no_delay{ 1 };
+        setsockopt(socket.getDescriptor(), IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof(no_delay));
+    }
+
+    // Creates a socket for the first address a TCP endpoint resolves to which the passed-in operation (bind or
+    // connect) succeeds on, throwing if there is none
+    template<typename Operation>
+    static Socket createTcpSocket(const Endpoint& endpoint, const std::string_view operation_name, Operation operation)
+    {
+        addrinfo hints{ };
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        addrinfo* address_list{ nullptr };
+        const std::string port{ std::to_string(endpoint.port) };
+        const int error{ getaddrinfo(endpoint.address.c_str(), port.c_str(), &hints, &address_list) };
+        if (error != 0) {
+            throw std::invalid_argument(
+                std::format("Unable to resolve '{}': {}", formatEndpoint(endpoint), gai_strerror(error)));
+        }
+
+        Socket socket{ };
+        int operation_errno{ 0 };
+        for (const addrinfo* address = address_list; address != nullptr; address = address->ai_next) {
+            Socket candidate{ ::socket(address->ai_family, address->ai_socktype, address->ai_protocol) };
+            if (candidate.isOpen() && operation(candidate, address->ai_addr, address->ai_addrlen) == 0) {
+                socket = std::move(candidate);
+                break;
+            }
+            operation_errno = errno;
+        }
+        freeaddrinfo(address_list);
+
+        if (!socket.isOpen()) {
+            errno = operation_errno;
+            throwSystemError(operation_name, endpoint);
+        }
+
+        return socket;
+    }
+
+    Socket::Socket(Socket&& src) noexcept
+            : m_descriptor{ std::exchange(src.m_descriptor, -1) }
+    {}
+
+    Socket::~Socket()
+    {
+        close();
+    }
+
+    Socket& Socket::operator=(Socket&& rhs) noexcept
+    {
+        if (this != &rhs) {
+            close();
+            m_descriptor = std::exchange(rhs.m_descriptor, -1);
+        }
+
+        return *this;
+    }
+
+    void Socket::close()
+    {
+        if (m_descriptor >= 0) {
+            ::close(m_descriptor);
+            m_descriptor = -1;
+        }
+    }
+
+    void Socket::shutdown() const
+    {
+        if (m_descriptor >= 0) {
+            ::shutdown(m_descriptor, SHUT_RDWR);
+        }
+    }
+
+    EndpointFileRemover::~EndpointFileRemover()
+    {
+        if (m_endpoint.type == EndpointType::UnixSocket) {
+            std::error_code error{ };
+            std::filesystem::remove(m_endpoint.address, error);
+        }
+    }
+
+    // Endpoint Parser
+    Endpoint parseEndpoint(const std::string_view description)
+    {
+        if (description.starts_with("unix:") && description.size() > 5) {
+            return Endpoint{ EndpointType::UnixSocket, std::string{ description.substr(5) } };
+        }
+
+        if (description.starts_with("tcp:")) {
+            const std::string_view host_and_port{ description.substr(4) };
+            const size_t separator{ host_and_port.rfind(':') };
+            if (separator != std::string_view::npos && separator > 0) {
+                const std::string_view port_string{ host_and_port.substr(separator + 1) };
+                uint16_t port{ 0 };
+                const auto [end, error]{
+                    std::from_chars(port_string.data(), port_string.data() + port_string.size(), port) };
+                if (error == std::errc{ } && end == port_string.data() + port_string.size() && port != 0) {
+                    return Endpoint{ EndpointType::Tcp, std::string{ host_and_port.substr(0, separator) }, port };
+                }
+            }
+        }
+
+        throw std::invalid_argument(
+            std::format("Invalid endpoint '{}', expected 'unix:<path>' or 'tcp:<host>:<port>'", description));
+    }
+
+    std::string formatEndpoint(const Endpoint& endpoint)
+    {
+        return endpoint.type == EndpointType::UnixSocket ?
+            std::format("unix:{}", endpoint.address) : std::format("tcp:{}:{}", endpoint.address, endpoint.port);
+    }
+
+    Socket listenOnEndpoint(const Endpoint& endpoint)
+    {
+        Socket socket{ };
+        if (endpoint.type == EndpointType::UnixSocket) {
+            const sockaddr_un address{ createUnixSocketAddress(endpoint) };
+            if (std::filesystem::is_socket(endpoint.address)) {
+                std::filesystem::remove(endpoint.address);
+            }
+
+            socket = Socket{ ::socket(AF_UNIX, SOCK_STREAM, 0) };
+            if (!socket.isOpen() ||
+                bind(socket.getDescriptor(), reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+                throwSystemError("listen on", endpoint);
+            }
+        }
+        else {
+            socket = createTcpSocket(endpoint, "listen on", [](const Socket& candidate,
+                                                               const sockaddr* address,
+                                                               const socklen_t address_length) {
+                const int reuse_address{ 1 };
+                setsockopt(candidate.getDescriptor(), SOL_SOCKET, SO_REUSEADDR, &reuse_address, sizeof(reuse_address));
+                return bind(candidate.getDescriptor(), address, address_length);
+            });
+        }
+
+        if (listen(socket.getDescriptor(), SOMAXCONN) != 0) {
+            throwSystemError("listen on", endpoint);
+        }
+
+        return socket;
+    }
+
+    Socket connectToEndpoint(const Endpoint& endpoint)
+    {
+        if (endpoint.type == EndpointType::Tcp) {
+            Socket socket{ createTcpSocket(endpoint, "connect to", [](const Socket& candidate,
+                                                                      const sockaddr* address,
+                                                                      const socklen_t address_length) {
+                return connect(candidate.getDescriptor(), address, address_length);
+            }) };
+            disableSendCoalescing(socket);
+            return socket;
+        }
+
+        const sockaddr_un address{ createUnixSocketAddress(endpoint) };
+        Socket socket{ ::socket(AF_UNIX, SOCK_STREAM, 0) };
+        if (!socket.isOpen() ||
+            connect(socket.getDescriptor(), reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+            throwSystemError("connect to", endpoint);
+        }
+
+        return socket;
+    }
+
+    Socket acceptConnection(const Socket& listener)
+    {
+        Socket socket{ accept(listener.getDescriptor(), nullptr, nullptr) };
+        if (!socket.isOpen()) {
+            throw std::system_error(errno, std::generic_category(), "Unable to accept a connection");
+        }
+
+        // Unix sockets do not support the option, which has no effect on them anyway
+        disableSendCoalescing(socket);
+
+        return socket;
+    }
+
+    void sendData(const Socket& socket, const std::span<const std::byte> data)
+    {
+        size_t sent_size{ 0 };
+        while (sent_size < data.size()) {
+            // Report a disconnected peer as an error rather than raising SIGPIPE
+            const ssize_t result{
+                send(socket.getDescriptor(), data.data() + sent_size, data.size() - sent_size, MSG_NOSIGNAL) };
+            if (result < 0 && errno != EINTR) {
+                throw std::system_error(errno, std::generic_category(), "Unable to send data");
+            }
+            if (result > 0) {
+                sent_size += static_cast<size_t>(result);
+            }
+        }
+    }
+
+    size_t receiveData(const Socket& socket, const std::span<std::byte> buffer)
+    {
+        while (true) {
+            const ssize_t result{ recv(socket.getDescriptor(), buffer.data(), buffer.size(), 0) };
+            if (result >= 0) {
+                return static_cast<size_t>(result);
+            }
+            if (errno != EINTR) {
+                return 0;
+            }
+        }
+    }
+}
\ No newline at end of file
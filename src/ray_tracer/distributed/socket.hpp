@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace rt {
+    // The kinds of address a coordinator can listen on
+    enum class EndpointType
+    {
+        UnixSocket,     // A socket file on the local node
+        Tcp             // A host name or IPv4 address with a port
+    };
+
+    // Describes where a coordinator listens for workers, and where workers connect to it
+    struct Endpoint
+    {
+        EndpointType type;
+        std::string address;        // The socket file path, or the host name
+        uint16_t port{ 0 };         // Only used by TCP endpoints
+
+        [[nodiscard]] bool operator==(const Endpoint&) const = default;
+    };
+
+    // Owns the file descriptor of a connected or listening socket, closing it on destruction
+    class Socket
+    {
+    public:
+        /* Constructors */
+
+        Socket() = default;
+        explicit Socket(const int descriptor) : m_descriptor{ descriptor } {}
+        Socket(const Socket&) = delete;
+        Socket(Socket&& src) noexcept;
+
+        /* Destructor */
+
+        ~Socket();
+
+        /* Assignment Operators */
+
+        Socket& operator=(const Socket&) = delete;
+        Socket& operator=(Socket&& rhs) noexcept;
+
+        /* Accessors */
+
+        [[nodiscard]] int getDescriptor() const
+        { return m_descriptor; }
+
+        [[nodiscard]] bool isOpen() const
+        { return m_descriptor >= 0; }
+
+        /* Mutators */
+
+        void close();
+
+        // Stops any further data being sent or received on a connection, waking any thread blocked reading from it,
+        // while keeping the descriptor open
+        void shutdown() const;
+
+    private:
+        /* Data Members */
+
+        int m_descriptor{ -1 };
+    };
+
+    // Removes the socket file of a Unix socket endpoint on destruction, once nothing listens on it anymore
+    class EndpointFileRemover
+    {
+    public:
+        /* Constructors */
+
+        EndpointFileRemover() = delete;
+        explicit EndpointFileRemover(const Endpoint& endpoint) : m_endpoint{ endpoint } {}
+        EndpointFileRemover(const EndpointFileRemover&) = delete;
+
+        /* Destructor */
+
+        ~EndpointFileRemover();
+
+        /* Assignment Operators */
+
+        EndpointFileRemover& operator=(const EndpointFileRemover&) = delete;
+
+    private:
+        /* Data Members */
+
+        Endpoint m_endpoint;
+    };
+
+    /* Endpoint Functions */
+
+    // Returns the endpoint described by a string of the form "unix:<path>" or "tcp:<host>:<port>", throwing if the
+    // string is malformed
+    [[nodiscard]] Endpoint parseEndpoint(std::string_view description);
+
+    // Returns the string describing an endpoint, in the form accepted by parseEndpoint
+    [[nodiscard]] std::string formatEndpoint(const Endpoint& endpoint);
+
+    /* Socket Functions */
+
+    // Returns a socket listening for connections on an endpoint. A stale socket file left at the path of a Unix
+    // socket endpoint is replaced. Throws std::system_error if the endpoint cannot be bound.
+    [[nodiscard]] Socket listenOnEndpoint(const Endpoint& endpoint);
+
+    // Returns a socket connected to an endpoint, throwing std::system_error if the connection is refused
+    [[nodiscard]] Socket connectToEndpoint(const Endpoint& endpoint);
+
+    // Returns the socket of the next pending connection of a listening socket
+    [[nodiscard]] Socket acceptConnection(const Socket& listener);
+
+    // Sends all of the passed-in data over a socket, blocking until it has been written. Throws std::system_error if
+    // the peer has disconnected.
+    void sendData(const Socket& socket, std::span<const std::byte> data);
+
+    // Reads whatever data is available from a socket, blocking only if none is, and returns the number of bytes
+    // read. Returns 0 once the peer has disconnected.
+    [[nodiscard]] size_t receiveData(const Socket& socket, std::span<std::byte> buffer);
+}
\ No newline at end of file
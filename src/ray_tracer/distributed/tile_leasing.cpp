@@ -0,0 +1,109 @@
+#include "tile_leasing.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace rt {
+    TileLeaseTable::TileLeaseTable(const rt::PixelRect& region,
+                                   const size_t tile_size,
+                                   const Clock::duration lease_timeout)
+            : m_tiles{ },
+              m_is_tile_complete{ },
+              m_lease_timeout{ lease_timeout }
+    {
+        if (tile_size == 0) {
+            throw std::invalid_argument("Leased tiles must be at least one pixel wide");
+        }
+
+        m_tiles = splitIntoTiles(region, tile_size);
+        for (size_t tile = 0; tile < m_tiles.size(); ++tile) {
+            m_pending_tiles.push_back(tile);
+        }
+        m_is_tile_complete.assign(m_tiles.size(), false);
+    }
+
+    // Leased Tile Accessor
+    std::optional<rt::PixelRect> TileLeaseTable::getLeasedTile(const uint64_t lease_id) const
+    {
+        const auto lease_tile{ m_lease_tiles.find(lease_id) };
+        if (lease_tile == m_lease_tiles.end()) {
+            return std::nullopt;
+        }
+
+        return m_tiles[lease_tile->second];
+    }
+
+    void TileLeaseTable::expireLeases(const Clock::time_point now)
+    {
+        std::vector<uint64_t> expired_lease_ids{ };
+        for (const auto& [lease_id, lease] : m_active_leases) {
+            if (lease.deadline <= now) {
+                expired_lease_ids.push_back(lease_id);
+            }
+        }
+
+        // Revoke the leases in the order they were granted, so their tiles are leased again in the same order
+        std::ranges::sort(expired_lease_ids, std::greater{ });
+        for (const uint64_t lease_id : expired_lease_ids) {
+            revokeLease(lease_id);
+        }
+    }
+
+    std::optional<rt::TileLease> TileLeaseTable::acquireLease(const size_t worker_id, const Clock::time_point now)
+    {
+        expireLeases(now);
+        if (m_pending_tiles.empty()) {
+            return std::nullopt;
+        }
+
+        const size_t tile{ m_pending_tiles.front() };
+        m_pending_tiles.pop_front();
+
+        const uint64_t lease_id{ m_next_lease_id++ };
+        m_active_leases.emplace(lease_id, ActiveLease{ tile, worker_id, now + m_lease_timeout });
+        m_lease_tiles.emplace(lease_id, tile);
+        return rt::TileLease{ lease_id, m_tiles[tile] };
+    }
+
+    std::optional<rt::PixelRect> TileLeaseTable::completeLease(const uint64_t lease_id)
+    {
+        const auto lease_tile{ m_lease_tiles.find(lease_id) };
+        if (lease_tile == m_lease_tiles.end() || m_is_tile_complete[lease_tile->second]) {
+            return std::nullopt;
+        }
+
+        // The tile may have been pending or leased to another worker after this lease expired, so withdraw it from
+        // both before marking it complete
+        const size_t tile{ lease_tile->second };
+        std::erase(m_pending_tiles, tile);
+        std::erase_if(m_active_leases, [tile](const auto& active_lease) { return active_lease.second.tile == tile; });
+
+        m_is_tile_complete[tile] = true;
+        ++m_completed_tile_count;
+        return m_tiles[tile];
+    }
+
+    void TileLeaseTable::releaseWorkerLeases(const size_t worker_id)
+    {
+        std::vector<uint64_t> worker_lease_ids{ };
+        for (const auto& [lease_id, lease] : m_active_leases) {
+            if (lease.worker_id == worker_id) {
+                worker_lease_ids.push_back(lease_id);
+            }
+        }
+
+        std::ranges::sort(worker_lease_ids, std::greater{ });
+        for (const uint64_t lease_id : worker_lease_ids) {
+            revokeLease(lease_id);
+        }
+    }
+
+    // Returns the tile of an active lease to the front of the pending queue
+    void TileLeaseTable::revokeLease(const uint64_t lease_id)
+    {
+        const auto lease{ m_active_leases.find(lease_id) };
+        m_pending_tiles.push_front(lease->second.tile);
+        m_active_leases.erase(lease);
+        ++m_revoked_lease_count;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "camera.hpp"
+#include "tile_protocol.hpp"
+
+namespace rt {
+    // The width and height, in pixels, of the tiles leased to workers, which is larger than the tiles used within a
+    // single process so that each lease amortizes its round trip over more work
+    inline constexpr size_t LEASED_TILE_SIZE{ 32 };
+
+    // Tracks which tiles of a region are waiting to be rendered, leased to a worker or complete. Each tile which is
+    // not complete is either pending or held by exactly one active lease. Leases which expire, or whose worker
+    // disconnects, return their tile to the front of the pending queue so it is leased again before any fresh work.
+    class TileLeaseTable
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        /* Constructors */
+
+        TileLeaseTable() = delete;
+        TileLeaseTable(const rt::PixelRect& region, size_t tile_size, Clock::duration lease_timeout);
+
+        /* Accessors */
+
+        [[nodiscard]] size_t getTileCount() const
+        { return m_tiles.size(); }
+
+        [[nodiscard]] size_t getCompletedTileCount() const
+        { return m_completed_tile_count; }
+
+        // Returns the number of leases which were given up because they expired or their worker disconnected
+        [[nodiscard]] size_t getRevokedLeaseCount() const
+        { return m_revoked_lease_count; }
+
+        [[nodiscard]] bool isComplete() const
+        { return m_completed_tile_count == m_tiles.size(); }
+
+        // Returns the tile granted by a lease, whether or not it is still active, or nothing if the lease is unknown
+        [[nodiscard]] std::optional<rt::PixelRect> getLeasedTile(uint64_t lease_id) const;
+
+        /* Lease Methods */
+
+        // Revokes every lease which has expired by the passed-in time, returning their tiles to the pending queue
+        void expireLeases(Clock::time_point now);
+
+        // Leases the next pending tile to a worker, or returns nothing if no tile is pending
+        [[nodiscard]] std::optional<rt::TileLease> acquireLease(size_t worker_id, Clock::time_point now);
+
+        // Marks the tile of a lease as complete and returns it, or returns nothing if the lease is unknown or its
+        // tile was already completed through another lease. Results of expired leases are still accepted if their
+        // tile has not been completed since, as the work they hold is valid.
+        [[nodiscard]] std::optional<rt::PixelRect> completeLease(uint64_t lease_id);
+
+        // Revokes every active lease held by a worker, such as when it disconnects
+        void releaseWorkerLeases(size_t worker_id);
+
+    private:
+        // Describes the worker currently responsible for a tile
+        struct ActiveLease
+        {
+            size_t tile;
+            size_t worker_id;
+            Clock::time_point deadline;
+        };
+
+        /* Helper Methods */
+
+        void revokeLease(uint64_t lease_id);
+
+        /* Data Members */
+
+        std::vector<rt::PixelRect> m_tiles;
+        std::vector<bool> m_is_tile_complete;
+        std::deque<size_t> m_pending_tiles{ };
+        std::unordered_map<uint64_t, ActiveLease> m_active_leases{ };
+        std::unordered_map<uint64_t, size_t> m_lease_tiles{ };      // The tile of every lease ever granted
+        Clock::duration m_lease_timeout;
+        uint64_t m_next_lease_id{ 1 };
+        size_t m_completed_tile_count{ 0 };
+        size_t m_revoked_lease_count{ 0 };
+    };
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+#include "gtest/gtest.h"
+#include "tile_leasing.hpp"
+
+#include <chrono>
+#include <optional>
+#include <vector>
+
+using Clock = rt::TileLeaseTable::Clock;
+
+// Tests splitting a region into tiles and leasing each of them once
+TEST(RayTracerTileLeasing, LeaseAllTiles)
+{
+    const Clock::time_point now{ };
+    rt::TileLeaseTable lease_table{ rt::PixelRect{ 10, 20, 70, 40 }, 32, std::chrono::seconds{ 5 } };
+
+    ASSERT_EQ(lease_table.getTileCount(), 6);
+
+    // Tiles are leased in row-major order, with those on the edges clipped to the region
+    std::vector<rt::TileLease> leases{ };
+    while (const std::optional<rt::TileLease> lease{ lease_table.acquireLease(0, now) }) {
+        leases.push_back(*lease);
+    }
+
+    ASSERT_EQ(leases.size(), 6);
+    EXPECT_EQ(leases[0].tile, rt::PixelRect(10, 20, 32, 32));
+    EXPECT_EQ(leases[2].tile, rt::PixelRect(74, 20, 6, 32));
+    EXPECT_EQ(leases[5].tile, rt::PixelRect(74, 52, 6, 8));
+
+    for (const rt::TileLease& lease : leases) {
+        ASSERT_FALSE(lease_table.isComplete());
+        EXPECT_EQ(lease_table.completeLease(lease.lease_id), lease.tile);
+    }
+    ASSERT_TRUE(lease_table.isComplete());
+    ASSERT_EQ(lease_table.getCompletedTileCount(), 6);
+
+    // Duplicate and unknown results are not accepted
+    EXPECT_FALSE(lease_table.completeLease(leases[0].lease_id).has_value());
+    EXPECT_FALSE(lease_table.completeLease(1000).has_value());
+}
+
+// Tests leasing the tiles of stalled and disconnected workers again
+TEST(RayTracerTileLeasing, RevokeLeases)
+{
+    const Clock::time_point start_time{ };
+    rt::TileLeaseTable lease_table{ rt::PixelRect{ 0, 0, 64, 32 }, 32, std::chrono::seconds{ 5 } };
+
+    const rt::TileLease stalled_lease{ *lease_table.acquireLease(0, start_time) };
+    const rt::TileLease lost_lease{ *lease_table.acquireLease(1, start_time) };
+    ASSERT_FALSE(lease_table.acquireLease(2, start_time).has_value());
+
+    // The tile of a disconnected worker is leased again straight away
+    lease_table.releaseWorkerLeases(1);
+    const rt::TileLease lost_tile_lease{ *lease_table.acquireLease(2, start_time + std::chrono::seconds{ 1 }) };
+
+    EXPECT_EQ(lost_tile_lease.tile, lost_lease.tile);
+    EXPECT_NE(lost_tile_lease.lease_id, lost_lease.lease_id);
+
+    // The tile of a stalled worker is leased again once its lease expires
+    ASSERT_FALSE(lease_table.acquireLease(2, start_time + std::chrono::seconds{ 4 }).has_value());
+    const rt::TileLease stalled_tile_lease{ *lease_table.acquireLease(2, start_time + std::chrono::seconds{ 5 }) };
+
+    EXPECT_EQ(stalled_tile_lease.tile, stalled_lease.tile);
+    EXPECT_EQ(lease_table.getRevokedLeaseCount(), 2);
+
+    // A late result from the stalled worker still completes its tile, after which the new lease is obsolete
+    EXPECT_EQ(lease_table.completeLease(stalled_lease.lease_id), stalled_lease.tile);
+    EXPECT_FALSE(lease_table.completeLease(stalled_tile_lease.lease_id).has_value());
+
+    EXPECT_EQ(lease_table.completeLease(lost_tile_lease.lease_id), lost_lease.tile);
+    EXPECT_TRUE(lease_table.isComplete());
+    EXPECT_FALSE(lease_table.acquireLease(2, start_time + std::chrono::seconds{ 60 }).has_value());
+}
\ No newline at end of file
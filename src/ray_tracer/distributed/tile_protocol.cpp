@@ -0,0 +1,150 @@
+#include "tile_protocol.hpp"
+
+#include <array>
+#include <format>
+#include <stdexcept>
+#include <utility>
+
+#include "binary_encoding.hpp"
+
+namespace rt {
+    // Returns a reader for the payload of a message, throwing if the message has a different type
+    static rt::BinaryReader createPayloadReader(const Message& message, const MessageType expected_type)
+    {
+        if (message.type != expected_type) {
+            throw std::invalid_argument(std::format("Expected a message of type {}, received type {}",
+                                                    std::to_underlying(expected_type),
+                                                    std::to_underlying(message.type)));
+        }
+
+        return rt::BinaryReader{ message.payload };
+    }
+
+    void MessageBuffer::append(const std::span<const std::byte> data)
+    {
+        m_data.insert(m_data.end(), data.begin(), data.end());
+    }
+
+    std::optional<Message> MessageBuffer::extractMessage()
+    {
+        if (m_data.size() < MESSAGE_HEADER_SIZE) {
+            return std::nullopt;
+        }
+
+        const std::span<const std::byte> header{ std::span{ m_data }.first(MESSAGE_HEADER_SIZE) };
+        const uint64_t type{ decodeUnsigned(header.first(4)) };
+        const uint64_t payload_size{ decodeUnsigned(header.last(4)) };
+        if (type < std::to_underlying(MessageType::RenderJob) || type > std::to_underlying(MessageType::Shutdown)) {
+            throw std::invalid_argument(std::format("Received a message of unknown type {}", type));
+        }
+        if (payload_size > MAX_MESSAGE_PAYLOAD_SIZE) {
+            throw std::invalid_argument(std::format("Received a message with an oversized payload of {} bytes",
+                                                    payload_size));
+        }
+        if (m_data.size() < MESSAGE_HEADER_SIZE + payload_size) {
+            return std::nullopt;
+        }
+
+        const auto payload_begin{ m_data.begin() + MESSAGE_HEADER_SIZE };
+        const auto payload_end{ payload_begin + static_cast<ptrdiff_t>(payload_size) };
+        Message message{ static_cast<MessageType>(type), { payload_begin, payload_end } };
+        m_data.erase(m_data.begin(), payload_end);
+        return message;
+    }
+
+    Message createMessage(const MessageType type)
+    {
+        return Message{ type, { } };
+    }
+
+    Message encodeRenderJob(const RenderJob& job)
+    {
+        Message message{ createMessage(MessageType::RenderJob) };
+        appendString(message.payload, job.scene_file_path);
+        appendUnsigned(message.payload, job.sampling_settings.min_samples);
+        appendUnsigned(message.payload, job.sampling_settings.max_samples);
+        appendDouble(message.payload, job.sampling_settings.variance_threshold);
+        appendDouble(message.payload, job.sampling_settings.contrast_threshold);
+        return message;
+    }
+
+    Message encodeTileLease(const TileLease& lease)
+    {
+        Message message{ createMessage(MessageType::TileLease) };
+        appendUnsigned(message.payload, lease.lease_id);
+        appendPixelRect(message.payload, lease.tile);
+        return message;
+    }
+
+    Message encodeTileResult(const TileResult& result)
+    {
+        Message message{ createMessage(MessageType::TileResult) };
+        appendUnsigned(message.payload, result.lease_id);
+        appendRenderResult(message.payload, result.render_result);
+        return message;
+    }
+
+    RenderJob decodeRenderJob(const Message& message)
+    {
+        rt::BinaryReader reader{ createPayloadReader(message, MessageType::RenderJob) };
+        RenderJob job{ };
+        job.scene_file_path = reader.readString();
+        job.sampling_settings.min_samples = reader.readUnsigned();
+        job.sampling_settings.max_samples = reader.readUnsigned();
+        job.sampling_settings.variance_threshold = reader.readDouble();
+        job.sampling_settings.contrast_threshold = reader.readDouble();
+        reader.finish();
+        return job;
+    }
+
+    TileLease decodeTileLease(const Message& message)
+    {
+        rt::BinaryReader reader{ createPayloadReader(message, MessageType::TileLease) };
+        const uint64_t lease_id{ reader.readUnsigned() };
+        const rt::PixelRect tile{ reader.readPixelRect() };
+        reader.finish();
+        return TileLease{ lease_id, tile };
+    }
+
+    TileResult decodeTileResult(const Message& message)
+    {
+        rt::BinaryReader reader{ createPayloadReader(message, MessageType::TileResult) };
+        const uint64_t lease_id{ reader.readUnsigned() };
+        rt::RenderResult render_result{ reader.readRenderResult() };
+        reader.finish();
+        return TileResult{ lease_id, std::move(render_result) };
+    }
+
+    std::vector<std::byte> serializeMessage(const Message& message)
+    {
+        std::vector<std::byte> data{ };
+        data.reserve(MESSAGE_HEADER_SIZE + message.payload.size());
+        appendUnsigned(data, std::to_underlying(message.type), 4);
+        appendUnsigned(data, message.payload.size(), 4);
+        data.insert(data.end(), message.payload.begin(), message.payload.end());
+        return data;
+    }
+
+    void sendMessage(const rt::Socket& socket, const Message& message)
+    {
+        sendData(socket, serializeMessage(message));
+    }
+
+    bool receiveAvailableData(const rt::Socket& socket, MessageBuffer& buffer)
+    {
+        std::array<std::byte, 64 * 1024> data{ };
+        const size_t received_size{ receiveData(socket, data) };
+        buffer.append(std::span{ data }.first(received_size));
+        return received_size > 0;
+    }
+
+    std::optional<Message> receiveMessage(const rt::Socket& socket, MessageBuffer& buffer)
+    {
+        std::optional<Message> message{ buffer.extractMessage() };
+        while (!message && receiveAvailableData(socket, buffer)) {
+            message = buffer.extractMessage();
+        }
+
+        return message;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "camera.hpp"
+#include "sampling.hpp"
+#include "rendering_functions.hpp"
+#include "socket.hpp"
+
+namespace rt {
+    // The size, in bytes, of the header preceding each message: its type and payload size as 32-bit integers
+    inline constexpr size_t MESSAGE_HEADER_SIZE{ 8 };
+
+    // The largest payload a message may carry, which bounds the memory a malformed header can make a peer allocate
+    inline constexpr size_t MAX_MESSAGE_PAYLOAD_SIZE{ 256 * 1024 * 1024 };
+
+    // The messages exchanged between a coordinator and its workers. After a worker connects, the coordinator sends it
+    // the render job, then the worker repeatedly requests a lease and replies to each tile lease with its result.
+    enum class MessageType : uint32_t
+    {
+        RenderJob = 1,      // Coordinator to worker: the scene and sampling settings to render
+        LeaseRequest,       // Worker to coordinator: asks for a tile to render
+        TileLease,          // Coordinator to worker: a tile the worker is responsible for until it expires
+        TileResult,         // Worker to coordinator: the rendered pixels of a leased tile
+        Wait,               // Coordinator to worker: no tile is available yet, so ask again later
+        Shutdown            // Coordinator to worker: every tile has been rendered
+    };
+
+    // Holds the type and encoded payload of a single message
+    struct Message
+    {
+        MessageType type;
+        std::vector<std::byte> payload;
+    };
+
+    // Describes the frame every worker renders part of
+    struct RenderJob
+    {
+        std::string scene_file_path;
+        rt::SamplingSettings sampling_settings;
+    };
+
+    // Grants a worker the responsibility to render a tile of the frame
+    struct TileLease
+    {
+        uint64_t lease_id;
+        rt::PixelRect tile;
+    };
+
+    // Holds the rendered pixels and sample counts of a leased tile
+    struct TileResult
+    {
+        uint64_t lease_id;
+        rt::RenderResult render_result;
+    };
+
+    // Accumulates the bytes received from a stream socket and splits them into messages
+    class MessageBuffer
+    {
+    public:
+        /* Mutators */
+
+        void append(std::span<const std::byte> data);
+
+        // Removes and returns the oldest complete message in the buffer, if any. Throws if the buffer starts with a
+        // malformed header.
+        [[nodiscard]] std::optional<Message> extractMessage();
+
+    private:
+        /* Data Members */
+
+        std::vector<std::byte> m_data{ };
+    };
+
+    /* Message Encoding Functions */
+
+    // Returns a message without a payload
+    [[nodiscard]] Message createMessage(MessageType type);
+
+    [[nodiscard]] Message encodeRenderJob(const RenderJob& job);
+    [[nodiscard]] Message encodeTileLease(const TileLease& lease);
+    [[nodiscard]] Message encodeTileResult(const TileResult& result);
+
+    // The decoders throw if the message has a different type or its payload is malformed
+    [[nodiscard]] RenderJob decodeRenderJob(const Message& message);
+    [[nodiscard]] TileLease decodeTileLease(const Message& message);
+    [[nodiscard]] TileResult decodeTileResult(const Message& message);
+
+    // Returns the header and payload of a message as they are sent over a socket, with all values in little-endian
+    // byte order so that nodes can exchange messages regardless of their architecture
+    [[nodiscard]] std::vector<std::byte> serializeMessage(const Message& message);
+
+    /* Message Transfer Functions */
+
+    // Sends a whole message over a socket, blocking until it has been written. Throws std::system_error if the peer
+    // has disconnected.
+    void sendMessage(const rt::Socket& socket, const Message& message);
+
+    // Reads whatever data is available from a socket into a buffer, blocking only if none is. Returns false once the
+    // peer has disconnected.
+    [[nodiscard]] bool receiveAvailableData(const rt::Socket& socket, MessageBuffer& buffer);
+
+    // Returns the next message received over a socket, blocking until it arrives, or nothing if the peer disconnects
+    // first
+    [[nodiscard]] std::optional<Message> receiveMessage(const rt::Socket& socket, MessageBuffer& buffer);
+}
\ No newline at end of file
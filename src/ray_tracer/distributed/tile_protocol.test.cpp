@@ -0,0 +1,132 @@
+#include "gtest/gtest.h"
+#include "tile_protocol.hpp"
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+
+#include <sys/socket.h>
+
+// Tests parsing and formatting endpoint descriptions
+TEST(RayTracerTileProtocol, ParseEndpoint)
+{
+    const rt::Endpoint unix_endpoint{ rt::parseEndpoint("unix:/tmp/coordinator.sock") };
+
+    ASSERT_EQ(unix_endpoint.type, rt::EndpointType::UnixSocket);
+    ASSERT_EQ(unix_endpoint.address, "/tmp/coordinator.sock");
+    ASSERT_EQ(rt::formatEndpoint(unix_endpoint), "unix:/tmp/coordinator.sock");
+
+    const rt::Endpoint tcp_endpoint{ rt::parseEndpoint("tcp:render-node-2:7400") };
+
+    ASSERT_EQ(tcp_endpoint.type, rt::EndpointType::Tcp);
+    ASSERT_EQ(tcp_endpoint.address, "render-node-2");
+    ASSERT_EQ(tcp_endpoint.port, 7400);
+    ASSERT_EQ(rt::formatEndpoint(tcp_endpoint), "tcp:render-node-2:7400");
+
+    for (const std::string_view description : { "unix:", "tcp:localhost", "tcp::7400", "tcp:host:0", "tcp:host:70000",
+                                                "/tmp/coordinator.sock" }) {
+        EXPECT_THROW({
+            const rt::Endpoint endpoint{ rt::parseEndpoint(description) };
+        }, std::invalid_argument);
+    }
+}
+
+// Tests encoding and decoding each message payload
+TEST(RayTracerTileProtocol, EncodeDecodeMessages)
+{
+    const rt::RenderJob job{ "/scenes/cornell_box.json", rt::SamplingSettings{ 4, 64, 0.005, 0.2 } };
+    const rt::RenderJob job_decoded{ rt::decodeRenderJob(rt::encodeRenderJob(job)) };
+
+    ASSERT_EQ(job_decoded.scene_file_path, job.scene_file_path);
+    ASSERT_EQ(job_decoded.sampling_settings.min_samples, 4);
+    ASSERT_EQ(job_decoded.sampling_settings.max_samples, 64);
+    ASSERT_EQ(job_decoded.sampling_settings.variance_threshold, 0.005);
+    ASSERT_EQ(job_decoded.sampling_settings.contrast_threshold, 0.2);
+
+    const rt::TileLease lease{ 42, rt::PixelRect{ 64, 32, 32, 16 } };
+    const rt::TileLease lease_decoded{ rt::decodeTileLease(rt::encodeTileLease(lease)) };
+
+    ASSERT_EQ(lease_decoded.lease_id, 42);
+    ASSERT_EQ(lease_decoded.tile, lease.tile);
+
+    // Tile results preserve the exact color values and sample counts of every pixel
+    rt::TileResult result{
+        7, rt::RenderResult{ rt::Canvas{ 2, 3 }, rt::PixelRect{ 10, 20, 2, 3 }, { 1, 2, 3, 4, 5, 6 }, 21 } };
+    result.render_result.image[1, 2] = gfx::Color{ 0.1, 1.0 / 3.0, 2.5 };
+    const rt::TileResult result_decoded{ rt::decodeTileResult(rt::encodeTileResult(result)) };
+
+    ASSERT_EQ(result_decoded.lease_id, 7);
+    ASSERT_EQ(result_decoded.render_result.region, result.render_result.region);
+    ASSERT_EQ(result_decoded.render_result.sample_counts, result.render_result.sample_counts);
+    ASSERT_EQ(result_decoded.render_result.total_sample_count, 21);
+    EXPECT_EQ((result_decoded.render_result.image[1, 2].g()), 1.0 / 3.0);
+    EXPECT_EQ((result_decoded.render_result.image[0, 0]), gfx::black());
+
+    // Messages of another type, or with truncated payloads, are rejected
+    EXPECT_THROW(static_cast<void>(rt::decodeTileLease(rt::encodeRenderJob(job))), std::invalid_argument);
+
+    rt::Message message_truncated{ rt::encodeTileResult(result) };
+    message_truncated.payload.pop_back();
+    EXPECT_THROW(static_cast<void>(rt::decodeTileResult(message_truncated)), std::invalid_argument);
+}
+
+// Tests splitting a stream of bytes into messages
+TEST(RayTracerTileProtocol, MessageBuffer)
+{
+    const std::vector<std::byte> lease_data{
+        rt::serializeMessage(rt::encodeTileLease(rt::TileLease{ 3, rt::PixelRect{ 0, 0, 8, 8 } })) };
+    const std::vector<std::byte> wait_data{ rt::serializeMessage(rt::createMessage(rt::MessageType::Wait)) };
+
+    // Messages split across reads are only extracted once they are complete
+    rt::MessageBuffer buffer{ };
+    buffer.append(std::span{ lease_data }.first(5));
+    ASSERT_FALSE(buffer.extractMessage().has_value());
+
+    buffer.append(std::span{ lease_data }.subspan(5));
+    buffer.append(wait_data);
+    const std::optional<rt::Message> lease_message{ buffer.extractMessage() };
+    const std::optional<rt::Message> wait_message{ buffer.extractMessage() };
+
+    ASSERT_TRUE(lease_message.has_value());
+    ASSERT_EQ(rt::decodeTileLease(*lease_message).lease_id, 3);
+    ASSERT_TRUE(wait_message.has_value());
+    ASSERT_EQ(wait_message->type, rt::MessageType::Wait);
+    ASSERT_FALSE(buffer.extractMessage().has_value());
+
+    // Headers with an unknown type are rejected
+    rt::MessageBuffer buffer_invalid{ };
+    buffer_invalid.append(std::vector<std::byte>(rt::MESSAGE_HEADER_SIZE, std::byte{ 0xFF }));
+    EXPECT_THROW({
+        const std::optional<rt::Message> message_invalid{ buffer_invalid.extractMessage() };
+    }, std::invalid_argument);
+}
+
+// Tests sending messages between a pair of connected sockets
+TEST(RayTracerTileProtocol, SendReceiveMessages)
+{
+    int descriptors[2]{ };
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, descriptors), 0);
+    rt::Socket coordinator_socket{ descriptors[0] };
+    const rt::Socket worker_socket{ descriptors[1] };
+
+    rt::sendMessage(worker_socket, rt::createMessage(rt::MessageType::LeaseRequest));
+    rt::sendMessage(worker_socket, rt::createMessage(rt::MessageType::LeaseRequest));
+
+    rt::MessageBuffer buffer{ };
+    for (size_t i = 0; i < 2; ++i) {
+        const std::optional<rt::Message> message{ rt::receiveMessage(coordinator_socket, buffer) };
+        ASSERT_TRUE(message.has_value());
+        EXPECT_EQ(message->type, rt::MessageType::LeaseRequest);
+    }
+
+    // Disconnecting ends the stream on the other side, and sending to a disconnected peer fails
+    coordinator_socket.close();
+    rt::MessageBuffer worker_buffer{ };
+    EXPECT_FALSE(rt::receiveMessage(worker_socket, worker_buffer).has_value());
+    EXPECT_THROW({
+        rt::sendMessage(worker_socket, rt::createMessage(rt::MessageType::LeaseRequest));
+    }, std::system_error);
+}
\ No newline at end of file
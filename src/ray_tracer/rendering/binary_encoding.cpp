@@ -0,0 +1,152 @@
+#include "binary_encoding.hpp"
+
+#include <bit>
+#include <format>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace rt {
+    uint64_t BinaryReader::readUnsigned(const size_t byte_count)
+    {
+        return decodeUnsigned(readBytes(byte_count));
+    }
+
+    double BinaryReader::readDouble()
+    {
+        return std::bit_cast<double>(readUnsigned());
+    }
+
+    std::string BinaryReader::readString()
+    {
+        const std::span<const std::byte> bytes{ readBytes(readUnsigned()) };
+        return std::string{ reinterpret_cast<const char*>(bytes.data()), bytes.size() };
+    }
+
+    rt::PixelRect BinaryReader::readPixelRect()
+    {
+        const size_t x{ readUnsigned() };
+        const size_t y{ readUnsigned() };
+        const size_t width{ readUnsigned() };
+        const size_t height{ readUnsigned() };
+        return rt::PixelRect{ x, y, width, height };
+    }
+
+    rt::RenderResult BinaryReader::readRenderResult()
+    {
+        const rt::PixelRect region{ readPixelRect() };
+
+        // Each pixel takes 32 bytes, so check the size before allocating the canvas
+        constexpr size_t PIXEL_SIZE{ 32 };
+        if (region.width == 0 || region.height == 0 || region.height > getRemainingSize() / PIXEL_SIZE / region.width) {
+            throw std::invalid_argument("Render result dimensions do not match the size of its data");
+        }
+
+        rt::RenderResult render_result{
+            rt::Canvas{ region.width, region.height }, region, std::vector<size_t>(region.width * region.height), 0 };
+        for (size_t y = 0; y < region.height; ++y)
+            for (size_t x = 0; x < region.width; ++x) {
+                const double r{ readDouble() };
+                const double g{ readDouble() };
+                const double b{ readDouble() };
+                const size_t sample_count{ readUnsigned() };
+                render_result.image[x, y] = gfx::Color{ r, g, b };
+                render_result.sample_counts[y * region.width + x] = sample_count;
+                render_result.total_sample_count += sample_count;
+            }
+
+        return render_result;
+    }
+
+    void BinaryReader::finish() const
+    {
+        if (m_offset != m_data.size()) {
+            throw std::invalid_argument("Data contains unexpected trailing bytes");
+        }
+    }
+
+    std::span<const std::byte> BinaryReader::readBytes(const size_t byte_count)
+    {
+        if (byte_count > m_data.size() - m_offset) {
+            throw std::invalid_argument("Data is shorter than its contents require");
+        }
+
+        const std::span<const std::byte> bytes{ m_data.subspan(m_offset, byte_count) };
+        m_offset += byte_count;
+        return bytes;
+    }
+
+    void appendUnsigned(std::vector<std::byte>& data, const uint64_t value, const size_t byte_count)
+    {
+        for (size_t i = 0; i < byte_count; ++i) {
+            data.push_back(static_cast<std::byte>((value >> (8 * i)) & 0xFF));
+        }
+    }
+
+    uint64_t decodeUnsigned(const std::span<const std::byte> bytes)
+    {
+        uint64_t value{ 0 };
+        for (size_t i = 0; i < bytes.size(); ++i) {
+            value |= std::to_integer<uint64_t>(bytes[i]) << (8 * i);
+        }
+
+        return value;
+    }
+
+    void appendDouble(std::vector<std::byte>& data, const double value)
+    {
+        appendUnsigned(data, std::bit_cast<uint64_t>(value));
+    }
+
+    void appendString(std::vector<std::byte>& data, const std::string_view value)
+    {
+        appendUnsigned(data, value.size());
+        for (const char character : value) {
+            data.push_back(static_cast<std::byte>(character));
+        }
+    }
+
+    void appendPixelRect(std::vector<std::byte>& data, const rt::PixelRect& region)
+    {
+        appendUnsigned(data, region.x);
+        appendUnsigned(data, region.y);
+        appendUnsigned(data, region.width);
+        appendUnsigned(data, region.height);
+    }
+
+    void appendRenderResult(std::vector<std::byte>& data, const rt::RenderResult& render_result)
+    {
+        appendPixelRect(data, render_result.region);
+        for (size_t y = 0; y < render_result.region.height; ++y)
+            for (size_t x = 0; x < render_result.region.width; ++x) {
+                const gfx::Color& color{ render_result.image[x, y] };
+                appendDouble(data, color.r());
+                appendDouble(data, color.g());
+                appendDouble(data, color.b());
+                appendUnsigned(data, render_result.sample_counts[y * render_result.region.width + x]);
+            }
+    }
+
+    uint64_t calculateContentHash(const std::string_view data)
+    {
+        uint64_t hash{ 0xcbf29ce484222325 };
+        for (const char character : data) {
+            hash ^= static_cast<unsigned char>(character);
+            hash *= 0x100000001b3;
+        }
+
+        return hash;
+    }
+
+    uint64_t calculateFileContentHash(const std::filesystem::path& file_path)
+    {
+        std::ifstream file{ file_path, std::ios_base::binary };
+        if (!file) {
+            throw std::invalid_argument(std::format("Unable to open file '{}'", file_path.string()));
+        }
+
+        std::ostringstream contents;
+        contents << file.rdbuf();
+        return calculateContentHash(contents.str());
+    }
+}
\ No newline at end of file
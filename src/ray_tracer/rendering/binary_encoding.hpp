@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "camera.hpp"
+#include "rendering_functions.hpp"
+
+namespace rt {
+    // Reads the values of a sequence of bytes in the order they were appended by the binary encoding functions,
+    // throwing if the data is too short
+    class BinaryReader
+    {
+    public:
+        /* Constructors */
+
+        BinaryReader() = delete;
+        explicit BinaryReader(const std::span<const std::byte> data) : m_data{ data } {}
+
+        /* Accessors */
+
+        [[nodiscard]] size_t getRemainingSize() const
+        { return m_data.size() - m_offset; }
+
+        /* Read Methods */
+
+        [[nodiscard]] uint64_t readUnsigned(size_t byte_count = 8);
+        [[nodiscard]] double readDouble();
+        [[nodiscard]] std::string readString();
+        [[nodiscard]] rt::PixelRect readPixelRect();
+        [[nodiscard]] rt::RenderResult readRenderResult();
+
+        // Throws if any of the data has not been read
+        void finish() const;
+
+    private:
+        /* Helper Methods */
+
+        [[nodiscard]] std::span<const std::byte> readBytes(size_t byte_count);
+
+        /* Data Members */
+
+        std::span<const std::byte> m_data;
+        size_t m_offset{ 0 };
+    };
+
+    /* Binary Encoding Functions */
+
+    // Values are encoded in little-endian byte order so that data can be exchanged regardless of architecture
+
+    // Appends an unsigned integer as a fixed number of bytes
+    void appendUnsigned(std::vector<std::byte>& data, uint64_t value, size_t byte_count = 8);
+
+    // Returns the unsigned integer stored in a sequence of bytes
+    [[nodiscard]] uint64_t decodeUnsigned(std::span<const std::byte> bytes);
+
+    // Appends a floating-point value using its exact bit pattern
+    void appendDouble(std::vector<std::byte>& data, double value);
+
+    // Appends a string, preceded by its length
+    void appendString(std::vector<std::byte>& data, std::string_view value);
+
+    // Appends the position and size of a pixel region
+    void appendPixelRect(std::vector<std::byte>& data, const rt::PixelRect& region);
+
+    // Appends the region of a render result, followed by the color and sample count of each of its pixels
+    void appendRenderResult(std::vector<std::byte>& data, const rt::RenderResult& render_result);
+
+    /* Content Hash Functions */
+
+    // Returns the 64-bit FNV-1a hash of a sequence of bytes
+    [[nodiscard]] uint64_t calculateContentHash(std::string_view data);
+
+    // Returns the hash of the contents of a file, throwing if it cannot be read
+    [[nodiscard]] uint64_t calculateFileContentHash(const std::filesystem::path& file_path);
+}
\ No newline at end of file
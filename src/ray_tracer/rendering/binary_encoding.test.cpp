@@ -0,0 +1,74 @@
+#include "gtest/gtest.h"
+#include "binary_encoding.hpp"
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+// Tests that encoded values are read back unchanged, in little-endian byte order
+TEST(RayTracerBinaryEncoding, EncodeDecodeValues)
+{
+    rt::RenderResult render_result{ rt::Canvas{ 2, 1 }, rt::PixelRect{ 5, 6, 2, 1 }, { 3, 9 }, 12 };
+    render_result.image[0, 0] = gfx::Color{ 0.1, 0.2, 0.3 };
+    render_result.image[1, 0] = gfx::Color{ -1.5, 2.0, 1e-9 };
+
+    std::vector<std::byte> data{ };
+    rt::appendUnsigned(data, 0x0102, 2);
+    rt::appendDouble(data, 0.1);
+    rt::appendString(data, "scene.json");
+    rt::appendPixelRect(data, rt::PixelRect{ 1, 2, 3, 4 });
+    rt::appendRenderResult(data, render_result);
+
+    ASSERT_EQ(data[0], std::byte{ 0x02 });
+    ASSERT_EQ(data[1], std::byte{ 0x01 });
+
+    rt::BinaryReader reader{ data };
+    ASSERT_EQ(reader.readUnsigned(2), 0x0102);
+    ASSERT_EQ(reader.readDouble(), 0.1);
+    ASSERT_EQ(reader.readString(), "scene.json");
+    ASSERT_EQ(reader.readPixelRect(), (rt::PixelRect{ 1, 2, 3, 4 }));
+
+    const rt::RenderResult decoded_result{ reader.readRenderResult() };
+    ASSERT_EQ(decoded_result.region, render_result.region);
+    ASSERT_EQ(decoded_result.sample_counts, render_result.sample_counts);
+    ASSERT_EQ(decoded_result.total_sample_count, 12);
+    ASSERT_EQ((decoded_result.image[0, 0]), (render_result.image[0, 0]));
+    ASSERT_EQ((decoded_result.image[1, 0]), (render_result.image[1, 0]));
+    ASSERT_EQ(reader.getRemainingSize(), 0);
+    reader.finish();
+}
+
+// Tests that reading past the end of the data, or leaving data unread, causes an error
+TEST(RayTracerBinaryEncoding, ReadMalformedData)
+{
+    std::vector<std::byte> data{ };
+    rt::appendUnsigned(data, 7);
+
+    rt::BinaryReader short_reader{ data };
+    EXPECT_THROW(static_cast<void>(short_reader.readString()), std::invalid_argument);
+
+    rt::BinaryReader unfinished_reader{ data };
+    static_cast<void>(unfinished_reader.readUnsigned(4));
+    EXPECT_THROW(unfinished_reader.finish(), std::invalid_argument);
+
+    // A render result whose dimensions exceed its data is rejected before its canvas is allocated
+    std::vector<std::byte> result_data{ };
+    rt::appendPixelRect(result_data, rt::PixelRect{ 0, 0, 100000, 100000 });
+    rt::BinaryReader result_reader{ result_data };
+    EXPECT_THROW(static_cast<void>(result_reader.readRenderResult()), std::invalid_argument);
+}
+
+// Tests calculating the FNV-1a hash of byte sequences and files
+TEST(RayTracerBinaryEncoding, CalculateContentHash)
+{
+    EXPECT_EQ(rt::calculateContentHash(""), 0xcbf29ce484222325);
+    EXPECT_EQ(rt::calculateContentHash("a"), 0xaf63dc4c8601ec8c);
+    EXPECT_NE(rt::calculateContentHash("ab"), rt::calculateContentHash("ba"));
+
+    const std::filesystem::path file_path{ std::filesystem::temp_directory_path() / "binary_encoding_test.txt" };
+    std::ofstream{ file_path, std::ios_base::trunc } << "ab";
+    EXPECT_EQ(rt::calculateFileContentHash(file_path), rt::calculateContentHash("ab"));
+    EXPECT_THROW(static_cast<void>(rt::calculateFileContentHash("missing_file.txt")), std::invalid_argument);
+}
\ No newline at end of file
@@ -26,11 +26,10 @@ namespace rt {
         const double world_y{ m_half_height - pixel_y_offset };
 
         // Move the viewport pixel position and the world origin into camera space
-        const gfx::Matrix4 inverse_transform{ m_transform_inverse };
         const gfx::Vector4 pixel_camera_space_pos{
-            inverse_transform * gfx::createPoint(world_x, world_y, -1) // Viewport is always 1 unit away from camera origin
+            m_transform_inverse * gfx::createPoint(world_x, world_y, -1) // Viewport is always 1 unit away from camera origin
         };
-        const gfx::Vector4 origin_camera_space_pos{ inverse_transform * gfx::createPoint(0, 0 , 0) };
+        const gfx::Vector4 origin_camera_space_pos{ m_transform_inverse * gfx::createPoint(0, 0 , 0) };
 
         // Calculate the ray direction and return the cast ray
         const gfx::Vector4 ray_cast_direction{ normalize(pixel_camera_space_pos - origin_camera_space_pos) };
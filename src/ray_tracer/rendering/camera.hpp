@@ -6,6 +6,17 @@
 #include "ray.hpp"
 
 namespace rt {
+    // A rectangular region of pixels within a camera's viewport, whose top-left corner is at (x, y)
+    struct PixelRect
+    {
+        size_t x;
+        size_t y;
+        size_t width;
+        size_t height;
+
+        [[nodiscard]] bool operator==(const PixelRect&) const = default;
+    };
+
     class Camera
     {
     public:
@@ -64,9 +75,29 @@ namespace rt {
         [[nodiscard]] double getFieldOfView() const
         { return m_field_of_view; }
 
+        // Returns the region covering the entire viewport
+        [[nodiscard]] PixelRect getViewportRect() const
+        { return PixelRect{ 0, 0, m_viewport_width, m_viewport_height }; }
+
+        // Returns true if a region lies entirely within the viewport
+        [[nodiscard]] bool isWithinViewport(const PixelRect& region) const
+        { return region.x + region.width <= m_viewport_width && region.y + region.height <= m_viewport_height; }
+
         [[nodiscard]] const gfx::Matrix4& getTransform() const
         { return m_transform; }
 
+        [[nodiscard]] const gfx::Matrix4& getInverseTransform() const
+        { return m_transform_inverse; }
+
+        [[nodiscard]] double getPixelSize() const
+        { return m_pixel_size; }
+
+        [[nodiscard]] double getHalfWidth() const
+        { return m_half_width; }
+
+        [[nodiscard]] double getHalfHeight() const
+        { return m_half_height; }
+
         /* Mutators */
 
         void setViewport(const size_t width, const size_t height)
@@ -0,0 +1,128 @@
+#include "camera_ray_generator.hpp"
+
+#include <stdexcept>
+
+namespace rt {
+    // Full Viewport Constructor
+    CameraRayGenerator::CameraRayGenerator(const Camera& camera)
+        : CameraRayGenerator{ camera, camera.getViewportRect() }
+    {}
+
+    // Viewport Region Constructor
+    CameraRayGenerator::CameraRayGenerator(const Camera& camera, const PixelRect& region)
+        : m_region{ region },
+          m_transform_inverse{ camera.getInverseTransform() },
+          m_pixel_size{ camera.getPixelSize() },
+          m_half_width{ camera.getHalfWidth() },
+          m_half_height{ camera.getHalfHeight() },
+          m_origin{ m_transform_inverse * gfx::createPoint(0, 0, 0) },
+          m_column_terms(region.width),
+          m_row_terms(region.height),
+          m_depth_terms{},
+          m_translation_terms{}
+    {
+        if (!camera.isWithinViewport(region)) {
+            throw std::invalid_argument("Region extends past the edges of the camera viewport");
+        }
+
+        // Split the product of the inverse transform and each pixel's viewport position into its per-column, per-row
+        // and constant terms, keeping the operands and their order identical to the full matrix-vector product
+        for (size_t x = 0; x < m_column_terms.size(); ++x) {
+            const double pixel_x_offset{ (static_cast<double>(region.x + x) + 0.5) * m_pixel_size };
+            const double world_x{ m_half_width - pixel_x_offset };
+            for (int row = 0; row < 4; ++row) {
+                m_column_terms[x][row] = m_transform_inverse[row, 0] * world_x;
+            }
+        }
+
+        for (size_t y = 0; y < m_row_terms.size(); ++y) {
+            const double pixel_y_offset{ (static_cast<double>(region.y + y) + 0.5) * m_pixel_size };
+            const double world_y{ m_half_height - pixel_y_offset };
+            for (int row = 0; row < 4; ++row) {
+                m_row_terms[y][row] = m_transform_inverse[row, 1] * world_y;
+            }
+        }
+
+        // Viewport is always 1 unit away from camera origin
+        for (int row = 0; row < 4; ++row) {
+            m_depth_terms[row] = m_transform_inverse[row, 2] * -1.0;
+            m_translation_terms[row] = m_transform_inverse[row, 3] * 1.0;
+        }
+    }
+
+    gfx::Ray CameraRayGenerator::generateRay(const size_t pixel_x, const size_t pixel_y) const
+    {
+        return gfx::Ray{ m_origin, normalize(calculatePixelOffset(pixel_x, pixel_y)) };
+    }
+
+    gfx::Ray CameraRayGenerator::generateRay(const size_t pixel_x,
+                                             const size_t pixel_y,
+                                             const double offset_x,
+                                             const double offset_y) const
+    {
+        // Calculate the un-transformed world-space coordinates of the sub-pixel position
+        const double world_x{ m_half_width - (static_cast<double>(m_region.x + pixel_x) + offset_x) * m_pixel_size };
+        const double world_y{ m_half_height - (static_cast<double>(m_region.y + pixel_y) + offset_y) * m_pixel_size };
+
+        const gfx::Vector4 sample_camera_space_pos{ m_transform_inverse * gfx::createPoint(world_x, world_y, -1) };
+        return gfx::Ray{ m_origin, normalize(sample_camera_space_pos - m_origin) };
+    }
+
+    void CameraRayGenerator::generateRays(const size_t tile_x,
+                                          const size_t tile_y,
+                                          const size_t tile_width,
+                                          const size_t tile_height,
+                                          const std::span<gfx::Ray> rays) const
+    {
+        if (tile_x + tile_width > m_region.width || tile_y + tile_height > m_region.height) {
+            throw std::invalid_argument("Tile extends past the edges of the region");
+        }
+        if (rays.size() < tile_width * tile_height) {
+            throw std::invalid_argument("Ray buffer is too small to hold every ray of the tile");
+        }
+
+        size_t ray_index{ 0 };
+        for (size_t y = tile_y; y < tile_y + tile_height; ++y)
+            for (size_t x = tile_x; x < tile_x + tile_width; ++x) {
+                rays[ray_index++] = generateRay(x, y);
+            }
+    }
+
+    gfx::RayPacket CameraRayGenerator::generateRayPacket(const size_t pixel_x, const size_t pixel_y) const
+    {
+        gfx::RayPacket packet{ };
+        for (size_t lane = 0; lane < gfx::RAY_PACKET_SIZE; ++lane) {
+            const size_t lane_x{ pixel_x + lane % 2 };
+            const size_t lane_y{ pixel_y + lane / 2 };
+            if (lane_x >= m_region.width || lane_y >= m_region.height) {
+                continue;
+            }
+
+            const gfx::Vector4 direction{ normalize(calculatePixelOffset(lane_x, lane_y)) };
+            packet.origin_x[lane] = m_origin.x();
+            packet.origin_y[lane] = m_origin.y();
+            packet.origin_z[lane] = m_origin.z();
+            packet.direction_x[lane] = direction.x();
+            packet.direction_y[lane] = direction.y();
+            packet.direction_z[lane] = direction.z();
+            packet.active_lanes |= 1u << lane;
+        }
+
+        return packet;
+    }
+
+    /* Private Methods */
+
+    gfx::Vector4 CameraRayGenerator::calculatePixelOffset(const size_t pixel_x, const size_t pixel_y) const
+    {
+        const std::array<double, 4>& column_terms{ m_column_terms[pixel_x] };
+        const std::array<double, 4>& row_terms{ m_row_terms[pixel_y] };
+
+        std::array<double, 4> pixel_camera_space_pos{};
+        for (int row = 0; row < 4; ++row) {
+            pixel_camera_space_pos[row] = column_terms[row] + row_terms[row] + m_depth_terms[row] + m_translation_terms[row];
+        }
+
+        return gfx::Vector4{ pixel_camera_space_pos } - m_origin;
+    }
+}
\ No newline at end of file
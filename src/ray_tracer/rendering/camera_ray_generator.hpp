@@ -0,0 +1,90 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "matrix4.hpp"
+#include "vector4.hpp"
+#include "ray.hpp"
+#include "ray_packet.hpp"
+#include "camera.hpp"
+
+namespace rt {
+    // Generates the primary rays of a single frame for a camera, optionally restricted to a region of its viewport.
+    // The world-space origin shared by every ray, and the row and column contributions of each pixel to its
+    // transformed viewport position, are computed once upon construction, so generating a ray only has to sum the
+    // precomputed terms and normalize. Every generated ray is identical to the one returned by Camera::castRay() for
+    // the same pixel. Pixel coordinates passed to the generator are relative to the top-left corner of its region.
+    class CameraRayGenerator
+    {
+    public:
+        /* Constructors */
+
+        CameraRayGenerator() = delete;
+        explicit CameraRayGenerator(const Camera& camera);
+        CameraRayGenerator(const Camera& camera, const PixelRect& region);
+        CameraRayGenerator(const CameraRayGenerator&) = default;
+        CameraRayGenerator(CameraRayGenerator&&) = default;
+
+        /* Destructor */
+
+        ~CameraRayGenerator() = default;
+
+        /* Assignment Operators */
+
+        CameraRayGenerator& operator=(const CameraRayGenerator&) = default;
+        CameraRayGenerator& operator=(CameraRayGenerator&&) = default;
+
+        /* Accessors */
+
+        // Returns the region of the camera's viewport the rays are generated for
+        [[nodiscard]] const PixelRect& getRegion() const
+        { return m_region; }
+
+        [[nodiscard]] const gfx::Vector4& getOrigin() const
+        { return m_origin; }
+
+        /* Ray Generation Operations */
+
+        // Returns the ray targeting a specific (x, y) coordinate in the region
+        [[nodiscard]] gfx::Ray generateRay(size_t pixel_x, size_t pixel_y) const;
+
+        // Returns the ray targeting a sub-pixel position within a pixel, where the offsets are measured from the
+        // pixel's top-left corner in fractions of a pixel. Offsets of 0.5 target the pixel's center, producing the
+        // same ray as the per-pixel overload, but other positions require a full matrix-vector product.
+        [[nodiscard]] gfx::Ray generateRay(size_t pixel_x, size_t pixel_y, double offset_x, double offset_y) const;
+
+        // Writes the rays for every pixel of a tile into a caller-provided buffer in row-major order. The buffer
+        // must hold at least tile_width * tile_height rays, and the tile must lie within the region.
+        void generateRays(size_t tile_x,
+                          size_t tile_y,
+                          size_t tile_width,
+                          size_t tile_height,
+                          std::span<gfx::Ray> rays) const;
+
+        // Returns a packet of rays targeting the 2x2 block of pixels whose top-left corner is at (x, y), where lane i
+        // targets pixel (x + i % 2, y + i / 2). Lanes for pixels outside the region are left inactive.
+        [[nodiscard]] gfx::RayPacket generateRayPacket(size_t pixel_x, size_t pixel_y) const;
+
+    private:
+        /* Data Members */
+
+        PixelRect m_region;
+        gfx::Matrix4 m_transform_inverse;
+        double m_pixel_size;
+        double m_half_width;
+        double m_half_height;
+        gfx::Vector4 m_origin;
+        std::vector<std::array<double, 4>> m_column_terms;  // Contribution of each region column's x-coordinate
+        std::vector<std::array<double, 4>> m_row_terms;     // Contribution of each region row's y-coordinate
+        std::array<double, 4> m_depth_terms;                // Contribution of the viewport's z-coordinate
+        std::array<double, 4> m_translation_terms;          // Contribution of the pixel position's w-value
+
+        /* Helper Methods */
+
+        // Returns the un-normalized direction from the origin to a pixel's transformed viewport position
+        [[nodiscard]] gfx::Vector4 calculatePixelOffset(size_t pixel_x, size_t pixel_y) const;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,130 @@
+#include "gtest/gtest.h"
+#include "camera_ray_generator.hpp"
+
+#include <cmath>
+#include <vector>
+#include <stdexcept>
+
+#include "camera.hpp"
+#include "matrix4.hpp"
+#include "transform.hpp"
+#include "ray.hpp"
+#include "ray_packet.hpp"
+
+// Tests that the generated rays are exactly the rays cast by the camera
+TEST(RayTracerCameraRayGenerator, GenerateRayMatchesCastRay)
+{
+    const gfx::Matrix4 transform_matrix{
+        gfx::createYRotationMatrix(M_PI_4) * gfx::createTranslationMatrix(0, -2, 5) };
+    const rt::Camera camera{ 31, 17, M_PI_2, transform_matrix };
+    const rt::CameraRayGenerator ray_generator{ camera };
+
+    ASSERT_EQ(ray_generator.getRegion(), camera.getViewportRect());
+
+    for (size_t y = 0; y < camera.getViewportHeight(); ++y)
+        for (size_t x = 0; x < camera.getViewportWidth(); ++x) {
+            const gfx::Ray ray_expected{ camera.castRay(x, y) };
+            const gfx::Ray ray_actual{ ray_generator.generateRay(x, y) };
+
+            // The rays must be bitwise identical, not just equal within a tolerance
+            ASSERT_EQ(ray_actual.getOrigin().x(), ray_expected.getOrigin().x());
+            ASSERT_EQ(ray_actual.getOrigin().y(), ray_expected.getOrigin().y());
+            ASSERT_EQ(ray_actual.getOrigin().z(), ray_expected.getOrigin().z());
+            ASSERT_EQ(ray_actual.getDirection().x(), ray_expected.getDirection().x());
+            ASSERT_EQ(ray_actual.getDirection().y(), ray_expected.getDirection().y());
+            ASSERT_EQ(ray_actual.getDirection().z(), ray_expected.getDirection().z());
+        }
+}
+
+// Tests generating the rays for a tile of pixels into a caller-provided buffer
+TEST(RayTracerCameraRayGenerator, GenerateRays)
+{
+    const rt::Camera camera{ 201, 101, M_PI_2 };
+    const rt::CameraRayGenerator ray_generator{ camera };
+
+    // Rays are written in row-major order
+    std::vector<gfx::Ray> rays(6);
+    ray_generator.generateRays(10, 20, 3, 2, rays);
+
+    EXPECT_EQ(rays[0], camera.castRay(10, 20));
+    EXPECT_EQ(rays[1], camera.castRay(11, 20));
+    EXPECT_EQ(rays[2], camera.castRay(12, 20));
+    EXPECT_EQ(rays[3], camera.castRay(10, 21));
+    EXPECT_EQ(rays[4], camera.castRay(11, 21));
+    EXPECT_EQ(rays[5], camera.castRay(12, 21));
+
+    // Tiles past the edges of the viewport and buffers which are too small are rejected
+    EXPECT_THROW({
+        ray_generator.generateRays(200, 0, 2, 1, rays);
+    }, std::invalid_argument);
+    EXPECT_THROW({
+        ray_generator.generateRays(0, 0, 4, 2, rays);
+    }, std::invalid_argument);
+}
+
+// Tests generating a packet of rays through a 2x2 block of pixels
+TEST(RayTracerCameraRayGenerator, GenerateRayPacket)
+{
+    const rt::Camera camera{ 201, 101, M_PI_2 };
+    const rt::CameraRayGenerator ray_generator{ camera };
+
+    // Each lane holds the same ray as casting through its pixel individually
+    const gfx::RayPacket packet{ ray_generator.generateRayPacket(10, 20) };
+
+    ASSERT_EQ(packet.active_lanes, 0b1111);
+    EXPECT_EQ(packet.getRayAt(0), camera.castRay(10, 20));
+    EXPECT_EQ(packet.getRayAt(1), camera.castRay(11, 20));
+    EXPECT_EQ(packet.getRayAt(2), camera.castRay(10, 21));
+    EXPECT_EQ(packet.getRayAt(3), camera.castRay(11, 21));
+
+    // Lanes for pixels past the edges of the viewport are inactive
+    const gfx::RayPacket packet_corner{ ray_generator.generateRayPacket(200, 100) };
+
+    ASSERT_EQ(packet_corner.active_lanes, 0b0001);
+    EXPECT_EQ(packet_corner.getRayAt(0), camera.castRay(200, 100));
+}
+
+// Tests generating rays through sub-pixel positions
+TEST(RayTracerCameraRayGenerator, GenerateSubPixelRay)
+{
+    const rt::Camera camera{ 201, 101, M_PI_2 };
+    const rt::CameraRayGenerator ray_generator{ camera };
+
+    // The center of a pixel produces the same ray as casting through the pixel
+    EXPECT_EQ(ray_generator.generateRay(10, 20, 0.5, 0.5), camera.castRay(10, 20));
+
+    // The far corner of a pixel is the near corner of the next pixel diagonally
+    const gfx::Ray ray_corner{ ray_generator.generateRay(10, 20, 1.0, 1.0) };
+    EXPECT_EQ(ray_corner, ray_generator.generateRay(11, 21, 0.0, 0.0));
+    EXPECT_NE(ray_corner, camera.castRay(10, 20));
+}
+
+// Tests generating rays for a region of the viewport
+TEST(RayTracerCameraRayGenerator, GenerateRegionRays)
+{
+    const gfx::Matrix4 transform_matrix{
+        gfx::createYRotationMatrix(M_PI_4) * gfx::createTranslationMatrix(0, -2, 5) };
+    const rt::Camera camera{ 31, 17, M_PI_2, transform_matrix };
+    const rt::PixelRect region{ 5, 3, 10, 7 };
+    const rt::CameraRayGenerator ray_generator{ camera, region };
+
+    ASSERT_EQ(ray_generator.getRegion(), region);
+
+    // Pixel coordinates are relative to the corner of the region
+    for (size_t y = 0; y < region.height; ++y)
+        for (size_t x = 0; x < region.width; ++x) {
+            ASSERT_EQ(ray_generator.generateRay(x, y), camera.castRay(region.x + x, region.y + y));
+        }
+    EXPECT_EQ(ray_generator.generateRay(2, 1, 0.5, 0.5), camera.castRay(7, 4));
+
+    // Lanes for pixels past the edges of the region are inactive
+    const gfx::RayPacket packet{ ray_generator.generateRayPacket(9, 6) };
+
+    ASSERT_EQ(packet.active_lanes, 0b0001);
+    EXPECT_EQ(packet.getRayAt(0), camera.castRay(14, 9));
+
+    // Regions past the edges of the viewport are rejected
+    EXPECT_THROW({
+        const rt::CameraRayGenerator ray_generator_invalid(camera, rt::PixelRect{ 30, 0, 2, 1 });
+    }, std::invalid_argument);
+}
\ No newline at end of file
@@ -2,16 +2,28 @@
 
 #include <sstream>
 #include <array>
+#include <fstream>
+#include <format>
+#include <stdexcept>
+#include <algorithm>
 
 #include "util_functions.hpp"
 
 namespace rt {
-    std::string exportAsPPM(const Canvas& canvas)
+    std::string exportAsPPM(const Canvas& canvas, const std::optional<CropMetadata>& crop)
     {
         std::ostringstream ppm_data;
 
         // Create the PPM header
         ppm_data << PPM_IDENTIFIER << '\n';
+        if (crop) {
+            ppm_data << std::format("# {} {} {} {} {}\n",
+                                    PPM_CROP_COMMENT_TAG,
+                                    crop->offset_x,
+                                    crop->offset_y,
+                                    crop->frame_width,
+                                    crop->frame_height);
+        }
         ppm_data << canvas.width() << ' ' << canvas.height() << '\n';
         ppm_data << PPM_MAX_COLOR_VALUE << '\n';
 
@@ -54,4 +66,142 @@ namespace rt {
 
         return ppm_data.str();
     }
+
+    void writePPMFile(const Canvas& canvas,
+                      const std::filesystem::path& file_path,
+                      const std::optional<CropMetadata>& crop)
+    {
+        // Write the image next to its destination, then move it into place in a single step
+        std::filesystem::path temporary_path{ file_path };
+        temporary_path += ".tmp";
+        {
+            std::ofstream out_file{ temporary_path, std::ios_base::trunc };
+            out_file << exportAsPPM(canvas, crop);
+        }
+
+        std::filesystem::rename(temporary_path, file_path);
+    }
+
+    PPMImage importFromPPM(const std::string_view ppm_data)
+    {
+        std::istringstream ppm_stream{ std::string{ ppm_data } };
+        std::optional<CropMetadata> crop{ };
+
+        // Reads the next whitespace-separated token, skipping (but inspecting) comments
+        const auto readToken{ [&]() {
+            std::string token{ };
+            while (ppm_stream >> token) {
+                if (!token.starts_with('#')) {
+                    return token;
+                }
+
+                std::string comment{ };
+                std::getline(ppm_stream, comment);
+                std::istringstream comment_stream{ token.substr(1) + comment };
+                std::string tag{ };
+                CropMetadata comment_crop{ };
+                if (comment_stream >> tag && tag == PPM_CROP_COMMENT_TAG &&
+                    comment_stream >> comment_crop.offset_x >> comment_crop.offset_y
+                                   >> comment_crop.frame_width >> comment_crop.frame_height) {
+                    crop = comment_crop;
+                }
+            }
+
+            throw std::invalid_argument("PPM data ended unexpectedly");
+        } };
+
+        // Reads the next token as a non-negative integer
+        const auto readInteger{ [&]() {
+            const std::string token{ readToken() };
+            size_t value{ };
+            size_t length{ };
+            try {
+                value = std::stoul(token, &length);
+            }
+            catch (const std::exception&) {
+                length = 0;
+            }
+            if (length != token.length() || token.starts_with('-')) {
+                throw std::invalid_argument(std::format("Invalid PPM value '{}'", token));
+            }
+            return value;
+        } };
+
+        // Read the PPM header
+        if (readToken() != PPM_IDENTIFIER) {
+            throw std::invalid_argument("Only plain (P3) PPM data is supported");
+        }
+        const size_t width{ readInteger() };
+        const size_t height{ readInteger() };
+        const size_t max_color_value{ readInteger() };
+        if (max_color_value == 0) {
+            throw std::invalid_argument("PPM maximum color value must be positive");
+        }
+
+        // Read the pixel data, scaling each value back to the [0, 1] range
+        Canvas canvas{ width, height };
+        const double max_color{ static_cast<double>(max_color_value) };
+        for (size_t row = 0; row < height; ++row)
+            for (size_t col = 0; col < width; ++col) {
+                const double r{ static_cast<double>(readInteger()) / max_color };
+                const double g{ static_cast<double>(readInteger()) / max_color };
+                const double b{ static_cast<double>(readInteger()) / max_color };
+                canvas[col, row] = gfx::Color{ r, g, b };
+            }
+
+        return PPMImage{ std::move(canvas), crop };
+    }
+
+    PPMImage readPPMFile(const std::filesystem::path& file_path)
+    {
+        std::ifstream in_file{ file_path };
+        if (!in_file) {
+            throw std::invalid_argument(std::format("Unable to open PPM file '{}'", file_path.string()));
+        }
+
+        std::ostringstream ppm_data;
+        ppm_data << in_file.rdbuf();
+        return importFromPPM(ppm_data.str());
+    }
+
+    Canvas mergeCrops(const std::span<const PPMImage> images)
+    {
+        if (images.empty()) {
+            throw std::invalid_argument("At least one image is required to merge crops");
+        }
+
+        // Returns the crop metadata of an image, treating images without it as starting at the top-left corner
+        const auto getCrop{ [](const PPMImage& image) {
+            return image.crop.value_or(CropMetadata{ 0, 0, image.canvas.width(), image.canvas.height() });
+        } };
+
+        const CropMetadata first_crop{ getCrop(images.front()) };
+        const size_t frame_width{ first_crop.frame_width };
+        const size_t frame_height{ first_crop.frame_height };
+        Canvas frame{ frame_width, frame_height };
+        std::vector<bool> is_covered(frame_width * frame_height, false);
+
+        for (const PPMImage& image : images) {
+            const CropMetadata crop{ getCrop(image) };
+            if (crop.frame_width != frame_width || crop.frame_height != frame_height) {
+                throw std::invalid_argument("Crops belong to frames with different dimensions");
+            }
+            if (crop.offset_x + image.canvas.width() > frame_width ||
+                crop.offset_y + image.canvas.height() > frame_height) {
+                throw std::invalid_argument("Crop extends past the edges of its frame");
+            }
+
+            for (size_t row = 0; row < image.canvas.height(); ++row)
+                for (size_t col = 0; col < image.canvas.width(); ++col) {
+                    frame[crop.offset_x + col, crop.offset_y + row] = image.canvas[col, row];
+                    is_covered[(crop.offset_y + row) * frame_width + crop.offset_x + col] = true;
+                }
+        }
+
+        if (std::ranges::find(is_covered, false) != is_covered.end()) {
+            throw std::invalid_argument("Crops do not cover the entire frame");
+        }
+
+        return frame;
+    }
 }
\ No newline at end of file
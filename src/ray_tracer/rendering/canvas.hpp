@@ -2,7 +2,11 @@
 
 #include <vector>
 #include <mdspan>
+#include <span>
 #include <string>
+#include <string_view>
+#include <optional>
+#include <filesystem>
 
 #include "color.hpp"
 
@@ -11,6 +15,7 @@ namespace rt
     constexpr std::string_view PPM_IDENTIFIER{ "P3" };
     constexpr int PPM_MAX_COLOR_VALUE{ 255 };
     constexpr int PPM_MAX_LINE_LEN{ 70 };
+    constexpr std::string_view PPM_CROP_COMMENT_TAG{ "crop" };
 
     class Canvas
     {
@@ -69,8 +74,49 @@ namespace rt
         > m_grid;
     };
 
+    // Describes where a canvas holding a cropped render lies within its full frame
+    struct CropMetadata
+    {
+        size_t offset_x;
+        size_t offset_y;
+        size_t frame_width;
+        size_t frame_height;
+
+        [[nodiscard]] bool operator==(const CropMetadata&) const = default;
+    };
+
+    // Holds a canvas read from a PPM file, alongside its crop metadata if it holds a cropped render
+    struct PPMImage
+    {
+        Canvas canvas;
+        std::optional<CropMetadata> crop;
+    };
+
     /* Canvas Export Methods */
 
-    // Returns a string containing the canvas color data in PPM format
-    std::string exportAsPPM(const Canvas& canvas);
+    // Returns a string containing the canvas color data in PPM format. The crop metadata of a cropped render is
+    // stored in a header comment of the form "# crop <offset x> <offset y> <frame width> <frame height>".
+    std::string exportAsPPM(const Canvas& canvas, const std::optional<CropMetadata>& crop = std::nullopt);
+
+    // Writes the canvas to a PPM file, replacing any existing file atomically so that readers never observe a
+    // partially written image
+    void writePPMFile(const Canvas& canvas,
+                      const std::filesystem::path& file_path,
+                      const std::optional<CropMetadata>& crop = std::nullopt);
+
+    /* Canvas Import Methods */
+
+    // Returns the image described by a string of plain (P3) PPM data, throwing if the data is malformed
+    [[nodiscard]] PPMImage importFromPPM(std::string_view ppm_data);
+
+    // Returns the image stored in a plain (P3) PPM file
+    [[nodiscard]] PPMImage readPPMFile(const std::filesystem::path& file_path);
+
+    /* Canvas Merge Methods */
+
+    // Returns the full frame stitched together from a list of cropped renders, where images without crop metadata
+    // cover the frame from its top-left corner. Later images overwrite earlier ones where they overlap, so damaged
+    // regions can be patched by appending re-rendered crops. Throws if the images disagree on the frame dimensions,
+    // extend past the frame or leave any pixel of it uncovered.
+    [[nodiscard]] Canvas mergeCrops(std::span<const PPMImage> images);
 }
\ No newline at end of file
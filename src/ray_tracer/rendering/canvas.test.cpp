@@ -6,6 +6,12 @@
 
 #include <string>
 #include <sstream>
+#include <fstream>
+#include <iterator>
+#include <filesystem>
+#include <vector>
+#include <span>
+#include <stdexcept>
 
 #include "color.hpp"
 
@@ -188,4 +194,88 @@ TEST(RayTracerCanvas, ExportPPMLargerCanvas)
     EXPECT_TRUE(ppm_string.at(ppm_string.length() - 1) == '\n');
 }
 
+// Tests writing a canvas to a PPM file
+TEST(RayTracerCanvas, WritePPMFile)
+{
+    const rt::Canvas canvas{ 5, 3, gfx::Color{ 1, 0.8, 0.6 } };
+    const std::filesystem::path file_path{ std::filesystem::temp_directory_path() / "canvas_write_test.ppm" };
+
+    rt::writePPMFile(canvas, file_path);
+
+    // The file holds the exported canvas, and no temporary file is left behind
+    std::ifstream ppm_file{ file_path };
+    const std::string ppm_string{ std::istreambuf_iterator<char>{ ppm_file }, std::istreambuf_iterator<char>{ } };
+
+    EXPECT_EQ(ppm_string, rt::exportAsPPM(canvas));
+    EXPECT_FALSE(std::filesystem::exists(std::filesystem::path{ file_path }.concat(".tmp")));
+
+    std::filesystem::remove(file_path);
+}
+
+// Tests exporting and importing a cropped canvas with its offset metadata
+TEST(RayTracerCanvas, ImportFromPPMWithCropMetadata)
+{
+    rt::Canvas canvas{ 3, 2, gfx::Color{ 1, 0.8, 0.6 } };
+    canvas[2, 1] = gfx::Color{ 0, 0.2, 1.5 };
+    const rt::CropMetadata crop_expected{ 10, 20, 640, 480 };
+
+    const std::string ppm_string{ rt::exportAsPPM(canvas, crop_expected) };
+    const rt::PPMImage image{ rt::importFromPPM(ppm_string) };
+
+    ASSERT_EQ(image.crop, crop_expected);
+    ASSERT_EQ(image.canvas.width(), 3);
+    ASSERT_EQ(image.canvas.height(), 2);
+    EXPECT_EQ((image.canvas[0, 0]), gfx::Color(1, 0.8, 0.6));
+    EXPECT_EQ((image.canvas[2, 1]), gfx::Color(0, 0.2, 1));
+
+    // Re-exporting the imported image reproduces the original data exactly
+    EXPECT_EQ(rt::exportAsPPM(image.canvas, image.crop), ppm_string);
+
+    // Images without crop metadata, and with unrelated comments, are supported
+    const rt::PPMImage image_uncropped{ rt::importFromPPM("P3\n# created by hand\n1 1\n255\n255 0 51\n") };
+
+    ASSERT_FALSE(image_uncropped.crop.has_value());
+    EXPECT_EQ((image_uncropped.canvas[0, 0]), gfx::Color(1, 0, 0.2));
+
+    // Malformed data is rejected
+    EXPECT_THROW({
+        const rt::PPMImage image_invalid{ rt::importFromPPM("P6\n1 1\n255\n0 0 0\n") };
+    }, std::invalid_argument);
+    EXPECT_THROW({
+        const rt::PPMImage image_invalid{ rt::importFromPPM("P3\n2 1\n255\n0 0 0\n") };
+    }, std::invalid_argument);
+}
+
+// Tests stitching cropped canvases into a full frame
+TEST(RayTracerCanvas, MergeCrops)
+{
+    std::vector<rt::PPMImage> images{ };
+    images.push_back(rt::PPMImage{ rt::Canvas{ 4, 1, gfx::red() }, rt::CropMetadata{ 0, 0, 4, 3 } });
+    images.push_back(rt::PPMImage{ rt::Canvas{ 4, 2, gfx::green() }, rt::CropMetadata{ 0, 1, 4, 3 } });
+
+    const rt::Canvas frame{ rt::mergeCrops(images) };
+
+    ASSERT_EQ(frame.width(), 4);
+    ASSERT_EQ(frame.height(), 3);
+    EXPECT_EQ((frame[3, 0]), gfx::red());
+    EXPECT_EQ((frame[0, 2]), gfx::green());
+
+    // Later crops patch over earlier ones
+    images.push_back(rt::PPMImage{ rt::Canvas{ 1, 1, gfx::blue() }, rt::CropMetadata{ 2, 0, 4, 3 } });
+    const rt::Canvas frame_patched{ rt::mergeCrops(images) };
+
+    EXPECT_EQ((frame_patched[2, 0]), gfx::blue());
+    EXPECT_EQ((frame_patched[1, 0]), gfx::red());
+
+    // Crops must cover the whole frame and agree on its dimensions
+    EXPECT_THROW({
+        const rt::Canvas frame_invalid{ rt::mergeCrops(std::span{ images }.first(1)) };
+    }, std::invalid_argument);
+
+    images.push_back(rt::PPMImage{ rt::Canvas{ 1, 1, gfx::blue() }, rt::CropMetadata{ 0, 0, 5, 3 } });
+    EXPECT_THROW({
+        const rt::Canvas frame_invalid{ rt::mergeCrops(images) };
+    }, std::invalid_argument);
+}
+
 #pragma clang diagnostic pop
\ No newline at end of file
@@ -0,0 +1,283 @@
+#include "g_buffer.hpp"
+
+#include <algorithm>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+
+#include "binary_encoding.hpp"
+#include "bounding_box.hpp"
+#include "camera_ray_generator.hpp"
+#include "ray_packet.hpp"
+#include "intersection.hpp"
+#include "surface.hpp"
+
+namespace rt {
+    // Identifies G-buffer files and the version of their format
+    static constexpr std::string_view G_BUFFER_FILE_SIGNATURE{ "ray_tracer g-buffer 2" };
+
+    // Appends the x, y and z components of a point or vector, whose w component is implied by its use
+    static void appendVector(std::vector<std::byte>& data, const gfx::Vector4& vector)
+    {
+        appendDouble(data, vector.x());
+        appendDouble(data, vector.y());
+        appendDouble(data, vector.z());
+    }
+
+    // Returns the primitive index of the surface each intersection of a compiled scene refers to
+    static std::unordered_map<const gfx::Surface*, size_t> mapSurfacesToPrimitives(const gfx::CompiledScene& scene)
+    {
+        std::unordered_map<const gfx::Surface*, size_t> primitive_indices{ };
+        primitive_indices.reserve(scene.getPrimitiveCount());
+        for (size_t i = 0; i < scene.getPrimitiveCount(); ++i) {
+            primitive_indices.emplace(scene.getPrimitiveAt(i).surface, i);
+        }
+
+        return primitive_indices;
+    }
+
+    // Returns the G-buffer entry of the hit among the sorted intersections of a primary ray, or nothing if it has none
+    static std::optional<GBufferHit>
+    createGBufferHit(const std::unordered_map<const gfx::Surface*, size_t>& primitive_indices,
+                     const gfx::Ray& ray,
+                     const std::vector<gfx::Intersection>& ray_intersections)
+    {
+        const auto hit_iter{ std::lower_bound(ray_intersections.begin(), ray_intersections.end(), 0.0f) };
+        if (hit_iter == ray_intersections.end()) {
+            return std::nullopt;
+        }
+
+        const gfx::DetailedIntersection detailed_hit{ *hit_iter, ray };
+        GBufferHit hit{ primitive_indices.at(&detailed_hit.getObject()),
+                        detailed_hit.getT(),
+                        detailed_hit.getIntersectionPosition(),
+                        detailed_hit.getSurfaceNormal(),
+                        detailed_hit.getViewVector(),
+                        detailed_hit.isInsideObject(),
+                        { } };
+        for (auto intersection_iter = ray_intersections.begin(); intersection_iter != hit_iter; ++intersection_iter) {
+            hit.preceding_intersections.emplace_back(primitive_indices.at(&intersection_iter->getObject()),
+                                                     intersection_iter->getT());
+        }
+
+        return hit;
+    }
+
+    uint64_t calculateSceneGeometryHash(const gfx::CompiledScene& scene)
+    {
+        std::vector<std::byte> geometry_data{ };
+        for (size_t i = 0; i < scene.getPrimitiveCount(); ++i) {
+            const gfx::Primitive& primitive{ scene.getPrimitiveAt(i) };
+            appendUnsigned(geometry_data, primitive.geometry.index());
+            const gfx::BoundingBox object_bounds{ primitive.surface->getBounds() };
+            appendVector(geometry_data, object_bounds.getMinExtentPoint());
+            appendVector(geometry_data, object_bounds.getMaxExtentPoint());
+            const gfx::Matrix4& world_transform{ primitive.world_transform.getMatrix() };
+            for (size_t row = 0; row < 4; ++row)
+                for (size_t column = 0; column < 4; ++column) {
+                    appendDouble(geometry_data, world_transform[row, column]);
+                }
+        }
+
+        return calculateContentHash(
+            std::string_view{ reinterpret_cast<const char*>(geometry_data.data()), geometry_data.size() });
+    }
+
+    GBuffer captureGBuffer(const gfx::CompiledScene& scene,
+                           const rt::Camera& camera,
+                           const std::optional<rt::PixelRect>& region)
+    {
+        const rt::PixelRect capture_region{ region.value_or(camera.getViewportRect()) };
+        const rt::CameraRayGenerator ray_generator{ camera, capture_region };
+        const std::unordered_map<const gfx::Surface*, size_t> primitive_indices{ mapSurfacesToPrimitives(scene) };
+        GBuffer g_buffer{ capture_region,
+                          camera.getViewportWidth(),
+                          camera.getViewportHeight(),
+                          scene.getPrimitiveCount(),
+                          calculateSceneGeometryHash(scene),
+                          std::vector<std::optional<GBufferHit>>(capture_region.width * capture_region.height) };
+
+        // Trace each 2x2 block of pixels as one packet, the same way as the standard render
+        for (size_t y = 0; y < capture_region.height; y += 2)
+            for (size_t x = 0; x < capture_region.width; x += 2) {
+                const gfx::RayPacket packet{ ray_generator.generateRayPacket(x, y) };
+                const gfx::PacketIntersections packet_intersections{ scene.getAllPacketIntersections(packet) };
+                for (size_t lane = 0; lane < gfx::RAY_PACKET_SIZE; ++lane) {
+                    if (packet.isLaneActive(lane)) {
+                        g_buffer.pixels[(y + lane / 2) * capture_region.width + x + lane % 2] =
+                            createGBufferHit(primitive_indices, packet.getRayAt(lane), packet_intersections[lane]);
+                    }
+                }
+            }
+
+        return g_buffer;
+    }
+
+    rt::RenderResult relight(const gfx::CompiledScene& scene, const GBuffer& g_buffer)
+    {
+        if (g_buffer.primitive_count != scene.getPrimitiveCount()) {
+            throw std::invalid_argument(std::format("The G-buffer was captured from a scene with {} primitives, not {}",
+                                                    g_buffer.primitive_count,
+                                                    scene.getPrimitiveCount()));
+        }
+        if (g_buffer.geometry_hash != calculateSceneGeometryHash(scene)) {
+            throw std::invalid_argument("The G-buffer was captured from a scene with different geometry");
+        }
+
+        const size_t width{ g_buffer.region.width };
+        const size_t height{ g_buffer.region.height };
+        rt::RenderResult result{ rt::Canvas{ width, height }, g_buffer.region, std::vector<size_t>(width * height, 1),
+                                 width * height };
+        std::vector<gfx::Intersection> ray_intersections{ };
+        for (size_t y = 0; y < height; ++y)
+            for (size_t x = 0; x < width; ++x) {
+                const std::optional<GBufferHit>& hit{ g_buffer.pixels[y * width + x] };
+                if (!hit) {
+                    continue;
+                }
+
+                // Restore the primary ray's intersections up to its hit, which is all refraction looks at
+                ray_intersections.clear();
+                for (const GBufferIntersection& intersection : hit->preceding_intersections) {
+                    ray_intersections.emplace_back(intersection.t,
+                                                   scene.getPrimitiveAt(intersection.object_id).surface);
+                }
+                ray_intersections.emplace_back(hit->t, scene.getPrimitiveAt(hit->object_id).surface);
+
+                const gfx::DetailedIntersection detailed_hit{ ray_intersections.back(),
+                                                              hit->position,
+                                                              hit->surface_normal,
+                                                              hit->view_vector,
+                                                              hit->is_inside_object };
+                result.image[x, y] = scene.calculateHitColor(detailed_hit, ray_intersections);
+            }
+
+        return result;
+    }
+
+    std::vector<std::byte> encodeGBuffer(const GBuffer& g_buffer)
+    {
+        std::vector<std::byte> data{ };
+        appendString(data, G_BUFFER_FILE_SIGNATURE);
+        appendPixelRect(data, g_buffer.region);
+        appendUnsigned(data, g_buffer.viewport_width);
+        appendUnsigned(data, g_buffer.viewport_height);
+        appendUnsigned(data, g_buffer.primitive_count);
+        appendUnsigned(data, g_buffer.geometry_hash);
+        for (const std::optional<GBufferHit>& hit : g_buffer.pixels) {
+            appendUnsigned(data, hit.has_value(), 1);
+            if (!hit) {
+                continue;
+            }
+
+            appendUnsigned(data, hit->object_id);
+            appendDouble(data, hit->t);
+            appendVector(data, hit->position);
+            appendVector(data, hit->surface_normal);
+            appendVector(data, hit->view_vector);
+            appendUnsigned(data, hit->is_inside_object, 1);
+            appendUnsigned(data, hit->preceding_intersections.size());
+            for (const GBufferIntersection& intersection : hit->preceding_intersections) {
+                appendUnsigned(data, intersection.object_id);
+                appendDouble(data, intersection.t);
+            }
+        }
+
+        return data;
+    }
+
+    GBuffer decodeGBuffer(const std::span<const std::byte> data)
+    {
+        rt::BinaryReader reader{ data };
+        if (reader.readString() != G_BUFFER_FILE_SIGNATURE) {
+            throw std::invalid_argument("Data is not a G-buffer of a supported version");
+        }
+
+        GBuffer g_buffer{ };
+        g_buffer.region = reader.readPixelRect();
+        g_buffer.viewport_width = reader.readUnsigned();
+        g_buffer.viewport_height = reader.readUnsigned();
+        g_buffer.primitive_count = reader.readUnsigned();
+        g_buffer.geometry_hash = reader.readUnsigned();
+
+        // Each pixel takes at least one byte, so check the size before allocating the pixels
+        const rt::PixelRect& region{ g_buffer.region };
+        if (region.width == 0 || region.height == 0 || region.height > reader.getRemainingSize() / region.width ||
+            region.x + region.width > g_buffer.viewport_width || region.y + region.height > g_buffer.viewport_height) {
+            throw std::invalid_argument("G-buffer dimensions do not match the size of its data");
+        }
+
+        const auto read_id{ [&]() {
+            const size_t object_id{ reader.readUnsigned() };
+            if (object_id >= g_buffer.primitive_count) {
+                throw std::invalid_argument("The G-buffer refers to a primitive past the end of its scene");
+            }
+            return object_id;
+        } };
+        const auto read_point{ [&]() {
+            const double x{ reader.readDouble() };
+            const double y{ reader.readDouble() };
+            const double z{ reader.readDouble() };
+            return gfx::createPoint(x, y, z);
+        } };
+        const auto read_vector{ [&]() {
+            const double x{ reader.readDouble() };
+            const double y{ reader.readDouble() };
+            const double z{ reader.readDouble() };
+            return gfx::createVector(x, y, z);
+        } };
+
+        g_buffer.pixels.resize(region.width * region.height);
+        for (std::optional<GBufferHit>& pixel : g_buffer.pixels) {
+            if (reader.readUnsigned(1) == 0) {
+                continue;
+            }
+
+            GBufferHit& hit{ pixel.emplace() };
+            hit.object_id = read_id();
+            hit.t = reader.readDouble();
+            hit.position = read_point();
+            hit.surface_normal = read_vector();
+            hit.view_vector = read_vector();
+            hit.is_inside_object = reader.readUnsigned(1) != 0;
+
+            // Each intersection takes 16 bytes
+            const size_t intersection_count{ reader.readUnsigned() };
+            if (intersection_count > reader.getRemainingSize() / 16) {
+                throw std::invalid_argument("Data is shorter than its contents require");
+            }
+            for (size_t i = 0; i < intersection_count; ++i) {
+                const size_t object_id{ read_id() };
+                hit.preceding_intersections.emplace_back(object_id, reader.readDouble());
+            }
+        }
+        reader.finish();
+
+        return g_buffer;
+    }
+
+    void writeGBufferFile(const GBuffer& g_buffer, const std::filesystem::path& file_path)
+    {
+        const std::vector<std::byte> data{ encodeGBuffer(g_buffer) };
+        std::ofstream out_file{ file_path, std::ios_base::binary | std::ios_base::trunc };
+        out_file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        if (!out_file.flush()) {
+            throw std::invalid_argument(std::format("Unable to write G-buffer file '{}'", file_path.string()));
+        }
+    }
+
+    GBuffer readGBufferFile(const std::filesystem::path& file_path)
+    {
+        std::ifstream in_file{ file_path, std::ios_base::binary };
+        if (!in_file) {
+            throw std::invalid_argument(std::format("Unable to open G-buffer file '{}'", file_path.string()));
+        }
+
+        const std::vector<char> contents{ std::istreambuf_iterator<char>{ in_file },
+                                          std::istreambuf_iterator<char>{ } };
+        return decodeGBuffer(std::as_bytes(std::span{ contents }));
+    }
+}
\ No newline at end of file
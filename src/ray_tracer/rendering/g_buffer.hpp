@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "vector4.hpp"
+#include "camera.hpp"
+#include "rendering_functions.hpp"
+#include "compiled_scene.hpp"
+
+namespace rt {
+    // An intersection of a primary ray with a primitive, identified by its index in the compiled scene
+    struct GBufferIntersection
+    {
+        size_t object_id;
+        double t;
+
+        [[nodiscard]] bool operator==(const GBufferIntersection&) const = default;
+    };
+
+    // The state of the primary hit of a pixel needed to shade it again, without tracing its primary ray
+    struct GBufferHit
+    {
+        size_t object_id;                   // Index of the hit primitive in the compiled scene
+        double t;
+        gfx::Vector4 position;
+        gfx::Vector4 surface_normal;        // Facing the viewer
+        gfx::Vector4 view_vector;
+        bool is_inside_object;
+        std::vector<GBufferIntersection> preceding_intersections;   // Intersections of the primary ray before the
+                                                                    // hit, which decide the media refraction leaves
+                                                                    // and enters
+
+        [[nodiscard]] bool operator==(const GBufferHit&) const = default;
+    };
+
+    // Holds the primary hit of each pixel of a region (in row-major order), or nothing for pixels whose primary ray
+    // missed every object
+    struct GBuffer
+    {
+        rt::PixelRect region;
+        size_t viewport_width;
+        size_t viewport_height;
+        size_t primitive_count;             // Of the compiled scene the hits were found in
+        uint64_t geometry_hash;             // Of the compiled scene the hits were found in
+        std::vector<std::optional<GBufferHit>> pixels;
+    };
+
+    /* G-Buffer Functions */
+
+    // Returns a hash of the shape, object-space bounds and world transform of every primitive of a compiled scene,
+    // which is unaffected by its lights and materials
+    [[nodiscard]] uint64_t calculateSceneGeometryHash(const gfx::CompiledScene& scene);
+
+    // Returns the G-buffer holding the primary hit through the center of each pixel of a region of the viewport
+    [[nodiscard]] GBuffer captureGBuffer(const gfx::CompiledScene& scene,
+                                         const rt::Camera& camera,
+                                         const std::optional<rt::PixelRect>& region = std::nullopt);
+
+    // Returns the image of a scene shaded from the primary hits saved in a G-buffer, tracing only shadow and
+    // secondary rays. The scene must have the same primitives as the scene the G-buffer was captured from, but its
+    // lights and materials may differ. Shading a G-buffer captured from the same scene matches the standard render.
+    // Throws if the geometry of the scene differs from the geometry the G-buffer was captured from.
+    [[nodiscard]] rt::RenderResult relight(const gfx::CompiledScene& scene, const GBuffer& g_buffer);
+
+    // Returns the encoded contents of a G-buffer file
+    [[nodiscard]] std::vector<std::byte> encodeGBuffer(const GBuffer& g_buffer);
+
+    // Returns the G-buffer stored in the contents of a G-buffer file, throwing if they are malformed
+    [[nodiscard]] GBuffer decodeGBuffer(std::span<const std::byte> data);
+
+    // Writes a G-buffer to a file, throwing if it cannot be written
+    void writeGBufferFile(const GBuffer& g_buffer, const std::filesystem::path& file_path);
+
+    // Returns the G-buffer stored in a file, throwing if it cannot be read or is malformed
+    [[nodiscard]] GBuffer readGBufferFile(const std::filesystem::path& file_path);
+}
\ No newline at end of file
@@ -0,0 +1,164 @@
+#include "gtest/gtest.h"
+#include "g_buffer.hpp"
+
+#include <filesystem>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include "parse.hpp"
+#include "compiled_scene.hpp"
+
+// Returns the description of a scene with a hollow glass sphere in front of a striped floor, all inside a sky sphere
+static json createTestSceneData()
+{
+    return json::parse(R"({
+        "world": {
+            "light_source": { "intensity": [1, 1, 1], "position": [-10, 10, -10] },
+            "objects": [
+                { "shape": "sphere", "material": { "color": [0.1, 0.1, 0.1], "reflectivity": 0.9, "transparency": 0.9,
+                                                   "refractive_index": 1.5 } },
+                { "shape": "sphere", "transform": [ { "type": "scale", "values": [0.5, 0.5, 0.5] } ],
+                  "material": { "color": [0.1, 0.1, 0.1], "transparency": 0.9, "refractive_index": 1.0 } },
+                { "shape": "sphere", "transform": [ { "type": "translate", "values": [-2, 0, 2] } ],
+                  "material": { "color": [0.8, 1.0, 0.6], "diffuse": 0.7, "specular": 0.2 } },
+                { "shape": "plane", "transform": [ { "type": "translate", "values": [0, -1, 0] } ],
+                  "material": { "texture": { "type": "stripe", "transform": [], "color_a": [1, 1, 1],
+                                             "color_b": [0, 0, 0] } } },
+                { "shape": "sphere", "transform": [ { "type": "scale", "values": [50, 50, 50] } ],
+                  "material": { "color": [0.2, 0.3, 0.6], "ambient": 1, "diffuse": 0, "specular": 0 } }
+            ]
+        },
+        "camera": {
+            "viewport_width": 31,
+            "viewport_height": 21,
+            "field_of_view": 1.0471975512,
+            "transform": { "input_base": [0, 1.5, -5], "output_base": [0, 0, 0], "up_vector": [0, 1, 0] }
+        }
+    })");
+}
+
+// Tests that relighting a G-buffer with the scene it was captured from matches the standard render
+TEST(RayTracerGBuffer, CaptureAndRelight)
+{
+    const Scene scene{ data::parseSceneData(createTestSceneData()) };
+    const gfx::CompiledScene compiled_scene{ gfx::compileScene(scene.world) };
+    const rt::GBuffer g_buffer{ rt::captureGBuffer(compiled_scene, scene.camera) };
+
+    ASSERT_EQ(g_buffer.region, scene.camera.getViewportRect());
+    ASSERT_EQ(g_buffer.primitive_count, 5);
+    ASSERT_EQ(g_buffer.pixels.size(), 31 * 21);
+
+    // Every ray starts inside the sky sphere, so it records the intersection with the sky sphere behind the camera
+    size_t hit_count{ 0 };
+    size_t overlapping_hit_count{ 0 };
+    for (const std::optional<rt::GBufferHit>& hit : g_buffer.pixels) {
+        if (hit) {
+            ++hit_count;
+            EXPECT_LT(hit->object_id, g_buffer.primitive_count);
+            overlapping_hit_count += hit->preceding_intersections.empty() ? 0 : 1;
+        }
+    }
+    EXPECT_EQ(hit_count, g_buffer.pixels.size());
+    EXPECT_EQ(overlapping_hit_count, hit_count);
+
+    const rt::Canvas image_expected{ rt::render(compiled_scene, scene.camera) };
+    const rt::RenderResult result{ rt::relight(compiled_scene, g_buffer) };
+    ASSERT_EQ(result.region, g_buffer.region);
+    ASSERT_EQ(result.total_sample_count, 31 * 21);
+    for (size_t y = 0; y < 21; ++y)
+        for (size_t x = 0; x < 31; ++x) {
+            EXPECT_EQ((result.image[x, y]), (image_expected[x, y]));
+        }
+
+    // Regions are captured with the same hits as the full viewport
+    const rt::PixelRect region{ 7, 4, 12, 9 };
+    const rt::GBuffer g_buffer_region{ rt::captureGBuffer(compiled_scene, scene.camera, region) };
+    ASSERT_EQ(g_buffer_region.viewport_width, 31);
+    for (size_t y = 0; y < region.height; ++y)
+        for (size_t x = 0; x < region.width; ++x) {
+            EXPECT_EQ(g_buffer_region.pixels[y * region.width + x],
+                      g_buffer.pixels[(region.y + y) * 31 + region.x + x]);
+        }
+}
+
+// Tests that relighting a G-buffer after changing the lights and materials of its scene matches rendering the
+// changed scene, and that changing its geometry is rejected
+TEST(RayTracerGBuffer, RelightChangedScene)
+{
+    const Scene scene{ data::parseSceneData(createTestSceneData()) };
+    const rt::GBuffer g_buffer{ rt::captureGBuffer(gfx::compileScene(scene.world), scene.camera) };
+
+    json changed_scene_data = createTestSceneData();
+    changed_scene_data["world"]["light_source"]["position"] = json::array({ 5, 8, -3 });
+    changed_scene_data["world"]["light_source"]["intensity"] = json::array({ 1, 0.5, 0.5 });
+    changed_scene_data["world"]["objects"].at(2)["material"]["diffuse"] = 0.3;
+    changed_scene_data["world"]["objects"].at(0)["material"]["reflectivity"] = 0.2;
+    const Scene changed_scene{ data::parseSceneData(changed_scene_data) };
+    const gfx::CompiledScene changed_compiled_scene{ gfx::compileScene(changed_scene.world) };
+
+    const rt::Canvas image_expected{ rt::render(changed_compiled_scene, changed_scene.camera) };
+    const rt::RenderResult result{ rt::relight(changed_compiled_scene, g_buffer) };
+    for (size_t y = 0; y < 21; ++y)
+        for (size_t x = 0; x < 31; ++x) {
+            EXPECT_EQ((result.image[x, y]), (image_expected[x, y]));
+        }
+
+    // Scenes with different primitives are rejected
+    json fewer_objects_data = createTestSceneData();
+    fewer_objects_data["world"]["objects"].erase(4);
+    const gfx::CompiledScene fewer_objects_scene{
+        gfx::compileScene(data::parseSceneData(fewer_objects_data).world) };
+    EXPECT_THROW(static_cast<void>(rt::relight(fewer_objects_scene, g_buffer)), std::invalid_argument);
+
+    // So are scenes with the same number of primitives in different places
+    json moved_object_data = createTestSceneData();
+    moved_object_data["world"]["objects"].at(2)["transform"][0]["values"] = json::array({ -2, 0.5, 2 });
+    const gfx::CompiledScene moved_object_scene{ gfx::compileScene(data::parseSceneData(moved_object_data).world) };
+    EXPECT_THROW(static_cast<void>(rt::relight(moved_object_scene, g_buffer)), std::invalid_argument);
+}
+
+// Tests writing a G-buffer to a file and reading it back
+TEST(RayTracerGBuffer, WriteAndReadGBufferFile)
+{
+    const Scene scene{ data::parseSceneData(createTestSceneData()) };
+    const rt::GBuffer g_buffer{
+        rt::captureGBuffer(gfx::compileScene(scene.world), scene.camera, rt::PixelRect{ 3, 2, 20, 15 }) };
+
+    const std::filesystem::path file_path{ std::filesystem::temp_directory_path() / "g_buffer_test.gbuf" };
+    rt::writeGBufferFile(g_buffer, file_path);
+    const rt::GBuffer g_buffer_read{ rt::readGBufferFile(file_path) };
+    std::filesystem::remove(file_path);
+
+    ASSERT_EQ(g_buffer_read.region, g_buffer.region);
+    ASSERT_EQ(g_buffer_read.viewport_width, g_buffer.viewport_width);
+    ASSERT_EQ(g_buffer_read.viewport_height, g_buffer.viewport_height);
+    ASSERT_EQ(g_buffer_read.primitive_count, g_buffer.primitive_count);
+    ASSERT_EQ(g_buffer_read.geometry_hash, g_buffer.geometry_hash);
+    ASSERT_EQ(g_buffer_read.pixels, g_buffer.pixels);
+
+    EXPECT_THROW(static_cast<void>(rt::readGBufferFile(file_path)), std::invalid_argument);
+}
+
+// Tests that malformed G-buffer data causes an error
+TEST(RayTracerGBuffer, DecodeMalformedGBuffer)
+{
+    rt::GBuffer g_buffer{ rt::PixelRect{ 0, 0, 2, 1 }, 2, 1, 1, 42, std::vector<std::optional<rt::GBufferHit>>(2) };
+    g_buffer.pixels[1] = rt::GBufferHit{ 0, 1.5, gfx::createPoint(0, 0, 1), gfx::createVector(0, 0, -1),
+                                         gfx::createVector(0, 0, -1), false, { { 0, -0.5 } } };
+    std::vector<std::byte> data{ rt::encodeGBuffer(g_buffer) };
+
+    const rt::GBuffer decoded_g_buffer{ rt::decodeGBuffer(data) };
+    ASSERT_EQ(decoded_g_buffer.geometry_hash, 42);
+    ASSERT_EQ(decoded_g_buffer.pixels, g_buffer.pixels);
+
+    data.pop_back();
+    EXPECT_THROW(static_cast<void>(rt::decodeGBuffer(data)), std::invalid_argument);
+    data[8] = std::byte{ 'X' };
+    EXPECT_THROW(static_cast<void>(rt::decodeGBuffer(data)), std::invalid_argument);
+
+    // Hits must refer to the primitives of the scene
+    g_buffer.primitive_count = 0;
+    g_buffer.pixels[1]->preceding_intersections.clear();
+    EXPECT_THROW(static_cast<void>(rt::decodeGBuffer(rt::encodeGBuffer(g_buffer))), std::invalid_argument);
+}
\ No newline at end of file
@@ -0,0 +1,342 @@
+#include "incremental_rendering.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+#include "binary_encoding.hpp"
+#include "traceable_scene.hpp"
+#include "surface.hpp"
+
+namespace rt {
+    // Identifies incremental render state files and the version of their format
+    static constexpr std::string_view INCREMENTAL_STATE_FILE_SIGNATURE{ "ray_tracer incremental render 2" };
+
+    // Returns the top-level object each primitive surface of a compiled scene was flattened out of
+    static std::unordered_map<const gfx::Surface*, size_t> mapSurfacesToObjects(const gfx::CompiledScene& scene)
+    {
+        std::unordered_map<const gfx::Surface*, size_t> object_indices{ };
+        object_indices.reserve(scene.getPrimitiveCount());
+        for (size_t object_index = 0; object_index < scene.getObjectCount(); ++object_index) {
+            for (const size_t primitive_index : scene.getObjectPrimitiveIndices(object_index)) {
+                object_indices.emplace(scene.getPrimitiveAt(primitive_index).surface, object_index);
+            }
+        }
+
+        return object_indices;
+    }
+
+    // Returns true if a saved render covers the tiles of a region, and was rendered with the same sampling settings
+    static bool isStateReusable(const IncrementalRenderState& state,
+                                const rt::SamplingSettings& settings,
+                                const rt::PixelRect& region,
+                                const size_t tile_count)
+    {
+        return state.sampling_settings == settings &&
+               state.region == region &&
+               state.tile_size == INCREMENTAL_TILE_SIZE &&
+               state.render_result.region == region &&
+               state.tile_footprints.size() == tile_count;
+    }
+
+    // Returns the bounding box stored as its minimum and then maximum extents
+    static gfx::BoundingBox readBoundingBox(rt::BinaryReader& reader)
+    {
+        const double min_x{ reader.readDouble() };
+        const double min_y{ reader.readDouble() };
+        const double min_z{ reader.readDouble() };
+        const double max_x{ reader.readDouble() };
+        const double max_y{ reader.readDouble() };
+        const double max_z{ reader.readDouble() };
+        return gfx::BoundingBox{ min_x, min_y, min_z, max_x, max_y, max_z };
+    }
+
+    // Returns the region over which the ray grid of each tile is recorded. It encloses the objects of a compiled scene
+    // which have finite bounds, widened on every side by a quarter of their largest extent, so that an object moved
+    // a little past the others is still compared with the cells of the grid.
+    static gfx::BoundingBox calculateRayGridBounds(const gfx::CompiledScene& scene)
+    {
+        gfx::BoundingBox object_bounds{ };
+        for (size_t object_index = 0; object_index < scene.getObjectCount(); ++object_index) {
+            const gfx::BoundingBox bounds{ scene.calculateObjectBounds(object_index) };
+            if (std::isfinite(bounds.getMinX()) && std::isfinite(bounds.getMinY()) &&
+                std::isfinite(bounds.getMinZ()) && std::isfinite(bounds.getMaxX()) &&
+                std::isfinite(bounds.getMaxY()) && std::isfinite(bounds.getMaxZ())) {
+                object_bounds.mergeWithBox(bounds);
+            }
+        }
+        if (object_bounds.getMinX() > object_bounds.getMaxX()) {
+            return object_bounds;
+        }
+
+        const double margin{ std::max({ object_bounds.getMaxX() - object_bounds.getMinX(),
+                                        object_bounds.getMaxY() - object_bounds.getMinY(),
+                                        object_bounds.getMaxZ() - object_bounds.getMinZ() }) / 4 };
+        return gfx::BoundingBox{ object_bounds.getMinX() - margin,
+                                 object_bounds.getMinY() - margin,
+                                 object_bounds.getMinZ() - margin,
+                                 object_bounds.getMaxX() + margin,
+                                 object_bounds.getMaxY() + margin,
+                                 object_bounds.getMaxZ() + margin };
+    }
+
+    std::vector<std::byte> encodeIncrementalRenderState(const IncrementalRenderState& state)
+    {
+        std::vector<std::byte> data{ };
+        appendString(data, INCREMENTAL_STATE_FILE_SIGNATURE);
+        appendString(data, state.scene_data);
+        appendUnsigned(data, state.sampling_settings.min_samples);
+        appendUnsigned(data, state.sampling_settings.max_samples);
+        appendDouble(data, state.sampling_settings.variance_threshold);
+        appendDouble(data, state.sampling_settings.contrast_threshold);
+        appendPixelRect(data, state.region);
+        appendUnsigned(data, state.tile_size);
+        appendRenderResult(data, state.render_result);
+        appendUnsigned(data, state.tile_footprints.size());
+        for (const TileFootprint& tile_footprint : state.tile_footprints) {
+            appendUnsigned(data, tile_footprint.object_indices.size());
+            for (const size_t object_index : tile_footprint.object_indices) {
+                appendUnsigned(data, object_index);
+            }
+
+            const gfx::BoundingBox& ray_bounds{ tile_footprint.ray_bounds };
+            appendDouble(data, ray_bounds.getMinX());
+            appendDouble(data, ray_bounds.getMinY());
+            appendDouble(data, ray_bounds.getMinZ());
+            appendDouble(data, ray_bounds.getMaxX());
+            appendDouble(data, ray_bounds.getMaxY());
+            appendDouble(data, ray_bounds.getMaxZ());
+
+            const gfx::BoundingBox& grid_bounds{ tile_footprint.ray_grid.getBounds() };
+            appendDouble(data, grid_bounds.getMinX());
+            appendDouble(data, grid_bounds.getMinY());
+            appendDouble(data, grid_bounds.getMinZ());
+            appendDouble(data, grid_bounds.getMaxX());
+            appendDouble(data, grid_bounds.getMaxY());
+            appendDouble(data, grid_bounds.getMaxZ());
+            for (const uint64_t cell_word : tile_footprint.ray_grid.getCells()) {
+                appendUnsigned(data, cell_word);
+            }
+        }
+
+        return data;
+    }
+
+    IncrementalRenderState decodeIncrementalRenderState(const std::span<const std::byte> data)
+    {
+        rt::BinaryReader reader{ data };
+        if (reader.readString() != INCREMENTAL_STATE_FILE_SIGNATURE) {
+            throw std::invalid_argument("Data is not an incremental render state of a supported version");
+        }
+
+        std::string scene_data{ reader.readString() };
+        rt::SamplingSettings sampling_settings{ };
+        sampling_settings.min_samples = reader.readUnsigned();
+        sampling_settings.max_samples = reader.readUnsigned();
+        sampling_settings.variance_threshold = reader.readDouble();
+        sampling_settings.contrast_threshold = reader.readDouble();
+        const rt::PixelRect region{ reader.readPixelRect() };
+        const size_t tile_size{ reader.readUnsigned() };
+        rt::RenderResult render_result{ reader.readRenderResult() };
+
+        // Each footprint takes at least 616 bytes, and each of its objects 8 bytes
+        const size_t tile_count{ reader.readUnsigned() };
+        if (tile_count > reader.getRemainingSize() / 616) {
+            throw std::invalid_argument("Data is shorter than its contents require");
+        }
+        std::vector<TileFootprint> tile_footprints(tile_count);
+        for (TileFootprint& tile_footprint : tile_footprints) {
+            const size_t object_count{ reader.readUnsigned() };
+            if (object_count > reader.getRemainingSize() / 8) {
+                throw std::invalid_argument("Data is shorter than its contents require");
+            }
+            for (size_t i = 0; i < object_count; ++i) {
+                tile_footprint.object_indices.push_back(reader.readUnsigned());
+            }
+
+            tile_footprint.ray_bounds = readBoundingBox(reader);
+            const gfx::BoundingBox grid_bounds{ readBoundingBox(reader) };
+            std::array<uint64_t, gfx::FootprintGrid::WORD_COUNT> grid_cells{ };
+            for (uint64_t& cell_word : grid_cells) {
+                cell_word = reader.readUnsigned();
+            }
+            tile_footprint.ray_grid = gfx::FootprintGrid{ grid_bounds, grid_cells };
+        }
+        reader.finish();
+
+        return IncrementalRenderState{ std::move(scene_data),
+                                       sampling_settings,
+                                       region,
+                                       tile_size,
+                                       std::move(render_result),
+                                       std::move(tile_footprints) };
+    }
+
+    void writeIncrementalRenderState(const IncrementalRenderState& state, const std::filesystem::path& file_path)
+    {
+        // Write the state next to its destination, then move it into place in a single step
+        std::filesystem::path temporary_path{ file_path };
+        temporary_path += ".tmp";
+        {
+            const std::vector<std::byte> data{ encodeIncrementalRenderState(state) };
+            std::ofstream out_file{ temporary_path, std::ios_base::binary | std::ios_base::trunc };
+            out_file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+            if (!out_file.flush()) {
+                throw std::invalid_argument(std::format("Unable to write incremental render state file '{}'",
+                                                        temporary_path.string()));
+            }
+        }
+
+        std::filesystem::rename(temporary_path, file_path);
+    }
+
+    std::optional<IncrementalRenderState> readIncrementalRenderState(const std::filesystem::path& file_path)
+    {
+        if (!std::filesystem::exists(file_path)) {
+            return std::nullopt;
+        }
+
+        std::ifstream in_file{ file_path, std::ios_base::binary };
+        if (!in_file) {
+            throw std::invalid_argument(std::format("Unable to open incremental render state file '{}'",
+                                                    file_path.string()));
+        }
+
+        const std::vector<char> contents{ std::istreambuf_iterator<char>{ in_file },
+                                          std::istreambuf_iterator<char>{ } };
+        return decodeIncrementalRenderState(std::as_bytes(std::span{ contents }));
+    }
+
+    std::vector<bool> findAffectedTiles(const std::span<const TileFootprint> tile_footprints,
+                                        const data::SceneEdit& scene_edit,
+                                        const gfx::CompiledScene& previous_scene,
+                                        const gfx::CompiledScene& scene)
+    {
+        const bool has_moved_objects{ !scene_edit.moved_object_indices.empty() };
+        if (scene_edit.is_full_render_required ||
+            (has_moved_objects && (!previous_scene.getShadowMaps().empty() || !scene.getShadowMaps().empty()))) {
+            return std::vector<bool>(tile_footprints.size(), true);
+        }
+
+        // The edited objects are compared against each footprint by their bounds before and after the edit
+        std::vector<size_t> edited_object_indices{ scene_edit.material_object_indices };
+        edited_object_indices.append_range(scene_edit.moved_object_indices);
+        std::vector<gfx::BoundingBox> moved_object_bounds{ };
+        for (const size_t object_index : scene_edit.moved_object_indices) {
+            moved_object_bounds.push_back(previous_scene.calculateObjectBounds(object_index));
+            moved_object_bounds.push_back(scene.calculateObjectBounds(object_index));
+        }
+
+        std::vector<bool> affected_tiles(tile_footprints.size(), false);
+        for (size_t tile = 0; tile < tile_footprints.size(); ++tile) {
+            const TileFootprint& tile_footprint{ tile_footprints[tile] };
+
+            // Lights may reach any surface from anywhere, so only tiles whose rays hit nothing are left unaffected
+            if (scene_edit.are_lights_changed && !tile_footprint.object_indices.empty()) {
+                affected_tiles[tile] = true;
+                continue;
+            }
+
+            affected_tiles[tile] =
+                std::ranges::any_of(edited_object_indices, [&](const size_t object_index) {
+                    return std::ranges::binary_search(tile_footprint.object_indices, object_index);
+                }) ||
+                std::ranges::any_of(moved_object_bounds, [&](const gfx::BoundingBox& object_bounds) {
+                    // Rays may have reached an object beyond the grid along the parts the grid clipped away
+                    return tile_footprint.ray_grid.containsBox(object_bounds) ?
+                        tile_footprint.ray_grid.overlapsBox(object_bounds) :
+                        tile_footprint.ray_bounds.overlapsBox(object_bounds);
+                });
+        }
+
+        return affected_tiles;
+    }
+
+    rt::IncrementalRenderResult renderIncrementally(const gfx::CompiledScene& scene,
+                                                    const rt::Camera& camera,
+                                                    const rt::SamplingSettings& settings,
+                                                    const json& scene_data,
+                                                    const std::filesystem::path& state_file_path,
+                                                    const std::optional<rt::PixelRect>& region)
+    {
+        const rt::PixelRect frame_region{ region.value_or(camera.getViewportRect()) };
+        if (!camera.isWithinViewport(frame_region)) {
+            throw std::invalid_argument("Region extends past the edges of the camera viewport");
+        }
+
+        const std::vector<rt::PixelRect> tiles{ splitIntoTiles(frame_region, INCREMENTAL_TILE_SIZE) };
+
+        // Reuse the previous render wherever the edit of its scene cannot reach
+        std::optional<IncrementalRenderState> previous_state{ readIncrementalRenderState(state_file_path) };
+        const bool is_state_reused{
+            previous_state && isStateReusable(*previous_state, settings, frame_region, tiles.size()) };
+        std::vector<bool> affected_tiles(tiles.size(), true);
+        if (is_state_reused) {
+            const json previous_scene_data = json::parse(previous_state->scene_data);
+            const data::SceneEdit scene_edit{ data::diffSceneData(previous_scene_data, scene_data) };
+
+            // Only moved objects need the bounds they had in the previous scene
+            if (scene_edit.is_full_render_required || scene_edit.moved_object_indices.empty()) {
+                affected_tiles = findAffectedTiles(previous_state->tile_footprints, scene_edit, scene, scene);
+            } else {
+                const gfx::CompiledScene previous_scene{
+                    gfx::compileScene(data::parseSceneData(previous_scene_data).world) };
+                affected_tiles = findAffectedTiles(previous_state->tile_footprints, scene_edit, previous_scene, scene);
+            }
+        }
+
+        IncrementalRenderState state{
+            scene_data.dump(),
+            settings,
+            frame_region,
+            INCREMENTAL_TILE_SIZE,
+            is_state_reused ?
+                std::move(previous_state->render_result) :
+                rt::RenderResult{ rt::Canvas{ frame_region.width, frame_region.height },
+                                  frame_region,
+                                  std::vector<size_t>(frame_region.width * frame_region.height),
+                                  0 },
+            is_state_reused ? std::move(previous_state->tile_footprints) : std::vector<TileFootprint>(tiles.size()) };
+
+        // Render the affected tiles, recording the footprint of each
+        const std::unordered_map<const gfx::Surface*, size_t> object_indices{ mapSurfacesToObjects(scene) };
+        const gfx::BoundingBox ray_grid_bounds{ calculateRayGridBounds(scene) };
+        size_t rendered_tile_count{ 0 };
+        for (size_t tile = 0; tile < tiles.size(); ++tile) {
+            if (!affected_tiles[tile]) {
+                continue;
+            }
+
+            gfx::RayFootprint ray_footprint{ };
+            ray_footprint.grid = gfx::FootprintGrid{ ray_grid_bounds };
+            gfx::TraceableScene::setRayFootprint(&ray_footprint);
+            const rt::RenderResult tile_result{ renderAdaptive(scene, camera, settings, tiles[tile]) };
+            gfx::TraceableScene::setRayFootprint(nullptr);
+            copyRenderRegion(tile_result, state.render_result);
+
+            TileFootprint& tile_footprint{ state.tile_footprints[tile] };
+            tile_footprint.object_indices.clear();
+            for (const gfx::Surface* const surface : ray_footprint.surfaces) {
+                tile_footprint.object_indices.push_back(object_indices.at(surface));
+            }
+            std::ranges::sort(tile_footprint.object_indices);
+            const auto [ duplicate_begin, duplicate_end ] { std::ranges::unique(tile_footprint.object_indices) };
+            tile_footprint.object_indices.erase(duplicate_begin, duplicate_end);
+            tile_footprint.ray_bounds = ray_footprint.bounds;
+            tile_footprint.ray_grid = ray_footprint.grid;
+            ++rendered_tile_count;
+        }
+
+        writeIncrementalRenderState(state, state_file_path);
+        return rt::IncrementalRenderResult{ std::move(state.render_result), tiles.size(), rendered_tile_count };
+    }
+}
\ No newline at end of file
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "camera.hpp"
+#include "sampling.hpp"
+#include "rendering_functions.hpp"
+#include "compiled_scene.hpp"
+#include "bounding_box.hpp"
+#include "footprint_grid.hpp"
+#include "scene_diff.hpp"
+
+namespace rt {
+    // The width and height, in pixels, of the tiles an incremental render tracks and renders again separately
+    inline constexpr size_t INCREMENTAL_TILE_SIZE{ 32 };
+
+    // What the rays of a tile touched when it was rendered
+    struct TileFootprint
+    {
+        std::vector<size_t> object_indices;     // Sorted top-level objects hit by any primary or secondary ray
+        gfx::BoundingBox ray_bounds;            // Encloses every primary, secondary and shadow ray of the tile
+        gfx::FootprintGrid ray_grid;            // The cells those rays pass through around the objects with finite
+                                                // bounds of the scene the tile was rendered from
+    };
+
+    // Holds a completed render alongside everything needed to update it after an edit of its scene
+    struct IncrementalRenderState
+    {
+        std::string scene_data;                         // The JSON text of the scene the render shows
+        rt::SamplingSettings sampling_settings;
+        rt::PixelRect region;                           // The region of the viewport being rendered
+        size_t tile_size;
+        rt::RenderResult render_result;
+        std::vector<TileFootprint> tile_footprints;     // One for each of the region's tiles, in row-major order
+    };
+
+    // Holds the result of an incremental render alongside how much of it was rendered again
+    struct IncrementalRenderResult
+    {
+        rt::RenderResult render_result;
+        size_t tile_count;
+        size_t rendered_tile_count;         // Tiles which were rendered instead of reused from the previous render
+    };
+
+    /* Incremental Render State Functions */
+
+    // Returns the encoded contents of an incremental render state file
+    [[nodiscard]] std::vector<std::byte> encodeIncrementalRenderState(const IncrementalRenderState& state);
+
+    // Returns the state stored in the contents of an incremental render state file, throwing if they are malformed
+    [[nodiscard]] IncrementalRenderState decodeIncrementalRenderState(std::span<const std::byte> data);
+
+    // Writes an incremental render state file, replacing any existing file atomically
+    void writeIncrementalRenderState(const IncrementalRenderState& state, const std::filesystem::path& file_path);
+
+    // Returns the state stored in a file, or nothing if the file does not exist. Throws if it is malformed.
+    [[nodiscard]] std::optional<IncrementalRenderState>
+    readIncrementalRenderState(const std::filesystem::path& file_path);
+
+    /* Incremental Rendering Functions */
+
+    // Returns which of the tiles recorded by a render may change after an edit of its scene. A tile changes if its
+    // rays hit an object whose material changed, if its rays pass through the old or new bounds of a moved object,
+    // or if it hit any object at all once the lights change. Moved objects are compared with the grid cells of each
+    // tile while both of their bounds lie within its grid, and otherwise with the bounds of all its rays. Shadow maps
+    // are rendered from every object, so any moved object changes every tile of a scene using them.
+    [[nodiscard]] std::vector<bool> findAffectedTiles(std::span<const TileFootprint> tile_footprints,
+                                                      const data::SceneEdit& scene_edit,
+                                                      const gfx::CompiledScene& previous_scene,
+                                                      const gfx::CompiledScene& scene);
+
+    // Returns the rendered image of a scene using adaptive supersampling, one tile at a time, reusing the tiles of
+    // the render saved in a state file which the difference between their scene descriptions cannot affect. The
+    // state file is then replaced with the new render. Neighbor contrast is measured within each tile, so the image
+    // matches a full incremental render of the edited scene. Every tile is rendered if the state file does not
+    // exist, or was written with different sampling settings or for a different region. Files the scene refers to,
+    // such as image textures, are not compared.
+    [[nodiscard]] rt::IncrementalRenderResult
+    renderIncrementally(const gfx::CompiledScene& scene,
+                        const rt::Camera& camera,
+                        const rt::SamplingSettings& settings,
+                        const json& scene_data,
+                        const std::filesystem::path& state_file_path,
+                        const std::optional<rt::PixelRect>& region = std::nullopt);
+}
\ No newline at end of file
@@ -0,0 +1,274 @@
+#include "gtest/gtest.h"
+#include "incremental_rendering.hpp"
+
+#include <filesystem>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include "parse.hpp"
+
+// Returns the description of a scene with a sphere on each side of a 75x40 viewport, which is split into 3x2 tiles
+static json createTestSceneData()
+{
+    return json::parse(R"({
+        "world": {
+            "light_source": { "intensity": [1, 1, 1], "position": [-10, 10, -10] },
+            "objects": [
+                { "shape": "sphere", "transform": [ { "type": "translate", "values": [-2.4, 0, 0] },
+                                                    { "type": "scale", "values": [0.6, 0.6, 0.6] } ],
+                  "material": { "color": [0.8, 1.0, 0.6], "diffuse": 0.7, "specular": 0.2 } },
+                { "shape": "sphere", "transform": [ { "type": "translate", "values": [2.4, 0, 0] },
+                                                    { "type": "scale", "values": [0.6, 0.6, 0.6] } ],
+                  "material": { "color": [0.2, 0.4, 1.0] } }
+            ]
+        },
+        "camera": {
+            "viewport_width": 75,
+            "viewport_height": 40,
+            "field_of_view": 1.0471975512,
+            "transform": { "input_base": [0, 1.5, -5], "output_base": [0, 0, 0], "up_vector": [0, 1, 0] }
+        }
+    })");
+}
+
+// Returns the path of an incremental render state file in the temporary directory, removing any file left by an
+// earlier test
+static std::filesystem::path createTestStatePath()
+{
+    const std::filesystem::path file_path{ std::filesystem::temp_directory_path() / "incremental_rendering_test.inc" };
+    std::filesystem::remove(file_path);
+    return file_path;
+}
+
+// Renders the described scene incrementally from a state file
+static rt::IncrementalRenderResult renderTestScene(const json& scene_data, const std::filesystem::path& file_path)
+{
+    const Scene scene{ data::parseSceneData(scene_data) };
+    const gfx::CompiledScene compiled_scene{ gfx::compileScene(scene.world) };
+    const rt::SamplingSettings settings{ .min_samples = 2, .max_samples = 8 };
+    return rt::renderIncrementally(compiled_scene, scene.camera, settings, scene_data, file_path);
+}
+
+// Expects two renders of the same region to have identical images and sample counts
+static void expectEqualRenders(const rt::RenderResult& result, const rt::RenderResult& expected)
+{
+    ASSERT_EQ(result.region, expected.region);
+    EXPECT_EQ(result.sample_counts, expected.sample_counts);
+    EXPECT_EQ(result.total_sample_count, expected.total_sample_count);
+    for (size_t y = 0; y < result.region.height; ++y)
+        for (size_t x = 0; x < result.region.width; ++x) {
+            EXPECT_EQ((result.image[x, y]), (expected.image[x, y]));
+        }
+}
+
+// Tests that an incremental render without a state file renders every tile, and records what each tile touched
+TEST(RayTracerIncrementalRendering, RenderWithoutState)
+{
+    const json scene_data = createTestSceneData();
+    const Scene scene{ data::parseSceneData(scene_data) };
+    const gfx::CompiledScene compiled_scene{ gfx::compileScene(scene.world) };
+    const rt::SamplingSettings settings{ .min_samples = 2, .max_samples = 8 };
+    const std::filesystem::path file_path{ createTestStatePath() };
+
+    const rt::IncrementalRenderResult result{
+        rt::renderIncrementally(compiled_scene, scene.camera, settings, scene_data, file_path) };
+
+    ASSERT_EQ(result.tile_count, 6);
+    ASSERT_EQ(result.rendered_tile_count, 6);
+    for (const rt::PixelRect& tile : rt::splitIntoTiles(scene.camera.getViewportRect(), rt::INCREMENTAL_TILE_SIZE)) {
+        const rt::RenderResult expected{ rt::renderAdaptive(compiled_scene, scene.camera, settings, tile) };
+        for (size_t y = 0; y < tile.height; ++y)
+            for (size_t x = 0; x < tile.width; ++x) {
+                EXPECT_EQ((result.render_result.image[tile.x + x, tile.y + y]), (expected.image[x, y]));
+            }
+    }
+
+    // The left sphere is only seen by the left tiles, and the right sphere only by the tiles right of the center
+    const std::optional<rt::IncrementalRenderState> state{ rt::readIncrementalRenderState(file_path) };
+    ASSERT_TRUE(state);
+    ASSERT_EQ(json::parse(state->scene_data), scene_data);
+    ASSERT_EQ(state->sampling_settings, settings);
+    ASSERT_EQ(state->tile_footprints.size(), 6);
+    for (size_t tile = 0; tile < 6; ++tile) {
+        const std::vector<size_t>& object_indices{ state->tile_footprints[tile].object_indices };
+        const std::vector<size_t> visible_object_indices{ tile % 3 == 0 ? size_t{ 0 } : size_t{ 1 } };
+        EXPECT_TRUE(object_indices.empty() || object_indices == visible_object_indices) << tile;
+    }
+    EXPECT_EQ(state->tile_footprints[0].object_indices, std::vector<size_t>{ 0 });
+    EXPECT_EQ(state->tile_footprints[2].object_indices, std::vector<size_t>{ 1 });
+    ASSERT_FALSE(std::filesystem::exists(file_path.string() + ".tmp"));
+}
+
+// Tests that edits of a scene only render the tiles they affect again, and match rendering the edited scene anew
+TEST(RayTracerIncrementalRendering, RenderEditedScene)
+{
+    const std::filesystem::path file_path{ createTestStatePath() };
+    const std::filesystem::path expected_file_path{
+        std::filesystem::temp_directory_path() / "incremental_rendering_test_expected.inc" };
+    json scene_data = createTestSceneData();
+    const rt::IncrementalRenderResult initial_result{ renderTestScene(scene_data, file_path) };
+    ASSERT_EQ(initial_result.rendered_tile_count, 6);
+
+    // Rendering the same scene again reuses every tile
+    const rt::IncrementalRenderResult unchanged_result{ renderTestScene(scene_data, file_path) };
+    ASSERT_EQ(unchanged_result.rendered_tile_count, 0);
+    expectEqualRenders(unchanged_result.render_result, initial_result.render_result);
+
+    const auto expect_edit_rendered{ [&](const size_t max_rendered_tile_count) {
+        const rt::IncrementalRenderResult result{ renderTestScene(scene_data, file_path) };
+        EXPECT_GT(result.rendered_tile_count, 0);
+        EXPECT_LE(result.rendered_tile_count, max_rendered_tile_count);
+
+        std::filesystem::remove(expected_file_path);
+        const rt::IncrementalRenderResult expected{ renderTestScene(scene_data, expected_file_path) };
+        expectEqualRenders(result.render_result, expected.render_result);
+    } };
+
+    // A new material for the left sphere only changes the tiles which saw it
+    scene_data["world"]["objects"].at(0)["material"]["color"] = json::array({ 1.0, 0.2, 0.2 });
+    expect_edit_rendered(2);
+
+    // Moving the right sphere changes the tiles whose rays pass near it
+    scene_data["world"]["objects"].at(1)["transform"].at(0)["values"] = json::array({ 2.2, 0.2, 0 });
+    expect_edit_rendered(6);
+
+    // Moving the light changes every tile which saw an object
+    scene_data["world"]["light_source"]["position"] = json::array({ 10, 10, -10 });
+    expect_edit_rendered(4);
+
+    // Moving the camera changes every tile
+    scene_data["camera"]["transform"]["input_base"] = json::array({ 0, 2, -5 });
+    expect_edit_rendered(6);
+    EXPECT_EQ(renderTestScene(scene_data, file_path).rendered_tile_count, 0);
+
+    // Rendering with different sampling settings renders every tile
+    const Scene scene{ data::parseSceneData(scene_data) };
+    const gfx::CompiledScene compiled_scene{ gfx::compileScene(scene.world) };
+    const rt::IncrementalRenderResult result{ rt::renderIncrementally(
+        compiled_scene, scene.camera, rt::SamplingSettings{ }, scene_data, file_path) };
+    EXPECT_EQ(result.rendered_tile_count, 6);
+    std::filesystem::remove(expected_file_path);
+}
+
+// Tests that moving a small object among others only renders the few tiles whose rays come near it again, even
+// though many rays of every tile leave the scene
+TEST(RayTracerIncrementalRendering, RenderMovedSmallObject)
+{
+    json scene_data = json::parse(R"({
+        "world": {
+            "light_source": { "intensity": [1, 1, 1], "position": [-10, 10, -10] },
+            "objects": [
+                { "shape": "sphere", "transform": [ { "type": "translate", "values": [-2.4, 0, 0] },
+                                                    { "type": "scale", "values": [0.6, 0.6, 0.6] } ] },
+                { "shape": "sphere", "transform": [ { "type": "translate", "values": [0, 0, 1] },
+                                                    { "type": "scale", "values": [0.6, 0.6, 0.6] } ] },
+                { "shape": "sphere", "transform": [ { "type": "translate", "values": [2.4, 0, 0] },
+                                                    { "type": "scale", "values": [0.6, 0.6, 0.6] } ] },
+                { "shape": "sphere", "transform": [ { "type": "translate", "values": [2, 1.2, -1] },
+                                                    { "type": "scale", "values": [0.15, 0.15, 0.15] } ] }
+            ]
+        },
+        "camera": {
+            "viewport_width": 192,
+            "viewport_height": 96,
+            "field_of_view": 1.0471975512,
+            "transform": { "input_base": [0, 1.5, -5], "output_base": [0, 0, 0], "up_vector": [0, 1, 0] }
+        }
+    })");
+    const std::filesystem::path file_path{ createTestStatePath() };
+    const rt::IncrementalRenderResult initial_result{ renderTestScene(scene_data, file_path) };
+    ASSERT_EQ(initial_result.tile_count, 18);
+
+    scene_data["world"]["objects"].at(3)["transform"].at(0)["values"] = json::array({ 2.1, 1.3, -1 });
+    const rt::IncrementalRenderResult result{ renderTestScene(scene_data, file_path) };
+    EXPECT_GT(result.rendered_tile_count, 0);
+    EXPECT_LT(result.rendered_tile_count, result.tile_count / 2);
+
+    const std::filesystem::path expected_file_path{
+        std::filesystem::temp_directory_path() / "incremental_rendering_test_expected.inc" };
+    std::filesystem::remove(expected_file_path);
+    const rt::IncrementalRenderResult expected{ renderTestScene(scene_data, expected_file_path) };
+    expectEqualRenders(result.render_result, expected.render_result);
+    std::filesystem::remove(expected_file_path);
+}
+
+// Tests finding the tiles an edit of a scene affects from the footprints of their rays
+TEST(RayTracerIncrementalRendering, FindAffectedTiles)
+{
+    json scene_data = createTestSceneData();
+    const gfx::CompiledScene previous_scene{ gfx::compileScene(data::parseSceneData(scene_data).world) };
+    scene_data["world"]["objects"].at(1)["transform"].at(0)["values"] = json::array({ 2.4, 5, 0 });
+    const gfx::CompiledScene scene{ gfx::compileScene(data::parseSceneData(scene_data).world) };
+
+    // The last two tiles only saw rays pass by the left sphere and leave the scene, which their grids recorded
+    constexpr double INF{ std::numeric_limits<double>::infinity() };
+    const gfx::BoundingBox infinite_bounds{ -INF, -INF, -INF, INF, INF, INF };
+    gfx::FootprintGrid scene_grid{ gfx::BoundingBox{ -3, -1, -1, 3, 6, 1 } };
+    scene_grid.addSegment(gfx::createPoint(-2.4, 0, -1), gfx::createVector(0, 0, 1), INF);
+    gfx::FootprintGrid previous_scene_grid{ gfx::BoundingBox{ -3, -1, -1, 3, 1, 1 } };
+    previous_scene_grid.addSegment(gfx::createPoint(-2.4, 0, -1), gfx::createVector(0, 0, 1), INF);
+    const std::vector<rt::TileFootprint> tile_footprints{
+        rt::TileFootprint{ { 0 }, gfx::BoundingBox{ -3, -1, -5, 0, 2, 0 } },
+        rt::TileFootprint{ { }, gfx::BoundingBox{ -1, -1, -5, 1, 2, INF } },
+        rt::TileFootprint{ { 1 }, gfx::BoundingBox{ 0, -1, -5, 3, 2, 0 } },
+        rt::TileFootprint{ { }, gfx::BoundingBox{ -1, 3, -5, 2, 6, 0 } },
+        rt::TileFootprint{ { 0, 1 }, gfx::BoundingBox{ -3, -1, -5, 3, 2, 0 } },
+        rt::TileFootprint{ { }, infinite_bounds, scene_grid },
+        rt::TileFootprint{ { }, infinite_bounds, previous_scene_grid }
+    };
+
+    data::SceneEdit scene_edit{ };
+    EXPECT_EQ(rt::findAffectedTiles(tile_footprints, scene_edit, scene, scene), std::vector<bool>(7, false));
+
+    scene_edit.material_object_indices = { 0 };
+    EXPECT_EQ(rt::findAffectedTiles(tile_footprints, scene_edit, scene, scene),
+              std::vector<bool>({ true, false, false, false, true, false, false }));
+
+    // The moved sphere leaves a box reaching from y = -0.6 to 0.6, and enters a box reaching from y = 4.4 to 5.6.
+    // The grid of the last tile does not reach the new box, so its rays are compared by their bounds instead.
+    scene_edit.material_object_indices.clear();
+    scene_edit.moved_object_indices = { 1 };
+    EXPECT_EQ(rt::findAffectedTiles(tile_footprints, scene_edit, previous_scene, scene),
+              std::vector<bool>({ false, false, true, true, true, false, true }));
+
+    scene_edit.moved_object_indices.clear();
+    scene_edit.are_lights_changed = true;
+    EXPECT_EQ(rt::findAffectedTiles(tile_footprints, scene_edit, scene, scene),
+              std::vector<bool>({ true, false, true, false, true, false, false }));
+
+    scene_edit.is_full_render_required = true;
+    EXPECT_EQ(rt::findAffectedTiles(tile_footprints, scene_edit, scene, scene), std::vector<bool>(7, true));
+}
+
+// Tests that malformed incremental render state data causes an error
+TEST(RayTracerIncrementalRendering, DecodeMalformedState)
+{
+    constexpr double INF{ std::numeric_limits<double>::infinity() };
+    const rt::PixelRect region{ 0, 0, 2, 1 };
+    gfx::FootprintGrid ray_grid{ gfx::BoundingBox{ -1, -2, -3, 1, 2, 3 } };
+    ray_grid.addSegment(gfx::createPoint(0, 0, -5), gfx::createVector(0, 0, 1), INF);
+    const rt::IncrementalRenderState state{
+        R"({"world":{}})",
+        rt::SamplingSettings{ },
+        region,
+        rt::INCREMENTAL_TILE_SIZE,
+        rt::RenderResult{ rt::Canvas{ 2, 1 }, region, std::vector<size_t>{ 1, 1 }, 2 },
+        { rt::TileFootprint{ { 3, 5 }, gfx::BoundingBox{ -1, -2, -3, 1, 2, INF }, ray_grid } } };
+    std::vector<std::byte> data{ rt::encodeIncrementalRenderState(state) };
+
+    const rt::IncrementalRenderState decoded_state{ rt::decodeIncrementalRenderState(data) };
+    ASSERT_EQ(decoded_state.scene_data, state.scene_data);
+    ASSERT_EQ(decoded_state.region, region);
+    ASSERT_EQ(decoded_state.render_result.total_sample_count, 2);
+    ASSERT_EQ(decoded_state.tile_footprints.size(), 1);
+    ASSERT_EQ(decoded_state.tile_footprints[0].object_indices, std::vector<size_t>({ 3, 5 }));
+    ASSERT_EQ(decoded_state.tile_footprints[0].ray_bounds, state.tile_footprints[0].ray_bounds);
+    ASSERT_EQ(decoded_state.tile_footprints[0].ray_grid, ray_grid);
+
+    data.pop_back();
+    EXPECT_THROW(static_cast<void>(rt::decodeIncrementalRenderState(data)), std::invalid_argument);
+    data[8] = std::byte{ 'X' };
+    EXPECT_THROW(static_cast<void>(rt::decodeIncrementalRenderState(data)), std::invalid_argument);
+}
\ No newline at end of file
@@ -0,0 +1,235 @@
+#include "render_checkpoint.hpp"
+
+#include <cerrno>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "binary_encoding.hpp"
+
+namespace rt {
+    // Identifies checkpoint files and the version of their format
+    static constexpr std::string_view CHECKPOINT_FILE_SIGNATURE{ "ray_tracer checkpoint 2" };
+
+    // Throws if a saved checkpoint cannot be resumed by a render which would write the expected checkpoint
+    static void validateCheckpoint(const RenderCheckpoint& checkpoint, const RenderCheckpoint& expected_checkpoint)
+    {
+        if (checkpoint.scene_hash != expected_checkpoint.scene_hash) {
+            throw std::invalid_argument("The checkpoint was written for a different scene file");
+        }
+        if (checkpoint.sampling_settings != expected_checkpoint.sampling_settings) {
+            throw std::invalid_argument("The checkpoint was written with different sampling settings");
+        }
+        if (checkpoint.region != expected_checkpoint.region) {
+            throw std::invalid_argument("The checkpoint was written for a different region of the viewport");
+        }
+    }
+
+    // Writes data to a file and flushes it to the storage device, throwing a system error on failure
+    static void writeSyncedFile(const std::filesystem::path& file_path, const std::span<const std::byte> data)
+    {
+        const int descriptor{ open(file_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644) };
+        if (descriptor < 0) {
+            throw std::system_error(errno, std::generic_category(),
+                                    std::format("Unable to open checkpoint file '{}'", file_path.string()));
+        }
+
+        const auto closeAndThrow{ [&](const int error_number) {
+            close(descriptor);
+            throw std::system_error(error_number, std::generic_category(),
+                                    std::format("Unable to write checkpoint file '{}'", file_path.string()));
+        } };
+
+        size_t written_size{ 0 };
+        while (written_size < data.size()) {
+            const ssize_t result{ write(descriptor, data.data() + written_size, data.size() - written_size) };
+            if (result < 0 && errno != EINTR) {
+                closeAndThrow(errno);
+            }
+            if (result > 0) {
+                written_size += static_cast<size_t>(result);
+            }
+        }
+        if (fsync(descriptor) < 0) {
+            closeAndThrow(errno);
+        }
+        if (close(descriptor) < 0) {
+            throw std::system_error(errno, std::generic_category(),
+                                    std::format("Unable to write checkpoint file '{}'", file_path.string()));
+        }
+    }
+
+    std::vector<std::byte> encodeRenderCheckpoint(const RenderCheckpoint& checkpoint)
+    {
+        const rt::AdaptiveRenderState& render_state{ checkpoint.render_state };
+        std::vector<std::byte> data{ };
+        appendString(data, CHECKPOINT_FILE_SIGNATURE);
+        appendUnsigned(data, checkpoint.scene_hash);
+        appendUnsigned(data, checkpoint.sampling_settings.min_samples);
+        appendUnsigned(data, checkpoint.sampling_settings.max_samples);
+        appendDouble(data, checkpoint.sampling_settings.variance_threshold);
+        appendDouble(data, checkpoint.sampling_settings.contrast_threshold);
+        appendPixelRect(data, checkpoint.region);
+        appendUnsigned(data, render_state.base_row_count);
+        appendUnsigned(data, render_state.refined_row_count);
+        appendUnsigned(data, render_state.pixel_statistics.size());
+        for (const rt::PixelSampleStatistics& statistics : render_state.pixel_statistics) {
+            appendUnsigned(data, statistics.getSampleCount());
+            appendDouble(data, statistics.getColorSum().r());
+            appendDouble(data, statistics.getColorSum().g());
+            appendDouble(data, statistics.getColorSum().b());
+            appendDouble(data, statistics.getLuminanceMean());
+            appendDouble(data, statistics.getLuminanceSquaredDeviation());
+        }
+        appendUnsigned(data, render_state.has_high_contrast.size());
+        for (const bool has_high_contrast : render_state.has_high_contrast) {
+            appendUnsigned(data, has_high_contrast ? 1 : 0, 1);
+        }
+
+        return data;
+    }
+
+    RenderCheckpoint decodeRenderCheckpoint(const std::span<const std::byte> data)
+    {
+        rt::BinaryReader reader{ data };
+        if (reader.readString() != CHECKPOINT_FILE_SIGNATURE) {
+            throw std::invalid_argument("Data is not a render checkpoint of a supported version");
+        }
+
+        RenderCheckpoint checkpoint{ };
+        checkpoint.scene_hash = reader.readUnsigned();
+        checkpoint.sampling_settings.min_samples = reader.readUnsigned();
+        checkpoint.sampling_settings.max_samples = reader.readUnsigned();
+        checkpoint.sampling_settings.variance_threshold = reader.readDouble();
+        checkpoint.sampling_settings.contrast_threshold = reader.readDouble();
+        checkpoint.region = reader.readPixelRect();
+
+        // Each pixel takes 48 bytes and each contrast flag one byte, so check the counts against the remaining data
+        // before allocating for them
+        rt::AdaptiveRenderState& render_state{ checkpoint.render_state };
+        render_state.base_row_count = reader.readUnsigned();
+        render_state.refined_row_count = reader.readUnsigned();
+        const size_t pixel_count{ reader.readUnsigned() };
+        if (pixel_count > reader.getRemainingSize() / 48) {
+            throw std::invalid_argument("Checkpoint data is too short for its pixel count");
+        }
+        render_state.pixel_statistics.reserve(pixel_count);
+        for (size_t pixel = 0; pixel < pixel_count; ++pixel) {
+            const size_t sample_count{ reader.readUnsigned() };
+            const double red{ reader.readDouble() };
+            const double green{ reader.readDouble() };
+            const double blue{ reader.readDouble() };
+            const double luminance_mean{ reader.readDouble() };
+            const double luminance_squared_deviation{ reader.readDouble() };
+            render_state.pixel_statistics.emplace_back(
+                sample_count, gfx::Color{ red, green, blue }, luminance_mean, luminance_squared_deviation);
+        }
+        const size_t flag_count{ reader.readUnsigned() };
+        if (flag_count > reader.getRemainingSize()) {
+            throw std::invalid_argument("Checkpoint data is too short for its contrast flag count");
+        }
+        render_state.has_high_contrast.reserve(flag_count);
+        for (size_t pixel = 0; pixel < flag_count; ++pixel) {
+            render_state.has_high_contrast.push_back(reader.readUnsigned(1) != 0);
+        }
+        reader.finish();
+
+        return checkpoint;
+    }
+
+    void writeRenderCheckpoint(const RenderCheckpoint& checkpoint, const std::filesystem::path& file_path)
+    {
+        // Write the checkpoint next to its destination and sync it, then move it into place in a single step and
+        // sync the directory so the rename itself survives a crash
+        std::filesystem::path temporary_path{ file_path };
+        temporary_path += ".tmp";
+        writeSyncedFile(temporary_path, encodeRenderCheckpoint(checkpoint));
+        std::filesystem::rename(temporary_path, file_path);
+
+        const std::filesystem::path directory_path{
+            file_path.has_parent_path() ? file_path.parent_path() : std::filesystem::path{ "." } };
+        const int directory_descriptor{ open(directory_path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC) };
+        if (directory_descriptor >= 0) {
+            // Not every file system supports syncing a directory, and the checkpoint is already complete
+            static_cast<void>(fsync(directory_descriptor));
+            close(directory_descriptor);
+        }
+    }
+
+    std::optional<RenderCheckpoint> readRenderCheckpoint(const std::filesystem::path& file_path)
+    {
+        if (!std::filesystem::exists(file_path)) {
+            return std::nullopt;
+        }
+
+        std::ifstream in_file{ file_path, std::ios_base::binary };
+        if (!in_file) {
+            throw std::invalid_argument(std::format("Unable to open checkpoint file '{}'", file_path.string()));
+        }
+
+        const std::vector<char> contents{ std::istreambuf_iterator<char>{ in_file },
+                                          std::istreambuf_iterator<char>{ } };
+        return decodeRenderCheckpoint(std::as_bytes(std::span{ contents }));
+    }
+
+    rt::CheckpointedRenderResult renderWithCheckpoints(const gfx::TraceableScene& scene,
+                                                       const rt::Camera& camera,
+                                                       const rt::SamplingSettings& settings,
+                                                       const rt::CheckpointSettings& checkpoint_settings,
+                                                       const std::optional<rt::PixelRect>& region)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        const rt::PixelRect frame_region{ region.value_or(camera.getViewportRect()) };
+        if (!camera.isWithinViewport(frame_region)) {
+            throw std::invalid_argument("Region extends past the edges of the camera viewport");
+        }
+
+        // The checkpoint file is current until the render makes progress beyond it
+        RenderCheckpoint checkpoint{ checkpoint_settings.scene_hash, settings, frame_region, { } };
+        bool is_checkpoint_current{ false };
+        if (checkpoint_settings.is_resuming) {
+            std::optional<RenderCheckpoint> saved_checkpoint{ readRenderCheckpoint(checkpoint_settings.file_path) };
+            if (saved_checkpoint) {
+                validateCheckpoint(*saved_checkpoint, checkpoint);
+                checkpoint = std::move(*saved_checkpoint);
+                is_checkpoint_current = true;
+            }
+        }
+
+        size_t resumed_sample_count{ 0 };
+        for (const rt::PixelSampleStatistics& statistics : checkpoint.render_state.pixel_statistics) {
+            resumed_sample_count += statistics.getSampleCount();
+        }
+
+        // Persist the render's progress whenever the interval has passed since the last checkpoint
+        size_t checkpoint_count{ 0 };
+        Clock::time_point last_checkpoint_time{ Clock::now() };
+        const rt::AdaptiveProgressCallback on_progress{ [&](const rt::AdaptiveRenderState&) {
+            is_checkpoint_current = false;
+            if (Clock::now() - last_checkpoint_time >= checkpoint_settings.interval) {
+                writeRenderCheckpoint(checkpoint, checkpoint_settings.file_path);
+                ++checkpoint_count;
+                is_checkpoint_current = true;
+                last_checkpoint_time = Clock::now();
+            }
+        } };
+
+        rt::RenderResult render_result{
+            resumeAdaptiveRender(scene, camera, settings, checkpoint.render_state, on_progress, frame_region) };
+        if (!is_checkpoint_current) {
+            writeRenderCheckpoint(checkpoint, checkpoint_settings.file_path);
+            ++checkpoint_count;
+        }
+
+        return rt::CheckpointedRenderResult{ std::move(render_result), resumed_sample_count, checkpoint_count };
+    }
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "camera.hpp"
+#include "sampling.hpp"
+#include "rendering_functions.hpp"
+#include "traceable_scene.hpp"
+
+namespace rt {
+    // Holds the progress of a render, alongside everything which must match for a render to resume from it
+    struct RenderCheckpoint
+    {
+        uint64_t scene_hash;                            // The content hash of the scene file
+        rt::SamplingSettings sampling_settings;
+        rt::PixelRect region;                           // The region of the viewport being rendered
+        rt::AdaptiveRenderState render_state;
+    };
+
+    // Controls where and how often a render persists its progress
+    struct CheckpointSettings
+    {
+        std::filesystem::path file_path;
+        std::chrono::duration<double> interval;     // The shortest time between two checkpoints
+        uint64_t scene_hash;
+        bool is_resuming;                           // Continue from the progress saved in an existing checkpoint file
+    };
+
+    // Holds the result of a checkpointed render alongside how much of it was resumed
+    struct CheckpointedRenderResult
+    {
+        rt::RenderResult render_result;
+        size_t resumed_sample_count;        // Samples which were read from the checkpoint file instead of traced
+        size_t checkpoint_count;            // Times the checkpoint file was written
+    };
+
+    /* Checkpoint File Functions */
+
+    // Returns the encoded contents of a checkpoint file
+    [[nodiscard]] std::vector<std::byte> encodeRenderCheckpoint(const RenderCheckpoint& checkpoint);
+
+    // Returns the checkpoint stored in the contents of a checkpoint file, throwing if they are malformed
+    [[nodiscard]] RenderCheckpoint decodeRenderCheckpoint(std::span<const std::byte> data);
+
+    // Writes a checkpoint file, replacing any existing file atomically so that a render interrupted while writing
+    // its checkpoint can still resume from the previous one. The file is synced to disk before it replaces the
+    // previous one, so a power loss cannot leave a truncated checkpoint behind.
+    void writeRenderCheckpoint(const RenderCheckpoint& checkpoint, const std::filesystem::path& file_path);
+
+    // Returns the checkpoint stored in a file, or nothing if the file does not exist. Throws if it is malformed.
+    [[nodiscard]] std::optional<RenderCheckpoint> readRenderCheckpoint(const std::filesystem::path& file_path);
+
+    /* Checkpointed Rendering Functions */
+
+    // Returns the rendered image of a scene using adaptive supersampling, writing the samples traced so far to a
+    // checkpoint file whenever the checkpoint interval has passed, and once the image is complete. The checkpoint
+    // keeps the statistics of every pixel, so a resumed render loses no samples and returns the same image as an
+    // uninterrupted adaptive render. When resuming, throws if the checkpoint was written for a different scene file
+    // or with different sampling settings or region.
+    [[nodiscard]] rt::CheckpointedRenderResult
+    renderWithCheckpoints(const gfx::TraceableScene& scene,
+                          const rt::Camera& camera,
+                          const rt::SamplingSettings& settings,
+                          const rt::CheckpointSettings& checkpoint_settings,
+                          const std::optional<rt::PixelRect>& region = std::nullopt);
+}
\ No newline at end of file
@@ -0,0 +1,183 @@
+#include "gtest/gtest.h"
+#include "render_checkpoint.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "parse.hpp"
+#include "compiled_scene.hpp"
+
+// Returns a small scene with a 75x40 viewport
+static Scene createTestScene()
+{
+    return data::parseSceneData(json::parse(R"({
+        "world": {
+            "light_source": { "intensity": [1, 1, 1], "position": [-10, 10, -10] },
+            "objects": [
+                { "shape": "sphere", "material": { "color": [0.8, 1.0, 0.6], "diffuse": 0.7, "specular": 0.2 } },
+                { "shape": "plane", "transform": [ { "type": "translate", "values": [0, -1, 0] } ] }
+            ]
+        },
+        "camera": {
+            "viewport_width": 75,
+            "viewport_height": 40,
+            "field_of_view": 1.0471975512,
+            "transform": { "input_base": [0, 1.5, -5], "output_base": [0, 0, 0], "up_vector": [0, 1, 0] }
+        }
+    })"));
+}
+
+// Returns the settings of a checkpoint file in the temporary directory, removing any file left by an earlier test
+static rt::CheckpointSettings createTestCheckpointSettings(const bool is_resuming)
+{
+    const std::filesystem::path file_path{ std::filesystem::temp_directory_path() / "render_checkpoint_test.ckpt" };
+    if (!is_resuming) {
+        std::filesystem::remove(file_path);
+    }
+
+    return rt::CheckpointSettings{ file_path, std::chrono::seconds{ 0 }, 42, is_resuming };
+}
+
+// Asserts that two render results hold exactly the same pixels and sample counts
+static void expectIdenticalRenders(const rt::RenderResult& result, const rt::RenderResult& expected)
+{
+    ASSERT_EQ(result.region, expected.region);
+    ASSERT_EQ(result.sample_counts, expected.sample_counts);
+    ASSERT_EQ(result.total_sample_count, expected.total_sample_count);
+    for (size_t y = 0; y < expected.region.height; ++y)
+        for (size_t x = 0; x < expected.region.width; ++x) {
+            EXPECT_EQ((result.image[x, y].r()), (expected.image[x, y].r()));
+            EXPECT_EQ((result.image[x, y].g()), (expected.image[x, y].g()));
+            EXPECT_EQ((result.image[x, y].b()), (expected.image[x, y].b()));
+        }
+}
+
+// Tests that a checkpointed render matches an adaptive render, and checkpoints after every row when the interval is
+// zero
+TEST(RayTracerRenderCheckpoint, RenderWithCheckpoints)
+{
+    const Scene scene{ createTestScene() };
+    const gfx::CompiledScene compiled_scene{ gfx::compileScene(scene.world) };
+    const rt::SamplingSettings settings{ .min_samples = 2, .max_samples = 8 };
+    const rt::CheckpointSettings checkpoint_settings{ createTestCheckpointSettings(false) };
+
+    const rt::CheckpointedRenderResult result{
+        rt::renderWithCheckpoints(compiled_scene, scene.camera, settings, checkpoint_settings) };
+
+    // The base pass takes 20 pairs of rows and refinement takes 40 rows
+    ASSERT_EQ(result.resumed_sample_count, 0);
+    ASSERT_EQ(result.checkpoint_count, 60);
+    expectIdenticalRenders(result.render_result, rt::renderAdaptive(compiled_scene, scene.camera, settings));
+
+    const std::optional<rt::RenderCheckpoint> checkpoint{ rt::readRenderCheckpoint(checkpoint_settings.file_path) };
+    ASSERT_TRUE(checkpoint);
+    ASSERT_EQ(checkpoint->scene_hash, 42);
+    ASSERT_EQ(checkpoint->sampling_settings, settings);
+    ASSERT_EQ(checkpoint->region, scene.camera.getViewportRect());
+    ASSERT_EQ(checkpoint->render_state.base_row_count, 40);
+    ASSERT_EQ(checkpoint->render_state.refined_row_count, 40);
+    ASSERT_EQ(checkpoint->render_state.pixel_statistics.size(), 75 * 40);
+    ASSERT_EQ(checkpoint->render_state.has_high_contrast.size(), 75 * 40);
+    ASSERT_FALSE(std::filesystem::exists(checkpoint_settings.file_path.string() + ".tmp"));
+}
+
+// Tests that a render interrupted part way through its base pass or its refinement resumes without losing the
+// samples traced before the interruption, and reproduces the uninterrupted image
+TEST(RayTracerRenderCheckpoint, ResumeFromCheckpoint)
+{
+    const Scene scene{ createTestScene() };
+    const gfx::CompiledScene compiled_scene{ gfx::compileScene(scene.world) };
+    const rt::SamplingSettings settings{ .min_samples = 2, .max_samples = 8 };
+    const rt::PixelRect crop_region{ 10, 5, 60, 35 };
+    const rt::RenderResult expected{ rt::renderAdaptive(compiled_scene, scene.camera, settings, crop_region) };
+
+    struct RenderInterrupted {};
+    for (const auto& [stop_base_row_count, stop_refined_row_count] :
+         { std::pair<size_t, size_t>{ 10, 0 }, std::pair<size_t, size_t>{ 35, 17 } }) {
+        // Interrupt the render once it reaches the stopping point, and save its state as a checkpoint would
+        rt::AdaptiveRenderState state{ };
+        const rt::AdaptiveProgressCallback interrupt{ [&](const rt::AdaptiveRenderState& progress) {
+            if (progress.base_row_count == stop_base_row_count &&
+                progress.refined_row_count == stop_refined_row_count) {
+                throw RenderInterrupted{ };
+            }
+        } };
+        EXPECT_THROW(static_cast<void>(rt::resumeAdaptiveRender(
+            compiled_scene, scene.camera, settings, state, interrupt, crop_region)), RenderInterrupted);
+        ASSERT_EQ(state.base_row_count, stop_base_row_count);
+        ASSERT_EQ(state.refined_row_count, stop_refined_row_count);
+
+        rt::CheckpointSettings checkpoint_settings{ createTestCheckpointSettings(false) };
+        rt::writeRenderCheckpoint(rt::RenderCheckpoint{ 42, settings, crop_region, state },
+                                  checkpoint_settings.file_path);
+        checkpoint_settings.interval = std::chrono::hours{ 1 };
+        checkpoint_settings.is_resuming = true;
+
+        const rt::CheckpointedRenderResult result{
+            rt::renderWithCheckpoints(compiled_scene, scene.camera, settings, checkpoint_settings, crop_region) };
+
+        ASSERT_GT(result.resumed_sample_count, 0);
+        ASSERT_LT(result.resumed_sample_count, expected.total_sample_count);
+        ASSERT_EQ(result.checkpoint_count, 1);
+        expectIdenticalRenders(result.render_result, expected);
+    }
+}
+
+// Tests that a checkpoint is only resumed by a render of the same scene with the same settings and region
+TEST(RayTracerRenderCheckpoint, RejectMismatchedCheckpoint)
+{
+    const Scene scene{ createTestScene() };
+    const gfx::CompiledScene compiled_scene{ gfx::compileScene(scene.world) };
+    const rt::SamplingSettings settings{ .min_samples = 1, .max_samples = 1 };
+    static_cast<void>(rt::renderWithCheckpoints(
+        compiled_scene, scene.camera, settings, createTestCheckpointSettings(false)));
+
+    rt::CheckpointSettings checkpoint_settings{ createTestCheckpointSettings(true) };
+    const rt::SamplingSettings other_settings{ .min_samples = 2, .max_samples = 2 };
+    EXPECT_THROW(static_cast<void>(rt::renderWithCheckpoints(
+        compiled_scene, scene.camera, other_settings, checkpoint_settings)), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(rt::renderWithCheckpoints(
+        compiled_scene, scene.camera, settings, checkpoint_settings, rt::PixelRect{ 0, 0, 10, 10 })),
+        std::invalid_argument);
+
+    checkpoint_settings.scene_hash = 7;
+    EXPECT_THROW(static_cast<void>(rt::renderWithCheckpoints(
+        compiled_scene, scene.camera, settings, checkpoint_settings)), std::invalid_argument);
+
+    // Without a checkpoint file, resuming starts a new render
+    std::filesystem::remove(checkpoint_settings.file_path);
+    const rt::CheckpointedRenderResult result{
+        rt::renderWithCheckpoints(compiled_scene, scene.camera, settings, checkpoint_settings) };
+    ASSERT_EQ(result.resumed_sample_count, 0);
+}
+
+// Tests that malformed checkpoint data causes an error
+TEST(RayTracerRenderCheckpoint, DecodeMalformedCheckpoint)
+{
+    const rt::AdaptiveRenderState render_state{
+        { rt::PixelSampleStatistics{ }, rt::PixelSampleStatistics{ 3, gfx::Color{ 0.5, 1.5, 0.25 }, 0.75, 0.125 } },
+        1,
+        { },
+        0 };
+    const rt::RenderCheckpoint checkpoint{ 1, rt::SamplingSettings{ }, rt::PixelRect{ 0, 0, 2, 1 }, render_state };
+    std::vector<std::byte> data{ rt::encodeRenderCheckpoint(checkpoint) };
+
+    const rt::RenderCheckpoint decoded_checkpoint{ rt::decodeRenderCheckpoint(data) };
+    ASSERT_EQ(decoded_checkpoint.region, checkpoint.region);
+    ASSERT_EQ(decoded_checkpoint.render_state.base_row_count, 1);
+    ASSERT_EQ(decoded_checkpoint.render_state.pixel_statistics.size(), 2);
+    const rt::PixelSampleStatistics& statistics{ decoded_checkpoint.render_state.pixel_statistics[1] };
+    ASSERT_EQ(statistics.getSampleCount(), 3);
+    ASSERT_EQ(statistics.getColorSum(), (gfx::Color{ 0.5, 1.5, 0.25 }));
+    ASSERT_EQ(statistics.getLuminanceMean(), 0.75);
+    ASSERT_EQ(statistics.getLuminanceSquaredDeviation(), 0.125);
+
+    data.pop_back();
+    EXPECT_THROW(static_cast<void>(rt::decodeRenderCheckpoint(data)), std::invalid_argument);
+    data[8] = std::byte{ 'X' };
+    EXPECT_THROW(static_cast<void>(rt::decodeRenderCheckpoint(data)), std::invalid_argument);
+}
\ No newline at end of file
@@ -2,6 +2,8 @@
 #include "rendering_functions.hpp"
 
 #include <cmath>
+#include <vector>
+#include <stdexcept>
 
 #include "color.hpp"
 #include "material.hpp"
@@ -34,4 +36,272 @@ TEST(RayTracerRendering, RenderWorld)
     const gfx::Color color_center_pixel_expected{ 0.380661, 0.475827, 0.285496 };
     const gfx::Color color_center_pixel_actual{ image[5, 5] };
     EXPECT_EQ(color_center_pixel_actual, color_center_pixel_expected);
+}
+
+// Tests that adaptive rendering with a single sample per pixel matches the standard render
+TEST(RayTracerRendering, RenderAdaptiveSingleSample)
+{
+    gfx::Sphere sphere{ gfx::createScalingMatrix(0.5) };
+    const gfx::World world{ sphere };
+    const gfx::CompiledScene compiled_scene{ gfx::compileScene(world) };
+
+    const gfx::Matrix4 view_transform_matrix{
+            gfx::createViewTransformMatrix(
+                    gfx::createPoint(0, 0, -5),
+                    gfx::createPoint(0, 0, 0),
+                    gfx::createVector(0, 1, 0)) };
+    const rt::Camera camera{ 11, 9, M_PI_4, view_transform_matrix };
+
+    const rt::Canvas image_expected{ rt::render(compiled_scene, camera) };
+    const rt::RenderResult result_actual{ rt::renderAdaptive(compiled_scene, camera, rt::SamplingSettings{ }) };
+
+    ASSERT_EQ(result_actual.total_sample_count, 11 * 9);
+    for (size_t y = 0; y < camera.getViewportHeight(); ++y)
+        for (size_t x = 0; x < camera.getViewportWidth(); ++x) {
+            EXPECT_EQ(result_actual.sample_counts[y * 11 + x], 1);
+            EXPECT_EQ((result_actual.image[x, y]), (image_expected[x, y]));
+        }
+}
+
+// Tests that adaptive rendering only adds samples to pixels along the edges of objects
+TEST(RayTracerRendering, RenderAdaptiveRefinesEdges)
+{
+    gfx::Sphere sphere{ gfx::createScalingMatrix(0.5) };
+    const gfx::World world{ sphere };
+    const gfx::CompiledScene compiled_scene{ gfx::compileScene(world) };
+
+    const gfx::Matrix4 view_transform_matrix{
+            gfx::createViewTransformMatrix(
+                    gfx::createPoint(0, 0, -5),
+                    gfx::createPoint(0, 0, 0),
+                    gfx::createVector(0, 1, 0)) };
+    const rt::Camera camera{ 11, 11, M_PI_4, view_transform_matrix };
+    const rt::SamplingSettings settings{ .min_samples = 4, .max_samples = 16 };
+
+    const rt::RenderResult result{ rt::renderAdaptive(compiled_scene, camera, settings) };
+
+    // The empty corners converge after the minimum number of samples
+    EXPECT_EQ(result.sample_counts[0], 4);
+    EXPECT_EQ((result.image[0, 0]), gfx::black());
+
+    // Some pixels on the silhouette of the sphere receive extra samples, but never more than the maximum
+    size_t refined_pixel_count{ 0 };
+    size_t total_sample_count{ 0 };
+    for (const size_t sample_count : result.sample_counts) {
+        ASSERT_GE(sample_count, settings.min_samples);
+        ASSERT_LE(sample_count, settings.max_samples);
+        refined_pixel_count += sample_count > settings.min_samples;
+        total_sample_count += sample_count;
+    }
+
+    EXPECT_GT(refined_pixel_count, 0);
+    EXPECT_LT(refined_pixel_count, result.sample_counts.size());
+    EXPECT_EQ(result.total_sample_count, total_sample_count);
+}
+
+// Tests refining a progressive render over coarse-to-fine passes
+TEST(RayTracerRendering, RenderProgressive)
+{
+    gfx::Sphere sphere{ gfx::createScalingMatrix(0.5) };
+    const gfx::World world{ sphere };
+    const gfx::CompiledScene compiled_scene{ gfx::compileScene(world) };
+
+    const gfx::Matrix4 view_transform_matrix{
+            gfx::createViewTransformMatrix(
+                    gfx::createPoint(0, 0, -5),
+                    gfx::createPoint(0, 0, 0),
+                    gfx::createVector(0, 1, 0)) };
+    const rt::Camera camera{ 11, 9, M_PI_4, view_transform_matrix };
+    const rt::Canvas image_expected{ rt::render(compiled_scene, camera) };
+
+    // With one sample per pixel, only the three grid passes run
+    std::vector<size_t> pass_strides{ };
+    std::vector<size_t> pass_sample_counts{ };
+    const rt::RenderResult result{
+        rt::renderProgressive(compiled_scene, camera, rt::SamplingSettings{ }, [&](const rt::ProgressivePass& pass) {
+            ASSERT_EQ(pass.pass_number, pass_strides.size() + 1);
+            pass_strides.push_back(pass.pixel_stride);
+            pass_sample_counts.push_back(pass.total_sample_count);
+
+            // Untraced pixels of the coarsest pass take the color of the traced pixel at the corner of their cell
+            if (pass.pixel_stride == 4) {
+                EXPECT_EQ((pass.preview[3, 3]), (image_expected[0, 0]));
+                EXPECT_EQ((pass.preview[6, 5]), (image_expected[4, 4]));
+                EXPECT_EQ((pass.preview[10, 8]), (image_expected[8, 8]));
+            }
+        })
+    };
+
+    ASSERT_EQ(pass_strides, std::vector<size_t>({ 4, 2, 1 }));
+    ASSERT_EQ(pass_sample_counts, std::vector<size_t>({ 3 * 3, 6 * 5, 11 * 9 }));
+    ASSERT_EQ(result.total_sample_count, 11 * 9);
+    for (size_t y = 0; y < camera.getViewportHeight(); ++y)
+        for (size_t x = 0; x < camera.getViewportWidth(); ++x) {
+            EXPECT_EQ((result.image[x, y]), (image_expected[x, y]));
+        }
+
+    // With supersampling enabled, extra passes follow until every pixel has converged
+    const rt::SamplingSettings settings{ .min_samples = 4, .max_samples = 16 };
+    size_t pass_count{ 0 };
+    const rt::RenderResult result_supersampled{
+        rt::renderProgressive(compiled_scene, camera, settings, [&](const rt::ProgressivePass& pass) {
+            ++pass_count;
+            if (pass.pass_number > rt::PROGRESSIVE_GRID_STRIDES.size()) {
+                EXPECT_EQ(pass.pixel_stride, 1);
+            }
+        })
+    };
+
+    EXPECT_GT(pass_count, rt::PROGRESSIVE_GRID_STRIDES.size());
+    for (const size_t sample_count : result_supersampled.sample_counts) {
+        ASSERT_GE(sample_count, settings.min_samples);
+        ASSERT_LE(sample_count, settings.max_samples);
+    }
+}
+
+// Tests rendering within a time budget
+TEST(RayTracerRendering, RenderWithTimeBudget)
+{
+    gfx::Sphere sphere{ gfx::createScalingMatrix(0.5) };
+    const gfx::World world{ sphere };
+    const gfx::CompiledScene compiled_scene{ gfx::compileScene(world) };
+
+    const gfx::Matrix4 view_transform_matrix{
+            gfx::createViewTransformMatrix(
+                    gfx::createPoint(0, 0, -5),
+                    gfx::createPoint(0, 0, 0),
+                    gfx::createVector(0, 1, 0)) };
+    const rt::Camera camera{ 40, 20, M_PI_4, view_transform_matrix };
+    const rt::Canvas image_expected{ rt::render(compiled_scene, camera) };
+    const rt::SamplingSettings settings{ .min_samples = 1, .max_samples = 8 };
+
+    // Without any time left after the base image, no tile is refined but the image is still complete. Tiles which only
+    // show the background have already converged.
+    const rt::BudgetedRenderResult result_no_budget{
+        rt::renderWithTimeBudget(compiled_scene, camera, settings, std::chrono::duration<double>{ 0.0 }) };
+    const rt::RenderQualityReport& quality_no_budget{ result_no_budget.quality_report };
+
+    EXPECT_EQ(quality_no_budget.tile_count, 3 * 2);
+    EXPECT_EQ(quality_no_budget.refined_tile_count, 0);
+    EXPECT_GT(quality_no_budget.completed_tile_count, 0);
+    EXPECT_LT(quality_no_budget.completed_tile_count, 3 * 2);
+    EXPECT_TRUE(quality_no_budget.is_budget_exhausted);
+    EXPECT_EQ(result_no_budget.render_result.total_sample_count, 40 * 20);
+    for (size_t y = 0; y < camera.getViewportHeight(); ++y)
+        for (size_t x = 0; x < camera.getViewportWidth(); ++x) {
+            EXPECT_EQ((result_no_budget.render_result.image[x, y]), (image_expected[x, y]));
+        }
+
+    // With an ample budget, every pixel is refined until it converges, as in an adaptive render
+    const rt::BudgetedRenderResult result_ample_budget{
+        rt::renderWithTimeBudget(compiled_scene, camera, settings, std::chrono::duration<double>{ 60.0 }) };
+    const rt::RenderQualityReport& quality_ample_budget{ result_ample_budget.quality_report };
+    const rt::RenderResult result_adaptive{ rt::renderAdaptive(compiled_scene, camera, settings) };
+
+    EXPECT_EQ(quality_ample_budget.completed_tile_count, 3 * 2);
+    EXPECT_FALSE(quality_ample_budget.is_budget_exhausted);
+    EXPECT_EQ(result_ample_budget.render_result.sample_counts, result_adaptive.sample_counts);
+    EXPECT_EQ(result_ample_budget.render_result.total_sample_count, result_adaptive.total_sample_count);
+    EXPECT_LT(result_ample_budget.render_result.total_sample_count, 40 * 20 * 8);
+    EXPECT_GE(quality_ample_budget.total_time, quality_ample_budget.base_image_time);
+
+    // Converged tiles are never refined, so the tiles away from the edge of the sphere are left alone
+    EXPECT_GT(quality_ample_budget.refined_tile_count, 0);
+    EXPECT_LT(quality_ample_budget.refined_tile_count, 3 * 2);
+}
+
+// Tests rendering a region of the viewport
+TEST(RayTracerRendering, RenderRegion)
+{
+    gfx::Sphere sphere{ gfx::createScalingMatrix(0.5) };
+    const gfx::World world{ sphere };
+    const gfx::CompiledScene compiled_scene{ gfx::compileScene(world) };
+
+    const gfx::Matrix4 view_transform_matrix{
+            gfx::createViewTransformMatrix(
+                    gfx::createPoint(0, 0, -5),
+                    gfx::createPoint(0, 0, 0),
+                    gfx::createVector(0, 1, 0)) };
+    const rt::Camera camera{ 21, 15, M_PI_4, view_transform_matrix };
+    const rt::PixelRect region{ 3, 5, 11, 7 };
+    const rt::Canvas image_expected{ rt::render(compiled_scene, camera) };
+
+    // The region matches the corresponding pixels of the full image
+    const rt::Canvas image_region{ rt::render(compiled_scene, camera, region) };
+
+    ASSERT_EQ(image_region.width(), region.width);
+    ASSERT_EQ(image_region.height(), region.height);
+    for (size_t y = 0; y < region.height; ++y)
+        for (size_t x = 0; x < region.width; ++x) {
+            EXPECT_EQ((image_region[x, y]), (image_expected[region.x + x, region.y + y]));
+        }
+
+    // Supersampled renders of a region jitter their samples the same way as the full frame
+    const rt::SamplingSettings settings{ .min_samples = 4, .max_samples = 4 };
+    const rt::RenderResult result_full{ rt::renderAdaptive(compiled_scene, camera, settings) };
+    const rt::RenderResult result_region{ rt::renderAdaptive(compiled_scene, camera, settings, region) };
+
+    ASSERT_EQ(result_region.region, region);
+    ASSERT_EQ(result_full.region, camera.getViewportRect());
+    for (size_t y = 0; y < region.height; ++y)
+        for (size_t x = 0; x < region.width; ++x) {
+            EXPECT_EQ((result_region.image[x, y]), (result_full.image[region.x + x, region.y + y]));
+        }
+
+    // Regions past the edges of the viewport are rejected
+    EXPECT_THROW({
+        const rt::Canvas image_invalid{ rt::render(compiled_scene, camera, rt::PixelRect{ 20, 0, 2, 2 }) };
+    }, std::invalid_argument);
+}
+// Tests that shading the primary hits of each tile in batches sorted by material matches the standard render
+TEST(RayTracerRendering, RenderDeferred)
+{
+    gfx::Material glass_material{ gfx::createGlassyMaterial() };
+    gfx::MaterialProperties glass_properties{ glass_material.getProperties() };
+    glass_properties.reflectivity = 0.9;
+    const gfx::Material glass{ glass_material.getTexture(), glass_properties };
+    const gfx::World world{
+        gfx::Sphere{ gfx::createTranslationMatrix(-1, 0, 0), gfx::Material{ 0.8, 0.2, 0.2 } },
+        gfx::Sphere{ gfx::createTranslationMatrix(1, 0, 0), glass },
+        gfx::Sphere{ gfx::createTranslationMatrix(0, 1.5, 1) * gfx::createScalingMatrix(0.5),
+                     gfx::Material{ 0.8, 0.2, 0.2 } }
+    };
+    const gfx::CompiledScene compiled_scene{ gfx::compileScene(world) };
+
+    const gfx::Matrix4 view_transform_matrix{
+            gfx::createViewTransformMatrix(
+                    gfx::createPoint(0, 0, -5),
+                    gfx::createPoint(0, 0, 0),
+                    gfx::createVector(0, 1, 0)) };
+    const rt::Camera camera{ 37, 23, M_PI_2, view_transform_matrix };
+    const rt::Canvas image_expected{ rt::render(compiled_scene, camera) };
+
+    // Tiles clipped at the right and bottom edges are shaded the same way as full ones
+    const rt::RenderResult result_actual{ rt::renderDeferred(compiled_scene, camera) };
+
+    ASSERT_EQ(result_actual.region, camera.getViewportRect());
+    ASSERT_EQ(result_actual.total_sample_count, 37 * 23);
+    for (size_t y = 0; y < camera.getViewportHeight(); ++y)
+        for (size_t x = 0; x < camera.getViewportWidth(); ++x) {
+            EXPECT_EQ(result_actual.sample_counts[y * 37 + x], 1);
+            EXPECT_EQ((result_actual.image[x, y]), (image_expected[x, y]));
+        }
+
+    // Regions match the corresponding pixels of the full image
+    const rt::PixelRect region{ 5, 3, 20, 17 };
+    const rt::RenderResult result_region{ rt::renderDeferred(compiled_scene, camera, region) };
+
+    ASSERT_EQ(result_region.region, region);
+    for (size_t y = 0; y < region.height; ++y)
+        for (size_t x = 0; x < region.width; ++x) {
+            EXPECT_EQ((result_region.image[x, y]), (image_expected[region.x + x, region.y + y]));
+        }
+
+    // Sharing the tiles between threads shades every pixel the same way
+    const rt::RenderResult result_threaded{ rt::renderDeferred(compiled_scene, camera, std::nullopt, 4) };
+
+    for (size_t y = 0; y < camera.getViewportHeight(); ++y)
+        for (size_t x = 0; x < camera.getViewportWidth(); ++x) {
+            EXPECT_EQ((result_threaded.image[x, y]), (image_expected[x, y]));
+        }
 }
\ No newline at end of file
@@ -1,16 +1,661 @@
 #include "rendering_functions.hpp"
 
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <algorithm>
+#include <exception>
+#include <iterator>
+#include <mutex>
+#include <stdexcept>
+#include <optional>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+#include "ray_packet.hpp"
+#include "camera_ray_generator.hpp"
+#include "intersection.hpp"
+#include "material.hpp"
+#include "util_functions.hpp"
+
 namespace rt {
-    rt::Canvas render(const gfx::World& world, const rt::Camera& camera)
+    // Traces a batch of stratified samples through a single pixel as one packet, adding them to the pixel's statistics
+    static void tracePixelSamples(const gfx::TraceableScene& scene,
+                                  const rt::CameraRayGenerator& ray_generator,
+                                  const size_t pixel_x,
+                                  const size_t pixel_y,
+                                  const size_t batch_size,
+                                  rt::PixelSampleStatistics& statistics)
+    {
+        // Jitter the samples based on their position within the full viewport, so that rendering a region produces
+        // the same samples as rendering the entire frame
+        const rt::PixelRect& region{ ray_generator.getRegion() };
+        const size_t first_sample{ statistics.getSampleCount() };
+        gfx::RayPacket packet{ };
+        for (size_t lane = 0; lane < batch_size; ++lane) {
+            const auto [offset_x, offset_y]{ calculateStratifiedSampleOffset(region.x + pixel_x,
+                                                                             region.y + pixel_y,
+                                                                             first_sample,
+                                                                             lane,
+                                                                             batch_size) };
+            packet.setRayAt(lane, ray_generator.generateRay(pixel_x, pixel_y, offset_x, offset_y));
+        }
+
+        const std::array<gfx::Color, gfx::RAY_PACKET_SIZE> sample_colors{ scene.calculatePixelColors(packet) };
+        for (size_t lane = 0; lane < batch_size; ++lane) {
+            statistics.addSample(sample_colors[lane]);
+        }
+    }
+
+    // Returns the largest luminance difference between the current estimate of each pixel and those of its four
+    // neighbors, in row-major order
+    static std::vector<double> calculateNeighborContrast(const std::vector<rt::PixelSampleStatistics>& pixel_statistics,
+                                                         const size_t width,
+                                                         const size_t height)
+    {
+        std::vector<double> luminance(width * height);
+        for (size_t pixel = 0; pixel < pixel_statistics.size(); ++pixel) {
+            luminance[pixel] = calculateLuminance(pixel_statistics[pixel].getMeanColor());
+        }
+
+        std::vector<double> neighbor_contrast(width * height, 0.0);
+        for (size_t y = 0; y < height; ++y)
+            for (size_t x = 0; x < width; ++x) {
+                const size_t pixel{ y * width + x };
+                const auto updateContrast{ [&](const size_t neighbor) {
+                    neighbor_contrast[pixel] =
+                        std::max(neighbor_contrast[pixel], std::abs(luminance[pixel] - luminance[neighbor]));
+                } };
+
+                if (x > 0) {
+                    updateContrast(pixel - 1);
+                }
+                if (x + 1 < width) {
+                    updateContrast(pixel + 1);
+                }
+                if (y > 0) {
+                    updateContrast(pixel - width);
+                }
+                if (y + 1 < height) {
+                    updateContrast(pixel + width);
+                }
+            }
+
+        return neighbor_contrast;
+    }
+
+    // Returns a flag for each pixel (in row-major order) marking whether its current estimate differs from one of
+    // its neighbors by more than the contrast threshold
+    static std::vector<bool> findHighContrastPixels(const std::vector<rt::PixelSampleStatistics>& pixel_statistics,
+                                                    const size_t width,
+                                                    const size_t height,
+                                                    const double contrast_threshold)
+    {
+        const std::vector<double> neighbor_contrast{ calculateNeighborContrast(pixel_statistics, width, height) };
+        std::vector<bool> has_high_contrast(width * height, false);
+        for (size_t pixel = 0; pixel < neighbor_contrast.size(); ++pixel) {
+            has_high_contrast[pixel] = utils::isGreater(neighbor_contrast[pixel], contrast_threshold);
+        }
+
+        return has_high_contrast;
+    }
+
+    // Traces the minimum number of samples through every pixel of a range of rows starting at an even row, packing
+    // the same sample of each pixel in a 2x2 block into one packet
+    static void traceMinimumSamples(const gfx::TraceableScene& scene,
+                                    const rt::CameraRayGenerator& ray_generator,
+                                    const rt::SamplingSettings& settings,
+                                    const size_t first_row,
+                                    const size_t end_row,
+                                    std::vector<rt::PixelSampleStatistics>& pixel_statistics)
+    {
+        const rt::PixelRect& region{ ray_generator.getRegion() };
+        const size_t width{ region.width };
+        for (size_t y = first_row; y < end_row; y += 2)
+            for (size_t x = 0; x < width; x += 2)
+                for (size_t sample = 0; sample < settings.min_samples; ++sample) {
+                    gfx::RayPacket packet{ };
+                    if (settings.min_samples == 1) {
+                        packet = ray_generator.generateRayPacket(x, y);
+                    }
+                    else {
+                        for (size_t lane = 0; lane < gfx::RAY_PACKET_SIZE; ++lane) {
+                            const size_t lane_x{ x + lane % 2 };
+                            const size_t lane_y{ y + lane / 2 };
+                            if (lane_x < width && lane_y < end_row) {
+                                const auto [offset_x, offset_y]{ calculateStratifiedSampleOffset(region.x + lane_x,
+                                                                                                 region.y + lane_y,
+                                                                                                 0,
+                                                                                                 sample,
+                                                                                                 settings.min_samples) };
+                                packet.setRayAt(lane, ray_generator.generateRay(lane_x, lane_y, offset_x, offset_y));
+                            }
+                        }
+                    }
+
+                    const std::array<gfx::Color, gfx::RAY_PACKET_SIZE> sample_colors{
+                        scene.calculatePixelColors(packet) };
+                    for (size_t lane = 0; lane < gfx::RAY_PACKET_SIZE; ++lane) {
+                        if (packet.isLaneActive(lane)) {
+                            pixel_statistics[(y + lane / 2) * width + x + lane % 2].addSample(sample_colors[lane]);
+                        }
+                    }
+                }
+    }
+
+    // Shades the primary hits of tiles claimed from a shared counter in two phases per tile, until every tile has
+    // been claimed. The primary hits of a tile are first traced into a hit buffer, which is then sorted by material so
+    // that the hits sharing a material are shaded together.
+    static void shadeDeferredTiles(const gfx::TraceableScene& scene,
+                                   const rt::CameraRayGenerator& ray_generator,
+                                   const std::vector<rt::PixelRect>& tiles,
+                                   std::atomic<size_t>& next_tile,
+                                   rt::Canvas& image)
+    {
+        // A primary hit waiting to be shaded. Only the hit and its oriented surface normal are kept, and the rest of
+        // its shading state is rebuilt from the camera ray of its pixel when it is shaded.
+        struct DeferredHit
+        {
+            size_t material_key;
+            uint32_t pixel_x;
+            uint32_t pixel_y;
+            gfx::Intersection hit;
+            gfx::Vector4 surface_normal;
+            bool is_inside_object;
+            std::optional<size_t> intersection_list_index;  // Into the lists kept for hits on transparent surfaces
+        };
+
+        // Materials are told apart by value, as when a scene is compiled, and each surface's material is looked up
+        // only once
+        std::vector<const gfx::Material*> materials{ };
+        std::unordered_map<const gfx::Surface*, size_t> surface_material_keys{ };
+        const auto findMaterialKey{ [&](const gfx::Surface& surface) {
+            const auto [key_iter, is_new_surface]{ surface_material_keys.try_emplace(&surface, 0) };
+            if (is_new_surface) {
+                const auto material_iter{ std::ranges::find_if(materials, [&](const gfx::Material* material) {
+                    return *material == surface.getMaterial();
+                }) };
+                key_iter->second = static_cast<size_t>(std::distance(materials.begin(), material_iter));
+                if (material_iter == materials.end()) {
+                    materials.push_back(&surface.getMaterial());
+                }
+            }
+
+            return key_iter->second;
+        } };
+
+        std::vector<DeferredHit> hit_buffer{ };
+        std::vector<std::vector<gfx::Intersection>> intersection_lists{ };
+        const std::vector<gfx::Intersection> no_intersections{ };
+        for (size_t tile_index = next_tile++; tile_index < tiles.size(); tile_index = next_tile++) {
+            const rt::PixelRect& tile{ tiles[tile_index] };
+            hit_buffer.clear();
+            intersection_lists.clear();
+
+            // Phase one traces the primary hits of the tile, leaving pixels which miss every object black
+            for (size_t y = tile.y; y < tile.y + tile.height; y += 2)
+                for (size_t x = tile.x; x < tile.x + tile.width; x += 2) {
+                    const gfx::RayPacket packet{ ray_generator.generateRayPacket(x, y) };
+                    gfx::PacketIntersections packet_intersections{ scene.getAllPacketIntersections(packet) };
+                    for (size_t lane = 0; lane < gfx::RAY_PACKET_SIZE; ++lane) {
+                        const std::optional<gfx::Intersection> possible_hit{
+                            packet.isLaneActive(lane) ? gfx::getHit(packet_intersections[lane]) : std::nullopt };
+                        if (!possible_hit) {
+                            continue;
+                        }
+
+                        const gfx::Surface& hit_surface{ possible_hit->getObject() };
+                        std::optional<size_t> intersection_list_index{ };
+                        if (utils::areNotEqual(hit_surface.getMaterial().getProperties().transparency, 0.0)) {
+                            intersection_list_index = intersection_lists.size();
+                            intersection_lists.push_back(std::move(packet_intersections[lane]));
+                        }
+                        const gfx::DetailedIntersection detailed_hit{ possible_hit.value(), packet.getRayAt(lane) };
+                        hit_buffer.emplace_back(findMaterialKey(hit_surface),
+                                                static_cast<uint32_t>(x + lane % 2),
+                                                static_cast<uint32_t>(y + lane / 2),
+                                                possible_hit.value(),
+                                                detailed_hit.getSurfaceNormal(),
+                                                detailed_hit.isInsideObject(),
+                                                intersection_list_index);
+                    }
+                }
+
+            // Phase two shades the hits of each material as one batch, in pixel order within the batch
+            std::ranges::stable_sort(hit_buffer, std::less{ }, &DeferredHit::material_key);
+            for (const DeferredHit& deferred_hit : hit_buffer) {
+                const gfx::Ray ray{ ray_generator.generateRay(deferred_hit.pixel_x, deferred_hit.pixel_y) };
+                const gfx::DetailedIntersection detailed_hit{ deferred_hit.hit,
+                                                              ray.position(deferred_hit.hit.getT()),
+                                                              deferred_hit.surface_normal,
+                                                              -ray.getDirection(),
+                                                              deferred_hit.is_inside_object };
+                const std::vector<gfx::Intersection>& ray_intersections{
+                    deferred_hit.intersection_list_index ?
+                    intersection_lists[*deferred_hit.intersection_list_index] :
+                    no_intersections };
+                image[deferred_hit.pixel_x, deferred_hit.pixel_y] =
+                    scene.calculateHitColor(detailed_hit, ray_intersections);
+            }
+        }
+    }
+
+    // Returns the render result holding the average color and sample count of each pixel of a region
+    static rt::RenderResult resolveRenderResult(const std::vector<rt::PixelSampleStatistics>& pixel_statistics,
+                                                const rt::PixelRect& region)
+    {
+        const size_t width{ region.width };
+        const size_t height{ region.height };
+        rt::RenderResult result{ rt::Canvas{ width, height }, region, std::vector<size_t>(width * height), 0 };
+        for (size_t y = 0; y < height; ++y)
+            for (size_t x = 0; x < width; ++x) {
+                const rt::PixelSampleStatistics& statistics{ pixel_statistics[y * width + x] };
+                result.image[x, y] = statistics.getMeanColor();
+                result.sample_counts[y * width + x] = statistics.getSampleCount();
+                result.total_sample_count += statistics.getSampleCount();
+            }
+
+        return result;
+    }
+
+    // Throws if the sample counts of the sampling settings are invalid
+    static void validateSamplingSettings(const rt::SamplingSettings& settings)
+    {
+        if (settings.min_samples == 0 || settings.max_samples < settings.min_samples) {
+            throw std::invalid_argument("Sample counts must satisfy 1 <= minimum samples <= maximum samples");
+        }
+    }
+
+    void copyRenderRegion(const rt::RenderResult& source, rt::RenderResult& destination)
+    {
+        const rt::PixelRect& source_region{ source.region };
+        const rt::PixelRect& destination_region{ destination.region };
+        if (source_region.x < destination_region.x || source_region.y < destination_region.y ||
+            source_region.x + source_region.width > destination_region.x + destination_region.width ||
+            source_region.y + source_region.height > destination_region.y + destination_region.height) {
+            throw std::invalid_argument("Source region extends past the edges of the destination region");
+        }
+
+        const size_t offset_x{ source_region.x - destination_region.x };
+        const size_t offset_y{ source_region.y - destination_region.y };
+        for (size_t y = 0; y < source_region.height; ++y)
+            for (size_t x = 0; x < source_region.width; ++x) {
+                const size_t destination_pixel{ (offset_y + y) * destination_region.width + offset_x + x };
+                size_t& sample_count{ destination.sample_counts[destination_pixel] };
+                destination.total_sample_count -= sample_count;
+                sample_count = source.sample_counts[y * source_region.width + x];
+                destination.total_sample_count += sample_count;
+                destination.image[offset_x + x, offset_y + y] = source.image[x, y];
+            }
+    }
+
+    std::vector<rt::PixelRect> splitIntoTiles(const rt::PixelRect& region, const size_t tile_size)
     {
-        rt::Canvas image{ camera.getViewportWidth(), camera.getViewportHeight() };
+        if (tile_size == 0) {
+            throw std::invalid_argument("Tiles must be at least one pixel wide");
+        }
 
-        // Cast a ray to determine the color for each pixel in the viewport
-        for (int y = 0; y < camera.getViewportHeight(); ++y)
-            for (int x = 0; x < camera.getViewportWidth(); ++x) {
-                image[x, y] = world.calculatePixelColor(camera.castRay(x, y));
+        std::vector<rt::PixelRect> tiles{ };
+        for (size_t y = 0; y < region.height; y += tile_size)
+            for (size_t x = 0; x < region.width; x += tile_size) {
+                tiles.push_back(rt::PixelRect{ region.x + x,
+                                               region.y + y,
+                                               std::min(tile_size, region.width - x),
+                                               std::min(tile_size, region.height - y) });
+            }
+
+        return tiles;
+    }
+
+    rt::Canvas render(const gfx::TraceableScene& scene, const rt::Camera& camera)
+    {
+        return render(scene, camera, camera.getViewportRect());
+    }
+
+    rt::Canvas render(const gfx::TraceableScene& scene, const rt::Camera& camera, const rt::PixelRect& region)
+    {
+        rt::Canvas image{ region.width, region.height };
+        const rt::CameraRayGenerator ray_generator{ camera, region };
+
+        // Cast a packet of rays to determine the colors for each 2x2 block of pixels in the region
+        for (size_t y = 0; y < region.height; y += 2)
+            for (size_t x = 0; x < region.width; x += 2) {
+                const gfx::RayPacket packet{ ray_generator.generateRayPacket(x, y) };
+                const std::array<gfx::Color, gfx::RAY_PACKET_SIZE> pixel_colors{ scene.calculatePixelColors(packet) };
+                for (size_t lane = 0; lane < gfx::RAY_PACKET_SIZE; ++lane) {
+                    if (packet.isLaneActive(lane)) {
+                        image[x + lane % 2, y + lane / 2] = pixel_colors[lane];
+                    }
+                }
             }
 
         return image;
     }
+
+    rt::Canvas render(const gfx::World& world, const rt::Camera& camera)
+    {
+        return render(gfx::compileScene(world), camera);
+    }
+
+    rt::RenderResult renderDeferred(const gfx::TraceableScene& scene,
+                                    const rt::Camera& camera,
+                                    const std::optional<rt::PixelRect>& region,
+                                    const size_t thread_count)
+    {
+        const rt::PixelRect render_region{ region.value_or(camera.getViewportRect()) };
+        const size_t width{ render_region.width };
+        const size_t height{ render_region.height };
+        const rt::CameraRayGenerator ray_generator{ camera, render_region };
+        rt::RenderResult result{ rt::Canvas{ width, height }, render_region, std::vector<size_t>(width * height, 1),
+                                 width * height };
+
+        // Each thread claims the next unshaded tile until none are left, so the tiles are shared out evenly
+        const std::vector<rt::PixelRect> tiles{ splitIntoTiles(rt::PixelRect{ 0, 0, width, height },
+                                                               RENDER_TILE_SIZE) };
+        std::atomic<size_t> next_tile{ 0 };
+        std::mutex error_mutex{ };
+        std::exception_ptr first_error{ };
+        const auto shadeTiles{ [&]() {
+            try {
+                shadeDeferredTiles(scene, ray_generator, tiles, next_tile, result.image);
+            }
+            catch (...) {
+                const std::lock_guard lock{ error_mutex };
+                if (!first_error) {
+                    first_error = std::current_exception();
+                }
+            }
+        } };
+
+        {
+            std::vector<std::jthread> threads{ };
+            for (size_t thread = 1; thread < std::max<size_t>(thread_count, 1); ++thread) {
+                threads.emplace_back(shadeTiles);
+            }
+            shadeTiles();
+        }
+        if (first_error) {
+            std::rethrow_exception(first_error);
+        }
+
+        return result;
+    }
+
+    rt::RenderResult renderAdaptive(const gfx::TraceableScene& scene,
+                                    const rt::Camera& camera,
+                                    const rt::SamplingSettings& settings,
+                                    const std::optional<rt::PixelRect>& region)
+    {
+        rt::AdaptiveRenderState state{ };
+        return resumeAdaptiveRender(scene, camera, settings, state, nullptr, region);
+    }
+
+    rt::RenderResult resumeAdaptiveRender(const gfx::TraceableScene& scene,
+                                          const rt::Camera& camera,
+                                          const rt::SamplingSettings& settings,
+                                          rt::AdaptiveRenderState& state,
+                                          const rt::AdaptiveProgressCallback& on_progress,
+                                          const std::optional<rt::PixelRect>& region)
+    {
+        static_assert(REFINEMENT_BATCH_SIZE <= gfx::RAY_PACKET_SIZE);
+        validateSamplingSettings(settings);
+
+        const rt::CameraRayGenerator ray_generator{ camera, region.value_or(camera.getViewportRect()) };
+        const size_t width{ ray_generator.getRegion().width };
+        const size_t height{ ray_generator.getRegion().height };
+        if (state.pixel_statistics.empty()) {
+            state = rt::AdaptiveRenderState{ std::vector<rt::PixelSampleStatistics>(width * height), 0, { }, 0 };
+        }
+
+        // The base pass advances by pairs of rows, so only the last row of an odd height can end it on an odd row
+        const bool is_base_complete{ state.base_row_count == height };
+        if (state.pixel_statistics.size() != width * height || state.base_row_count > height ||
+            (!is_base_complete && state.base_row_count % 2 != 0) ||
+            state.has_high_contrast.size() != (is_base_complete ? width * height : 0) ||
+            state.refined_row_count > (is_base_complete ? height : 0)) {
+            throw std::invalid_argument("The render state does not match the region");
+        }
+
+        const auto reportProgress{ [&]() {
+            if (on_progress) {
+                on_progress(state);
+            }
+        } };
+
+        while (state.base_row_count < height) {
+            const size_t end_row{ std::min(state.base_row_count + 2, height) };
+            traceMinimumSamples(scene, ray_generator, settings, state.base_row_count, end_row, state.pixel_statistics);
+            state.base_row_count = end_row;
+            if (state.base_row_count == height) {
+                state.has_high_contrast =
+                    findHighContrastPixels(state.pixel_statistics, width, height, settings.contrast_threshold);
+            }
+            reportProgress();
+        }
+
+        // Keep adding batches of stratified samples to each pixel until its estimate converges
+        while (state.refined_row_count < height) {
+            const size_t y{ state.refined_row_count };
+            for (size_t x = 0; x < width; ++x) {
+                const size_t pixel{ y * width + x };
+                rt::PixelSampleStatistics& statistics{ state.pixel_statistics[pixel] };
+                while (isRefinementNeeded(statistics, state.has_high_contrast[pixel], settings)) {
+                    const size_t batch_size{
+                        std::min(REFINEMENT_BATCH_SIZE, settings.max_samples - statistics.getSampleCount()) };
+                    tracePixelSamples(scene, ray_generator, x, y, batch_size, statistics);
+                }
+            }
+
+            ++state.refined_row_count;
+            reportProgress();
+        }
+
+        return resolveRenderResult(state.pixel_statistics, ray_generator.getRegion());
+    }
+
+    rt::RenderResult renderProgressive(const gfx::TraceableScene& scene,
+                                       const rt::Camera& camera,
+                                       const rt::SamplingSettings& settings,
+                                       const rt::ProgressCallback& on_pass_complete,
+                                       const std::optional<rt::PixelRect>& region)
+    {
+        validateSamplingSettings(settings);
+
+        const rt::CameraRayGenerator ray_generator{ camera, region.value_or(camera.getViewportRect()) };
+        const size_t width{ ray_generator.getRegion().width };
+        const size_t height{ ray_generator.getRegion().height };
+        std::vector<rt::PixelSampleStatistics> pixel_statistics(width * height);
+        rt::Canvas preview{ width, height };
+        size_t pass_number{ 0 };
+        size_t total_sample_count{ 0 };
+
+        // Trace the pixel center of each cell of progressively finer grids, skipping pixels already traced by a
+        // coarser grid, and fill each cell of the preview with the color of its traced pixel
+        std::vector<std::pair<size_t, size_t>> pass_pixels{ };
+        for (const size_t pixel_stride : PROGRESSIVE_GRID_STRIDES) {
+            pass_pixels.clear();
+            for (size_t y = 0; y < height; y += pixel_stride)
+                for (size_t x = 0; x < width; x += pixel_stride) {
+                    const size_t coarser_stride{ pixel_stride * 2 };
+                    const bool is_traced{ pixel_stride != PROGRESSIVE_GRID_STRIDES.front() &&
+                                          x % coarser_stride == 0 && y % coarser_stride == 0 };
+                    if (!is_traced) {
+                        pass_pixels.emplace_back(x, y);
+                    }
+                }
+
+            for (size_t first_pixel = 0; first_pixel < pass_pixels.size(); first_pixel += gfx::RAY_PACKET_SIZE) {
+                const size_t lane_count{ std::min(gfx::RAY_PACKET_SIZE, pass_pixels.size() - first_pixel) };
+                gfx::RayPacket packet{ };
+                for (size_t lane = 0; lane < lane_count; ++lane) {
+                    const auto [x, y]{ pass_pixels[first_pixel + lane] };
+                    packet.setRayAt(lane, ray_generator.generateRay(x, y));
+                }
+
+                const std::array<gfx::Color, gfx::RAY_PACKET_SIZE> pixel_colors{ scene.calculatePixelColors(packet) };
+                for (size_t lane = 0; lane < lane_count; ++lane) {
+                    const auto [x, y]{ pass_pixels[first_pixel + lane] };
+                    pixel_statistics[y * width + x].addSample(pixel_colors[lane]);
+                    for (size_t cell_y = y; cell_y < std::min(y + pixel_stride, height); ++cell_y)
+                        for (size_t cell_x = x; cell_x < std::min(x + pixel_stride, width); ++cell_x) {
+                            preview[cell_x, cell_y] = pixel_colors[lane];
+                        }
+                }
+            }
+
+            total_sample_count += pass_pixels.size();
+            on_pass_complete(rt::ProgressivePass{ ++pass_number, pixel_stride, total_sample_count, preview });
+        }
+
+        // Add one batch of samples per pass to every pixel which is below the minimum sample count or has not yet
+        // converged, until no pixel needs more samples
+        const std::vector<bool> has_high_contrast{
+            findHighContrastPixels(pixel_statistics, width, height, settings.contrast_threshold) };
+        bool is_refined{ true };
+        while (is_refined) {
+            is_refined = false;
+            for (size_t y = 0; y < height; ++y)
+                for (size_t x = 0; x < width; ++x) {
+                    const size_t pixel{ y * width + x };
+                    rt::PixelSampleStatistics& statistics{ pixel_statistics[pixel] };
+                    const size_t sample_count{ statistics.getSampleCount() };
+                    if (sample_count >= settings.min_samples &&
+                        !isRefinementNeeded(statistics, has_high_contrast[pixel], settings)) {
+                        continue;
+                    }
+
+                    const size_t batch_size{ std::min(REFINEMENT_BATCH_SIZE, settings.max_samples - sample_count) };
+                    tracePixelSamples(scene, ray_generator, x, y, batch_size, statistics);
+                    preview[x, y] = statistics.getMeanColor();
+                    total_sample_count += batch_size;
+                    is_refined = true;
+                }
+
+            if (is_refined) {
+                on_pass_complete(rt::ProgressivePass{ ++pass_number, 1, total_sample_count, preview });
+            }
+        }
+
+        return resolveRenderResult(pixel_statistics, ray_generator.getRegion());
+    }
+
+    rt::BudgetedRenderResult renderWithTimeBudget(const gfx::TraceableScene& scene,
+                                                  const rt::Camera& camera,
+                                                  const rt::SamplingSettings& settings,
+                                                  const std::chrono::duration<double> time_budget,
+                                                  const std::optional<rt::PixelRect>& region)
+    {
+        using Clock = std::chrono::steady_clock;
+        const Clock::time_point start_time{ Clock::now() };
+        const Clock::time_point deadline{ start_time + std::chrono::duration_cast<Clock::duration>(time_budget) };
+        validateSamplingSettings(settings);
+
+        const rt::CameraRayGenerator ray_generator{ camera, region.value_or(camera.getViewportRect()) };
+        const size_t width{ ray_generator.getRegion().width };
+        const size_t height{ ray_generator.getRegion().height };
+        std::vector<rt::PixelSampleStatistics> pixel_statistics(width * height);
+        rt::RenderQualityReport quality_report{ };
+
+        // Always complete the base image, regardless of the budget
+        traceMinimumSamples(scene, ray_generator, settings, 0, height, pixel_statistics);
+        quality_report.base_image_time = Clock::now() - start_time;
+
+        // Estimate the error of a tile as the average over its pixels, using the standard error of pixels with enough
+        // samples and the contrast with their neighbors otherwise. Pixels are left alone once they converge, as in an
+        // adaptive render, so tiles without any pixel left to refine have a negative error.
+        const std::vector<double> neighbor_contrast{ calculateNeighborContrast(pixel_statistics, width, height) };
+        const std::vector<bool> has_high_contrast{
+            findHighContrastPixels(pixel_statistics, width, height, settings.contrast_threshold) };
+        const size_t tile_columns{ (width + RENDER_TILE_SIZE - 1) / RENDER_TILE_SIZE };
+        const size_t tile_rows{ (height + RENDER_TILE_SIZE - 1) / RENDER_TILE_SIZE };
+        const auto estimateTileError{ [&](const size_t tile) {
+            const size_t tile_x{ (tile % tile_columns) * RENDER_TILE_SIZE };
+            const size_t tile_y{ (tile / tile_columns) * RENDER_TILE_SIZE };
+
+            double error_sum{ 0.0 };
+            size_t pixel_count{ 0 };
+            bool is_complete{ true };
+            for (size_t y = tile_y; y < std::min(tile_y + RENDER_TILE_SIZE, height); ++y)
+                for (size_t x = tile_x; x < std::min(tile_x + RENDER_TILE_SIZE, width); ++x) {
+                    const size_t pixel{ y * width + x };
+                    const rt::PixelSampleStatistics& statistics{ pixel_statistics[pixel] };
+                    is_complete = is_complete && !isRefinementNeeded(statistics, has_high_contrast[pixel], settings);
+                    error_sum += statistics.getSampleCount() >= 2 ?
+                        statistics.getStandardError() : neighbor_contrast[pixel];
+                    ++pixel_count;
+                }
+
+            return is_complete ? -1.0 : error_sum / static_cast<double>(pixel_count);
+        } };
+
+        quality_report.tile_count = tile_columns * tile_rows;
+        std::priority_queue<std::pair<double, size_t>> tile_queue{ };
+        for (size_t tile = 0; tile < quality_report.tile_count; ++tile) {
+            const double tile_error{ estimateTileError(tile) };
+            if (tile_error >= 0.0) {
+                tile_queue.emplace(tile_error, tile);
+            }
+        }
+
+        // Refine the tile with the highest estimated error until the next refinement would overrun the deadline,
+        // predicting its duration from a moving average of the previous ones
+        std::vector<bool> is_tile_refined(quality_report.tile_count, false);
+        std::chrono::duration<double> expected_refinement_time{ 0.0 };
+        while (!tile_queue.empty()) {
+            const Clock::time_point refinement_start{ Clock::now() };
+            const Clock::duration expected_duration{
+                std::chrono::duration_cast<Clock::duration>(expected_refinement_time) };
+            if (refinement_start + expected_duration >= deadline) {
+                quality_report.is_budget_exhausted = true;
+                break;
+            }
+
+            const size_t tile{ tile_queue.top().second };
+            tile_queue.pop();
+
+            const size_t tile_x{ (tile % tile_columns) * RENDER_TILE_SIZE };
+            const size_t tile_y{ (tile / tile_columns) * RENDER_TILE_SIZE };
+            for (size_t y = tile_y; y < std::min(tile_y + RENDER_TILE_SIZE, height); ++y)
+                for (size_t x = tile_x; x < std::min(tile_x + RENDER_TILE_SIZE, width); ++x) {
+                    const size_t pixel{ y * width + x };
+                    rt::PixelSampleStatistics& statistics{ pixel_statistics[pixel] };
+                    if (isRefinementNeeded(statistics, has_high_contrast[pixel], settings)) {
+                        const size_t batch_size{
+                            std::min(REFINEMENT_BATCH_SIZE, settings.max_samples - statistics.getSampleCount()) };
+                        tracePixelSamples(scene, ray_generator, x, y, batch_size, statistics);
+                    }
+                }
+            is_tile_refined[tile] = true;
+
+            const std::chrono::duration<double> refinement_time{ Clock::now() - refinement_start };
+            expected_refinement_time = expected_refinement_time.count() == 0.0 ?
+                refinement_time : 0.75 * expected_refinement_time + 0.25 * refinement_time;
+
+            const double tile_error{ estimateTileError(tile) };
+            if (tile_error >= 0.0) {
+                tile_queue.emplace(tile_error, tile);
+            }
+        }
+
+        // Summarize the quality reached within the budget
+        quality_report.refined_tile_count = std::ranges::count(is_tile_refined, true);
+        quality_report.completed_tile_count = quality_report.tile_count - tile_queue.size();
+
+        double standard_error_sum{ 0.0 };
+        size_t estimated_pixel_count{ 0 };
+        for (const rt::PixelSampleStatistics& statistics : pixel_statistics) {
+            if (statistics.getSampleCount() >= 2) {
+                standard_error_sum += statistics.getStandardError();
+                ++estimated_pixel_count;
+            }
+        }
+        quality_report.mean_standard_error =
+            estimated_pixel_count > 0 ? standard_error_sum / static_cast<double>(estimated_pixel_count) : 0.0;
+
+        rt::RenderResult render_result{ resolveRenderResult(pixel_statistics, ray_generator.getRegion()) };
+        quality_report.total_time = Clock::now() - start_time;
+        return rt::BudgetedRenderResult{ std::move(render_result), quality_report };
+    }
 }
\ No newline at end of file
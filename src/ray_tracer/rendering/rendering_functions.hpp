@@ -1,10 +1,147 @@
 #pragma once
 
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <vector>
+#include <functional>
+#include <optional>
+
 #include "canvas.hpp"
+#include "traceable_scene.hpp"
 #include "world.hpp"
+#include "compiled_scene.hpp"
 #include "camera.hpp"
+#include "sampling.hpp"
 
 namespace rt {
-    // Returns a canvas containing the rendered image of a world from the viewpoint of the passed-in camera
+    // Holds a rendered image, the region of the camera's viewport it covers and the number of samples traced through
+    // each of its pixels, in row-major order
+    struct RenderResult
+    {
+        rt::Canvas image;
+        rt::PixelRect region;
+        std::vector<size_t> sample_counts;
+        size_t total_sample_count;
+    };
+
+    // The width and height, in pixels, of the tiles used to schedule rendering work
+    inline constexpr size_t RENDER_TILE_SIZE{ 16 };
+
+    // Describes the quality reached by a time-budgeted render
+    struct RenderQualityReport
+    {
+        std::chrono::duration<double> base_image_time;  // Time spent tracing the minimum samples of every pixel
+        std::chrono::duration<double> total_time;
+        size_t tile_count;
+        size_t refined_tile_count;          // Tiles which received at least one batch of extra samples
+        size_t completed_tile_count;        // Tiles whose pixels all converged or reached the maximum sample count
+        double mean_standard_error;         // Average estimated noise of the pixels with at least two samples
+        bool is_budget_exhausted;           // True if refinement stopped at the deadline rather than completing
+    };
+
+    // Holds the result of a time-budgeted render alongside the quality it reached
+    struct BudgetedRenderResult
+    {
+        rt::RenderResult render_result;
+        rt::RenderQualityReport quality_report;
+    };
+
+    // The pixel spacings of the grids traced by the coarse passes of progressive rendering, i.e. 1/16 density, then
+    // 1/4 density, then every pixel
+    inline constexpr std::array<size_t, 3> PROGRESSIVE_GRID_STRIDES{ 4, 2, 1 };
+
+    // Describes the state of a progressive render after one of its passes has completed
+    struct ProgressivePass
+    {
+        size_t pass_number;             // Starting from 1
+        size_t pixel_stride;            // Spacing of the traced pixel grid, which is 1 for the extra sample passes
+        size_t total_sample_count;      // Number of samples traced so far
+        const rt::Canvas& preview;      // The image refined so far, with untraced pixels filled from traced neighbors
+    };
+
+    // Invoked after each pass of a progressive render
+    using ProgressCallback = std::function<void(const ProgressivePass&)>;
+
+    // Holds the progress of an adaptive render, from which it can be resumed. The minimum samples are traced a pair
+    // of rows at a time, after which the contrast flags are fixed and the pixels are refined a row at a time.
+    struct AdaptiveRenderState
+    {
+        std::vector<rt::PixelSampleStatistics> pixel_statistics;   // In row-major order, empty before the render
+        size_t base_row_count;                  // Rows which have received their minimum samples
+        std::vector<bool> has_high_contrast;    // Empty until every row has received its minimum samples
+        size_t refined_row_count;               // Rows whose pixels have all converged or reached the maximum count
+    };
+
+    // Invoked each time an adaptive render has made progress
+    using AdaptiveProgressCallback = std::function<void(const AdaptiveRenderState&)>;
+
+    // Copies the pixels and sample counts of a render of one region into a render of a larger region containing it,
+    // throwing if the source region extends past the destination region
+    void copyRenderRegion(const rt::RenderResult& source, rt::RenderResult& destination);
+
+    // Returns the tiles covering a region in row-major order, with those on its right and bottom edges clipped to it
+    [[nodiscard]] std::vector<rt::PixelRect> splitIntoTiles(const rt::PixelRect& region, size_t tile_size);
+
+    // Returns a canvas containing the rendered image of a scene (either an authored world or a compiled scene)
+    // from the viewpoint of the passed-in camera
+    [[nodiscard]] rt::Canvas render(const gfx::TraceableScene& scene, const rt::Camera& camera);
+
+    // Returns a canvas containing only a region of the rendered image of a scene, whose pixels are identical to the
+    // corresponding pixels of the full image
+    [[nodiscard]] rt::Canvas render(const gfx::TraceableScene& scene,
+                                    const rt::Camera& camera,
+                                    const rt::PixelRect& region);
+
+    // Compiles a world into an immutable scene snapshot and returns a canvas containing its rendered image
     [[nodiscard]] rt::Canvas render(const gfx::World& world, const rt::Camera& camera);
+
+    // Returns the rendered image of a scene with one sample through the center of each pixel, identical to the
+    // standard render but shaded in two phases per tile. The primary hits of a tile are first traced into a hit
+    // buffer, which is then sorted by material so that the hits sharing a material are shaded together. Tiles are
+    // shared out between a number of threads, including the calling thread.
+    [[nodiscard]] rt::RenderResult renderDeferred(const gfx::TraceableScene& scene,
+                                                  const rt::Camera& camera,
+                                                  const std::optional<rt::PixelRect>& region = std::nullopt,
+                                                  size_t thread_count = 1);
+
+    // Returns the rendered image of a scene using adaptive supersampling, where each pixel receives between the
+    // minimum and maximum number of stratified samples set by the sampling settings. The following renderers can
+    // each be restricted to a region of the viewport, in which case neighbor contrast is only measured within it.
+    [[nodiscard]] rt::RenderResult renderAdaptive(const gfx::TraceableScene& scene,
+                                                  const rt::Camera& camera,
+                                                  const rt::SamplingSettings& settings,
+                                                  const std::optional<rt::PixelRect>& region = std::nullopt);
+
+    // Continues an adaptive render from its saved state, updating the state and invoking a callback (if one is
+    // passed) after each step, and returns the same image as an uninterrupted adaptive render. An empty state starts
+    // a new render. Throws if the state does not match the region.
+    [[nodiscard]] rt::RenderResult resumeAdaptiveRender(const gfx::TraceableScene& scene,
+                                                        const rt::Camera& camera,
+                                                        const rt::SamplingSettings& settings,
+                                                        rt::AdaptiveRenderState& state,
+                                                        const rt::AdaptiveProgressCallback& on_progress,
+                                                        const std::optional<rt::PixelRect>& region = std::nullopt);
+
+    // Returns the rendered image of a scene, refining it over a series of passes and invoking a callback after each
+    // one. The coarse passes trace one sample through the center of each pixel on progressively finer grids, so the
+    // image after the last of them matches the standard render. The following passes each add one batch of
+    // stratified samples to every pixel which needs more, as decided by the sampling settings.
+    [[nodiscard]] rt::RenderResult renderProgressive(const gfx::TraceableScene& scene,
+                                                     const rt::Camera& camera,
+                                                     const rt::SamplingSettings& settings,
+                                                     const rt::ProgressCallback& on_pass_complete,
+                                                     const std::optional<rt::PixelRect>& region = std::nullopt);
+
+    // Returns the rendered image of a scene, spending a time budget on extra samples in its noisiest tiles. The
+    // minimum samples of every pixel are always traced first, so the image is complete even if that alone exceeds
+    // the budget. Tiles are then refined one batch of samples at a time in order of their estimated error, stopping
+    // once the next batch is not expected to finish before the deadline or every pixel has converged or reached the
+    // maximum sample count. Pixels converge as in an adaptive render, so an ample budget gives the same image.
+    [[nodiscard]] rt::BudgetedRenderResult
+    renderWithTimeBudget(const gfx::TraceableScene& scene,
+                         const rt::Camera& camera,
+                         const rt::SamplingSettings& settings,
+                         std::chrono::duration<double> time_budget,
+                         const std::optional<rt::PixelRect>& region = std::nullopt);
 }
\ No newline at end of file
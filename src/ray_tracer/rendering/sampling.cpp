@@ -0,0 +1,130 @@
+#include "sampling.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "util_functions.hpp"
+
+namespace rt {
+    // Average Sample Color Accessor
+    gfx::Color PixelSampleStatistics::getMeanColor() const
+    {
+        if (m_sample_count == 0) {
+            return gfx::black();
+        }
+
+        return m_color_sum * (1.0 / static_cast<double>(m_sample_count));
+    }
+
+    // Standard Error Accessor
+    double PixelSampleStatistics::getStandardError() const
+    {
+        if (m_sample_count < 2) {
+            return 0.0;
+        }
+
+        const double sample_count{ static_cast<double>(m_sample_count) };
+        const double sample_variance{ m_luminance_squared_deviation / (sample_count - 1.0) };
+        return std::sqrt(sample_variance / sample_count);
+    }
+
+    // Sample Accumulation (Welford's Online Variance Algorithm)
+    void PixelSampleStatistics::addSample(const gfx::Color& color)
+    {
+        ++m_sample_count;
+        m_color_sum += color;
+
+        const double luminance{ calculateLuminance(color) };
+        const double delta{ luminance - m_luminance_mean };
+        m_luminance_mean += delta / static_cast<double>(m_sample_count);
+        m_luminance_squared_deviation += delta * (luminance - m_luminance_mean);
+    }
+
+    /* Sampling Utility Functions */
+
+    double calculateLuminance(const gfx::Color& color)
+    {
+        return 0.2126 * std::clamp(color.r(), 0.0, 1.0) +
+               0.7152 * std::clamp(color.g(), 0.0, 1.0) +
+               0.0722 * std::clamp(color.b(), 0.0, 1.0);
+    }
+
+    double calculateSampleJitter(const size_t pixel_x,
+                                 const size_t pixel_y,
+                                 const size_t sample_index,
+                                 const uint32_t dimension)
+    {
+        // Hash the sample's coordinates with the SplitMix64 finalizer
+        uint64_t hash{ pixel_x * 0x9E3779B97F4A7C15ull };
+        hash ^= pixel_y * 0xC2B2AE3D27D4EB4Full;
+        hash ^= sample_index * 0x165667B19E3779F9ull;
+        hash ^= static_cast<uint64_t>(dimension) * 0xD6E8FEB86659FD93ull;
+        hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ull;
+        hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBull;
+        hash ^= hash >> 31;
+
+        // Use the upper 53 bits as the mantissa of a double in [0, 1)
+        return static_cast<double>(hash >> 11) * 0x1.0p-53;
+    }
+
+    std::pair<double, double> calculateStratifiedSampleOffset(const size_t pixel_x,
+                                                              const size_t pixel_y,
+                                                              const size_t first_sample_index,
+                                                              const size_t batch_index,
+                                                              const size_t batch_size)
+    {
+        if (batch_size <= 1) {
+            return { 0.5, 0.5 };
+        }
+
+        // Split the pixel into rows of cells, shortening the last row so the cells cover the pixel whatever the batch
+        // size. A batch of two samples gets one cell in each vertical half.
+        const auto row_count{ static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(batch_size)))) };
+        const size_t column_count{ (batch_size + row_count - 1) / row_count };
+        const size_t row{ batch_index / column_count };
+        const size_t row_column_count{ row + 1 < row_count ? column_count : batch_size - row * column_count };
+        const size_t sample_index{ first_sample_index + batch_index };
+
+        const double offset_x{
+            (static_cast<double>(batch_index % column_count) +
+             calculateSampleJitter(pixel_x, pixel_y, sample_index, 0)) / static_cast<double>(row_column_count) };
+        const double offset_y{
+            (static_cast<double>(row) +
+             calculateSampleJitter(pixel_x, pixel_y, sample_index, 1)) / static_cast<double>(row_count) };
+        return { offset_x, offset_y };
+    }
+
+    bool isRefinementNeeded(const PixelSampleStatistics& statistics,
+                            const bool has_high_contrast,
+                            const SamplingSettings& settings)
+    {
+        if (statistics.getSampleCount() >= settings.max_samples) {
+            return false;
+        }
+
+        // A high contrast with the neighboring pixels always earns one batch beyond the minimum, after which the
+        // pixel's own variance estimate decides whether to keep sampling
+        if (has_high_contrast && statistics.getSampleCount() <= settings.min_samples) {
+            return true;
+        }
+
+        return utils::isGreater(statistics.getStandardError(), settings.variance_threshold);
+    }
+
+    rt::Canvas createSampleHeatmap(const std::vector<size_t>& sample_counts,
+                                   const size_t width,
+                                   const size_t height,
+                                   const SamplingSettings& settings)
+    {
+        rt::Canvas heatmap{ width, height };
+        const double sample_range{ static_cast<double>(settings.max_samples - settings.min_samples) };
+        for (size_t y = 0; y < height; ++y)
+            for (size_t x = 0; x < width; ++x) {
+                const size_t extra_samples{ sample_counts[y * width + x] - settings.min_samples };
+                const double heat{ sample_range > 0.0 ? static_cast<double>(extra_samples) / sample_range : 0.0 };
+                heatmap[x, y] = gfx::Color{ heat, 0.0, 1.0 - heat };
+            }
+
+        return heatmap;
+    }
+}
\ No newline at end of file
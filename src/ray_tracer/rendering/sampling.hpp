@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "color.hpp"
+#include "canvas.hpp"
+
+namespace rt {
+    // The number of samples added to a pixel in each refinement pass of adaptive sampling
+    inline constexpr size_t REFINEMENT_BATCH_SIZE{ 4 };
+
+    // Controls how many samples adaptive sampling traces through each pixel. Every pixel first receives the minimum
+    // sample count, then further batches are added while the pixel's estimated variance (the standard error of its
+    // mean luminance) or the luminance contrast with its neighbors exceeds a threshold, up to the maximum count.
+    struct SamplingSettings
+    {
+        size_t min_samples{ 1 };
+        size_t max_samples{ 1 };
+        double variance_threshold{ 0.01 };
+        double contrast_threshold{ 0.1 };
+
+        [[nodiscard]] bool operator==(const SamplingSettings&) const = default;
+    };
+
+    // Accumulates the samples traced through a single pixel, keeping a running estimate of the variance of their
+    // luminance
+    class PixelSampleStatistics
+    {
+    public:
+        /* Constructors */
+
+        PixelSampleStatistics() = default;
+
+        // Restores statistics saved from their accessors, e.g. by a render checkpoint
+        PixelSampleStatistics(size_t sample_count,
+                              const gfx::Color& color_sum,
+                              double luminance_mean,
+                              double luminance_squared_deviation)
+            : m_sample_count{ sample_count }, m_color_sum{ color_sum }, m_luminance_mean{ luminance_mean },
+              m_luminance_squared_deviation{ luminance_squared_deviation } {}
+
+        /* Accessors */
+
+        [[nodiscard]] size_t getSampleCount() const
+        { return m_sample_count; }
+
+        [[nodiscard]] const gfx::Color& getColorSum() const
+        { return m_color_sum; }
+
+        [[nodiscard]] double getLuminanceMean() const
+        { return m_luminance_mean; }
+
+        // Returns the sum of the squared deviations of the sample luminances from their mean
+        [[nodiscard]] double getLuminanceSquaredDeviation() const
+        { return m_luminance_squared_deviation; }
+
+        // Returns the average color of the samples
+        [[nodiscard]] gfx::Color getMeanColor() const;
+
+        // Returns the standard error of the mean sample luminance, or 0 if fewer than two samples have been added
+        [[nodiscard]] double getStandardError() const;
+
+        /* Mutators */
+
+        void addSample(const gfx::Color& color);
+
+    private:
+        /* Data Members */
+
+        size_t m_sample_count{ 0 };
+        gfx::Color m_color_sum{ 0, 0, 0 };
+        double m_luminance_mean{ 0.0 };
+        double m_luminance_squared_deviation{ 0.0 };
+    };
+
+    /* Sampling Utility Functions */
+
+    // Returns the relative luminance of a color as it would be displayed, i.e. with each channel clamped to [0, 1]
+    [[nodiscard]] double calculateLuminance(const gfx::Color& color);
+
+    // Returns a deterministic pseudo-random value in [0, 1) for one dimension of a pixel sample, so that repeated
+    // renders of the same scene produce identical images
+    [[nodiscard]] double calculateSampleJitter(size_t pixel_x, size_t pixel_y, size_t sample_index, uint32_t dimension);
+
+    // Returns the sub-pixel offset of a sample within a batch of stratified samples. The pixel is divided into rows
+    // of equal cells, one for each sample of the batch, and each sample is jittered within its own cell. A batch of
+    // one sample targets the pixel's center.
+    [[nodiscard]] std::pair<double, double> calculateStratifiedSampleOffset(size_t pixel_x,
+                                                                            size_t pixel_y,
+                                                                            size_t first_sample_index,
+                                                                            size_t batch_index,
+                                                                            size_t batch_size);
+
+    // Returns true if a pixel should receive another batch of samples, based on its sampling statistics and whether
+    // its initial estimate differed from one of its neighbors by more than the contrast threshold
+    [[nodiscard]] bool isRefinementNeeded(const PixelSampleStatistics& statistics,
+                                          bool has_high_contrast,
+                                          const SamplingSettings& settings);
+
+    // Returns a canvas visualizing the number of samples traced through each pixel, ranging from blue for the minimum
+    // sample count to red for the maximum sample count
+    [[nodiscard]] rt::Canvas createSampleHeatmap(const std::vector<size_t>& sample_counts,
+                                                 size_t width,
+                                                 size_t height,
+                                                 const SamplingSettings& settings);
+}
\ No newline at end of file
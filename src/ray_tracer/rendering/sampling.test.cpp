@@ -0,0 +1,153 @@
+#include "gtest/gtest.h"
+#include "sampling.hpp"
+
+#include <cmath>
+#include <vector>
+
+#include "color.hpp"
+#include "canvas.hpp"
+#include "util_functions.hpp"
+
+// Tests accumulating samples into the statistics of a pixel
+TEST(RayTracerSampling, PixelSampleStatistics)
+{
+    rt::PixelSampleStatistics statistics{ };
+
+    ASSERT_EQ(statistics.getSampleCount(), 0);
+    ASSERT_EQ(statistics.getMeanColor(), gfx::black());
+    ASSERT_EQ(statistics.getStandardError(), 0.0);
+
+    // A single sample has no variance estimate
+    statistics.addSample(gfx::white());
+
+    ASSERT_EQ(statistics.getSampleCount(), 1);
+    ASSERT_EQ(statistics.getMeanColor(), gfx::white());
+    ASSERT_EQ(statistics.getStandardError(), 0.0);
+
+    // Two samples with luminances of 1 and 0 have a sample variance of 0.5
+    statistics.addSample(gfx::black());
+
+    ASSERT_EQ(statistics.getSampleCount(), 2);
+    ASSERT_EQ(statistics.getMeanColor(), gfx::Color(0.5, 0.5, 0.5));
+    ASSERT_TRUE(utils::areEqual(statistics.getStandardError(), 0.5));
+}
+
+// Tests calculating the displayed luminance of a color
+TEST(RayTracerSampling, CalculateLuminance)
+{
+    ASSERT_TRUE(utils::areEqual(rt::calculateLuminance(gfx::black()), 0.0));
+    ASSERT_TRUE(utils::areEqual(rt::calculateLuminance(gfx::white()), 1.0));
+    ASSERT_TRUE(utils::areEqual(rt::calculateLuminance(gfx::green()), 0.7152));
+
+    // Channels are clamped to the displayable range
+    ASSERT_TRUE(utils::areEqual(rt::calculateLuminance(gfx::Color(4, 4, 4)), 1.0));
+    ASSERT_TRUE(utils::areEqual(rt::calculateLuminance(gfx::Color(-1, -1, -1)), 0.0));
+}
+
+// Tests that sample jitter is deterministic and within [0, 1)
+TEST(RayTracerSampling, CalculateSampleJitter)
+{
+    ASSERT_EQ(rt::calculateSampleJitter(3, 7, 2, 0), rt::calculateSampleJitter(3, 7, 2, 0));
+    ASSERT_NE(rt::calculateSampleJitter(3, 7, 2, 0), rt::calculateSampleJitter(3, 7, 2, 1));
+    ASSERT_NE(rt::calculateSampleJitter(3, 7, 2, 0), rt::calculateSampleJitter(7, 3, 2, 0));
+
+    for (size_t sample = 0; sample < 100; ++sample) {
+        const double jitter{ rt::calculateSampleJitter(1, 2, sample, 0) };
+        ASSERT_GE(jitter, 0.0);
+        ASSERT_LT(jitter, 1.0);
+    }
+}
+
+// Tests placing stratified samples within a pixel
+TEST(RayTracerSampling, CalculateStratifiedSampleOffset)
+{
+    // A single sample targets the pixel's center
+    const std::pair<double, double> center_offset{ rt::calculateStratifiedSampleOffset(5, 5, 0, 0, 1) };
+
+    ASSERT_EQ(center_offset.first, 0.5);
+    ASSERT_EQ(center_offset.second, 0.5);
+
+    // Each sample of a batch of 4 lies within its own quadrant of the pixel
+    for (size_t sample = 0; sample < 4; ++sample) {
+        const auto [offset_x, offset_y]{ rt::calculateStratifiedSampleOffset(5, 5, 8, sample, 4) };
+        const double cell_x{ static_cast<double>(sample % 2) * 0.5 };
+        const double cell_y{ static_cast<double>(sample / 2) * 0.5 };
+
+        ASSERT_GE(offset_x, cell_x);
+        ASSERT_LT(offset_x, cell_x + 0.5);
+        ASSERT_GE(offset_y, cell_y);
+        ASSERT_LT(offset_y, cell_y + 0.5);
+    }
+
+    // Batches which are not square numbers widen the cells of their last row to cover the pixel
+    const auto [offset_x, offset_y]{ rt::calculateStratifiedSampleOffset(5, 5, 0, 4, 5) };
+
+    ASSERT_GE(offset_x, 0.0);
+    ASSERT_LT(offset_x, 1.0);
+    ASSERT_GE(offset_y, 2.0 / 3.0);
+    ASSERT_LT(offset_y, 1.0);
+}
+
+// Tests that batches of two and three samples sample both vertical halves of a pixel
+TEST(RayTracerSampling, StratifiedSampleCoverage)
+{
+    for (size_t pixel_x = 0; pixel_x < 16; ++pixel_x) {
+        for (const size_t batch_size : { 2, 3 }) {
+            bool is_top_sampled{ false };
+            bool is_bottom_sampled{ false };
+            for (size_t sample = 0; sample < batch_size; ++sample) {
+                const double offset_y{ rt::calculateStratifiedSampleOffset(pixel_x, 3, 0, sample, batch_size).second };
+                is_top_sampled |= offset_y < 0.5;
+                is_bottom_sampled |= offset_y >= 0.5;
+            }
+            EXPECT_TRUE(is_top_sampled && is_bottom_sampled) << "batch of " << batch_size;
+        }
+
+        // The last sample of a batch of three is alone in its row, so it may fall anywhere across the pixel
+        const auto [offset_x, offset_y]{ rt::calculateStratifiedSampleOffset(pixel_x, 3, 0, 2, 3) };
+        EXPECT_GE(offset_y, 0.5);
+        EXPECT_GE(offset_x, 0.0);
+        EXPECT_LT(offset_x, 1.0);
+    }
+}
+
+// Tests deciding whether a pixel needs more samples
+TEST(RayTracerSampling, IsRefinementNeeded)
+{
+    const rt::SamplingSettings settings{ .min_samples = 2, .max_samples = 8, .variance_threshold = 0.01 };
+
+    // Pixels with consistent samples have converged, unless they contrast with their neighbors
+    rt::PixelSampleStatistics flat_statistics{ };
+    flat_statistics.addSample(gfx::white());
+    flat_statistics.addSample(gfx::white());
+
+    ASSERT_FALSE(rt::isRefinementNeeded(flat_statistics, false, settings));
+    ASSERT_TRUE(rt::isRefinementNeeded(flat_statistics, true, settings));
+
+    // Pixels with noisy samples keep sampling until the maximum count
+    rt::PixelSampleStatistics noisy_statistics{ };
+    for (size_t sample = 0; sample < 7; ++sample) {
+        noisy_statistics.addSample(sample % 2 == 0 ? gfx::white() : gfx::black());
+        ASSERT_EQ(rt::isRefinementNeeded(noisy_statistics, false, settings), sample >= 1);
+    }
+
+    noisy_statistics.addSample(gfx::white());
+
+    ASSERT_FALSE(rt::isRefinementNeeded(noisy_statistics, true, settings));
+}
+
+// Tests visualizing the sample counts of an image
+TEST(RayTracerSampling, CreateSampleHeatmap)
+{
+    const rt::SamplingSettings settings{ .min_samples = 4, .max_samples = 12 };
+    const std::vector<size_t> sample_counts{ 4, 8, 12, 4 };
+
+    const rt::Canvas heatmap{ rt::createSampleHeatmap(sample_counts, 2, 2, settings) };
+
+    ASSERT_EQ(heatmap.width(), 2);
+    ASSERT_EQ(heatmap.height(), 2);
+    EXPECT_EQ((heatmap[0, 0]), gfx::blue());
+    EXPECT_EQ((heatmap[1, 0]), gfx::Color(0.5, 0, 0.5));
+    EXPECT_EQ((heatmap[0, 1]), gfx::red());
+    EXPECT_EQ((heatmap[1, 1]), gfx::blue());
+}
\ No newline at end of file
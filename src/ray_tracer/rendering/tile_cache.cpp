@@ -0,0 +1,273 @@
+#include "tile_cache.hpp"
+
+#include <algorithm>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+
+#include "binary_encoding.hpp"
+
+namespace rt {
+    // Identifies tile files and the version of their format. Changes to how tiles are rendered must change the
+    // version, so that tiles rendered before them are no longer found.
+    static constexpr std::string_view TILE_FILE_SIGNATURE{ "ray_tracer tile cache 1" };
+
+    // The extension of the tile files in a cache directory
+    static constexpr std::string_view TILE_FILE_EXTENSION{ ".tile" };
+
+    // Returns the hash of a sequence of bytes
+    static uint64_t calculateByteHash(const std::span<const std::byte> data)
+    {
+        return calculateContentHash(std::string_view{ reinterpret_cast<const char*>(data.data()), data.size() });
+    }
+
+    // Appends every field of a tile's key
+    static void appendTileCacheKey(std::vector<std::byte>& data, const TileCacheKey& key)
+    {
+        appendUnsigned(data, key.scene_hash);
+        appendUnsigned(data, key.camera_hash);
+        appendPixelRect(data, key.tile);
+        appendUnsigned(data, key.sampling_settings.min_samples);
+        appendUnsigned(data, key.sampling_settings.max_samples);
+        appendDouble(data, key.sampling_settings.variance_threshold);
+        appendDouble(data, key.sampling_settings.contrast_threshold);
+    }
+
+    // Returns the name of the file storing a tile, made from the hash of its key
+    static std::string createTileFileName(const TileCacheKey& key)
+    {
+        std::vector<std::byte> key_data{ };
+        appendTileCacheKey(key_data, key);
+        return std::format("{:016x}{}", calculateByteHash(key_data), TILE_FILE_EXTENSION);
+    }
+
+    TileCache::TileCache(std::filesystem::path directory_path, const uint64_t size_limit)
+            : m_directory_path{ std::move(directory_path) }, m_size_limit{ size_limit }
+    {
+        std::error_code error{ };
+        std::filesystem::create_directories(m_directory_path, error);
+        if (!std::filesystem::is_directory(m_directory_path)) {
+            throw std::invalid_argument(std::format("Unable to create tile cache directory '{}'",
+                                                    m_directory_path.string()));
+        }
+
+        // Index the tiles already in the directory from the most to the least recently used
+        struct IndexedFile
+        {
+            CacheEntry entry;
+            std::filesystem::file_time_type last_use_time;
+        };
+        std::vector<IndexedFile> indexed_files{ };
+        for (const std::filesystem::directory_entry& file : std::filesystem::directory_iterator{ m_directory_path }) {
+            if (file.is_regular_file() && file.path().extension() == TILE_FILE_EXTENSION) {
+                indexed_files.emplace_back(CacheEntry{ file.path().filename().string(), file.file_size() },
+                                           file.last_write_time());
+            }
+        }
+        std::ranges::sort(indexed_files, std::ranges::greater{ }, &IndexedFile::last_use_time);
+        for (IndexedFile& indexed_file : indexed_files) {
+            m_total_size += indexed_file.entry.file_size;
+            m_entries.push_back(std::move(indexed_file.entry));
+            m_entry_lookup.emplace(m_entries.back().file_name, std::prev(m_entries.end()));
+        }
+        this->evictOverLimit();
+    }
+
+    // Statistics Accessor
+    TileCacheStatistics TileCache::getStatistics() const
+    {
+        return TileCacheStatistics{ m_hit_count, m_miss_count, m_eviction_count, m_entries.size(), m_total_size };
+    }
+
+    std::optional<rt::RenderResult> TileCache::findTile(const TileCacheKey& key)
+    {
+        // Other processes sharing the directory may have stored the tile, so its file is looked for even if the
+        // index does not hold it
+        const std::string file_name{ createTileFileName(key) };
+        const std::filesystem::path file_path{ m_directory_path / file_name };
+        std::ifstream in_file{ file_path, std::ios_base::binary };
+        if (!in_file) {
+            ++m_miss_count;
+            return std::nullopt;
+        }
+
+        const std::vector<char> contents{ std::istreambuf_iterator<char>{ in_file },
+                                          std::istreambuf_iterator<char>{ } };
+        in_file.close();
+        std::optional<std::pair<TileCacheKey, rt::RenderResult>> cached_tile{ };
+        try {
+            cached_tile.emplace(decodeCachedTile(std::as_bytes(std::span{ contents })));
+        }
+        catch (const std::invalid_argument&) {
+            // Tiles left incomplete by an interrupted write are discarded
+            std::error_code error{ };
+            std::filesystem::remove(file_path, error);
+        }
+        if (!cached_tile || cached_tile->first != key) {
+            ++m_miss_count;
+            return std::nullopt;
+        }
+
+        // Mark the tile as the most recently used, both in the index and for other processes
+        std::error_code error{ };
+        std::filesystem::last_write_time(file_path, std::filesystem::file_time_type::clock::now(), error);
+        const auto entry_iter{ m_entry_lookup.find(file_name) };
+        if (entry_iter != m_entry_lookup.end()) {
+            m_entries.splice(m_entries.begin(), m_entries, entry_iter->second);
+        } else {
+            m_entries.push_front(CacheEntry{ file_name, contents.size() });
+            m_entry_lookup.emplace(file_name, m_entries.begin());
+            m_total_size += contents.size();
+        }
+
+        ++m_hit_count;
+        return std::move(cached_tile->second);
+    }
+
+    void TileCache::storeTile(const TileCacheKey& key, const rt::RenderResult& tile_result)
+    {
+        // Write the tile next to its destination, then move it into place in a single step so that other processes
+        // never read a partial tile
+        const std::string file_name{ createTileFileName(key) };
+        const std::filesystem::path file_path{ m_directory_path / file_name };
+        std::filesystem::path temporary_path{ file_path };
+        temporary_path += ".tmp";
+        const std::vector<std::byte> data{ encodeCachedTile(key, tile_result) };
+        {
+            std::ofstream out_file{ temporary_path, std::ios_base::binary | std::ios_base::trunc };
+            out_file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+            if (!out_file.flush()) {
+                throw std::invalid_argument(std::format("Unable to write tile file '{}'", temporary_path.string()));
+            }
+        }
+        std::filesystem::rename(temporary_path, file_path);
+
+        const auto entry_iter{ m_entry_lookup.find(file_name) };
+        if (entry_iter != m_entry_lookup.end()) {
+            m_total_size -= entry_iter->second->file_size;
+            m_entries.erase(entry_iter->second);
+            m_entry_lookup.erase(entry_iter);
+        }
+        m_entries.push_front(CacheEntry{ file_name, data.size() });
+        m_entry_lookup.emplace(file_name, m_entries.begin());
+        m_total_size += data.size();
+
+        this->evictOverLimit();
+    }
+
+    void TileCache::evictOverLimit()
+    {
+        while (m_total_size > m_size_limit && !m_entries.empty()) {
+            this->removeEntry(std::prev(m_entries.end()));
+            ++m_eviction_count;
+        }
+    }
+
+    void TileCache::removeEntry(const std::list<CacheEntry>::iterator entry)
+    {
+        // Another process may have evicted the file already
+        std::error_code error{ };
+        std::filesystem::remove(m_directory_path / entry->file_name, error);
+        m_total_size -= entry->file_size;
+        m_entry_lookup.erase(entry->file_name);
+        m_entries.erase(entry);
+    }
+
+    uint64_t calculateSceneWorldHash(const json& scene_data)
+    {
+        return calculateContentHash(scene_data.at("world").dump());
+    }
+
+    TileCacheKey createTileCacheKey(const uint64_t scene_hash,
+                                    const rt::Camera& camera,
+                                    const rt::PixelRect& tile,
+                                    const rt::SamplingSettings& settings)
+    {
+        std::vector<std::byte> camera_data{ };
+        appendUnsigned(camera_data, camera.getViewportWidth());
+        appendUnsigned(camera_data, camera.getViewportHeight());
+        appendDouble(camera_data, camera.getFieldOfView());
+        const gfx::Matrix4& camera_transform{ camera.getTransform() };
+        for (size_t row = 0; row < 4; ++row)
+            for (size_t column = 0; column < 4; ++column) {
+                appendDouble(camera_data, camera_transform[row, column]);
+            }
+
+        return TileCacheKey{ scene_hash, calculateByteHash(camera_data), tile, settings };
+    }
+
+    std::vector<std::byte> encodeCachedTile(const TileCacheKey& key, const rt::RenderResult& tile_result)
+    {
+        std::vector<std::byte> data{ };
+        appendString(data, TILE_FILE_SIGNATURE);
+        appendTileCacheKey(data, key);
+        appendRenderResult(data, tile_result);
+
+        return data;
+    }
+
+    std::pair<TileCacheKey, rt::RenderResult> decodeCachedTile(const std::span<const std::byte> data)
+    {
+        rt::BinaryReader reader{ data };
+        if (reader.readString() != TILE_FILE_SIGNATURE) {
+            throw std::invalid_argument("Data is not a cached tile of a supported version");
+        }
+
+        TileCacheKey key{ };
+        key.scene_hash = reader.readUnsigned();
+        key.camera_hash = reader.readUnsigned();
+        key.tile = reader.readPixelRect();
+        key.sampling_settings.min_samples = reader.readUnsigned();
+        key.sampling_settings.max_samples = reader.readUnsigned();
+        key.sampling_settings.variance_threshold = reader.readDouble();
+        key.sampling_settings.contrast_threshold = reader.readDouble();
+        rt::RenderResult tile_result{ reader.readRenderResult() };
+        reader.finish();
+
+        if (tile_result.region != key.tile) {
+            throw std::invalid_argument("The cached tile does not cover the region of its key");
+        }
+
+        return { key, std::move(tile_result) };
+    }
+
+    rt::CachedRenderResult renderWithTileCache(const gfx::TraceableScene& scene,
+                                               const rt::Camera& camera,
+                                               const rt::SamplingSettings& settings,
+                                               const uint64_t scene_hash,
+                                               TileCache& tile_cache,
+                                               const std::optional<rt::PixelRect>& region)
+    {
+        const rt::PixelRect frame_region{ region.value_or(camera.getViewportRect()) };
+        if (!camera.isWithinViewport(frame_region)) {
+            throw std::invalid_argument("Region extends past the edges of the camera viewport");
+        }
+
+        const std::vector<rt::PixelRect> tiles{ splitIntoTiles(frame_region, TILE_CACHE_TILE_SIZE) };
+        rt::CachedRenderResult result{
+            rt::RenderResult{ rt::Canvas{ frame_region.width, frame_region.height },
+                              frame_region,
+                              std::vector<size_t>(frame_region.width * frame_region.height),
+                              0 },
+            tiles.size(),
+            0 };
+        for (const rt::PixelRect& tile : tiles) {
+            const TileCacheKey key{ createTileCacheKey(scene_hash, camera, tile, settings) };
+            const std::optional<rt::RenderResult> cached_tile{ tile_cache.findTile(key) };
+            if (cached_tile) {
+                copyRenderRegion(*cached_tile, result.render_result);
+                ++result.cached_tile_count;
+                continue;
+            }
+
+            const rt::RenderResult tile_result{ renderAdaptive(scene, camera, settings, tile) };
+            tile_cache.storeTile(key, tile_result);
+            copyRenderRegion(tile_result, result.render_result);
+        }
+
+        return result;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "parse.hpp"
+#include "camera.hpp"
+#include "sampling.hpp"
+#include "rendering_functions.hpp"
+#include "traceable_scene.hpp"
+
+namespace rt {
+    // The width and height, in pixels, of the tiles a cached render stores and looks up separately
+    inline constexpr size_t TILE_CACHE_TILE_SIZE{ 32 };
+
+    // The number of bytes of tiles a tile cache keeps on disk, unless set explicitly
+    inline constexpr uint64_t DEFAULT_TILE_CACHE_SIZE_LIMIT{ uint64_t{ 1 } << 30 };
+
+    // Identifies the pixels of a rendered tile by everything they depend on
+    struct TileCacheKey
+    {
+        uint64_t scene_hash;                        // Of the objects, materials and lights of the scene
+        uint64_t camera_hash;                       // Of the viewport, field of view and transform of the camera
+        rt::PixelRect tile;                         // The tile's position within the viewport
+        rt::SamplingSettings sampling_settings;
+
+        [[nodiscard]] bool operator==(const TileCacheKey&) const = default;
+    };
+
+    // Counts how often tiles were found in a tile cache, and how many were evicted to stay within its size limit
+    struct TileCacheStatistics
+    {
+        size_t hit_count;
+        size_t miss_count;
+        size_t eviction_count;
+        size_t entry_count;
+        uint64_t total_size;                        // In bytes, of every tile file in the cache directory
+    };
+
+    // Keeps the pixels of rendered tiles in a directory across runs, one file per tile named by the hash of its key,
+    // so that tiles of unchanged scenes are read instead of rendered. Files are evicted in least recently used order
+    // (by their modification times, which are refreshed whenever a tile is read) once the cache grows past its size
+    // limit. Several processes may share a directory; a tile file which cannot be read is treated as missing.
+    class TileCache
+    {
+    public:
+        /* Constructors */
+
+        TileCache() = delete;
+
+        // Opens the cache in a directory, creating it if it does not exist, and evicts the least recently used tiles
+        // while it is over its size limit. Throws if the directory cannot be created.
+        TileCache(std::filesystem::path directory_path, uint64_t size_limit);
+
+        /* Accessors */
+
+        [[nodiscard]] const std::filesystem::path& getDirectoryPath() const
+        { return m_directory_path; }
+
+        [[nodiscard]] TileCacheStatistics getStatistics() const;
+
+        /* Cache Operations */
+
+        // Returns the cached render of a tile, or nothing if the cache does not hold it
+        [[nodiscard]] std::optional<rt::RenderResult> findTile(const TileCacheKey& key);
+
+        // Stores the render of a tile, then evicts the least recently used tiles while the cache is over its size
+        // limit. Throws if the tile cannot be written.
+        void storeTile(const TileCacheKey& key, const rt::RenderResult& tile_result);
+
+    private:
+        // Holds the name and size of a tile file
+        struct CacheEntry
+        {
+            std::string file_name;
+            uint64_t file_size;
+        };
+
+        /* Helper Methods */
+
+        void removeEntry(std::list<CacheEntry>::iterator entry);
+        void evictOverLimit();
+
+        /* Data Members */
+
+        std::filesystem::path m_directory_path;
+        uint64_t m_size_limit;
+        std::list<CacheEntry> m_entries{ };     // Ordered from most to least recently used
+        std::unordered_map<std::string, std::list<CacheEntry>::iterator> m_entry_lookup{ };
+        uint64_t m_total_size{ 0 };
+        size_t m_hit_count{ 0 };
+        size_t m_miss_count{ 0 };
+        size_t m_eviction_count{ 0 };
+    };
+
+    // Holds the result of a cached render alongside how much of it was read from the cache
+    struct CachedRenderResult
+    {
+        rt::RenderResult render_result;
+        size_t tile_count;
+        size_t cached_tile_count;           // Tiles which were read from the cache instead of rendered
+    };
+
+    /* Tile Cache Functions */
+
+    // Returns the hash of the world of a JSON scene description, which is unaffected by the formatting of the JSON
+    // text and by the camera and animation of the scene
+    [[nodiscard]] uint64_t calculateSceneWorldHash(const json& scene_data);
+
+    // Returns the key of a tile rendered from a camera with the passed-in sampling settings
+    [[nodiscard]] TileCacheKey createTileCacheKey(uint64_t scene_hash,
+                                                  const rt::Camera& camera,
+                                                  const rt::PixelRect& tile,
+                                                  const rt::SamplingSettings& settings);
+
+    // Returns the encoded contents of a tile file
+    [[nodiscard]] std::vector<std::byte> encodeCachedTile(const TileCacheKey& key, const rt::RenderResult& tile_result);
+
+    // Returns the key and render stored in the contents of a tile file, throwing if they are malformed
+    [[nodiscard]] std::pair<TileCacheKey, rt::RenderResult> decodeCachedTile(std::span<const std::byte> data);
+
+    /* Cached Rendering Functions */
+
+    // Returns the rendered image of a scene using adaptive supersampling, rendering one tile at a time and reading
+    // each tile from the cache if it holds it. Rendered tiles are stored in the cache. Neighbor contrast is measured
+    // within each tile, so cached tiles match rendered ones. The scene hash must identify the world the scene was
+    // compiled from (see calculateSceneWorldHash).
+    [[nodiscard]] rt::CachedRenderResult renderWithTileCache(const gfx::TraceableScene& scene,
+                                                             const rt::Camera& camera,
+                                                             const rt::SamplingSettings& settings,
+                                                             uint64_t scene_hash,
+                                                             TileCache& tile_cache,
+                                                             const std::optional<rt::PixelRect>& region = std::nullopt);
+}
\ No newline at end of file
@@ -0,0 +1,202 @@
+#include "gtest/gtest.h"
+#include "tile_cache.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include "compiled_scene.hpp"
+
+// Returns the description of a small scene whose 75x40 viewport is split into 3x2 cached tiles
+static json createTestSceneData()
+{
+    return json::parse(R"({
+        "world": {
+            "light_source": { "intensity": [1, 1, 1], "position": [-10, 10, -10] },
+            "objects": [
+                { "shape": "sphere", "material": { "color": [0.8, 1.0, 0.6], "diffuse": 0.7, "specular": 0.2 } },
+                { "shape": "plane", "transform": [ { "type": "translate", "values": [0, -1, 0] } ] }
+            ]
+        },
+        "camera": {
+            "viewport_width": 75,
+            "viewport_height": 40,
+            "field_of_view": 1.0471975512,
+            "transform": { "input_base": [0, 1.5, -5], "output_base": [0, 0, 0], "up_vector": [0, 1, 0] }
+        }
+    })");
+}
+
+// Returns the path of an empty tile cache directory in the temporary directory
+static std::filesystem::path createTestCacheDirectory()
+{
+    const std::filesystem::path directory_path{ std::filesystem::temp_directory_path() / "tile_cache_test" };
+    std::filesystem::remove_all(directory_path);
+    return directory_path;
+}
+
+// Returns a rendered tile filled with a single color
+static rt::RenderResult createTestTile(const rt::PixelRect& tile, const double value)
+{
+    rt::RenderResult tile_result{ rt::Canvas{ tile.width, tile.height },
+                                  tile,
+                                  std::vector<size_t>(tile.width * tile.height, 1),
+                                  tile.width * tile.height };
+    for (size_t y = 0; y < tile.height; ++y)
+        for (size_t x = 0; x < tile.width; ++x) {
+            tile_result.image[x, y] = gfx::Color{ value, value, value };
+        }
+
+    return tile_result;
+}
+
+// Tests that a render reads the tiles stored by an earlier render of the same scene, and matches rendering each tile
+TEST(RayTracerTileCache, RenderWithTileCache)
+{
+    const json scene_data = createTestSceneData();
+    const Scene scene{ data::parseSceneData(scene_data) };
+    const gfx::CompiledScene compiled_scene{ gfx::compileScene(scene.world) };
+    const rt::SamplingSettings settings{ .min_samples = 2, .max_samples = 8 };
+    const uint64_t scene_hash{ rt::calculateSceneWorldHash(scene_data) };
+    const std::filesystem::path directory_path{ createTestCacheDirectory() };
+
+    rt::TileCache tile_cache{ directory_path, rt::DEFAULT_TILE_CACHE_SIZE_LIMIT };
+    const rt::CachedRenderResult result{
+        rt::renderWithTileCache(compiled_scene, scene.camera, settings, scene_hash, tile_cache) };
+
+    ASSERT_EQ(result.tile_count, 6);
+    ASSERT_EQ(result.cached_tile_count, 0);
+    ASSERT_EQ(tile_cache.getStatistics().entry_count, 6);
+    for (const rt::PixelRect& tile : rt::splitIntoTiles(scene.camera.getViewportRect(), rt::TILE_CACHE_TILE_SIZE)) {
+        const rt::RenderResult expected{ rt::renderAdaptive(compiled_scene, scene.camera, settings, tile) };
+        for (size_t y = 0; y < tile.height; ++y)
+            for (size_t x = 0; x < tile.width; ++x) {
+                EXPECT_EQ((result.render_result.image[tile.x + x, tile.y + y]), (expected.image[x, y]));
+            }
+    }
+
+    // A later run finds every tile in the directory
+    rt::TileCache reopened_tile_cache{ directory_path, rt::DEFAULT_TILE_CACHE_SIZE_LIMIT };
+    ASSERT_EQ(reopened_tile_cache.getStatistics().entry_count, 6);
+    ASSERT_EQ(reopened_tile_cache.getStatistics().total_size, tile_cache.getStatistics().total_size);
+    const rt::CachedRenderResult cached_result{
+        rt::renderWithTileCache(compiled_scene, scene.camera, settings, scene_hash, reopened_tile_cache) };
+    ASSERT_EQ(cached_result.cached_tile_count, 6);
+    ASSERT_EQ(cached_result.render_result.sample_counts, result.render_result.sample_counts);
+    ASSERT_EQ(cached_result.render_result.total_sample_count, result.render_result.total_sample_count);
+    for (size_t y = 0; y < 40; ++y)
+        for (size_t x = 0; x < 75; ++x) {
+            EXPECT_EQ((cached_result.render_result.image[x, y]), (result.render_result.image[x, y]));
+        }
+
+    // Crops share the tiles which cover the same pixels as the tiles of the full viewport
+    const rt::CachedRenderResult crop_result{ rt::renderWithTileCache(
+        compiled_scene, scene.camera, settings, scene_hash, reopened_tile_cache, rt::PixelRect{ 32, 0, 43, 40 }) };
+    ASSERT_EQ(crop_result.tile_count, 4);
+    ASSERT_EQ(crop_result.cached_tile_count, 4);
+    const rt::CachedRenderResult shifted_crop_result{ rt::renderWithTileCache(
+        compiled_scene, scene.camera, settings, scene_hash, reopened_tile_cache, rt::PixelRect{ 16, 0, 59, 40 }) };
+    ASSERT_EQ(shifted_crop_result.cached_tile_count, 0);
+
+    // Other sampling settings, cameras and scenes do not match the cached tiles
+    const rt::CachedRenderResult settings_result{ rt::renderWithTileCache(
+        compiled_scene, scene.camera, rt::SamplingSettings{ }, scene_hash, reopened_tile_cache) };
+    ASSERT_EQ(settings_result.cached_tile_count, 0);
+
+    rt::Camera moved_camera{ scene.camera };
+    moved_camera.setTransform(gfx::createTranslationMatrix(0, 0, 1) * scene.camera.getTransform());
+    const rt::CachedRenderResult camera_result{
+        rt::renderWithTileCache(compiled_scene, moved_camera, settings, scene_hash, reopened_tile_cache) };
+    ASSERT_EQ(camera_result.cached_tile_count, 0);
+
+    const rt::CachedRenderResult scene_result{
+        rt::renderWithTileCache(compiled_scene, scene.camera, settings, scene_hash + 1, reopened_tile_cache) };
+    ASSERT_EQ(scene_result.cached_tile_count, 0);
+    std::filesystem::remove_all(directory_path);
+}
+
+// Tests that the hash of a scene depends only on the contents of its world
+TEST(RayTracerTileCache, CalculateSceneWorldHash)
+{
+    const json scene_data = createTestSceneData();
+    const uint64_t scene_hash{ rt::calculateSceneWorldHash(scene_data) };
+
+    // Reformatting the JSON text or moving the camera keeps the hash
+    ASSERT_EQ(rt::calculateSceneWorldHash(json::parse(scene_data.dump(4))), scene_hash);
+    json scene_data_camera = createTestSceneData();
+    scene_data_camera["camera"]["field_of_view"] = 0.8;
+    ASSERT_EQ(rt::calculateSceneWorldHash(scene_data_camera), scene_hash);
+
+    json scene_data_world = createTestSceneData();
+    scene_data_world["world"]["objects"].at(0)["material"]["diffuse"] = 0.6;
+    ASSERT_NE(rt::calculateSceneWorldHash(scene_data_world), scene_hash);
+}
+
+// Tests that a tile cache evicts the least recently used tiles once it grows past its size limit
+TEST(RayTracerTileCache, EvictLeastRecentlyUsed)
+{
+    const std::filesystem::path directory_path{ createTestCacheDirectory() };
+    const rt::Camera camera{ 16, 16, 1.0 };
+    const rt::SamplingSettings settings{ };
+    const std::vector<rt::TileCacheKey> keys{
+        rt::createTileCacheKey(1, camera, rt::PixelRect{ 0, 0, 4, 4 }, settings),
+        rt::createTileCacheKey(1, camera, rt::PixelRect{ 4, 0, 4, 4 }, settings),
+        rt::createTileCacheKey(1, camera, rt::PixelRect{ 8, 0, 4, 4 }, settings) };
+    const size_t tile_file_size{ rt::encodeCachedTile(keys[0], createTestTile(keys[0].tile, 0)).size() };
+
+    // The cache holds two tiles, and reading the first one makes the second one the least recently used
+    rt::TileCache tile_cache{ directory_path, 2 * tile_file_size };
+    tile_cache.storeTile(keys[0], createTestTile(keys[0].tile, 0.25));
+    tile_cache.storeTile(keys[1], createTestTile(keys[1].tile, 0.5));
+    ASSERT_TRUE(tile_cache.findTile(keys[0]));
+    tile_cache.storeTile(keys[2], createTestTile(keys[2].tile, 0.75));
+
+    const rt::TileCacheStatistics statistics{ tile_cache.getStatistics() };
+    ASSERT_EQ(statistics.eviction_count, 1);
+    ASSERT_EQ(statistics.entry_count, 2);
+    ASSERT_EQ(statistics.total_size, 2 * tile_file_size);
+    ASSERT_FALSE(tile_cache.findTile(keys[1]));
+
+    const std::optional<rt::RenderResult> cached_tile{ tile_cache.findTile(keys[2]) };
+    ASSERT_TRUE(cached_tile);
+    ASSERT_EQ(cached_tile->region, keys[2].tile);
+    ASSERT_EQ((cached_tile->image[3, 3]), gfx::Color(0.75, 0.75, 0.75));
+    ASSERT_TRUE(tile_cache.findTile(keys[0]));
+    ASSERT_EQ(tile_cache.getStatistics().hit_count, 3);
+    ASSERT_EQ(tile_cache.getStatistics().miss_count, 1);
+
+    // Opening the directory with a smaller limit evicts tiles straight away
+    const rt::TileCache reopened_tile_cache{ directory_path, tile_file_size };
+    ASSERT_EQ(reopened_tile_cache.getStatistics().eviction_count, 1);
+    ASSERT_EQ(reopened_tile_cache.getStatistics().entry_count, 1);
+    std::filesystem::remove_all(directory_path);
+}
+
+// Tests that malformed tile data causes an error, and that a tile cache discards malformed tile files
+TEST(RayTracerTileCache, DecodeMalformedTile)
+{
+    const rt::TileCacheKey key{ 1, 2, rt::PixelRect{ 0, 0, 2, 2 }, rt::SamplingSettings{ } };
+    std::vector<std::byte> data{ rt::encodeCachedTile(key, createTestTile(key.tile, 0.5)) };
+
+    const auto [ decoded_key, decoded_tile ] { rt::decodeCachedTile(data) };
+    ASSERT_EQ(decoded_key, key);
+    ASSERT_EQ(decoded_tile.total_sample_count, 4);
+
+    data.pop_back();
+    EXPECT_THROW(static_cast<void>(rt::decodeCachedTile(data)), std::invalid_argument);
+    data[8] = std::byte{ 'X' };
+    EXPECT_THROW(static_cast<void>(rt::decodeCachedTile(data)), std::invalid_argument);
+
+    // Truncate a stored tile file, as an interrupted write by another process would
+    const std::filesystem::path directory_path{ createTestCacheDirectory() };
+    rt::TileCache tile_cache{ directory_path, rt::DEFAULT_TILE_CACHE_SIZE_LIMIT };
+    tile_cache.storeTile(key, createTestTile(key.tile, 0.5));
+    const std::filesystem::path file_path{ std::filesystem::directory_iterator{ directory_path }->path() };
+    std::filesystem::resize_file(file_path, 16);
+
+    ASSERT_FALSE(tile_cache.findTile(key));
+    ASSERT_FALSE(std::filesystem::exists(file_path));
+    std::filesystem::remove_all(directory_path);
+}
\ No newline at end of file
@@ -0,0 +1,234 @@
+#include "render_job_scheduler.hpp"
+
+#include <stdexcept>
+
+#include "canvas.hpp"
+
+namespace rt {
+    // Returns true if a job in the passed-in state will not change state again
+    static bool isJobFinished(const JobState state)
+    {
+        return state == JobState::Completed || state == JobState::Cancelled || state == JobState::Failed;
+    }
+
+    RenderJobScheduler::RenderJobScheduler(const size_t thread_count)
+    {
+        if (thread_count == 0) {
+            throw std::invalid_argument("A render job scheduler requires at least one thread");
+        }
+
+        for (size_t i = 0; i < thread_count; ++i) {
+            m_threads.emplace_back([this](const std::stop_token stop_token) { runWorkerThread(stop_token); });
+        }
+    }
+
+    RenderJobScheduler::~RenderJobScheduler()
+    {
+        cancelAllJobs();
+        m_threads.clear();
+    }
+
+    // Job Status Accessor
+    std::optional<RenderJobStatus> RenderJobScheduler::getJobStatus(const uint64_t job_id) const
+    {
+        const std::scoped_lock lock{ m_mutex };
+        const auto job{ m_jobs.find(job_id) };
+        if (job == m_jobs.end()) {
+            return std::nullopt;
+        }
+
+        return createJobStatus(*job->second);
+    }
+
+    uint64_t RenderJobScheduler::submitJob(RenderJobRequest request)
+    {
+        if (!request.scene || !request.camera) {
+            throw std::invalid_argument("A render job requires a scene and a camera");
+        }
+        const rt::SamplingSettings& settings{ request.sampling_settings };
+        if (settings.min_samples == 0 || settings.max_samples < settings.min_samples) {
+            throw std::invalid_argument("Sample counts must satisfy 1 <= minimum samples <= maximum samples");
+        }
+
+        const rt::Camera camera{ *request.camera };
+        const rt::PixelRect region{ request.crop_region.value_or(camera.getViewportRect()) };
+        if (!camera.isWithinViewport(region)) {
+            throw std::invalid_argument("Region extends past the edges of the camera viewport");
+        }
+
+        const int64_t priority_key{ -static_cast<int64_t>(request.priority) };
+        std::unique_ptr<Job> job{ std::make_unique<Job>(Job{
+            0,
+            std::move(request),
+            camera,
+            splitIntoTiles(region, SCHEDULED_TILE_SIZE),
+            rt::RenderResult{ rt::Canvas{ region.width, region.height },
+                              region,
+                              std::vector<size_t>(region.width * region.height),
+                              0 } }) };
+
+        const std::scoped_lock lock{ m_mutex };
+        this->pruneFinishedJobsLocked();
+        const uint64_t job_id{ m_next_job_id++ };
+        job->job_id = job_id;
+        m_jobs.emplace(job_id, std::move(job));
+        m_scheduled_jobs.emplace(priority_key, job_id);
+        m_tile_available.notify_all();
+        return job_id;
+    }
+
+    bool RenderJobScheduler::cancelJob(const uint64_t job_id)
+    {
+        const std::scoped_lock lock{ m_mutex };
+        const auto job{ m_jobs.find(job_id) };
+        return job != m_jobs.end() && cancelJobLocked(*job->second);
+    }
+
+    void RenderJobScheduler::cancelAllJobs()
+    {
+        const std::scoped_lock lock{ m_mutex };
+        for (const auto& [job_id, job] : m_jobs) {
+            cancelJobLocked(*job);
+        }
+    }
+
+    std::optional<RenderJobStatus> RenderJobScheduler::waitForJob(const uint64_t job_id)
+    {
+        std::unique_lock lock{ m_mutex };
+        const auto job{ m_jobs.find(job_id) };
+        if (job == m_jobs.end()) {
+            return std::nullopt;
+        }
+
+        // Waiting keeps the job from being forgotten, so the iterator stays valid
+        ++job->second->waiter_count;
+        m_job_finished.wait(lock, [&job]() { return isJobFinished(job->second->state); });
+        --job->second->waiter_count;
+        return createJobStatus(*job->second);
+    }
+
+    void RenderJobScheduler::runWorkerThread(const std::stop_token stop_token)
+    {
+        std::unique_lock lock{ m_mutex };
+        while (m_tile_available.wait(lock, stop_token, [this]() { return !m_scheduled_jobs.empty(); })) {
+            // Start on the next tile of the job with the highest priority, unscheduling the job once every one of its
+            // tiles has been started
+            const auto scheduled_job{ m_scheduled_jobs.begin() };
+            Job& job{ *m_jobs.at(scheduled_job->second) };
+            const rt::PixelRect tile{ job.tiles[job.next_tile++] };
+            job.state = JobState::Running;
+            ++job.active_tile_count;
+            if (job.next_tile == job.tiles.size()) {
+                m_scheduled_jobs.erase(scheduled_job);
+            }
+
+            // The request and camera of a job never change once it is submitted, so render without holding the lock
+            lock.unlock();
+            const rt::RenderResult tile_result{ renderAdaptive(
+                *job.request.scene, job.camera, job.request.sampling_settings, tile) };
+            lock.lock();
+            --job.active_tile_count;
+
+            // Discard the tiles of cancelled jobs, releasing the scene after the last tile in flight
+            if (job.state != JobState::Running) {
+                if (job.active_tile_count == 0) {
+                    job.request.scene.reset();
+                }
+                continue;
+            }
+
+            copyRenderRegion(tile_result, *job.frame);
+            if (++job.completed_tile_count == job.tiles.size()) {
+                lock.unlock();
+                finishJob(job);
+                lock.lock();
+            }
+        }
+    }
+
+    void RenderJobScheduler::finishJob(Job& job)
+    {
+        // Cancellation is refused once every tile is complete, so the frame can be written without holding the lock
+        std::optional<rt::CropMetadata> crop{ };
+        if (job.request.crop_region) {
+            crop = rt::CropMetadata{ job.request.crop_region->x,
+                                     job.request.crop_region->y,
+                                     job.camera.getViewportWidth(),
+                                     job.camera.getViewportHeight() };
+        }
+
+        std::string error_message{ };
+        try {
+            rt::writePPMFile(job.frame->image, job.request.output_file_path, crop);
+        }
+        catch (const std::exception& error) {
+            error_message = error.what();
+        }
+
+        const std::scoped_lock lock{ m_mutex };
+        job.state = error_message.empty() ? JobState::Completed : JobState::Failed;
+        job.error_message = std::move(error_message);
+        this->releaseJobLocked(job);
+        m_job_finished.notify_all();
+    }
+
+    bool RenderJobScheduler::cancelJobLocked(Job& job)
+    {
+        if (isJobFinished(job.state) || job.completed_tile_count == job.tiles.size()) {
+            return false;
+        }
+
+        m_scheduled_jobs.erase({ -static_cast<int64_t>(job.request.priority), job.job_id });
+        job.state = JobState::Cancelled;
+        this->releaseJobLocked(job);
+        m_job_finished.notify_all();
+        return true;
+    }
+
+    void RenderJobScheduler::releaseJobLocked(Job& job)
+    {
+        job.frame.reset();
+        if (job.active_tile_count == 0) {
+            job.request.scene.reset();
+        }
+        m_finished_job_ids.push_back(job.job_id);
+    }
+
+    void RenderJobScheduler::pruneFinishedJobsLocked()
+    {
+        auto job_id_iter{ m_finished_job_ids.begin() };
+        while (m_finished_job_ids.size() > FINISHED_JOB_RETENTION_COUNT && job_id_iter != m_finished_job_ids.end()) {
+            const Job& job{ *m_jobs.at(*job_id_iter) };
+            if (job.active_tile_count > 0 || job.waiter_count > 0) {
+                ++job_id_iter;
+                continue;
+            }
+
+            m_jobs.erase(*job_id_iter);
+            job_id_iter = m_finished_job_ids.erase(job_id_iter);
+        }
+    }
+
+    RenderJobStatus RenderJobScheduler::createJobStatus(const Job& job)
+    {
+        return RenderJobStatus{ job.job_id, job.state, job.tiles.size(), job.completed_tile_count, job.error_message };
+    }
+
+    std::string_view getJobStateName(const JobState state)
+    {
+        switch (state) {
+            case JobState::Queued:
+                return "queued";
+            case JobState::Running:
+                return "running";
+            case JobState::Completed:
+                return "completed";
+            case JobState::Cancelled:
+                return "cancelled";
+            case JobState::Failed:
+                return "failed";
+        }
+
+        return "unknown";
+    }
+}
\ No newline at end of file
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "camera.hpp"
+#include "sampling.hpp"
+#include "rendering_functions.hpp"
+#include "traceable_scene.hpp"
+
+namespace rt {
+    // The width and height, in pixels, of the tiles each job is split into. Every tile is a separate task for the
+    // thread pool, so a single job can use every thread and cancelling it takes effect within one tile.
+    inline constexpr size_t SCHEDULED_TILE_SIZE{ 32 };
+
+    // The number of finished jobs whose status is kept for clients to collect. Older finished jobs are forgotten as
+    // new jobs are submitted, so a long-running scheduler does not grow without bound.
+    inline constexpr size_t FINISHED_JOB_RETENTION_COUNT{ 64 };
+
+    // The stages of a render job's life
+    enum class JobState
+    {
+        Queued,         // Waiting for a thread to start on its first tile
+        Running,
+        Completed,      // Written to its output file
+        Cancelled,
+        Failed          // Rendered, but its output file could not be written
+    };
+
+    // Describes a frame to render, for a render server client or as part of an animation sequence
+    struct RenderJobRequest
+    {
+        std::shared_ptr<const gfx::TraceableScene> scene{ };    // Must not change until the job has finished
+        std::optional<rt::Camera> camera{ };                    // Required, but optional so requests can be built up
+        std::filesystem::path output_file_path{ };
+        rt::SamplingSettings sampling_settings{ };
+        std::optional<rt::PixelRect> crop_region{ };
+        int priority{ 0 };                              // Jobs with a higher priority are rendered first
+    };
+
+    // Describes the progress of a render job
+    struct RenderJobStatus
+    {
+        uint64_t job_id;
+        JobState state;
+        size_t tile_count;
+        size_t completed_tile_count;
+        std::string error_message;      // Set for failed jobs
+    };
+
+    // Renders jobs on a shared pool of threads, one tile at a time. Threads always take the next tile of the queued
+    // or running job with the highest priority, with ties going to the job submitted first. The scheduler may be used
+    // by several threads at once.
+    class RenderJobScheduler
+    {
+    public:
+        /* Constructors */
+
+        RenderJobScheduler() = delete;
+        explicit RenderJobScheduler(size_t thread_count);
+        RenderJobScheduler(const RenderJobScheduler&) = delete;
+
+        /* Destructor */
+
+        // Cancels every unfinished job, then waits for the threads to finish their current tiles
+        ~RenderJobScheduler();
+
+        /* Assignment Operators */
+
+        RenderJobScheduler& operator=(const RenderJobScheduler&) = delete;
+
+        /* Accessors */
+
+        [[nodiscard]] size_t getThreadCount() const
+        { return m_threads.size(); }
+
+        // Returns the status of a job, or nothing if no job with the passed-in ID was submitted or it has been
+        // forgotten (see FINISHED_JOB_RETENTION_COUNT)
+        [[nodiscard]] std::optional<RenderJobStatus> getJobStatus(uint64_t job_id) const;
+
+        /* Job Methods */
+
+        // Queues a job and returns its ID, throwing if its settings are invalid
+        uint64_t submitJob(RenderJobRequest request);
+
+        // Cancels a queued or running job, returning false if it has already finished or does not exist. Tiles which
+        // are being rendered when a job is cancelled are discarded once they finish.
+        bool cancelJob(uint64_t job_id);
+
+        // Cancels every job which has not yet finished
+        void cancelAllJobs();
+
+        // Blocks until a job has finished, returning its final status, or nothing if the job does not exist
+        [[nodiscard]] std::optional<RenderJobStatus> waitForJob(uint64_t job_id);
+
+    private:
+        // Holds the state of a single job. Its frame and scene are released once the job finishes and no thread is
+        // still rendering one of its tiles.
+        struct Job
+        {
+            uint64_t job_id;
+            RenderJobRequest request;
+            rt::Camera camera;
+            std::vector<rt::PixelRect> tiles;
+            std::optional<rt::RenderResult> frame;
+            size_t next_tile{ 0 };
+            size_t completed_tile_count{ 0 };
+            size_t active_tile_count{ 0 };          // Tiles being rendered without the lock held
+            size_t waiter_count{ 0 };               // Callers blocked in waitForJob, which keep the job from being
+                                                    // forgotten
+            JobState state{ JobState::Queued };
+            std::string error_message{ };
+        };
+
+        /* Helper Methods */
+
+        // Repeatedly renders the next scheduled tile until the scheduler is destroyed
+        void runWorkerThread(std::stop_token stop_token);
+
+        // Writes the frame of a job whose tiles have all been rendered, then marks it as finished
+        void finishJob(Job& job);
+
+        // Cancels a job which has not started writing its frame, returning false if it is too late to. The mutex must
+        // be held by the caller.
+        bool cancelJobLocked(Job& job);
+
+        // Releases the scene of a finished job once none of its tiles are being rendered, and records it as finished.
+        // The mutex must be held by the caller.
+        void releaseJobLocked(Job& job);
+
+        // Forgets the oldest finished jobs beyond the retention count, apart from those still in use. The mutex must
+        // be held by the caller.
+        void pruneFinishedJobsLocked();
+
+        [[nodiscard]] static RenderJobStatus createJobStatus(const Job& job);
+
+        /* Data Members */
+
+        mutable std::mutex m_mutex{ };
+        std::condition_variable_any m_tile_available{ };
+        std::condition_variable m_job_finished{ };
+        std::map<uint64_t, std::unique_ptr<Job>> m_jobs{ };
+        std::set<std::pair<int64_t, uint64_t>> m_scheduled_jobs{ };    // The negated priority and ID of each job with
+                                                                        // tiles left to start
+        std::deque<uint64_t> m_finished_job_ids{ };                    // In the order the jobs finished
+        uint64_t m_next_job_id{ 1 };
+        std::vector<std::jthread> m_threads{ };                         // Declared last, so threads stop first
+    };
+
+    /* Render Job Functions */
+
+    // Returns the lowercase name of a job state
+    [[nodiscard]] std::string_view getJobStateName(JobState state);
+}
\ No newline at end of file
@@ -0,0 +1,181 @@
+#include "gtest/gtest.h"
+#include "render_job_scheduler.hpp"
+
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+#include "canvas.hpp"
+#include "scene_cache.hpp"
+
+// A small scene for the scheduler to render
+static const std::string TEST_SCENE_DATA{ R"({
+    "world": {
+        "light_source": { "intensity": [1, 1, 1], "position": [-10, 10, -10] },
+        "objects": [
+            { "shape": "sphere", "material": { "color": [0.8, 1.0, 0.6], "diffuse": 0.7, "specular": 0.2 } },
+            { "shape": "plane", "transform": [ { "type": "translate", "values": [0, -1, 0] } ] }
+        ]
+    },
+    "camera": {
+        "viewport_width": 75,
+        "viewport_height": 40,
+        "field_of_view": 1.0471975512,
+        "transform": { "input_base": [0, 1.5, -5], "output_base": [0, 0, 0], "up_vector": [0, 1, 0] }
+    }
+})" };
+
+// Returns a request to render the test scene to a file in the temporary directory
+static rt::RenderJobRequest createTestJobRequest(rt::SceneCache& scene_cache,
+                                                 const std::string& output_file_name,
+                                                 const size_t sample_count)
+{
+    const std::shared_ptr<const rt::CachedScene> cached_scene{ scene_cache.loadScene(TEST_SCENE_DATA) };
+    rt::RenderJobRequest request{
+        .scene = std::shared_ptr<const gfx::TraceableScene>{ cached_scene, &cached_scene->compiled_scene },
+        .camera = cached_scene->scene.camera,
+        .output_file_path = std::filesystem::temp_directory_path() / output_file_name,
+        .sampling_settings = rt::SamplingSettings{ .min_samples = sample_count, .max_samples = sample_count } };
+    std::filesystem::remove(request.output_file_path);
+    return request;
+}
+
+// Tests that a job's tiles are rendered across the thread pool into the same image as a single render. Written images
+// are quantized, so they are compared in their exported form.
+TEST(RayTracerRenderJobScheduler, RenderJob)
+{
+    rt::SceneCache scene_cache{ 1 };
+    rt::RenderJobScheduler scheduler{ 3 };
+    const rt::RenderJobRequest request{ createTestJobRequest(scene_cache, "scheduler_test_render.ppm", 4) };
+    rt::RenderJobRequest crop_request{ createTestJobRequest(scene_cache, "scheduler_test_crop.ppm", 4) };
+    crop_request.crop_region = rt::PixelRect{ 20, 10, 40, 20 };
+
+    const uint64_t job_id{ scheduler.submitJob(request) };
+    const uint64_t crop_job_id{ scheduler.submitJob(crop_request) };
+    const std::optional<rt::RenderJobStatus> status{ scheduler.waitForJob(job_id) };
+    const std::optional<rt::RenderJobStatus> crop_status{ scheduler.waitForJob(crop_job_id) };
+
+    ASSERT_TRUE(status);
+    EXPECT_EQ(status->job_id, job_id);
+    EXPECT_EQ(status->state, rt::JobState::Completed);
+    EXPECT_EQ(status->tile_count, 6);
+    EXPECT_EQ(status->completed_tile_count, 6);
+    ASSERT_TRUE(crop_status);
+    EXPECT_EQ(crop_status->state, rt::JobState::Completed);
+    EXPECT_EQ(crop_status->tile_count, 2);
+
+    const rt::RenderResult expected{ rt::renderAdaptive(*request.scene, *request.camera, request.sampling_settings) };
+    EXPECT_EQ(rt::exportAsPPM(rt::readPPMFile(request.output_file_path).canvas), rt::exportAsPPM(expected.image));
+
+    const rt::RenderResult expected_crop{ rt::renderAdaptive(*request.scene,
+                                                             *request.camera,
+                                                             request.sampling_settings,
+                                                             *crop_request.crop_region) };
+    const rt::PPMImage crop{ rt::readPPMFile(crop_request.output_file_path) };
+    EXPECT_EQ(rt::exportAsPPM(crop.canvas), rt::exportAsPPM(expected_crop.image));
+    EXPECT_EQ(crop.crop, (rt::CropMetadata{ 20, 10, 75, 40 }));
+}
+
+// Tests that jobs with a higher priority are rendered before jobs submitted earlier
+TEST(RayTracerRenderJobScheduler, RenderJobsByPriority)
+{
+    rt::SceneCache scene_cache{ 1 };
+    rt::RenderJobScheduler scheduler{ 1 };
+
+    // The first job occupies the only thread while the others are submitted, so the thread chooses between them
+    const uint64_t busy_job_id{ scheduler.submitJob(createTestJobRequest(scene_cache, "scheduler_test_busy.ppm", 64)) };
+    const uint64_t low_job_id{ scheduler.submitJob(createTestJobRequest(scene_cache, "scheduler_test_low.ppm", 1)) };
+    rt::RenderJobRequest high_request{ createTestJobRequest(scene_cache, "scheduler_test_high.ppm", 1) };
+    high_request.priority = 5;
+    const uint64_t high_job_id{ scheduler.submitJob(high_request) };
+
+    EXPECT_EQ(scheduler.waitForJob(low_job_id)->state, rt::JobState::Completed);
+    EXPECT_EQ(scheduler.getJobStatus(high_job_id)->state, rt::JobState::Completed);
+    EXPECT_EQ(scheduler.getJobStatus(busy_job_id)->state, rt::JobState::Completed);
+}
+
+// Tests cancelling queued, running and finished jobs
+TEST(RayTracerRenderJobScheduler, CancelJobs)
+{
+    rt::SceneCache scene_cache{ 1 };
+    rt::RenderJobScheduler scheduler{ 1 };
+    const rt::RenderJobRequest running_request{ createTestJobRequest(scene_cache, "scheduler_test_running.ppm", 64) };
+    const rt::RenderJobRequest queued_request{ createTestJobRequest(scene_cache, "scheduler_test_queued.ppm", 1) };
+    const uint64_t running_job_id{ scheduler.submitJob(running_request) };
+    const uint64_t queued_job_id{ scheduler.submitJob(queued_request) };
+
+    EXPECT_TRUE(scheduler.cancelJob(queued_job_id));
+    EXPECT_TRUE(scheduler.cancelJob(running_job_id));
+    EXPECT_FALSE(scheduler.cancelJob(running_job_id));
+    EXPECT_FALSE(scheduler.cancelJob(1000));
+    EXPECT_EQ(scheduler.waitForJob(queued_job_id)->state, rt::JobState::Cancelled);
+    EXPECT_EQ(scheduler.waitForJob(running_job_id)->state, rt::JobState::Cancelled);
+    EXPECT_FALSE(scheduler.waitForJob(1000));
+
+    // Cancelled jobs never write their output, and the scheduler keeps serving later jobs
+    const rt::RenderJobRequest request{ createTestJobRequest(scene_cache, "scheduler_test_after.ppm", 1) };
+    const uint64_t job_id{ scheduler.submitJob(request) };
+    EXPECT_EQ(scheduler.waitForJob(job_id)->state, rt::JobState::Completed);
+    EXPECT_FALSE(scheduler.cancelJob(job_id));
+    EXPECT_FALSE(std::filesystem::exists(running_request.output_file_path));
+    EXPECT_FALSE(std::filesystem::exists(queued_request.output_file_path));
+    EXPECT_TRUE(std::filesystem::exists(request.output_file_path));
+}
+
+// Tests that jobs which cannot be rendered are rejected or reported as failed
+TEST(RayTracerRenderJobScheduler, RejectInvalidJobs)
+{
+    rt::SceneCache scene_cache{ 1 };
+    rt::RenderJobScheduler scheduler{ 1 };
+
+    rt::RenderJobRequest crop_request{ createTestJobRequest(scene_cache, "scheduler_test_invalid.ppm", 1) };
+    crop_request.crop_region = rt::PixelRect{ 70, 0, 10, 10 };
+    EXPECT_THROW(static_cast<void>(scheduler.submitJob(crop_request)), std::invalid_argument);
+
+    rt::RenderJobRequest sample_request{ createTestJobRequest(scene_cache, "scheduler_test_invalid.ppm", 1) };
+    sample_request.sampling_settings.min_samples = 0;
+    EXPECT_THROW(static_cast<void>(scheduler.submitJob(sample_request)), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(scheduler.submitJob(rt::RenderJobRequest{ })), std::invalid_argument);
+
+    rt::RenderJobRequest camera_request{ createTestJobRequest(scene_cache, "scheduler_test_invalid.ppm", 1) };
+    camera_request.camera.reset();
+    EXPECT_THROW(static_cast<void>(scheduler.submitJob(camera_request)), std::invalid_argument);
+    EXPECT_THROW(rt::RenderJobScheduler{ 0 }, std::invalid_argument);
+
+    rt::RenderJobRequest output_request{ createTestJobRequest(scene_cache, "scheduler_test_invalid.ppm", 1) };
+    output_request.output_file_path = std::filesystem::temp_directory_path() / "missing_directory" / "image.ppm";
+    const std::optional<rt::RenderJobStatus> status{ scheduler.waitForJob(scheduler.submitJob(output_request)) };
+    EXPECT_EQ(status->state, rt::JobState::Failed);
+    EXPECT_FALSE(status->error_message.empty());
+}
+
+// Tests that finished jobs release their scenes, and that only the most recently finished jobs are remembered
+TEST(RayTracerRenderJobScheduler, ForgetFinishedJobs)
+{
+    rt::SceneCache scene_cache{ 1 };
+    rt::RenderJobScheduler scheduler{ 2 };
+    rt::RenderJobRequest request{ createTestJobRequest(scene_cache, "scheduler_test_retention.ppm", 1) };
+    request.crop_region = rt::PixelRect{ 0, 0, 1, 1 };
+
+    const long scene_use_count{ request.scene.use_count() };
+    const uint64_t first_job_id{ scheduler.submitJob(request) };
+    ASSERT_EQ(scheduler.waitForJob(first_job_id)->state, rt::JobState::Completed);
+    EXPECT_EQ(request.scene.use_count(), scene_use_count);
+
+    const uint64_t cancelled_job_id{ scheduler.submitJob(request) };
+    static_cast<void>(scheduler.cancelJob(cancelled_job_id));
+    static_cast<void>(scheduler.waitForJob(cancelled_job_id));
+    for (size_t i = 1; i < rt::FINISHED_JOB_RETENTION_COUNT; ++i) {
+        static_cast<void>(scheduler.waitForJob(scheduler.submitJob(request)));
+    }
+    EXPECT_TRUE(scheduler.getJobStatus(first_job_id));
+
+    // Submitting another job forgets the oldest finished job beyond the retention count
+    const uint64_t last_job_id{ scheduler.submitJob(request) };
+    EXPECT_FALSE(scheduler.getJobStatus(first_job_id));
+    EXPECT_TRUE(scheduler.getJobStatus(cancelled_job_id));
+    EXPECT_EQ(scheduler.waitForJob(last_job_id)->state, rt::JobState::Completed);
+    EXPECT_FALSE(scheduler.cancelJob(first_job_id));
+}
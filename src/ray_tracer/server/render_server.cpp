@@ -0,0 +1,224 @@
+#include "render_server.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <format>
+#include <list>
+#include <optional>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+#include <poll.h>
+
+#include "parse.hpp"
+#include "render_job_scheduler.hpp"
+#include "scene_cache.hpp"
+
+namespace rt {
+    // Holds the state shared by every client of a render server
+    struct RenderServerState
+    {
+        rt::SceneCache scene_cache;
+        rt::RenderJobScheduler scheduler;
+        std::atomic<bool> is_shutdown_requested{ false };
+    };
+
+    // Holds the connection to a single client alongside the thread serving it
+    struct ClientConnection
+    {
+        rt::Socket socket;
+        std::atomic<bool> is_finished{ false };
+        std::jthread thread{ };
+    };
+
+    // Returns the JSON reply describing the status of a job
+    static json createStatusReply(const rt::RenderJobStatus& status)
+    {
+        return json{ { "job", status.job_id },
+                     { "state", getJobStateName(status.state) },
+                     { "tiles", status.tile_count },
+                     { "completed_tiles", status.completed_tile_count },
+                     { "error", status.error_message } };
+    }
+
+    // Returns the status reply of the job whose ID is the "job" member of a request, waiting for the job to finish
+    // first if requested
+    static json createJobReply(RenderServerState& state, const json& request, const bool wait_for_job)
+    {
+        const uint64_t job_id{ request.at("job").get<uint64_t>() };
+        const std::optional<rt::RenderJobStatus> status{
+            wait_for_job ? state.scheduler.waitForJob(job_id) : state.scheduler.getJobStatus(job_id) };
+        if (!status) {
+            throw std::invalid_argument(std::format("No job with ID {} was submitted", job_id));
+        }
+
+        return createStatusReply(*status);
+    }
+
+    // Queues the render job described by a request and returns the reply describing its status
+    static json submitRenderJob(RenderServerState& state, const json& request)
+    {
+        // The job shares ownership of the cached scene through its compiled snapshot, so that it outlives eviction
+        const std::shared_ptr<const rt::CachedScene> cached_scene{
+            state.scene_cache.loadSceneFile(request.at("scene").get<std::string>()) };
+        rt::RenderJobRequest job_request{
+            .scene = std::shared_ptr<const gfx::TraceableScene>{ cached_scene, &cached_scene->compiled_scene },
+            .camera = cached_scene->scene.camera,
+            .output_file_path = request.at("output").get<std::string>() };
+        if (request.contains("camera")) {
+            job_request.camera = data::parseCameraData(request["camera"]);
+        }
+        if (request.contains("quality")) {
+            const json& quality{ request["quality"] };
+            rt::SamplingSettings& settings{ job_request.sampling_settings };
+            settings.min_samples = quality.value("min_spp", settings.min_samples);
+            settings.max_samples = quality.value("max_spp", std::max(settings.max_samples, settings.min_samples));
+            settings.variance_threshold = quality.value("variance_threshold", settings.variance_threshold);
+            settings.contrast_threshold = quality.value("contrast_threshold", settings.contrast_threshold);
+        }
+        if (request.contains("crop")) {
+            const std::array<size_t, 4> crop{ request["crop"].get<std::array<size_t, 4>>() };
+            job_request.crop_region = rt::PixelRect{ crop[0], crop[1], crop[2], crop[3] };
+        }
+        job_request.priority = request.value("priority", 0);
+
+        const uint64_t job_id{ state.scheduler.submitJob(std::move(job_request)) };
+        const std::optional<rt::RenderJobStatus> status{ request.value("wait", false) ?
+            state.scheduler.waitForJob(job_id) : state.scheduler.getJobStatus(job_id) };
+        return createStatusReply(*status);
+    }
+
+    // Returns the reply to a single request line, describing the error if the request fails
+    static json serveRequest(RenderServerState& state, const std::string_view request_line)
+    {
+        // Define string-to-case mapping for possible commands
+        enum class Cases { Render, Status, Wait, Cancel, Stats, Shutdown };
+        static const std::unordered_map<std::string_view, Cases> stringToCaseMap{
+                { "render",             Cases::Render },
+                { "status",             Cases::Status },
+                { "wait",               Cases::Wait },
+                { "cancel",             Cases::Cancel },
+                { "stats",              Cases::Stats },
+                { "shutdown",           Cases::Shutdown }
+        };
+
+        try {
+            const json request = json::parse(request_line);
+            const auto it{ stringToCaseMap.find(request.at("command").get<std::string_view>()) };
+            if (it == stringToCaseMap.end()) {
+                throw std::invalid_argument("Invalid command, check spelling in render server request");
+            }
+
+            switch (it->second) {
+                case Cases::Render:
+                    return submitRenderJob(state, request);
+                case Cases::Status:
+                    return createJobReply(state, request, false);
+                case Cases::Wait:
+                    return createJobReply(state, request, true);
+                case Cases::Cancel:
+                    state.scheduler.cancelJob(request.at("job").get<uint64_t>());
+                    return createJobReply(state, request, false);
+                case Cases::Stats: {
+                    const rt::SceneCacheStatistics statistics{ state.scene_cache.getStatistics() };
+                    return json{ { "cache_hits", statistics.hit_count },
+                                 { "cache_misses", statistics.miss_count },
+                                 { "cached_scenes", statistics.entry_count },
+                                 { "threads", state.scheduler.getThreadCount() } };
+                }
+                case Cases::Shutdown:
+                    state.is_shutdown_requested = true;
+                    return json{ { "shutdown", true } };
+            }
+        }
+        catch (const std::exception& error) {
+            return json{ { "error", error.what() } };
+        }
+
+        return json{ { "error", "Unhandled command" } };
+    }
+
+    // Replies to each request line a client sends until it disconnects
+    static void serveClient(RenderServerState& state, const rt::Socket& socket)
+    {
+        std::string received_data{ };
+        std::array<std::byte, 4096> buffer{ };
+        while (size_t received_size = receiveData(socket, buffer)) {
+            received_data.append(reinterpret_cast<const char*>(buffer.data()), received_size);
+
+            size_t line_end{ };
+            while ((line_end = received_data.find('\n')) != std::string::npos) {
+                const std::string request_line{ received_data.substr(0, line_end) };
+                received_data.erase(0, line_end + 1);
+                if (request_line.find_first_not_of(" \t\r") == std::string::npos) {
+                    continue;
+                }
+
+                const std::string reply{ serveRequest(state, request_line).dump() + '\n' };
+                try {
+                    sendData(socket, std::as_bytes(std::span{ reply }));
+                }
+                catch (const std::system_error&) {
+                    return;
+                }
+            }
+        }
+    }
+
+    void runRenderServer(const RenderServerSettings& settings)
+    {
+        const rt::Socket listener{ listenOnEndpoint(settings.endpoint) };
+        const rt::EndpointFileRemover endpoint_file_remover{ settings.endpoint };
+        RenderServerState state{ rt::SceneCache{ settings.scene_cache_capacity },
+                                 rt::RenderJobScheduler{ settings.thread_count } };
+
+        std::list<ClientConnection> connections{ };
+        while (!state.is_shutdown_requested) {
+            pollfd poll_descriptor{ listener.getDescriptor(), POLLIN, 0 };
+            if (poll(&poll_descriptor, 1, SERVER_POLL_INTERVAL.count()) < 0 && errno != EINTR) {
+                throw std::system_error(errno, std::generic_category(), "Unable to wait for clients");
+            }
+
+            // Serve each new client on its own thread, so clients waiting for their jobs do not hold up others
+            if ((poll_descriptor.revents & POLLIN) != 0) {
+                ClientConnection& connection{ connections.emplace_back(acceptConnection(listener)) };
+                connection.thread = std::jthread{ [&state, &connection]() {
+                    serveClient(state, connection.socket);
+                    connection.is_finished = true;
+                } };
+            }
+            connections.remove_if([](const ClientConnection& connection) { return connection.is_finished.load(); });
+        }
+
+        // Wake clients waiting for their jobs, then disconnect every client before their threads are joined
+        state.scheduler.cancelAllJobs();
+        for (const ClientConnection& connection : connections) {
+            connection.socket.shutdown();
+        }
+        connections.clear();
+    }
+
+    std::string sendServerRequest(const rt::Endpoint& endpoint, const std::string_view request)
+    {
+        const rt::Socket socket{ connectToEndpoint(endpoint) };
+        const std::string request_line{ std::string{ request } + '\n' };
+        sendData(socket, std::as_bytes(std::span{ request_line }));
+
+        std::string reply{ };
+        std::array<std::byte, 4096> buffer{ };
+        while (reply.find('\n') == std::string::npos) {
+            const size_t received_size{ receiveData(socket, buffer) };
+            if (received_size == 0) {
+                throw std::system_error(ECONNRESET, std::generic_category(), "Render server disconnected");
+            }
+            reply.append(reinterpret_cast<const char*>(buffer.data()), received_size);
+        }
+
+        return reply.substr(0, reply.find('\n'));
+    }
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "socket.hpp"
+
+namespace rt {
+    // How often the render server checks whether it has been asked to shut down while no client connects
+    inline constexpr std::chrono::milliseconds SERVER_POLL_INTERVAL{ 250 };
+
+    // Controls the resources of a render server
+    struct RenderServerSettings
+    {
+        rt::Endpoint endpoint;              // Where the server listens for clients
+        size_t thread_count;                // Threads shared by every render job
+        size_t scene_cache_capacity;        // Scenes kept parsed and compiled between jobs
+    };
+
+    /* Render Server Functions */
+
+    // Serves clients until one of them sends a shutdown request, then cancels every unfinished job. Each request and
+    // reply is a single line of JSON holding an object. A request's "command" member selects what it does:
+    //   "render"   - queues a job rendering the scene file "scene" to the PPM file "output". The optional members are
+    //                "camera" (replacing the scene's camera, in the scene file format), "quality" (holding any of
+    //                "min_spp", "max_spp", "variance_threshold" and "contrast_threshold"), "crop" ([x, y, width,
+    //                height]), "priority" (an integer, higher first) and "wait" (reply once the job has finished)
+    //   "status"   - replies with the status of the job whose ID is "job"
+    //   "wait"     - replies with the status of the job whose ID is "job" once it has finished
+    //   "cancel"   - cancels the job whose ID is "job", then replies with its status
+    //   "stats"    - replies with the scene cache statistics
+    //   "shutdown" - stops the server
+    // Job statuses are replied as {"job", "state", "tiles", "completed_tiles", "error"}, and failed requests as
+    // {"error"}. Relative paths are resolved against the server's working directory. Throws std::system_error if the
+    // endpoint cannot be bound.
+    void runRenderServer(const RenderServerSettings& settings);
+
+    // Sends a single request line to a render server and returns its reply line, throwing std::system_error if the
+    // server cannot be reached or disconnects before replying
+    [[nodiscard]] std::string sendServerRequest(const rt::Endpoint& endpoint, std::string_view request);
+}
\ No newline at end of file
@@ -0,0 +1,90 @@
+#include "gtest/gtest.h"
+#include "render_server.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <future>
+#include <string>
+#include <system_error>
+#include <thread>
+
+#include "parse.hpp"
+#include "canvas.hpp"
+
+// Sends a request to a render server, retrying until the server has started listening
+static json sendRequestWhenReady(const rt::Endpoint& endpoint, const json& request)
+{
+    for (size_t attempt = 0; ; ++attempt) {
+        try {
+            return json::parse(rt::sendServerRequest(endpoint, request.dump()));
+        }
+        catch (const std::system_error&) {
+            if (attempt == 100) {
+                throw;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds{ 20 });
+        }
+    }
+}
+
+// Tests rendering a scene twice through a render server, which compiles the scene only once.
+TEST(RayTracerRenderServer, ServeRenderRequests)
+{
+    const std::filesystem::path temp_directory{ std::filesystem::temp_directory_path() };
+    const std::filesystem::path scene_file_path{ temp_directory / "render_server_test_scene.json" };
+    const std::filesystem::path output_file_path{ temp_directory / "render_server_test_output.ppm" };
+    std::ofstream{ scene_file_path, std::ios_base::trunc } << R"({
+        "world": {
+            "light_source": { "intensity": [1, 1, 1], "position": [-10, 10, -10] },
+            "objects": [ { "shape": "sphere" } ]
+        },
+        "camera": {
+            "viewport_width": 40,
+            "viewport_height": 20,
+            "field_of_view": 1.0471975512,
+            "transform": { "input_base": [0, 1.5, -5], "output_base": [0, 0, 0], "up_vector": [0, 1, 0] }
+        }
+    })";
+
+    const rt::RenderServerSettings settings{
+        rt::Endpoint{ rt::EndpointType::UnixSocket, (temp_directory / "render_server_test.sock").string() }, 2, 4 };
+    std::future<void> server{ std::async(std::launch::async, [&]() { rt::runRenderServer(settings); }) };
+
+    const json render_request{ { "command", "render" },
+                               { "scene", scene_file_path.string() },
+                               { "output", output_file_path.string() },
+                               { "quality", { { "min_spp", 2 } } },
+                               { "wait", true } };
+    const json first_reply = sendRequestWhenReady(settings.endpoint, render_request);
+    EXPECT_EQ(first_reply["state"], "completed");
+    EXPECT_EQ(first_reply["tiles"], 2);
+    EXPECT_EQ(first_reply["completed_tiles"], 2);
+
+    json crop_request = render_request;
+    crop_request["crop"] = { 10, 5, 20, 10 };
+    const json second_reply = sendRequestWhenReady(settings.endpoint, crop_request);
+    EXPECT_EQ(second_reply["state"], "completed");
+    EXPECT_EQ(second_reply["job"], first_reply["job"].get<uint64_t>() + 1);
+    EXPECT_EQ(rt::readPPMFile(output_file_path).crop, (rt::CropMetadata{ 10, 5, 40, 20 }));
+
+    const json status_reply = sendRequestWhenReady(settings.endpoint, { { "command", "status" },
+                                                                        { "job", first_reply["job"] } });
+    EXPECT_EQ(status_reply, first_reply);
+
+    const json stats_reply = sendRequestWhenReady(settings.endpoint, { { "command", "stats" } });
+    EXPECT_EQ(stats_reply["cache_hits"], 1);
+    EXPECT_EQ(stats_reply["cache_misses"], 1);
+    EXPECT_EQ(stats_reply["threads"], 2);
+
+    // Failed requests are reported without disconnecting the client or stopping the server
+    EXPECT_TRUE(sendRequestWhenReady(settings.endpoint, { { "command", "status" }, { "job", 1000 } }).contains("error"));
+    EXPECT_TRUE(sendRequestWhenReady(settings.endpoint, { { "command", "paint" } }).contains("error"));
+    EXPECT_TRUE(sendRequestWhenReady(settings.endpoint, { { "command", "render" } }).contains("error"));
+
+    EXPECT_EQ(sendRequestWhenReady(settings.endpoint, { { "command", "shutdown" } })["shutdown"], true);
+    EXPECT_EQ(server.wait_for(std::chrono::seconds{ 10 }), std::future_status::ready);
+    server.get();
+    EXPECT_FALSE(std::filesystem::exists(settings.endpoint.address));
+}
\ No newline at end of file
@@ -0,0 +1,68 @@
+#include "scene_cache.hpp"
+
+#include <format>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+namespace rt {
+    SceneCache::SceneCache(const size_t capacity)
+            : m_capacity{ capacity }
+    {
+        if (capacity == 0) {
+            throw std::invalid_argument("A scene cache must be able to hold at least one scene");
+        }
+    }
+
+    // Statistics Accessor
+    SceneCacheStatistics SceneCache::getStatistics() const
+    {
+        const std::scoped_lock lock{ m_mutex };
+        return SceneCacheStatistics{ m_hit_count, m_miss_count, m_entries.size() };
+    }
+
+    std::shared_ptr<const CachedScene> SceneCache::loadScene(const std::string_view scene_data)
+    {
+        const uint64_t content_hash{ calculateContentHash(scene_data) };
+        {
+            const std::scoped_lock lock{ m_mutex };
+            for (auto entry = m_entries.begin(); entry != m_entries.end(); ++entry) {
+                if (entry->scene->content_hash == content_hash && entry->scene_data == scene_data) {
+                    m_entries.splice(m_entries.begin(), m_entries, entry);
+                    ++m_hit_count;
+                    return m_entries.front().scene;
+                }
+            }
+            ++m_miss_count;
+        }
+
+        // Parse and compile the scene without holding the lock, so that jobs for cached scenes are not held up. If
+        // another thread loads the same scene meanwhile, both compile it and the later one replaces the earlier entry.
+        Scene scene{ data::parseSceneData(json::parse(scene_data)) };
+        gfx::CompiledScene compiled_scene{ gfx::compileScene(scene.world) };
+        std::shared_ptr<const CachedScene> cached_scene{
+            std::make_shared<const CachedScene>(content_hash, std::move(scene), std::move(compiled_scene)) };
+
+        const std::scoped_lock lock{ m_mutex };
+        std::erase_if(m_entries, [&](const CacheEntry& entry) { return entry.scene_data == scene_data; });
+        m_entries.push_front(CacheEntry{ std::string{ scene_data }, cached_scene });
+        if (m_entries.size() > m_capacity) {
+            m_entries.pop_back();
+        }
+
+        return cached_scene;
+    }
+
+    std::shared_ptr<const CachedScene> SceneCache::loadSceneFile(const std::filesystem::path& file_path)
+    {
+        std::ifstream scene_file{ file_path };
+        if (!scene_file) {
+            throw std::invalid_argument(std::format("Unable to open scene file '{}'", file_path.string()));
+        }
+
+        std::ostringstream scene_data;
+        scene_data << scene_file.rdbuf();
+        return loadScene(scene_data.str());
+    }
+}
\ No newline at end of file
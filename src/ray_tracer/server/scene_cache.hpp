@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include "parse.hpp"
+#include "binary_encoding.hpp"
+#include "compiled_scene.hpp"
+
+namespace rt {
+    // The number of scenes a render server keeps compiled, unless set explicitly
+    inline constexpr size_t DEFAULT_SCENE_CACHE_CAPACITY{ 8 };
+
+    // Holds a parsed scene alongside its compiled snapshot, which every job rendering the scene shares
+    struct CachedScene
+    {
+        uint64_t content_hash;
+        Scene scene;
+        gfx::CompiledScene compiled_scene;
+    };
+
+    // Counts how often scenes were found in a scene cache
+    struct SceneCacheStatistics
+    {
+        size_t hit_count;
+        size_t miss_count;
+        size_t entry_count;
+    };
+
+    // Keeps the most recently used scenes parsed and compiled, keyed by a hash of their JSON data, so that rendering
+    // a scene again skips parsing, building transform inverses and building its BVH. Editing a scene file changes its
+    // hash, so stale scenes are never returned. The cache may be used by several threads at once.
+    class SceneCache
+    {
+    public:
+        /* Constructors */
+
+        SceneCache() = delete;
+        explicit SceneCache(size_t capacity);
+
+        /* Accessors */
+
+        [[nodiscard]] SceneCacheStatistics getStatistics() const;
+
+        /* Scene Loading Methods */
+
+        // Returns the scene described by JSON scene data, parsing and compiling it only if it is not cached. Throws
+        // if the data does not describe a valid scene.
+        [[nodiscard]] std::shared_ptr<const CachedScene> loadScene(std::string_view scene_data);
+
+        // Returns the scene stored in a JSON scene file, throwing if the file cannot be read
+        [[nodiscard]] std::shared_ptr<const CachedScene> loadSceneFile(const std::filesystem::path& file_path);
+
+    private:
+        // Holds a cached scene alongside the data it was parsed from, which guards against hash collisions
+        struct CacheEntry
+        {
+            std::string scene_data;
+            std::shared_ptr<const CachedScene> scene;
+        };
+
+        /* Data Members */
+
+        mutable std::mutex m_mutex{ };
+        std::list<CacheEntry> m_entries{ };     // Ordered from most to least recently used
+        size_t m_capacity;
+        size_t m_hit_count{ 0 };
+        size_t m_miss_count{ 0 };
+    };
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+#include "gtest/gtest.h"
+#include "scene_cache.hpp"
+
+#include <format>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+// Returns the JSON data of a small scene whose sphere has the passed-in radius
+static std::string createTestSceneData(const double radius)
+{
+    return std::format(R"({{
+        "world": {{
+            "light_source": {{ "intensity": [1, 1, 1], "position": [-10, 10, -10] }},
+            "objects": [ {{ "shape": "sphere", "transform": [ {{ "type": "scale", "values": [{0}, {0}, {0}] }} ] }} ]
+        }},
+        "camera": {{
+            "viewport_width": 20,
+            "viewport_height": 10,
+            "field_of_view": 1.0471975512,
+            "transform": {{ "input_base": [0, 1.5, -5], "output_base": [0, 0, 0], "up_vector": [0, 1, 0] }}
+        }}
+    }})", radius);
+}
+
+// Tests that loading the same scene data again returns the cached scene instead of compiling it again
+TEST(RayTracerSceneCache, LoadCachedScene)
+{
+    rt::SceneCache scene_cache{ 2 };
+    const std::string scene_data{ createTestSceneData(1.0) };
+
+    const std::shared_ptr<const rt::CachedScene> scene_a{ scene_cache.loadScene(scene_data) };
+    const std::shared_ptr<const rt::CachedScene> scene_b{ scene_cache.loadScene(scene_data) };
+    const std::shared_ptr<const rt::CachedScene> scene_c{ scene_cache.loadScene(createTestSceneData(2.0)) };
+
+    EXPECT_EQ(scene_a, scene_b);
+    EXPECT_NE(scene_a, scene_c);
+    EXPECT_EQ(scene_a->content_hash, rt::calculateContentHash(scene_data));
+    EXPECT_EQ(scene_a->scene.camera.getViewportWidth(), 20);
+    EXPECT_GT(scene_a->compiled_scene.getBuildStatistics().primitive_count, 0);
+
+    const rt::SceneCacheStatistics statistics{ scene_cache.getStatistics() };
+    EXPECT_EQ(statistics.hit_count, 1);
+    EXPECT_EQ(statistics.miss_count, 2);
+    EXPECT_EQ(statistics.entry_count, 2);
+}
+
+// Tests that a full scene cache evicts its least recently used scene
+TEST(RayTracerSceneCache, EvictLeastRecentlyUsedScene)
+{
+    rt::SceneCache scene_cache{ 2 };
+    const std::shared_ptr<const rt::CachedScene> scene_a{ scene_cache.loadScene(createTestSceneData(1.0)) };
+    const std::shared_ptr<const rt::CachedScene> scene_b{ scene_cache.loadScene(createTestSceneData(2.0)) };
+
+    // Using the first scene again makes the second the least recently used, so the third scene evicts it
+    EXPECT_EQ(scene_cache.loadScene(createTestSceneData(1.0)), scene_a);
+    static_cast<void>(scene_cache.loadScene(createTestSceneData(3.0)));
+    EXPECT_EQ(scene_cache.loadScene(createTestSceneData(1.0)), scene_a);
+    EXPECT_NE(scene_cache.loadScene(createTestSceneData(2.0)), scene_b);
+
+    const rt::SceneCacheStatistics statistics{ scene_cache.getStatistics() };
+    EXPECT_EQ(statistics.hit_count, 2);
+    EXPECT_EQ(statistics.miss_count, 4);
+    EXPECT_EQ(statistics.entry_count, 2);
+}
+
+// Tests that invalid scene data is not cached
+TEST(RayTracerSceneCache, LoadInvalidScene)
+{
+    rt::SceneCache scene_cache{ 2 };
+
+    EXPECT_ANY_THROW(static_cast<void>(scene_cache.loadScene("{ not json")));
+    EXPECT_THROW(static_cast<void>(scene_cache.loadSceneFile("missing_scene_file.json")), std::invalid_argument);
+    EXPECT_EQ(scene_cache.getStatistics().entry_count, 0);
+}
\ No newline at end of file